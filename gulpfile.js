@@ -29,7 +29,8 @@ const nodeTests =
 	'test/test-Peer.js',
 	'test/test-Transport.js',
 	'test/test-RtpReceiver.js',
-	'test/test-extra.js'
+	'test/test-extra.js',
+	'test/test-Channel.js'
 ];
 const workerCompilationDatabaseTemplate = 'worker/compile_commands_template.json';
 const workerHeaderFilterRegex =
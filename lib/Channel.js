@@ -6,17 +6,23 @@ const logger = require('./logger')('Channel');
 const workerLogger = require('./logger')('mediasoup-worker');
 const utils = require('./utils');
 const errors = require('./errors');
+const binaryCodec = require('./binaryCodec');
 
 // netstring length for a 65536 bytes payload.
 const NS_MAX_SIZE = 65543;
+// Max size of a message received as several fragments.
+const FRAGMENTED_MESSAGE_MAX_SIZE = 16777216;
+// Fragments start with these instead of '{' or binaryCodec.MARKER.
+const FRAGMENT_MARKER = 0x01;
+const LAST_FRAGMENT_MARKER = 0x02;
 // Max time waiting for a response from the worker subprocess.
 const REQUEST_TIMEOUT = 5000;
 
 class Channel extends EventEmitter
 {
-	constructor(socket)
+	constructor(socket, binary)
 	{
-		logger.debug('constructor()');
+		logger.debug('constructor() [binary:%s]', Boolean(binary));
 
 		super();
 		this.setMaxListeners(Infinity);
@@ -24,14 +30,27 @@ class Channel extends EventEmitter
 		// Unix Socket instance.
 		this._socket = socket;
 
+		// Whether requests are sent in binary instead of JSON.
+		this._binary = Boolean(binary);
+
 		this._pendingSent = new Map();
 
+		// Whether requests are being held to be written together.
+		this._corked = false;
+
 		// Buffer for incomplete data received from the Channel's socket.
 		this._recvBuffer = null;
 
 		// Last binary notification received.
 		this._lastBinaryNotification = null;
 
+		// Last binary response received, whose data comes as fragments.
+		this._lastBinaryResponse = null;
+
+		// Fragments of the message being received.
+		this._fragments = [];
+		this._fragmentsLength = 0;
+
 		// Read Channel responses/notifications from the worker.
 		this._socket.on('data', (buffer) =>
 		{
@@ -43,18 +62,6 @@ class Channel extends EventEmitter
 			{
 				this._recvBuffer = Buffer.concat([ this._recvBuffer, buffer ],
 					this._recvBuffer.length + buffer.length);
-
-				if (this._recvBuffer.length > NS_MAX_SIZE)
-				{
-					logger.error('recvBuffer is full, discarding all the data in it');
-
-					// Reset the recvBuffer and exit.
-					this._recvBuffer = null;
-					// Just in case.
-					this._lastBinaryNotification = null;
-
-					return;
-				}
 			}
 
 			while (true) // eslint-disable-line no-constant-condition
@@ -74,21 +81,48 @@ class Channel extends EventEmitter
 					// Just in case.
 					this._lastBinaryNotification = null;
 
+					if (this._lastBinaryResponse)
+						this._abortBinaryResponse('invalid data received');
+
 					return;
 				}
 
 				// Incomplete netstring.
 				if (nsPayload === -1)
 				{
+					// It may be preceded by complete ones in a big chunk, so just check
+					// the size once those have been read.
+					if (this._recvBuffer.length > NS_MAX_SIZE)
+					{
+						logger.error('recvBuffer is full, discarding all the data in it');
+
+						// Reset the recvBuffer and exit.
+						this._recvBuffer = null;
+						// Just in case.
+						this._lastBinaryNotification = null;
+
+						if (this._lastBinaryResponse)
+							this._abortBinaryResponse('recvBuffer is full');
+					}
+
 					return;
 				}
 
 				// We are not waiting for binary data for a previous binary event.
 				if (!this._lastBinaryNotification)
 				{
+					// The fragments of a binary response follow it right away, so any
+					// other Channel message means they will never come.
+					if (this._lastBinaryResponse &&
+						(nsPayload[0] === 123 || nsPayload[0] === binaryCodec.MARKER))
+					{
+						this._abortBinaryResponse('binary data not received');
+					}
+
 					try
 					{
-						// We can receive JSON messages (Channel messages) or log strings.
+						// We can receive JSON or binary messages (Channel messages) or log
+						// strings.
 						switch (nsPayload[0])
 						{
 							// 123 = '{' (a Channel JSON messsage).
@@ -96,6 +130,17 @@ class Channel extends EventEmitter
 								this._processMessage(JSON.parse(nsPayload));
 								break;
 
+							// A Channel binary message.
+							case binaryCodec.MARKER:
+								this._processMessage(binaryCodec.decode(nsPayload));
+								break;
+
+							// A fragment of a Channel message too big for a netstring.
+							case FRAGMENT_MARKER:
+							case LAST_FRAGMENT_MARKER:
+								this._processFragment(nsPayload);
+								break;
+
 							// 68 = 'D' (a debug log).
 							case 68:
 								workerLogger.debug(nsPayload.toString(null, 1));
@@ -195,7 +240,12 @@ class Channel extends EventEmitter
 		logger.debug('request() [method:%s, id:%s]', method, id);
 
 		let request = { id, method, internal, data };
-		let ns = netstring.nsWrite(JSON.stringify(request));
+		let ns;
+
+		if (this._binary)
+			ns = netstring.nsWrite(binaryCodec.encode(request));
+		else
+			ns = netstring.nsWrite(JSON.stringify(request));
 
 		if (Buffer.byteLength(ns) > NS_MAX_SIZE)
 			return Promise.reject(new Error('request too big'));
@@ -203,6 +253,21 @@ class Channel extends EventEmitter
 		// This may raise if closed or remote side ended.
 		try
 		{
+			// Requests made in the same tick are written at once, so the worker
+			// reads them together (e.g. a close right after a dump is received
+			// before the first step of the dump runs).
+			if (!this._corked)
+			{
+				this._corked = true;
+				this._socket.cork();
+
+				process.nextTick(() =>
+				{
+					this._corked = false;
+					this._socket.uncork();
+				});
+			}
+
 			this._socket.write(ns);
 		}
 		catch (error)
@@ -212,14 +277,42 @@ class Channel extends EventEmitter
 
 		return new Promise((pResolve, pReject) =>
 		{
+			let onTimeout = () =>
+			{
+				if (!this._pendingSent.delete(id))
+					return;
+
+				pReject(new Error('request timeout'));
+			};
+
 			let sent =
 			{
+				// Data received in partial responses.
+				parts: null,
+
+				partial: (data) =>
+				{
+					// Dumps sent in several loop iterations may take long.
+					clearTimeout(sent.timer);
+					sent.timer = setTimeout(onTimeout, REQUEST_TIMEOUT);
+
+					sent.parts = sent.parts || {};
+					mergePartialData(sent.parts, data);
+				},
+
 				resolve: (data) =>
 				{
 					if (!this._pendingSent.delete(id))
 						return;
 
 					clearTimeout(sent.timer);
+
+					if (sent.parts)
+					{
+						mergePartialData(sent.parts, data);
+						data = sent.parts;
+					}
+
 					pResolve(data);
 				},
 
@@ -232,13 +325,7 @@ class Channel extends EventEmitter
 					pReject(error);
 				},
 
-				timer: setTimeout(() =>
-				{
-					if (!this._pendingSent.delete(id))
-						return;
-
-					pReject(new Error('request timeout'));
-				}, REQUEST_TIMEOUT),
+				timer: setTimeout(onTimeout, REQUEST_TIMEOUT),
 
 				close: () =>
 				{
@@ -252,6 +339,74 @@ class Channel extends EventEmitter
 		});
 	}
 
+	_processFragment(nsPayload)
+	{
+		let fragment = nsPayload.slice(1);
+
+		this._fragmentsLength += fragment.length;
+
+		if (this._fragmentsLength > FRAGMENTED_MESSAGE_MAX_SIZE)
+		{
+			this._fragments = [];
+			this._fragmentsLength = 0;
+
+			if (this._lastBinaryResponse)
+				this._abortBinaryResponse('binary data too big');
+
+			throw new Error('fragmented message too big');
+		}
+
+		this._fragments.push(fragment);
+
+		if (nsPayload[0] !== LAST_FRAGMENT_MARKER)
+			return;
+
+		let payload = Buffer.concat(this._fragments, this._fragmentsLength);
+
+		this._fragments = [];
+		this._fragmentsLength = 0;
+
+		// Binary data of a previous binary response.
+		if (this._lastBinaryResponse)
+		{
+			let msg = this._lastBinaryResponse;
+
+			if (payload.length !== msg.binaryLen)
+			{
+				this._abortBinaryResponse('binary data of a wrong length');
+
+				return;
+			}
+
+			let sent = this._pendingSent.get(msg.id);
+
+			this._lastBinaryResponse = null;
+
+			if (sent)
+				sent.resolve(payload);
+
+			return;
+		}
+
+		if (binaryCodec.isBinary(payload))
+			this._processMessage(binaryCodec.decode(payload));
+		else
+			this._processMessage(JSON.parse(payload));
+	}
+
+	_abortBinaryResponse(reason)
+	{
+		let msg = this._lastBinaryResponse;
+		let sent = this._pendingSent.get(msg.id);
+
+		logger.error('binary response aborted: %s', reason);
+
+		this._lastBinaryResponse = null;
+
+		if (sent)
+			sent.reject(new Error(reason));
+	}
+
 	_processMessage(msg)
 	{
 		logger.debug('received message: %o', msg);
@@ -261,6 +416,32 @@ class Channel extends EventEmitter
 		{
 			let sent = this._pendingSent.get(msg.id);
 
+			// If a binary response, keep this message until the binary data
+			// arrives.
+			if (msg.accepted && msg.binary)
+			{
+				if (!Number.isInteger(msg.binaryLen) || msg.binaryLen < 0 ||
+					msg.binaryLen > FRAGMENTED_MESSAGE_MAX_SIZE)
+				{
+					logger.error('invalid binary response length: %s', msg.binaryLen);
+
+					if (sent)
+						sent.reject(new Error('invalid binary response length'));
+				}
+				// No fragments follow empty binary data.
+				else if (msg.binaryLen === 0)
+				{
+					if (sent)
+						sent.resolve(Buffer.alloc(0));
+				}
+				else
+				{
+					this._lastBinaryResponse = msg;
+				}
+
+				return;
+			}
+
 			if (!sent)
 			{
 				logger.error('received Response does not match any sent Request');
@@ -268,7 +449,9 @@ class Channel extends EventEmitter
 				return;
 			}
 
-			if (msg.accepted)
+			if (msg.partial)
+				sent.partial(msg.data);
+			else if (msg.accepted)
 				sent.resolve(msg.data);
 			else if (msg.rejected)
 				sent.reject(new Error(msg.reason));
@@ -295,4 +478,37 @@ class Channel extends EventEmitter
 	}
 }
 
+/**
+ * Merges the data of a partial response into the data received so far.
+ * Arrays are appended to the same member, an object given for an array is
+ * merged into its last item, and any other value is set.
+ */
+function mergePartialData(target, data)
+{
+	for (let key of Object.keys(data))
+	{
+		let value = data[key];
+		let current = target[key];
+
+		if (Array.isArray(value))
+		{
+			if (!Array.isArray(current))
+				current = target[key] = [];
+
+			for (let item of value)
+			{
+				current.push(item);
+			}
+		}
+		else if (Array.isArray(current) && current.length > 0 && value && typeof value === 'object')
+		{
+			mergePartialData(current[current.length - 1], value);
+		}
+		else
+		{
+			target[key] = value;
+		}
+	}
+}
+
 module.exports = Channel;
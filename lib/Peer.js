@@ -315,6 +315,63 @@ class Peer extends EventEmitter
 			});
 	}
 
+	/**
+	 * Create a Transport exchanging plain RTP and RTCP (no ICE, DTLS or SRTP)
+	 * over a single UDP socket.
+	 *
+	 * @param {[Object]} [options]
+	 * @param {[Boolean]} [options.preferIPv6=false] - Listen on IPv6.
+	 * @param {[String]} [options.remoteIP] - Remote IP.
+	 * @param {[Number]} [options.remotePort] - Remote port.
+	 * @param {[Boolean]} [options.comedia=false] - Take the remote address from
+	 *   the first received packet.
+	 *
+	 * @return {Promise} Resolves to the created Transport.
+	 */
+	createPlainRtpTransport(options)
+	{
+		logger.debug('createPlainRtpTransport() [options:%o]', options);
+
+		options = Object.assign({}, options, { plainRtp: true });
+
+		return this.createTransport(options);
+	}
+
+	/**
+	 * Create a video RtpSender that sends the video of the dominant speaker in
+	 * the Room with a single SSRC.
+	 *
+	 * @return {Promise} Resolves to the created RtpSender.
+	 */
+	createActiveSpeakerRtpSender()
+	{
+		logger.debug('createActiveSpeakerRtpSender()');
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('Peer closed'));
+
+		return this._channel.request('peer.createActiveSpeakerRtpSender', this._internal)
+			.then((data) =>
+			{
+				logger.debug('"peer.createActiveSpeakerRtpSender" request succeeded');
+
+				// The RtpSender has been already notified with "newrtpsender".
+				for (let rtpSender of this._rtpSenders)
+				{
+					if (rtpSender.id === data.rtpSenderId)
+						return rtpSender;
+				}
+
+				throw new Error('RtpSender not found');
+			})
+			.catch((error) =>
+			{
+				logger.error('"peer.createActiveSpeakerRtpSender" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
 	/**
 	 * Create a RtpReceiver instance.
 	 *
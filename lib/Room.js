@@ -235,6 +235,73 @@ class Room extends EventEmitter
 			});
 	}
 
+	/**
+	 * Get the stats of every RTP stream in the Room as a binary snapshot, cheap
+	 * enough to be polled frequently. Parse it with mediasoup.statsSnapshot.
+	 *
+	 * @return {Promise} Resolves to a Buffer.
+	 */
+	getStats()
+	{
+		logger.debug('getStats()');
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('Room closed'));
+
+		return this._channel.request('room.getStats', this._internal)
+			.catch((error) =>
+			{
+				logger.error('"room.getStats" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
+	/**
+	 * Forward just the audio and/or video of the N most recently active
+	 * speakers. Pinned video is always forwarded.
+	 *
+	 * @param {Object} options
+	 * @param {Number} [options.audio] - Number of forwarded audio streams, 0
+	 *   means all of them.
+	 * @param {Number} [options.video] - Number of Peers whose video is
+	 *   forwarded, 0 means all of them.
+	 *
+	 * @return {Promise} Resolves to this.
+	 */
+	setLastN(options)
+	{
+		logger.debug('setLastN() [options:%o]', options);
+
+		options = options || {};
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('Room closed'));
+
+		let data = {};
+
+		if (options.audio !== undefined)
+			data.audio = Number(options.audio) || 0;
+
+		if (options.video !== undefined)
+			data.video = Number(options.video) || 0;
+
+		// Send Channel request.
+		return this._channel.request('room.setLastN', this._internal, data)
+			.then(() =>
+			{
+				logger.debug('"room.setLastN" request succeeded');
+
+				return this;
+			})
+			.catch((error) =>
+			{
+				logger.error('"room.setLastN" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
 	/**
 	 * Get room's capabilities per kind.
 	 *
@@ -243,6 +243,65 @@ class RtpReceiver extends EventEmitter
 			});
 	}
 
+	/**
+	 * Copy every received RTP packet into a shared memory ring that an external
+	 * process can open at the resolved path and map.
+	 *
+	 * @param {Number} [size=4194304] - Ring data size in bytes.
+	 *
+	 * @return {Promise} Resolves to an Object with path and size.
+	 */
+	openRtpTap(size)
+	{
+		logger.debug('openRtpTap() [size:%s]', size);
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('RtpReceiver closed'));
+
+		if (size === undefined)
+			size = 4194304;
+
+		return this._channel.request(
+			'rtpReceiver.setRtpTap', this._internal, { enabled: true, size: size })
+			.then((data) =>
+			{
+				logger.debug('"rtpReceiver.setRtpTap" request succeeded');
+
+				return data;
+			})
+			.catch((error) =>
+			{
+				logger.error('"rtpReceiver.setRtpTap" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
+	/**
+	 * Stop copying RTP packets into the shared memory ring.
+	 *
+	 * @return {Promise}
+	 */
+	closeRtpTap()
+	{
+		logger.debug('closeRtpTap()');
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('RtpReceiver closed'));
+
+		return this._channel.request('rtpReceiver.setRtpTap', this._internal, { enabled: false })
+			.then(() =>
+			{
+				logger.debug('"rtpReceiver.setRtpTap" request succeeded');
+			})
+			.catch((error) =>
+			{
+				logger.error('"rtpReceiver.setRtpTap" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
 	/**
 	 * Start receiving media.
 	 *
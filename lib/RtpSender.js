@@ -273,6 +273,114 @@ class RtpSender extends EventEmitter
 				throw error;
 			});
 	}
+
+	/**
+	 * Set the preferred VP9 layers. Lower ones are sent if the bitrate allocated
+	 * to this RtpSender does not allow them.
+	 *
+	 * @param {Number} spatialLayer
+	 * @param {Number} temporalLayer
+	 *
+	 * @return {Promise} Resolves to this.
+	 */
+	setPreferredLayers(spatialLayer, temporalLayer)
+	{
+		logger.debug(
+			'setPreferredLayers() [spatialLayer:%s, temporalLayer:%s]',
+			spatialLayer, temporalLayer);
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('RtpSender closed'));
+
+		// Send Channel request.
+		return this._channel.request('rtpSender.setPreferredLayers', this._internal,
+			{
+				spatialLayer  : spatialLayer,
+				temporalLayer : temporalLayer
+			})
+			.then(() =>
+			{
+				logger.debug('"rtpSender.setPreferredLayers" request succeeded');
+
+				return this;
+			})
+			.catch((error) =>
+			{
+				logger.error('"rtpSender.setPreferredLayers" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
+	/**
+	 * Pin this RtpSender so its layers are preferred over the thumbnails (but
+	 * not over the active speaker) when sharing the available bitrate.
+	 *
+	 * @param {Boolean} pinned
+	 *
+	 * @return {Promise} Resolves to this.
+	 */
+	setPinned(pinned)
+	{
+		logger.debug('setPinned() [pinned:%s]', pinned);
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('RtpSender closed'));
+
+		// Send Channel request.
+		return this._channel.request('rtpSender.setPinned', this._internal,
+			{
+				pinned : Boolean(pinned)
+			})
+			.then(() =>
+			{
+				logger.debug('"rtpSender.setPinned" request succeeded');
+
+				return this;
+			})
+			.catch((error) =>
+			{
+				logger.error('"rtpSender.setPinned" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
+	/**
+	 * Set the size at which the remote Peer renders this video so VP9 spatial
+	 * layers with higher resolution are not sent. 0x0 means unknown.
+	 *
+	 * @param {Number} width
+	 * @param {Number} height
+	 *
+	 * @return {Promise} Resolves to this.
+	 */
+	setMaxResolution(width, height)
+	{
+		logger.debug('setMaxResolution() [width:%s, height:%s]', width, height);
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('RtpSender closed'));
+
+		// Send Channel request.
+		return this._channel.request('rtpSender.setMaxResolution', this._internal,
+			{
+				width  : width,
+				height : height
+			})
+			.then(() =>
+			{
+				logger.debug('"rtpSender.setMaxResolution" request succeeded');
+
+				return this;
+			})
+			.catch((error) =>
+			{
+				logger.error('"rtpSender.setMaxResolution" request failed: %s', error);
+
+				throw error;
+			});
+	}
 }
 
 module.exports = RtpSender;
@@ -23,8 +23,13 @@ const VALID_WORKER_PARAMETERS =
     'vp9MinSpartial',
     'vp9MinTemporial',
     'needToFilterAudioLevels',
+	'nackAggregationWindow',
+	'keyFrameRequestMinInterval',
+	'keyFrameCacheSize',
+	'retransmissionBudget',
 	'dtlsCertificateFile',
-	'dtlsPrivateKeyFile'
+	'dtlsPrivateKeyFile',
+	'channelFormat'
 ];
 
 class Server extends EventEmitter
@@ -89,6 +94,21 @@ class Server extends EventEmitter
         if (!check.greaterOrEqual(options.vp9MinTemporial, 0))
 			options.vp9MinTemporial = 0;
 
+		if (!check.greaterOrEqual(options.nackAggregationWindow, 0))
+			delete options.nackAggregationWindow;
+
+		if (!check.greaterOrEqual(options.keyFrameRequestMinInterval, 0))
+			delete options.keyFrameRequestMinInterval;
+
+		if (!check.greaterOrEqual(options.keyFrameCacheSize, 0))
+			delete options.keyFrameCacheSize;
+
+		if (!check.greaterOrEqual(options.retransmissionBudget, 0))
+			delete options.retransmissionBudget;
+
+		if (options.channelFormat !== 'binary')
+			options.channelFormat = 'json';
+
 		if (check.nonEmptyString(options.dtlsCertificateFile))
 			options.dtlsCertificateFile = path.resolve(options.dtlsCertificateFile);
 
@@ -216,6 +236,41 @@ class Server extends EventEmitter
 			});
 	}
 
+	/**
+	 * Get the event loop and packet path latency histograms of every worker
+	 * (values in nanoseconds).
+	 *
+	 * @param {Object} [options]
+	 * @param {Boolean} [options.reset] - Reset the histograms once read.
+	 *
+	 * @return {Promise}
+	 */
+	getLatency(options)
+	{
+		logger.debug('getLatency() [options:%o]', options);
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('Server closed'));
+
+		let promises = [];
+
+		for (let worker of this._workers)
+		{
+			promises.push(worker.getLatency(options));
+		}
+
+		return Promise.all(promises)
+			.then((datas) =>
+			{
+				let json =
+				{
+					workers : datas
+				};
+
+				return json;
+			});
+	}
+
 	/**
 	 * Update Server settings.
 	 *
@@ -87,6 +87,14 @@ class Transport extends EventEmitter
 					break;
 				}
 
+				case 'tuplechange':
+				{
+					this._data.tuple = data.tuple;
+					// Emit it to the app.
+					this.emit(event, data.tuple);
+					break;
+				}
+
 				case 'dtlsstatechange':
 				{
 					this._data.dtlsState = data.dtlsState;
@@ -153,6 +161,26 @@ class Transport extends EventEmitter
 		return this._data.dtlsRemoteCert;
 	}
 
+	get plainRtp()
+	{
+		return this._data.plainRtp;
+	}
+
+	get localIP()
+	{
+		return this._data.localIP;
+	}
+
+	get localPort()
+	{
+		return this._data.localPort;
+	}
+
+	get tuple()
+	{
+		return this._data.tuple;
+	}
+
 	/**
 	 * Close the Transport.
 	 */
@@ -221,6 +249,28 @@ class Transport extends EventEmitter
 			});
 	}
 
+	/**
+	 * Get the stats of every RTP stream in the Transport as a binary snapshot, cheap
+	 * enough to be polled frequently. Parse it with mediasoup.statsSnapshot.
+	 *
+	 * @return {Promise} Resolves to a Buffer.
+	 */
+	getStats()
+	{
+		logger.debug('getStats()');
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('Transport closed'));
+
+		return this._channel.request('transport.getStats', this._internal)
+			.catch((error) =>
+			{
+				logger.error('"transport.getStats" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
 	/**
 	 * Provide the remote DTLS parameters.
 	 *
@@ -318,6 +368,40 @@ class Transport extends EventEmitter
 				throw error;
 			});
 	}
+
+	/**
+	 * Set the remote address of a plain RTP transport.
+	 *
+	 * @param {Object} options
+	 * @param {String} options.ip - Remote IP.
+	 * @param {Number} options.port - Remote port.
+	 *
+	 * @return {Promise} Resolves to this.
+	 */
+	setRemoteParameters(options)
+	{
+		logger.debug('setRemoteParameters() [options:%o]', options);
+
+		if (this._closed)
+			return Promise.reject(new errors.InvalidStateError('Transport closed'));
+
+		// Send Channel request.
+		return this._channel.request('transport.setRemoteParameters', this._internal, options)
+			.then((data) =>
+			{
+				logger.debug('"transport.setRemoteParameters" request succeeded');
+
+				this._data.tuple = data;
+
+				return this;
+			})
+			.catch((error) =>
+			{
+				logger.error('"transport.setRemoteParameters" request failed: %s', error);
+
+				throw error;
+			});
+	}
 }
 
 module.exports = Transport;
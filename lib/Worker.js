@@ -58,8 +58,9 @@ class Worker extends EventEmitter
 		// Create the mediasoup-worker child process.
 		this._child = spawn(workerPath, spawnArgs, spawnOptions);
 
-		// Channel instance.
-		this._channel = new Channel(this._child.stdio[CHANNEL_FD]);
+		// Channel instance. Use the binary encoding if the worker is told so.
+		this._channel = new Channel(
+			this._child.stdio[CHANNEL_FD], parameters.indexOf('--channelFormat=binary') !== -1);
 
 		// Set of Room instances.
 		this._rooms = new Set();
@@ -172,6 +173,25 @@ class Worker extends EventEmitter
 			});
 	}
 
+	getLatency(options)
+	{
+		logger.debug('getLatency() [options:%o]', options);
+
+		return this._channel.request('worker.getLatency', null, options)
+			.then((data) =>
+			{
+				logger.debug('"worker.getLatency" request succeeded');
+
+				return data;
+			})
+			.catch((error) =>
+			{
+				logger.error('"worker.getLatency" request failed: %s', error);
+
+				throw error;
+			});
+	}
+
 	createRoom(options)
 	{
 		logger.debug('createRoom() [options:%o]', options);
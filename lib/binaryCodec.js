@@ -0,0 +1,325 @@
+'use strict';
+
+/**
+ * Compact binary encoding of the Channel messages. It must match the one in
+ * the worker (Channel::BinaryCodec).
+ *
+ * A message is the MARKER byte followed by a value. Every value is a tag byte
+ * followed by its payload. Lengths, counts and integers are LEB128 varints,
+ * doubles are little-endian IEEE 754.
+ */
+
+// JSON messages start with '{' and logs with a letter.
+const MARKER = 0x00;
+
+const TAG_NULL = 0;
+const TAG_FALSE = 1;
+const TAG_TRUE = 2;
+const TAG_UINT = 3;
+const TAG_NEGATIVE_INT = 4;
+const TAG_DOUBLE = 5;
+const TAG_STRING = 6;
+const TAG_ARRAY = 7;
+const TAG_OBJECT = 8;
+
+// Nesting of arrays and objects allowed when decoding.
+const MAX_DEPTH = 64;
+
+// Bytes of a 64 bits varint.
+const MAX_VARINT_LEN = 10;
+
+class Writer
+{
+	constructor()
+	{
+		this._buffer = Buffer.allocUnsafe(1024);
+		this._pos = 0;
+	}
+
+	get buffer()
+	{
+		return this._buffer.slice(0, this._pos);
+	}
+
+	reserve(len)
+	{
+		if (this._pos + len <= this._buffer.length)
+			return;
+
+		let buffer = Buffer.allocUnsafe(Math.max(this._buffer.length * 2, this._pos + len));
+
+		this._buffer.copy(buffer, 0, 0, this._pos);
+		this._buffer = buffer;
+	}
+
+	writeByte(byte)
+	{
+		this.reserve(1);
+		this._buffer[this._pos++] = byte;
+	}
+
+	writeVarint(value)
+	{
+		while (value >= 0x80)
+		{
+			this.writeByte((value % 0x80) | 0x80);
+			value = Math.floor(value / 0x80);
+		}
+
+		this.writeByte(value);
+	}
+
+	writeDouble(value)
+	{
+		this.reserve(8);
+		this._buffer.writeDoubleLE(value, this._pos);
+		this._pos += 8;
+	}
+
+	writeString(value)
+	{
+		let len = Buffer.byteLength(value);
+
+		this.writeVarint(len);
+		this.reserve(len);
+		this._buffer.write(value, this._pos, len, 'utf8');
+		this._pos += len;
+	}
+
+	// Same as JSON.stringify(): undefined and functions are skipped within
+	// objects and become null within arrays.
+	writeValue(value)
+	{
+		if (value && typeof value.toJSON === 'function')
+			value = value.toJSON();
+
+		switch (typeof value)
+		{
+			case 'boolean':
+				this.writeByte(value ? TAG_TRUE : TAG_FALSE);
+				break;
+
+			case 'number':
+				if (Number.isSafeInteger(value) && value >= 0)
+				{
+					this.writeByte(TAG_UINT);
+					this.writeVarint(value);
+				}
+				else if (Number.isSafeInteger(value))
+				{
+					this.writeByte(TAG_NEGATIVE_INT);
+					this.writeVarint(-(value + 1));
+				}
+				else if (Number.isFinite(value))
+				{
+					this.writeByte(TAG_DOUBLE);
+					this.writeDouble(value);
+				}
+				else
+				{
+					this.writeByte(TAG_NULL);
+				}
+				break;
+
+			case 'string':
+				this.writeByte(TAG_STRING);
+				this.writeString(value);
+				break;
+
+			case 'object':
+				if (value === null)
+				{
+					this.writeByte(TAG_NULL);
+				}
+				else if (Array.isArray(value))
+				{
+					this.writeByte(TAG_ARRAY);
+					this.writeVarint(value.length);
+
+					for (let item of value)
+					{
+						this.writeValue(item);
+					}
+				}
+				else
+				{
+					let keys = Object.keys(value)
+						.filter((key) => value[key] !== undefined && typeof value[key] !== 'function');
+
+					this.writeByte(TAG_OBJECT);
+					this.writeVarint(keys.length);
+
+					for (let key of keys)
+					{
+						this.writeString(key);
+						this.writeValue(value[key]);
+					}
+				}
+				break;
+
+			default:
+				this.writeByte(TAG_NULL);
+		}
+	}
+}
+
+class Reader
+{
+	constructor(buffer)
+	{
+		this._buffer = buffer;
+		this._pos = 0;
+	}
+
+	get done()
+	{
+		return this._pos === this._buffer.length;
+	}
+
+	readByte()
+	{
+		if (this._pos >= this._buffer.length)
+			throw new Error('truncated binary message');
+
+		return this._buffer[this._pos++];
+	}
+
+	// As with JSON.parse(), integers above Number.MAX_SAFE_INTEGER (such as
+	// big uint64_t values of the worker) lose precision instead of failing.
+	readVarint()
+	{
+		let value = 0;
+
+		for (let i = 0, factor = 1; i < MAX_VARINT_LEN; i++, factor *= 0x80)
+		{
+			let byte = this.readByte();
+
+			value += (byte & 0x7F) * factor;
+
+			if ((byte & 0x80) === 0)
+				return value;
+		}
+
+		throw new Error('varint too long');
+	}
+
+	readSlice(len)
+	{
+		if (this._buffer.length - this._pos < len)
+			throw new Error('truncated binary message');
+
+		let start = this._pos;
+
+		this._pos += len;
+
+		return start;
+	}
+
+	readString()
+	{
+		let len = this.readVarint();
+		let start = this.readSlice(len);
+
+		return this._buffer.toString('utf8', start, start + len);
+	}
+
+	readValue(depth)
+	{
+		if (depth > MAX_DEPTH)
+			throw new Error('binary message too deep');
+
+		let tag = this.readByte();
+
+		switch (tag)
+		{
+			case TAG_NULL:
+				return null;
+
+			case TAG_FALSE:
+				return false;
+
+			case TAG_TRUE:
+				return true;
+
+			case TAG_UINT:
+				return this.readVarint();
+
+			case TAG_NEGATIVE_INT:
+				return -this.readVarint() - 1;
+
+			case TAG_DOUBLE:
+				return this._buffer.readDoubleLE(this.readSlice(8));
+
+			case TAG_STRING:
+				return this.readString();
+
+			case TAG_ARRAY:
+			{
+				let count = this.readVarint();
+				let array = [];
+
+				for (let i = 0; i < count; i++)
+				{
+					array.push(this.readValue(depth + 1));
+				}
+
+				return array;
+			}
+
+			case TAG_OBJECT:
+			{
+				let count = this.readVarint();
+				let object = {};
+
+				for (let i = 0; i < count; i++)
+				{
+					let key = this.readString();
+
+					object[key] = this.readValue(depth + 1);
+				}
+
+				return object;
+			}
+
+			default:
+				throw new Error(`unknown binary tag ${tag}`);
+		}
+	}
+}
+
+module.exports =
+{
+	MARKER,
+
+	isBinary(buffer)
+	{
+		return buffer.length > 1 && buffer[0] === MARKER;
+	},
+
+	encode(value)
+	{
+		let writer = new Writer();
+
+		writer.writeByte(MARKER);
+		writer.writeValue(value);
+
+		return writer.buffer;
+	},
+
+	decode(buffer)
+	{
+		if (!module.exports.isBinary(buffer))
+			throw new Error('not a binary message');
+
+		let reader = new Reader(buffer);
+
+		reader.readByte();
+
+		let value = reader.readValue(0);
+
+		if (!reader.done)
+			throw new Error('trailing data in binary message');
+
+		return value;
+	}
+};
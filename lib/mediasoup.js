@@ -5,6 +5,7 @@ const Server = require('./Server');
 const errors = require('./errors');
 const extra = require('./extra');
 const webrtc = require('./webrtc');
+const statsSnapshot = require('./statsSnapshot');
 const PKG = require('../package.json');
 
 logger.debug('%s version %s', PKG.name, PKG.version);
@@ -34,7 +35,7 @@ module.exports =
 	 * @param {number} [options.rtcMaxPort=59999] - Maximum RTC port.
      * @param {number} [options.vp9MinSpartial=0] - Minimun spartial value.
 	 * @param {number} [options.vp9MinTemporial=0] - Minimum temporal value.
-     * @param {boolean} [options.needToFilterAudioLevels=false] - True if will send packets from active speaker only.
+     * @param {boolean} [options.needToFilterAudioLevels=false] - True to forward just the video of the most recently active speaker (see Room.setLastN()).
 	 * @param {string} [options.dtlsCertificateFile] - Path to DTLS certificate.
 	 * @param {string} [options.dtlsPrivateKeyFile] - Path to DTLS private key.
 	 *
@@ -66,7 +67,12 @@ module.exports =
 	/**
 	 * Export the webrtc module.
 	 */
-	webrtc: webrtc
+	webrtc: webrtc,
+
+	/**
+	 * Export the stats snapshot parser.
+	 */
+	statsSnapshot: statsSnapshot
 };
 
 // On process exit close all the Servers.
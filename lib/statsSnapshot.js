@@ -0,0 +1,72 @@
+'use strict';
+
+/**
+ * Parser of the binary stats snapshots returned by Room.getStats() and
+ * Transport.getStats(). It must match the layout in the worker
+ * (RTC::StatsSnapshot). Every field is big-endian.
+ */
+
+const VERSION = 1;
+const HEADER_SIZE = 16;
+
+const DIRECTIONS = [ 'receive', 'send' ];
+const KINDS = [ 'all', 'audio', 'video', 'depth' ];
+
+// Target layer of streams with no layers.
+const NO_LAYER = 0xFF;
+
+module.exports =
+{
+	/**
+	 * Parse a stats snapshot.
+	 *
+	 * @param {Buffer} buffer
+	 *
+	 * @return {Object} - Snapshot time (ms, worker clock) and the stats of
+	 * every stream.
+	 */
+	parse(buffer)
+	{
+		if (buffer.length < HEADER_SIZE || buffer[0] !== VERSION)
+			throw new Error('invalid stats snapshot');
+
+		let recordSize = buffer[1];
+		let count = buffer.readUInt32BE(4);
+		let time = (buffer.readUInt32BE(8) * 0x100000000) + buffer.readUInt32BE(12);
+		let streams = [];
+
+		if (buffer.length < HEADER_SIZE + (count * recordSize))
+			throw new Error('truncated stats snapshot');
+
+		for (let i = 0; i < count; i++)
+		{
+			let pos = HEADER_SIZE + (i * recordSize);
+			let spatialLayer = buffer[pos + 10];
+			let temporalLayer = buffer[pos + 11];
+			let bytes =
+				(buffer.readUInt32BE(pos + 16) * 0x100000000) + buffer.readUInt32BE(pos + 20);
+
+			streams.push(
+				{
+					id               : buffer.readUInt32BE(pos),
+					ssrc             : buffer.readUInt32BE(pos + 4),
+					direction        : DIRECTIONS[buffer[pos + 8]],
+					kind             : KINDS[buffer[pos + 9]],
+					spatialLayer     : spatialLayer !== NO_LAYER ? spatialLayer : undefined,
+					temporalLayer    : temporalLayer !== NO_LAYER ? temporalLayer : undefined,
+					packets          : buffer.readUInt32BE(pos + 12),
+					bytes            : bytes,
+					packetsLost      : buffer.readUInt32BE(pos + 24),
+					fractionLost     : buffer[pos + 28] / 256,
+					jitter           : buffer.readUInt32BE(pos + 32),
+					rtt              : buffer.readUInt32BE(pos + 36),
+					nackPackets      : buffer.readUInt32BE(pos + 40),
+					keyFrameRequests : buffer.readUInt32BE(pos + 44),
+					retransmitted    : buffer.readUInt32BE(pos + 48),
+					bitrate          : buffer.readUInt32BE(pos + 52)
+				});
+		}
+
+		return { time, streams };
+	}
+};
@@ -134,7 +134,8 @@ let supportedRtpCapabilities =
 				{ type: 'ccm',  parameter: 'fir'  }, // Bypassed.
 				{ type: 'ack',  parameter: 'rpsi' }, // Bypassed.
 				{ type: 'ack',  parameter: 'app'  }, // Bypassed.
-				{ type: 'goog-remb'               }  // Locally generated.
+				{ type: 'goog-remb'               }, // Locally generated.
+				{ type: 'transport-cc'            }  // Locally generated.
 			]
 		},
 		{
@@ -151,7 +152,8 @@ let supportedRtpCapabilities =
 				{ type: 'ccm',  parameter: 'fir'  },
 				{ type: 'ack',  parameter: 'rpsi' },
 				{ type: 'ack',  parameter: 'app'  },
-				{ type: 'goog-remb'               }
+				{ type: 'goog-remb'               },
+				{ type: 'transport-cc'            }
 			]
 		},
 		{
@@ -172,7 +174,8 @@ let supportedRtpCapabilities =
 				{ type: 'ccm',  parameter: 'fir'  },
 				{ type: 'ack',  parameter: 'rpsi' },
 				{ type: 'ack',  parameter: 'app'  },
-				{ type: 'goog-remb'               }
+				{ type: 'goog-remb'               },
+				{ type: 'transport-cc'            }
 			]
 		},
 		{
@@ -193,7 +196,8 @@ let supportedRtpCapabilities =
 				{ type: 'ccm',  parameter: 'fir'  },
 				{ type: 'ack',  parameter: 'rpsi' },
 				{ type: 'ack',  parameter: 'app'  },
-				{ type: 'goog-remb'               }
+				{ type: 'goog-remb'               },
+				{ type: 'transport-cc'            }
 			]
 		},
 		{
@@ -210,7 +214,8 @@ let supportedRtpCapabilities =
 				{ type: 'ccm',  parameter: 'fir'  },
 				{ type: 'ack',  parameter: 'rpsi' },
 				{ type: 'ack',  parameter: 'app'  },
-				{ type: 'goog-remb'               }
+				{ type: 'goog-remb'               },
+				{ type: 'transport-cc'            }
 			]
 		}
 	],
@@ -245,15 +250,15 @@ let supportedRtpCapabilities =
 			uri              : 'urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id',
 			preferredId      : 5,
 			preferredEncrypt : false
+		},
+		{
+			kind             : '',
+			uri              : 'http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01',
+			preferredId      : 6,
+			preferredEncrypt : false
 		}
 		// {
 		// 	kind             : 'video',
-		// 	uri              : 'http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01',
-		// 	preferredId      : 6,
-		// 	preferredEncrypt : false
-		// },
-		// {
-		// 	kind             : 'video',
 		// 	uri              : 'http://www.webrtc.org/experiments/rtp-hdrext/playout-delay',
 		// 	preferredId      : 7,
 		// 	preferredEncrypt : false
@@ -0,0 +1,119 @@
+'use strict';
+
+const EventEmitter = require('events').EventEmitter;
+const netstring = require('netstring');
+const tap = require('tap');
+const Channel = require('../lib/Channel');
+
+const FRAGMENT_MARKER = 0x01;
+const LAST_FRAGMENT_MARKER = 0x02;
+
+/**
+ * Socket standing for the worker, which keeps the ids of the requests
+ * written into it.
+ */
+function createSocket()
+{
+	let socket = new EventEmitter();
+
+	socket.ids = [];
+	// Requests are written right away.
+	socket.cork = () => null;
+	socket.uncork = () => null;
+	socket.write = (ns) =>
+	{
+		socket.ids.push(JSON.parse(netstring.nsPayload(Buffer.from(ns))).id);
+	};
+
+	socket.receive = (payload) =>
+	{
+		socket.emit('data', netstring.nsWrite(payload));
+	};
+
+	return socket;
+}
+
+function fragment(marker, data)
+{
+	return Buffer.concat([ Buffer.from([ marker ]), data ]);
+}
+
+tap.test('binary response with empty binary data must resolve', { timeout: 2000 }, (t) =>
+{
+	let socket = createSocket();
+	let channel = new Channel(socket);
+	let first = channel.request('room.getStatsSnapshot', {});
+	let second = channel.request('room.dump', {});
+
+	socket.receive(
+		JSON.stringify({ id: socket.ids[0], accepted: true, binary: true, binaryLen: 0 }));
+	socket.receive(JSON.stringify({ id: socket.ids[1], accepted: true, data: { foo: 1 } }));
+
+	return Promise.all([ first, second ])
+		.then((data) =>
+		{
+			t.equal(data[0].length, 0, 'binary data must be empty');
+			t.same(data[1], { foo: 1 }, 'next response must be received');
+		});
+});
+
+tap.test('binary response with binary data must resolve', { timeout: 2000 }, (t) =>
+{
+	let socket = createSocket();
+	let channel = new Channel(socket);
+	let request = channel.request('room.getStatsSnapshot', {});
+
+	socket.receive(
+		JSON.stringify({ id: socket.ids[0], accepted: true, binary: true, binaryLen: 4 }));
+	socket.receive(fragment(FRAGMENT_MARKER, Buffer.from([ 1, 2 ])));
+	socket.receive(fragment(LAST_FRAGMENT_MARKER, Buffer.from([ 3, 4 ])));
+
+	return request
+		.then((data) =>
+		{
+			t.same([ ...data ], [ 1, 2, 3, 4 ], 'binary data must be joined');
+		});
+});
+
+tap.test('binary response with an invalid length must fail', { timeout: 2000 }, (t) =>
+{
+	let socket = createSocket();
+	let channel = new Channel(socket);
+	let first = channel.request('room.getStatsSnapshot', {});
+	let second = channel.request('room.dump', {});
+
+	socket.receive(
+		JSON.stringify({ id: socket.ids[0], accepted: true, binary: true, binaryLen: 16777217 }));
+	socket.receive(JSON.stringify({ id: socket.ids[1], accepted: true, data: { foo: 1 } }));
+
+	return first
+		.then(() => t.fail('request succeeded'))
+		.catch((error) => t.pass(`request failed: ${error}`))
+		.then(() => second)
+		.then((data) => t.same(data, { foo: 1 }, 'next response must be received'));
+});
+
+tap.test('binary response not followed by its binary data must fail', { timeout: 2000 }, (t) =>
+{
+	let socket = createSocket();
+	let channel = new Channel(socket);
+	let first = channel.request('room.getStatsSnapshot', {});
+	let second = channel.request('room.getStatsSnapshot', {});
+	let third = channel.request('room.dump', {});
+
+	socket.receive(
+		JSON.stringify({ id: socket.ids[0], accepted: true, binary: true, binaryLen: 4 }));
+	socket.receive(fragment(LAST_FRAGMENT_MARKER, Buffer.from([ 1, 2, 3 ])));
+	socket.receive(
+		JSON.stringify({ id: socket.ids[1], accepted: true, binary: true, binaryLen: 4 }));
+	socket.receive(JSON.stringify({ id: socket.ids[2], accepted: true, data: { foo: 1 } }));
+
+	return first
+		.then(() => t.fail('request with binary data of a wrong length succeeded'))
+		.catch((error) => t.pass(`request with binary data of a wrong length failed: ${error}`))
+		.then(() => second)
+		.then(() => t.fail('request without binary data succeeded'))
+		.catch((error) => t.pass(`request without binary data failed: ${error}`))
+		.then(() => third)
+		.then((data) => t.same(data, { foo: 1 }, 'next response must be received'));
+});
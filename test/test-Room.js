@@ -1,9 +1,389 @@
 'use strict';
 
+const dgram = require('dgram');
 const tap = require('tap');
 const mediasoup = require('../');
 const roomOptions = require('./data/options').roomOptions;
 const peerOptions = require('./data/options').peerOptions;
+const peerCapabilities = require('./data/options').peerCapabilities;
+
+// Audio levels (-dBov) of speech and silence.
+const SPEECH = 20;
+const SILENCE = 90;
+// Audio packets are sent every 20 ms.
+const FRAME_INTERVAL = 20;
+// Id of the transport-wide sequence number header extension given by the Room.
+const TRANSPORT_WIDE_CC_ID = 6;
+
+/**
+ * Peer capabilities with transport-cc feedback for VP8.
+ */
+function getTransportCcCapabilities()
+{
+	let capabilities = JSON.parse(JSON.stringify(peerCapabilities));
+	let vp8 = capabilities.codecs.find((codec) => codec.name === 'video/VP8');
+
+	vp8.rtcpFeedback.push({ type: 'transport-cc' });
+	capabilities.headerExtensions.push(
+		{
+			kind             : '',
+			uri              : 'http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01',
+			preferredId      : TRANSPORT_WIDE_CC_ID,
+			preferredEncrypt : false
+		});
+
+	return capabilities;
+}
+
+/**
+ * Create a Peer with a plain RTP transport connected to a local UDP socket.
+ * RtpSenders are attached to the transport and the RTP packets they send
+ * are stored by SSRC, as are the ranges of the transport feedback received.
+ */
+function createEndpoint(t, room, peerName, capabilities = peerCapabilities)
+{
+	let peer = room.Peer(peerName);
+	let socket = dgram.createSocket('udp4');
+	let endpoint =
+	{
+		peer,
+		socket,
+		transport          : null,
+		received           : new Map(),
+		transportFeedbacks : []
+	};
+
+	t.tearDown(() => socket.close());
+
+	socket.on('message', (packet) =>
+	{
+		let payloadType = packet[1] & 0x7F;
+
+		// RTCP, just key frame requests and transport feedback matter.
+		if (payloadType >= 72 && payloadType <= 79)
+		{
+			if (endpoint.video && hasKeyFrameRequest(packet))
+			{
+				endpoint.video.keyFrameRequests++;
+				endpoint.video.keyFrameRequested = true;
+			}
+
+			endpoint.transportFeedbacks.push(...getTransportFeedbacks(packet));
+
+			return;
+		}
+
+		let ssrc = packet.readUInt32BE(8);
+
+		if (!endpoint.received.has(ssrc))
+			endpoint.received.set(ssrc, []);
+
+		endpoint.received.get(ssrc).push(packet);
+	});
+
+	peer.on('newrtpsender', (rtpSender) =>
+	{
+		if (endpoint.transport)
+			rtpSender.setTransport(endpoint.transport);
+	});
+
+	return new Promise((resolve) => socket.bind(0, '127.0.0.1', resolve))
+		.then(() => peer.setCapabilities(capabilities))
+		.then(() =>
+		{
+			return peer.createPlainRtpTransport(
+				{
+					remoteIP   : '127.0.0.1',
+					remotePort : socket.address().port
+				});
+		})
+		.then((transport) =>
+		{
+			endpoint.transport = transport;
+
+			return Promise.all(peer.rtpSenders.map((rtpSender) => rtpSender.setTransport(transport)));
+		})
+		.then(() => endpoint);
+}
+
+/**
+ * Make the endpoint send audio with the given SSRC and audio levels.
+ */
+function publish(endpoint, ssrc)
+{
+	let rtpReceiver = endpoint.peer.RtpReceiver('audio', endpoint.transport);
+
+	endpoint.audio = { ssrc, seq: 0, level: SILENCE };
+
+	return rtpReceiver.receive(
+		{
+			codecs :
+			[
+				{
+					name        : 'audio/opus',
+					payloadType : 100,
+					clockRate   : 48000,
+					numChannels : 2
+				}
+			],
+			encodings        : [ { ssrc } ],
+			headerExtensions :
+			[
+				{
+					uri : 'urn:ietf:params:rtp-hdrext:ssrc-audio-level',
+					id  : 1
+				}
+			],
+			rtcp : { cname: endpoint.peer.name }
+		})
+		.then(() => endpoint);
+}
+
+/**
+ * Make the endpoint send VP8 video with the given SSRC. It sends a key frame
+ * first and whenever requested. If firstWideSeq is given the packets also
+ * carry transport-wide sequence numbers, starting with it, and transport-cc
+ * feedback is requested.
+ */
+function publishVideo(endpoint, ssrc, firstWideSeq)
+{
+	let rtpReceiver = endpoint.peer.RtpReceiver('video', endpoint.transport);
+	let rtcpFeedback =
+	[
+		{ type: 'nack' },
+		{ type: 'nack', parameter: 'pli' },
+		{ type: 'ccm', parameter: 'fir' }
+	];
+	let headerExtensions = [];
+
+	endpoint.video =
+	{
+		ssrc,
+		seq               : 0,
+		timestamp         : 0,
+		wideSeq           : firstWideSeq,
+		keyFrameRequested : true,
+		keyFrameRequests  : 0
+	};
+
+	if (firstWideSeq !== undefined)
+	{
+		rtcpFeedback.push({ type: 'transport-cc' });
+		headerExtensions.push(
+			{
+				uri : 'http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01',
+				id  : TRANSPORT_WIDE_CC_ID
+			});
+	}
+
+	return rtpReceiver.receive(
+		{
+			codecs :
+			[
+				{
+					name        : 'video/VP8',
+					payloadType : 110,
+					clockRate   : 90000,
+					rtcpFeedback
+				}
+			],
+			encodings : [ { ssrc } ],
+			headerExtensions,
+			rtcp      : { cname: endpoint.peer.name }
+		})
+		.then(() => endpoint);
+}
+
+/**
+ * Whether the RTCP compound packet has a PLI or a FIR.
+ */
+function hasKeyFrameRequest(packet)
+{
+	let offset = 0;
+
+	while (offset + 4 <= packet.length)
+	{
+		let format = packet[offset] & 0x1F;
+		let packetType = packet[offset + 1];
+
+		// 206 = PSFB, with format 1 (PLI) or 4 (FIR).
+		if (packetType === 206 && (format === 1 || format === 4))
+			return true;
+
+		offset += (packet.readUInt16BE(offset + 2) + 1) * 4;
+	}
+
+	return false;
+}
+
+/**
+ * Ranges of transport-wide sequence numbers ({ baseSeq, count }) reported by
+ * the transport feedback messages in the RTCP compound packet.
+ */
+function getTransportFeedbacks(packet)
+{
+	let feedbacks = [];
+	let offset = 0;
+
+	while (offset + 4 <= packet.length)
+	{
+		let format = packet[offset] & 0x1F;
+		let packetType = packet[offset + 1];
+
+		// 205 = RTPFB, with format 15 (transport-cc).
+		if (packetType === 205 && format === 15 && offset + 16 <= packet.length)
+		{
+			feedbacks.push(
+				{
+					baseSeq : packet.readUInt16BE(offset + 12),
+					count   : packet.readUInt16BE(offset + 14)
+				});
+		}
+
+		offset += (packet.readUInt16BE(offset + 2) + 1) * 4;
+	}
+
+	return feedbacks;
+}
+
+/**
+ * Send a RTP packet to the transport of the endpoint.
+ */
+function send(endpoint, packet)
+{
+	endpoint.socket.send(packet, 0, packet.length, endpoint.transport.localPort, '127.0.0.1');
+}
+
+/**
+ * Send the next audio packet of the endpoint, with its audio level in a
+ * one-byte header extension.
+ */
+function sendAudio(endpoint)
+{
+	let audio = endpoint.audio;
+	let packet = Buffer.alloc(12 + 8 + 40);
+
+	audio.seq++;
+
+	packet[0] = 0x90; // Version 2 with header extension.
+	packet[1] = 100;
+	packet.writeUInt16BE(audio.seq, 2);
+	packet.writeUInt32BE(audio.seq * 960, 4);
+	packet.writeUInt32BE(audio.ssrc, 8);
+	packet.writeUInt16BE(0xBEDE, 12);
+	packet.writeUInt16BE(1, 14);
+	packet[16] = 0x10; // Id 1 with one byte.
+	packet[17] = audio.level;
+
+	send(endpoint, packet);
+}
+
+/**
+ * Send the next video frame of the endpoint in two packets, with their
+ * transport-wide sequence numbers in a one-byte header extension if any.
+ */
+function sendVideo(endpoint)
+{
+	let video = endpoint.video;
+	let keyFrame = video.keyFrameRequested;
+	let transportCc = video.wideSeq !== undefined;
+	let payloadOffset = transportCc ? 12 + 8 : 12;
+
+	video.keyFrameRequested = false;
+	video.timestamp += 1800;
+
+	for (let i = 0; i < 2; i++)
+	{
+		let packet = Buffer.alloc(payloadOffset + 2 + 100);
+
+		video.seq++;
+
+		packet[0] = transportCc ? 0x90 : 0x80;
+		packet[1] = 110 | (i === 1 ? 0x80 : 0); // Marker bit in the last packet.
+		packet.writeUInt16BE(video.seq, 2);
+		packet.writeUInt32BE(video.timestamp, 4);
+		packet.writeUInt32BE(video.ssrc, 8);
+
+		if (transportCc)
+		{
+			packet.writeUInt16BE(0xBEDE, 12);
+			packet.writeUInt16BE(1, 14);
+			packet[16] = (TRANSPORT_WIDE_CC_ID << 4) | 0x01; // Two bytes.
+			packet.writeUInt16BE(video.wideSeq, 17);
+
+			video.wideSeq = (video.wideSeq + 1) & 0xFFFF;
+		}
+
+		// VP8 payload descriptor, with the start of the first partition in the
+		// first packet, followed by the VP8 payload header (inverse key frame
+		// flag).
+		packet[payloadOffset] = i === 0 ? 0x10 : 0x00;
+		packet[payloadOffset + 1] = keyFrame ? 0x00 : 0x01;
+		// The original SSRC, to know the source of forwarded packets.
+		packet.writeUInt32BE(video.ssrc, payloadOffset + 2);
+
+		send(endpoint, packet);
+	}
+}
+
+/**
+ * Whether the forwarded VP8 packet starts a key frame.
+ */
+function isKeyFrame(packet)
+{
+	return (packet[12] & 0x10) !== 0 && (packet[13] & 0x01) === 0;
+}
+
+/**
+ * Send audio (and video if any) from all the publishers every 20 ms for the
+ * given time.
+ */
+function talk(publishers, duration)
+{
+	return new Promise((resolve) =>
+	{
+		let elapsed = 0;
+		let interval = setInterval(() =>
+		{
+			for (let publisher of publishers)
+			{
+				sendAudio(publisher);
+
+				if (publisher.video)
+					sendVideo(publisher);
+			}
+
+			elapsed += FRAME_INTERVAL;
+
+			if (elapsed < duration)
+				return;
+
+			clearInterval(interval);
+
+			// Let the last packets arrive.
+			setTimeout(resolve, 100);
+		}, FRAME_INTERVAL);
+	});
+}
+
+/**
+ * Original SSRC of the last video packet with the given SSRC received by the
+ * endpoint.
+ */
+function lastSource(endpoint, ssrc)
+{
+	let packets = endpoint.received.get(ssrc) || [];
+
+	return packets.length > 0 ? packets[packets.length - 1].readUInt32BE(14) : undefined;
+}
+
+/**
+ * Number of RTP packets with the given SSRC received by the endpoint.
+ */
+function countReceived(endpoint, ssrc)
+{
+	return endpoint.received.has(ssrc) ? endpoint.received.get(ssrc).length : 0;
+}
 
 tap.test('room.Peer() with peerName must succeed', { timeout: 2000 }, (t) =>
 {
@@ -169,3 +549,358 @@ tap.test('room.dump() must succeed', { timeout: 2000 }, (t) =>
 		})
 		.catch((error) => t.fail(`server.createRoom() failed: ${error}`));
 });
+
+tap.test('room.dump() must retrieve every peer with its own entities', { timeout: 2000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+	let peers;
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			return Promise.all(
+				[
+					createEndpoint(t, room, 'alice').then((endpoint) => publish(endpoint, 1111)),
+					createEndpoint(t, room, 'bob').then((endpoint) => publish(endpoint, 2222)),
+					createEndpoint(t, room, 'carol')
+				])
+				.then((endpoints) =>
+				{
+					peers = endpoints.map((endpoint) => endpoint.peer);
+
+					return room.dump();
+				});
+		})
+		.then((data) =>
+		{
+			let ids = (items, key) => items.map((item) => item[key]).sort();
+
+			t.equal(data.peers.length, 3, 'room.dump() must retrieve three peers');
+
+			for (let peer of peers)
+			{
+				let peerData = data.peers.find((item) => item.peerName === peer.name);
+
+				t.ok(peerData, `room.dump() must retrieve "${peer.name}"`);
+				t.same(
+					ids(peerData.transports, 'transportId'), ids(peer.transports, 'id'),
+					`"${peer.name}" must have its own transports`);
+				t.same(
+					ids(peerData.rtpReceivers, 'rtpReceiverId'), ids(peer.rtpReceivers, 'id'),
+					`"${peer.name}" must have its own rtpReceivers`);
+				t.same(
+					ids(peerData.rtpSenders, 'rtpSenderId'), ids(peer.rtpSenders, 'id'),
+					`"${peer.name}" must have its own rtpSenders`);
+			}
+
+			// Each peer but carol sends audio to the other two.
+			t.equal(peers[2].rtpSenders.length, 2, '"carol" must have two rtpSenders');
+
+			return Promise.all([ peers[0].dump(), peers[0].transports[0].dump() ]);
+		})
+		.then((data) =>
+		{
+			let peerData = data[0];
+			let transportData = data[1];
+
+			t.equal(peerData.peerName, 'alice', 'peer.dump() must retrieve "alice"');
+			t.equal(peerData.transports.length, 1, 'peer.dump() must retrieve one transport');
+			t.equal(peerData.rtpReceivers.length, 1, 'peer.dump() must retrieve one rtpReceiver');
+			t.equal(peerData.rtpSenders.length, 1, 'peer.dump() must retrieve one rtpSender');
+			t.equal(transportData.plainRtp, true, 'transport.dump() must retrieve the transport');
+			t.same(
+				Object.keys(transportData.rtpListener.ssrcTable), [ '1111' ],
+				'transport.dump() must retrieve the rtpListener');
+		});
+});
+
+tap.test('room.close() during room.dump() must reject it', { timeout: 2000 }, (t) =>
+{
+	let server = mediasoup.Server();
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			room.Peer('alice', peerOptions);
+			room.Peer('bob', peerOptions);
+
+			let dump = room.dump();
+
+			// Before the first step of the dump runs.
+			room.close();
+
+			return dump
+				.then(() => t.fail('room.dump() succeeded'))
+				.catch((error) => t.pass(`room.dump() failed: ${error}`));
+		});
+});
+
+tap.test('transport feedback must report the transport-wide sequence numbers sent by the publisher', { timeout: 10000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+	let firstWideSeq = 40000;
+	let alice;
+	let bob;
+	let carol;
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			return createEndpoint(t, room, 'alice', getTransportCcCapabilities())
+				.then((endpoint) => publish(endpoint, 1111))
+				.then((endpoint) => publishVideo(endpoint, 1112, firstWideSeq))
+				.then((endpoint) => (alice = endpoint))
+				.then(() => createEndpoint(t, room, 'bob'))
+				.then((endpoint) => (bob = endpoint))
+				.then(() => createEndpoint(t, room, 'carol'));
+		})
+		.then((endpoint) =>
+		{
+			carol = endpoint;
+
+			return talk([ alice ], 1000);
+		})
+		.then(() =>
+		{
+			let numSent = alice.video.seq;
+			let reported = new Set();
+			let unexpected = [];
+
+			t.ok(countReceived(bob, 1112) > 0, 'the video must be forwarded to the first subscriber');
+			t.ok(countReceived(carol, 1112) > 0, 'the video must be forwarded to the second subscriber');
+			t.ok(alice.transportFeedbacks.length > 0, 'the publisher must receive transport feedback');
+
+			for (let feedback of alice.transportFeedbacks)
+			{
+				for (let i = 0; i < feedback.count; i++)
+				{
+					let wideSeq = (feedback.baseSeq + i) & 0xFFFF;
+
+					if (wideSeq < firstWideSeq || wideSeq >= firstWideSeq + numSent)
+						unexpected.push(wideSeq);
+					else
+						reported.add(wideSeq);
+				}
+			}
+
+			t.same(unexpected, [], 'the feedback must not report other sequence numbers');
+			t.equal(reported.size, numSent, 'the feedback must report every sent packet');
+		});
+});
+
+tap.test('room.setLastN() must forward just the audio of the last N speakers', { timeout: 10000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+	let alice;
+	let bob;
+	let carol;
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			return room.setLastN({ audio: 1 })
+				.then(() => createEndpoint(t, room, 'alice'))
+				.then((endpoint) => publish(endpoint, 1111))
+				.then((endpoint) => (alice = endpoint))
+				.then(() => createEndpoint(t, room, 'bob'))
+				.then((endpoint) => publish(endpoint, 2222))
+				.then((endpoint) => (bob = endpoint))
+				.then(() => createEndpoint(t, room, 'carol'));
+		})
+		.then((endpoint) =>
+		{
+			carol = endpoint;
+
+			// Let the noise floor of both be known.
+			return talk([ alice, bob ], 500);
+		})
+		.then(() =>
+		{
+			alice.audio.level = SPEECH;
+
+			return talk([ alice, bob ], 2000);
+		})
+
+		.then(() =>
+		{
+			t.ok(countReceived(carol, 1111) >= 90, 'the audio of the speaker must be forwarded');
+			t.equal(countReceived(carol, 2222), 0, 'the audio of the silent Peer must not be forwarded');
+
+			// Bob interrupts Alice, who keeps being the dominant speaker.
+			bob.audio.level = SPEECH;
+
+			return talk([ alice, bob ], 600);
+		})
+		.then(() =>
+		{
+			let packets = countReceived(carol, 2222);
+
+			t.ok(packets >= 5, `the beginning of the speech must be forwarded [packets:${packets}]`);
+			t.ok(packets <= 15, `the speech must not be forwarded for long [packets:${packets}]`);
+		});
+});
+
+tap.test('room.setLastN() must switch the video of the last N speakers at key frames', { timeout: 20000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+	let alice;
+	let bob;
+	let carol;
+	let keyFrameRequests;
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			return room.setLastN({ video: 1 })
+				.then(() => createEndpoint(t, room, 'alice'))
+				.then((endpoint) => publish(endpoint, 1111))
+				.then((endpoint) => publishVideo(endpoint, 1112))
+				.then((endpoint) => (alice = endpoint))
+				.then(() => createEndpoint(t, room, 'bob'))
+				.then((endpoint) => publish(endpoint, 2221))
+				.then((endpoint) => publishVideo(endpoint, 2222))
+				.then((endpoint) => (bob = endpoint))
+				.then(() => createEndpoint(t, room, 'carol'));
+		})
+		.then((endpoint) =>
+		{
+			carol = endpoint;
+
+			// Let the noise floor of both be known.
+			return talk([ alice, bob ], 500);
+		})
+		.then(() =>
+		{
+			alice.audio.level = SPEECH;
+
+			return talk([ alice, bob ], 2000);
+		})
+		.then(() =>
+		{
+			t.ok(countReceived(carol, 1112) > 0, 'the video of the speaker must be forwarded');
+			t.equal(countReceived(carol, 2222), 0, 'the video of the silent Peer must not be forwarded');
+
+			// Bob takes the floor.
+			keyFrameRequests = bob.video.keyFrameRequests;
+			alice.audio.level = SILENCE;
+			bob.audio.level = SPEECH;
+
+			return talk([ alice, bob ], 6000);
+		})
+		.then(() =>
+		{
+			let alicePackets = carol.received.get(1112);
+			let bobPackets = carol.received.get(2222) || [];
+
+			t.ok(
+				bob.video.keyFrameRequests > keyFrameRequests,
+				'a key frame must be requested to the new speaker');
+			t.ok(bobPackets.length > 0, 'the video of the new speaker must be forwarded');
+			t.ok(bobPackets.length > 0 && isKeyFrame(bobPackets[0]), 'the video must resume at a key frame');
+			t.ok(
+				(alicePackets[alicePackets.length - 1][1] & 0x80) !== 0,
+				'the video must pause at the end of a frame');
+
+			let forwarded = alicePackets.length;
+
+			return talk([ alice, bob ], 500)
+				.then(() =>
+				{
+					t.equal(
+						carol.received.get(1112).length, forwarded,
+						'the video of the previous speaker must not be forwarded anymore');
+				});
+		});
+});
+
+tap.test('peer.createActiveSpeakerRtpSender() must send the video of the dominant speaker', { timeout: 20000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+	let alice;
+	let bob;
+	let carol;
+	let ssrc;
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			return createEndpoint(t, room, 'alice')
+				.then((endpoint) => publish(endpoint, 1111))
+				.then((endpoint) => publishVideo(endpoint, 1112))
+				.then((endpoint) => (alice = endpoint))
+				.then(() => createEndpoint(t, room, 'bob'))
+				.then((endpoint) => publish(endpoint, 2221))
+				.then((endpoint) => publishVideo(endpoint, 2222))
+				.then((endpoint) => (bob = endpoint))
+				.then(() => createEndpoint(t, room, 'carol'));
+		})
+		.then((endpoint) =>
+		{
+			carol = endpoint;
+
+			return carol.peer.createActiveSpeakerRtpSender();
+		})
+		.then((rtpSender) =>
+		{
+			ssrc = rtpSender.rtpParameters.encodings[0].ssrc;
+
+			t.ok(ssrc !== 1112 && ssrc !== 2222, 'the active speaker stream must have its own SSRC');
+
+			// Let the noise floor of both be known.
+			return talk([ alice, bob ], 500);
+		})
+		.then(() =>
+		{
+			alice.audio.level = SPEECH;
+
+			return talk([ alice, bob ], 2000);
+		})
+		.then(() =>
+		{
+			t.equal(lastSource(carol, ssrc), 1112, 'the stream must send the video of the speaker');
+
+			// Bob takes the floor.
+			alice.audio.level = SILENCE;
+			bob.audio.level = SPEECH;
+
+			return talk([ alice, bob ], 6000);
+		})
+		.then(() =>
+		{
+			t.equal(lastSource(carol, ssrc), 2222, 'the stream must switch to the new speaker');
+
+			let packets = carol.received.get(ssrc);
+			let sources = [];
+			let consecutive = true;
+			let switchedAtKeyFrame = true;
+
+			packets.forEach((packet, idx) =>
+			{
+				let source = packet.readUInt32BE(14);
+
+				if (sources[sources.length - 1] !== source)
+				{
+					sources.push(source);
+					switchedAtKeyFrame = switchedAtKeyFrame && isKeyFrame(packet);
+				}
+
+				if (idx > 0 && packet.readUInt16BE(2) !== ((packets[idx - 1].readUInt16BE(2) + 1) & 0xFFFF))
+					consecutive = false;
+			});
+
+			t.ok(switchedAtKeyFrame, 'every source must start at a key frame');
+			t.ok(consecutive, 'the sequence numbers must be consecutive');
+		});
+});
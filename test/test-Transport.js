@@ -247,3 +247,170 @@ tap.test('create transport in a server with rtcAnnouncedIPv4', { timeout: 2000 }
 			t.equal(candidate.ip, 'test.foo.com', 'candidate.ip must be test.foo.com');
 		});
 });
+
+tap.test('peer.createPlainRtpTransport() must succeed', { timeout: 2000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			let peer = room.Peer('alice');
+
+			return peer.createPlainRtpTransport({ remoteIP: '127.0.0.1', remotePort: 5004 });
+		})
+		.then((transport) =>
+		{
+			t.pass('peer.createPlainRtpTransport() succeeded');
+			t.equal(transport.plainRtp, true, 'transport.plainRtp must be true');
+			t.equal(transport.localIP, '127.0.0.1', 'transport.localIP must be 127.0.0.1');
+			t.ok(transport.localPort > 0, 'transport.localPort must be set');
+			t.equal(transport.tuple.remoteIP, '127.0.0.1', 'tuple.remoteIP must be 127.0.0.1');
+			t.equal(transport.tuple.remotePort, 5004, 'tuple.remotePort must be 5004');
+			t.equal(transport.iceLocalCandidates, undefined, 'transport must not have ICE candidates');
+			t.equal(transport.dtlsLocalParameters, undefined, 'transport must not have DTLS parameters');
+
+			// The initial tuple is given in the response, not in an event.
+			transport.on('tuplechange', () => t.fail('unexpected "tuplechange" event'));
+
+			return transport.dump();
+		})
+		.then((data) =>
+		{
+			t.pass('transport.dump() succeeded');
+			t.equal(data.plainRtp, true, 'data.plainRtp must be true');
+			t.equal(data.tuple.remotePort, 5004, 'data.tuple.remotePort must be 5004');
+			t.equal(data.iceState, undefined, 'data.iceState must not be set');
+			t.equal(data.dtlsState, undefined, 'data.dtlsState must not be set');
+		});
+});
+
+tap.test('peer.createPlainRtpTransport() with invalid remote parameters must fail', { timeout: 2000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+	let peer;
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			peer = room.Peer('alice');
+
+			return Promise.all(
+				[
+					{ remoteIP: '127.0.0.1', remotePort: 70000 },
+					{ remoteIP: '127.0.0.1', remotePort: 0 },
+					{ remoteIP: 'foo', remotePort: 5004 },
+					{ remoteIP: '::1', remotePort: 5004 },
+					{ remoteIP: '127.0.0.1' }
+				].map((options) =>
+				{
+					return peer.createPlainRtpTransport(options)
+						.then(() => t.fail(`peer.createPlainRtpTransport() succeeded with ${JSON.stringify(options)}`))
+						.catch((error) => t.pass(`peer.createPlainRtpTransport() failed: ${error}`));
+				}));
+		})
+		.then(() => peer.dump())
+		.then((data) =>
+		{
+			t.equal(Object.keys(data.transports).length, 0, 'peer.dump() must retrieve zero transports');
+		});
+});
+
+tap.test('transport.setRemoteParameters() in a plain RTP transport must succeed', { timeout: 2000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			let peer = room.Peer('alice');
+
+			return peer.createPlainRtpTransport();
+		})
+		.then((transport) =>
+		{
+			t.equal(transport.tuple, undefined, 'transport.tuple must not be set');
+
+			let tuplechange = new Promise((resolve) => transport.once('tuplechange', resolve));
+
+			return transport.setRemoteParameters({ ip: '127.0.0.1', port: 5006 })
+				.then(() =>
+				{
+					t.pass('transport.setRemoteParameters() succeeded');
+					t.equal(transport.tuple.remotePort, 5006, 'tuple.remotePort must be 5006');
+
+					return tuplechange;
+				})
+				.then((tuple) =>
+				{
+					t.equal(tuple.remotePort, 5006, '"tuplechange" event must carry the new tuple');
+
+					return transport.setRemoteParameters({ ip: '127.0.0.1', port: 70000 })
+						.then(() => t.fail('transport.setRemoteParameters() succeeded with port 70000'))
+						.catch(() => t.pass('transport.setRemoteParameters() with port 70000 failed'));
+				})
+				.then(() =>
+				{
+					t.equal(transport.tuple.remotePort, 5006, 'tuple.remotePort must still be 5006');
+
+					// The event would be received before the response.
+					transport.on('tuplechange', () => t.fail('unexpected "tuplechange" event'));
+
+					return transport.setRemoteParameters({ ip: '127.0.0.1', port: 5006 });
+				})
+				.then(() =>
+				{
+					t.pass('transport.setRemoteParameters() with the same tuple succeeded');
+					t.equal(transport.tuple.remotePort, 5006, 'tuple.remotePort must still be 5006');
+				});
+		});
+});
+
+tap.test('ICE and DTLS requests in a plain RTP transport must fail', { timeout: 2000 }, (t) =>
+{
+	let server = mediasoup.Server({ rtcIPv4: '127.0.0.1', rtcIPv6: false });
+
+	t.tearDown(() => server.close());
+
+	return server.createRoom(roomOptions)
+		.then((room) =>
+		{
+			let peer = room.Peer('alice');
+
+			return peer.createPlainRtpTransport({ remoteIP: '127.0.0.1', remotePort: 5004 });
+		})
+		.then((transport) =>
+		{
+			return transport.setRemoteDtlsParameters(
+				{
+					role        : 'server',
+					fingerprint :
+					{
+						algorithm : 'sha-1',
+						value     : '751b8193b7ed277e42bed6c48ef7043a49ce3faa'
+					}
+				})
+				.then(() => t.fail('transport.setRemoteDtlsParameters() succeeded'))
+				.catch(() => t.pass('transport.setRemoteDtlsParameters() failed'))
+				.then(() => transport.changeUfragPwd())
+				.then(() => t.fail('transport.changeUfragPwd() succeeded'))
+				.catch(() => t.pass('transport.changeUfragPwd() failed'));
+		});
+});
+
+tap.test('transport.setRemoteParameters() in a non plain RTP transport must fail', { timeout: 2000 }, (t) =>
+{
+	return initTest(t)
+		.then((data) =>
+		{
+			return data.transport.setRemoteParameters({ ip: '127.0.0.1', port: 5004 })
+				.then(() => t.fail('transport.setRemoteParameters() succeeded'))
+				.catch(() => t.pass('transport.setRemoteParameters() failed'));
+		});
+});
@@ -0,0 +1,120 @@
+#ifndef MS_CHANNEL_BINARY_CODEC_HPP
+#define MS_CHANNEL_BINARY_CODEC_HPP
+
+#include "common.hpp"
+#include <json/json.h>
+#include <string>
+
+namespace Channel
+{
+	/**
+	 * Compact binary encoding of the Channel messages, used instead of JSON
+	 * when the Node side asks for it at startup (--channelFormat=binary).
+	 *
+	 * A message is the Marker byte followed by a value. Every value is a tag
+	 * byte followed by its payload. Lengths, counts and integers are LEB128
+	 * varints, doubles are little-endian IEEE 754:
+	 *
+	 *   null, false, true: tag only.
+	 *   uint:              varint.
+	 *   negative int:      varint of -(value + 1).
+	 *   double:            8 bytes.
+	 *   string:            varint length, bytes.
+	 *   array:             varint count, values.
+	 *   object:            varint count, (varint length, key bytes, value) pairs.
+	 */
+	class BinaryCodec
+	{
+	public:
+		// JSON messages start with '{' and logs with a letter.
+		static constexpr uint8_t Marker{ 0x00 };
+
+	public:
+		enum class Tag : uint8_t
+		{
+			NULL_VALUE = 0,
+			BOOL_FALSE,
+			BOOL_TRUE,
+			UINT,
+			NEGATIVE_INT,
+			DOUBLE,
+			STRING,
+			ARRAY,
+			OBJECT
+		};
+
+		/**
+		 * Writes a message straight into a buffer, from typed data or from a
+		 * Json::Value. Arrays and objects are given their count first and then
+		 * their items, or their members as key and value pairs.
+		 */
+		class Writer
+		{
+		public:
+			Writer(uint8_t* buffer, size_t size);
+
+		public:
+			void WriteNull();
+			void WriteBool(bool value);
+			void WriteUInt(uint64_t value);
+			void WriteInt(int64_t value);
+			void WriteDouble(double value);
+			void WriteString(const char* data, size_t len);
+			void WriteString(const std::string& value);
+			void WriteArray(size_t count);
+			void WriteObject(size_t count);
+			void WriteKey(const char* key);
+			void WriteJson(const Json::Value& json);
+			size_t GetLength() const;
+			size_t GetNeededSize() const;
+
+		private:
+			void WriteByte(uint8_t byte);
+			void WriteVarint(uint64_t value);
+			void WriteBytes(const char* data, size_t len);
+
+		private:
+			uint8_t* buffer{ nullptr };
+			size_t size{ 0 };
+			size_t pos{ 0 };
+			bool overflow{ false };
+		};
+
+	public:
+		static bool IsBinary(const uint8_t* data, size_t len);
+		static size_t Encode(const Json::Value& json, uint8_t* buffer, size_t size);
+		static bool Decode(const uint8_t* data, size_t len, Json::Value& json);
+	};
+
+	/* Inline static methods. */
+
+	inline bool BinaryCodec::IsBinary(const uint8_t* data, size_t len)
+	{
+		return len > 1 && data[0] == Marker;
+	}
+
+	/* Inline instance methods. */
+
+	inline void BinaryCodec::Writer::WriteString(const std::string& value)
+	{
+		WriteString(value.c_str(), value.length());
+	}
+
+	/**
+	 * Written length, 0 if the message does not fit into the buffer.
+	 */
+	inline size_t BinaryCodec::Writer::GetLength() const
+	{
+		return this->overflow ? 0 : this->pos;
+	}
+
+	/**
+	 * Length of the whole message, also when it does not fit into the buffer.
+	 */
+	inline size_t BinaryCodec::Writer::GetNeededSize() const
+	{
+		return this->pos;
+	}
+} // namespace Channel
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef MS_CHANNEL_DUMP_WRITER_HPP
+#define MS_CHANNEL_DUMP_WRITER_HPP
+
+#include "common.hpp"
+#include "Channel/Request.hpp"
+#include "handles/Idle.hpp"
+#include <json/json.h>
+
+namespace Channel
+{
+	/**
+	 * Replies to a dump Request a step per loop iteration, so dumping a big
+	 * entity does not stall the media. The data of every step but the last one
+	 * is sent as a partial response (see Request::AcceptPartial()).
+	 */
+	class DumpWriter : public Idle::Listener
+	{
+	public:
+		class Listener
+		{
+		public:
+			// Must return true for the last step, after which the DumpWriter is
+			// destroyed.
+			virtual bool OnDumpWriterStep(
+			    Channel::DumpWriter* dumpWriter, size_t step, Json::Value& data) = 0;
+		};
+
+	public:
+		DumpWriter(Listener* listener, Channel::Request* request);
+
+	private:
+		~DumpWriter() override;
+
+	public:
+		void Destroy();
+
+		/* Pure virtual methods inherited from Idle::Listener. */
+	public:
+		void OnIdle(Idle* idle) override;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Allocated by this.
+		Channel::Request* request{ nullptr };
+		Idle* idle{ nullptr };
+		// Others.
+		size_t step{ 0 };
+	};
+} // namespace Channel
+
+#endif
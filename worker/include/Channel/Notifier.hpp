@@ -2,14 +2,41 @@
 #define MS_CHANNEL_NOTIFIER_HPP
 
 #include "common.hpp"
+#include "Channel/BinaryCodec.hpp"
 #include "Channel/UnixStreamSocket.hpp"
 #include <json/json.h>
 #include <string>
+#include <vector>
 
 namespace Channel
 {
 	class Notifier
 	{
+	private:
+		struct RateLimit
+		{
+			uint32_t maxPerSecond{ 0 };
+			uint64_t periodStart{ 0 };
+			uint32_t count{ 0 };
+			uint32_t dropped{ 0 };
+		};
+
+	public:
+		struct AudioLevel
+		{
+			uint32_t rtpReceiverId{ 0 };
+			int8_t level{ 0 };
+		};
+
+		struct RtpObject
+		{
+			uint8_t payloadType{ 0 };
+			bool marker{ false };
+			uint16_t sequenceNumber{ 0 };
+			uint32_t timestamp{ 0 };
+			uint32_t ssrc{ 0 };
+		};
+
 	public:
 		explicit Notifier(Channel::UnixStreamSocket* channel);
 
@@ -21,10 +48,33 @@ namespace Channel
 		    Json::Value& data,
 		    const uint8_t* binaryData,
 		    size_t binaryLen);
+		// Frequent events, written straight from their data in binary mode. The
+		// per packet ones are rate limited and may be dropped if Node is slow.
+		void EmitAudioLevels(uint32_t targetId, const std::vector<AudioLevel>& entries);
+		void EmitRtpRaw(uint32_t targetId, const uint8_t* packet, size_t packetLen);
+		void EmitRtpObject(
+		    uint32_t targetId, const RtpObject& object, const uint8_t* payload, size_t payloadLen);
+
+	private:
+		bool IsAllowed(RateLimit& rateLimit, const std::string& event);
+		void SendEvent(
+		    uint32_t targetId,
+		    const std::string& event,
+		    const Json::Value* data,
+		    const uint8_t* binaryData,
+		    size_t binaryLen,
+		    bool droppable);
+		void WriteEvent(
+		    BinaryCodec::Writer& writer, uint32_t targetId, const std::string& event, size_t numMembers);
 
 	public:
 		// Passed by argument.
 		Channel::UnixStreamSocket* channel{ nullptr };
+
+	private:
+		// Others.
+		RateLimit rtpRawRateLimit;
+		RateLimit rtpObjectRateLimit;
 	};
 } // namespace Channel
 
@@ -19,30 +19,40 @@ namespace Channel
 		{
 			WORKER_DUMP = 1,
 			WORKER_UPDATE_SETTINGS,
+			WORKER_GET_LATENCY,
 			WORKER_CREATE_ROOM,
 			ROOM_CLOSE,
 			ROOM_DUMP,
+			ROOM_GET_STATS,
 			ROOM_CREATE_PEER,
 			ROOM_SET_AUDIO_LEVELS_EVENT,
+			ROOM_SET_LAST_N,
 			PEER_CLOSE,
 			PEER_DUMP,
 			PEER_SET_CAPABILITIES,
 			PEER_CREATE_TRANSPORT,
 			PEER_CREATE_RTP_RECEIVER,
+			PEER_CREATE_ACTIVE_SPEAKER_RTP_SENDER,
 			TRANSPORT_CLOSE,
 			TRANSPORT_DUMP,
+			TRANSPORT_GET_STATS,
 			TRANSPORT_SET_REMOTE_DTLS_PARAMETERS,
 			TRANSPORT_SET_MAX_BITRATE,
 			TRANSPORT_CHANGE_UFRAG_PWD,
+			TRANSPORT_SET_REMOTE_PARAMETERS,
 			RTP_RECEIVER_CLOSE,
 			RTP_RECEIVER_DUMP,
 			RTP_RECEIVER_RECEIVE,
 			RTP_RECEIVER_SET_TRANSPORT,
 			RTP_RECEIVER_SET_RTP_RAW_EVENT,
 			RTP_RECEIVER_SET_RTP_OBJECT_EVENT,
+			RTP_RECEIVER_SET_RTP_TAP,
 			RTP_SENDER_DUMP,
 			RTP_SENDER_SET_TRANSPORT,
-			RTP_SENDER_DISABLE
+			RTP_SENDER_DISABLE,
+			RTP_SENDER_SET_PREFERRED_LAYERS,
+			RTP_SENDER_SET_PINNED,
+			RTP_SENDER_SET_MAX_RESOLUTION
 		};
 
 	private:
@@ -54,6 +64,8 @@ namespace Channel
 
 		void Accept();
 		void Accept(Json::Value& data);
+		void Accept(Json::Value& data, const uint8_t* binaryData, size_t binaryLen);
+		void AcceptPartial(Json::Value& data);
 		void Reject(std::string& reason);
 		void Reject(const char* reason = nullptr);
 
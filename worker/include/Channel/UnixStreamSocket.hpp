@@ -3,13 +3,28 @@
 
 #include "common.hpp"
 #include "Channel/Request.hpp"
+#include "handles/Check.hpp"
+#include "handles/Timer.hpp"
 #include "handles/UnixStreamSocket.hpp"
 #include <json/json.h>
+#include <vector>
 
 namespace Channel
 {
-	class UnixStreamSocket : public ::UnixStreamSocket
+	class UnixStreamSocket : public ::UnixStreamSocket, public Check::Listener, public Timer::Listener
 	{
+	public:
+		// Max size of a message sent as several fragments.
+		static constexpr size_t FragmentedMessageMaxSize{ 16777216 };
+
+	private:
+		struct QueuedEvent
+		{
+			size_t len{ 0 };
+			bool droppable{ false };
+			bool dropped{ false };
+		};
+
 	public:
 		class Listener
 		{
@@ -26,24 +41,76 @@ namespace Channel
 
 	public:
 		void SetListener(Listener* listener);
+		void SetBinary(bool binary);
+		bool IsBinary() const;
 		void Send(Json::Value& msg);
+		void SendEvent(
+		    Json::Value& msg,
+		    const uint8_t* binaryData = nullptr,
+		    size_t binaryLen          = 0,
+		    bool droppable            = false);
+		void SendEvent(
+		    const uint8_t* msg,
+		    size_t msgLen,
+		    const uint8_t* binaryData = nullptr,
+		    size_t binaryLen          = 0,
+		    bool droppable            = false);
+		void FlushEvents();
 		void SendLog(char* nsPayload, size_t nsPayloadLen);
 		void SendBinary(const uint8_t* nsPayload, size_t nsPayloadLen);
+		void SendFragments(const uint8_t* payload, size_t len);
+
+	private:
+		size_t Encode(Json::Value& msg, std::vector<uint8_t>* bigPayload = nullptr);
+		void QueueEvent(
+		    const uint8_t* msg,
+		    size_t msgLen,
+		    const uint8_t* binaryData,
+		    size_t binaryLen,
+		    bool droppable);
+		bool DropOldestEvent();
+		void CompactEvents();
+		void ClearEvents();
 
 		/* Pure virtual methods inherited from ::UnixStreamSocket. */
 	public:
 		void UserOnUnixStreamRead() override;
 		void UserOnUnixStreamSocketClosed(bool isClosedByPeer) override;
 
+		/* Pure virtual methods inherited from Check::Listener. */
+	public:
+		void OnCheck(Check* check) override;
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
+
 	private:
 		// Passed by argument.
 		Listener* listener{ nullptr };
+		// Allocated by this.
+		Check* flushCheck{ nullptr };
+		Timer* flushTimer{ nullptr };
 		// Others.
 		Json::CharReader* jsonReader{ nullptr };
 		Json::StreamWriter* jsonWriter{ nullptr };
+		// Events waiting for the end of the loop iteration, as netstrings.
+		std::vector<uint8_t> events;
+		std::vector<QueuedEvent> queuedEvents;
+		size_t queuedSize{ 0 };    // Bytes of the events not dropped.
+		size_t nextDroppable{ 0 }; // Oldest event which may be dropped.
+		size_t droppedEvents{ 0 };
 		size_t msgStart{ 0 }; // Where the latest message starts.
 		bool closed{ false };
+		bool binary{ false };
 	};
+
+	/* Inline instance methods. */
+
+	inline bool UnixStreamSocket::IsBinary() const
+	{
+		return this->binary;
+	}
 } // namespace Channel
 
 #endif
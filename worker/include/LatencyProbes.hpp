@@ -0,0 +1,201 @@
+#ifndef MS_LATENCY_PROBES_HPP
+#define MS_LATENCY_PROBES_HPP
+
+#include "common.hpp"
+#include "Channel/Request.hpp"
+#include <json/json.h>
+#include <uv.h>
+
+/**
+ * Latency instrumentation of the worker: the time of every loop iteration and
+ * how long what is ready waits for the loop (measured with uv_prepare and
+ * uv_check handles), and the time spent in every stage of the packet path.
+ *
+ * Probes are only compiled in if MS_LATENCY_PROBES is defined (set by the
+ * mediasoup_latency_probes gyp variable), otherwise MS_LATENCY_PROBE() expands
+ * to nothing.
+ */
+class LatencyProbes
+{
+public:
+	enum class Metric : uint8_t
+	{
+		LOOP_ITERATION = 0,
+		LOOP_LAG,
+		DECRYPT,
+		PARSE,
+		ROUTING, // Includes the encrypt and send of the forwarded packets.
+		ENCRYPT,
+		SEND,
+		RTCP_DECRYPT,
+		RTCP_ENCRYPT
+	};
+
+	static constexpr size_t NumMetrics{ 9 };
+
+public:
+	/**
+	 * HDR-style histogram of nanosecond values: exact below SubBuckets, then
+	 * SubBuckets linear buckets per power of two, so the error of any reported
+	 * value is below 1 / SubBuckets. Recording is a few integer operations.
+	 */
+	class Histogram
+	{
+	public:
+		static constexpr uint8_t SubBucketBits{ 4 };
+		static constexpr size_t SubBuckets{ 1 << SubBucketBits };
+		static constexpr size_t NumBuckets{ (64 - SubBucketBits + 1) * SubBuckets };
+
+	public:
+		static size_t GetBucket(uint64_t value);
+		static uint64_t GetBucketMaxValue(size_t bucket);
+
+	public:
+		void Record(uint64_t value);
+		void Reset();
+		uint64_t GetCount() const;
+		uint64_t GetMax() const;
+		uint64_t GetMean() const;
+		uint64_t GetPercentile(double percentile) const;
+		Json::Value ToJson() const;
+
+	private:
+		uint32_t buckets[NumBuckets]{};
+		uint64_t count{ 0 };
+		uint64_t sum{ 0 };
+		uint64_t max{ 0 };
+	};
+
+	/**
+	 * Records the time elapsed until it goes out of scope.
+	 */
+	class Probe
+	{
+	public:
+		explicit Probe(Metric metric);
+		Probe& operator=(const Probe&) = delete;
+		Probe(const Probe&)            = delete;
+		~Probe();
+
+	private:
+		Metric metric;
+		uint64_t startedAt{ 0 };
+	};
+
+	/**
+	 * Adds the time elapsed until it goes out of scope to the time spent in the
+	 * I/O callbacks of the current loop iteration.
+	 */
+	class IoCallbackProbe
+	{
+	public:
+		IoCallbackProbe();
+		IoCallbackProbe& operator=(const IoCallbackProbe&) = delete;
+		IoCallbackProbe(const IoCallbackProbe&)            = delete;
+		~IoCallbackProbe();
+
+	private:
+		uint64_t startedAt{ 0 };
+	};
+
+public:
+	static void ClassInit();
+	static void ClassDestroy();
+	static void Record(Metric metric, uint64_t value);
+	static uint64_t GetLoopLag(uint64_t elapsed, uint64_t ioCallbacksTime, int pollTimeout);
+	static Json::Value ToJson();
+	static void HandleRequest(Channel::Request* request);
+
+	/* Callbacks fired by UV events. */
+public:
+	static void OnUvPrepare();
+	static void OnUvCheck();
+
+private:
+	static uv_prepare_t* uvPrepareHandle;
+	static uv_check_t* uvCheckHandle;
+	static uint64_t lastPrepareAt;
+	static int pollTimeout;
+	static uint64_t ioCallbacksTime;
+	static Histogram histograms[NumMetrics];
+};
+
+#ifdef MS_LATENCY_PROBES
+#define MS_LATENCY_PROBE(metric) \
+	LatencyProbes::Probe msLatencyProbe(LatencyProbes::Metric::metric) // NOLINT
+#define MS_LATENCY_IO_CALLBACK() LatencyProbes::IoCallbackProbe msLatencyIoCallbackProbe // NOLINT
+#else
+#define MS_LATENCY_PROBE(metric)
+#define MS_LATENCY_IO_CALLBACK()
+#endif
+
+/* Inline static methods. */
+
+inline void LatencyProbes::Record(Metric metric, uint64_t value)
+{
+	LatencyProbes::histograms[static_cast<size_t>(metric)].Record(value);
+}
+
+/* Inline instance methods. */
+
+inline size_t LatencyProbes::Histogram::GetBucket(uint64_t value)
+{
+	if (value < SubBuckets)
+		return static_cast<size_t>(value);
+
+	// Position of the highest bit set.
+	uint8_t msb{ 0 };
+
+	for (uint8_t shift{ 32 }; shift != 0; shift >>= 1)
+	{
+		if ((value >> (msb + shift)) != 0)
+			msb += shift;
+	}
+
+	return (msb - SubBucketBits + 1) * SubBuckets + (value >> (msb - SubBucketBits)) - SubBuckets;
+}
+
+inline void LatencyProbes::Histogram::Record(uint64_t value)
+{
+	++this->buckets[GetBucket(value)];
+	++this->count;
+	this->sum += value;
+
+	if (value > this->max)
+		this->max = value;
+}
+
+inline uint64_t LatencyProbes::Histogram::GetCount() const
+{
+	return this->count;
+}
+
+inline uint64_t LatencyProbes::Histogram::GetMax() const
+{
+	return this->max;
+}
+
+inline uint64_t LatencyProbes::Histogram::GetMean() const
+{
+	return this->count != 0 ? this->sum / this->count : 0;
+}
+
+inline LatencyProbes::Probe::Probe(Metric metric) : metric(metric), startedAt(uv_hrtime())
+{
+}
+
+inline LatencyProbes::Probe::~Probe()
+{
+	LatencyProbes::Record(this->metric, uv_hrtime() - this->startedAt);
+}
+
+inline LatencyProbes::IoCallbackProbe::IoCallbackProbe() : startedAt(uv_hrtime())
+{
+}
+
+inline LatencyProbes::IoCallbackProbe::~IoCallbackProbe()
+{
+	LatencyProbes::ioCallbacksTime += uv_hrtime() - this->startedAt;
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef MS_RTC_ACTIVE_SPEAKER_DETECTOR_HPP
+#define MS_RTC_ACTIVE_SPEAKER_DETECTOR_HPP
+
+#include "common.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Dominant speaker identification (Volfin and Cohen, "Dominant Speaker
+	 * Identification for Multipoint Videoconferencing"). The speech activity
+	 * of every audio stream is scored in three time scales (immediate, medium
+	 * and long) and a speaker replaces the dominant one when it beats it in all
+	 * of them.
+	 *
+	 * Each audio level (one per packet) is processed in constant time and every
+	 * stream uses constant memory.
+	 */
+	class ActiveSpeakerDetector
+	{
+	public:
+		// Frames (packets) in a medium block and medium blocks in a long block.
+		static constexpr uint8_t MediumBlockFrames{ 5 };
+		static constexpr uint8_t LongBlockMediumBlocks{ 5 };
+		// Sizes of the windows.
+		static constexpr uint8_t ImmediateSubbands{ 13 };
+		static constexpr uint8_t MediumWindowBlocks{ 5 };
+		static constexpr uint8_t LongWindowBlocks{ 6 };
+
+	private:
+		struct Stream
+		{
+			// Noise floor, as loudness (127 - dBov).
+			uint8_t noiseFloor{ 0 };
+			uint8_t noiseFloorFrames{ 0 };
+			bool hasNoiseFloor{ false };
+			// Averaged audio level (dBov, negative).
+			int16_t level{ -127 };
+			// Active subbands of the last frame.
+			uint8_t immediateSubbands{ 0 };
+			// Active frames of the current medium block.
+			uint8_t mediumBlockFrames{ 0 };
+			uint8_t mediumBlockActiveFrames{ 0 };
+			// Last medium blocks, a bit per block (1 if active).
+			uint8_t mediumHistory{ 0 };
+			uint8_t mediumActiveBlocks{ 0 };
+			// Active medium blocks of the current long block.
+			uint8_t longBlockMediumBlocks{ 0 };
+			uint8_t longBlockActiveMediumBlocks{ 0 };
+			// Last long blocks, a bit per block (1 if active).
+			uint8_t longHistory{ 0 };
+			uint8_t longActiveBlocks{ 0 };
+			uint64_t lastLevelAt{ 0 };
+		};
+
+	public:
+		ActiveSpeakerDetector();
+
+	public:
+		bool ReceiveLevel(uint32_t id, uint8_t volume, uint64_t now);
+		void RemoveStream(uint32_t id);
+		void Clear();
+		bool Process(uint64_t now);
+		bool HasDominantSpeaker() const;
+		uint32_t GetDominantSpeaker() const;
+		int8_t GetLevel(uint32_t id) const;
+		bool IsActiveFrame(uint32_t id) const;
+
+	private:
+		void ResetActivity(Stream& stream);
+		bool Beats(const Stream& challenger, const Stream& dominant) const;
+		double GetImmediateScore(const Stream& stream) const;
+		double GetMediumScore(const Stream& stream) const;
+		double GetLongScore(const Stream& stream) const;
+
+	private:
+		std::unordered_map<uint32_t, Stream> streams;
+		bool hasDominantSpeaker{ false };
+		uint32_t dominantSpeaker{ 0 };
+		// Whether the dominant speaker was removed since the last Process().
+		bool dominantSpeakerRemoved{ false };
+		// Speech activity score for every number of active subbands/blocks.
+		std::vector<double> immediateScores;
+		std::vector<double> mediumScores;
+		std::vector<double> longScores;
+	};
+
+	/* Inline methods. */
+
+	inline bool ActiveSpeakerDetector::HasDominantSpeaker() const
+	{
+		return this->hasDominantSpeaker;
+	}
+
+	inline uint32_t ActiveSpeakerDetector::GetDominantSpeaker() const
+	{
+		return this->dominantSpeaker;
+	}
+
+	inline double ActiveSpeakerDetector::GetImmediateScore(const Stream& stream) const
+	{
+		return this->immediateScores[stream.immediateSubbands];
+	}
+
+	inline double ActiveSpeakerDetector::GetMediumScore(const Stream& stream) const
+	{
+		return this->mediumScores[stream.mediumActiveBlocks];
+	}
+
+	inline double ActiveSpeakerDetector::GetLongScore(const Stream& stream) const
+	{
+		return this->longScores[stream.longActiveBlocks];
+	}
+} // namespace RTC
+
+#endif
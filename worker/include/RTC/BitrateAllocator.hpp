@@ -0,0 +1,48 @@
+#ifndef MS_RTC_BITRATE_ALLOCATOR_HPP
+#define MS_RTC_BITRATE_ALLOCATOR_HPP
+
+#include "common.hpp"
+#include "RTC/RtpSender.hpp"
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Shares the bitrate available towards a Peer among the VP9 streams it
+	 * receives. Every stream gets its base layer and the rest of the bitrate
+	 * goes, in priority order, to the highest layers each stream can afford.
+	 */
+	class BitrateAllocator
+	{
+	public:
+		// Lower values are served first.
+		enum class Priority : uint8_t
+		{
+			ACTIVE_SPEAKER = 0,
+			PINNED,
+			THUMBNAIL
+		};
+
+	public:
+		struct Stream
+		{
+			RTC::RtpSender* rtpSender{ nullptr };
+			Priority priority{ Priority::THUMBNAIL };
+			uint8_t preferredSpatialLayer{ 0 };
+			uint8_t preferredTemporalLayer{ 0 };
+			// Layers currently sent.
+			uint8_t currentSpatialLayer{ 0 };
+			uint8_t currentTemporalLayer{ 0 };
+			// Bitrate of each layer including the layers it depends on.
+			uint32_t layersBitrate[RTC::RtpSender::MaxSpatialLayers][RTC::RtpSender::MaxTemporalLayers]{};
+			// Result of the allocation.
+			uint8_t spatialLayer{ 0 };
+			uint8_t temporalLayer{ 0 };
+		};
+
+	public:
+		static void Allocate(uint32_t availableBitrate, std::vector<Stream>& streams);
+	};
+} // namespace RTC
+
+#endif
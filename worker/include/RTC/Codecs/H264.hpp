@@ -0,0 +1,18 @@
+#ifndef MS_RTC_CODECS_H264_HPP
+#define MS_RTC_CODECS_H264_HPP
+
+#include "common.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		class H264
+		{
+		public:
+			static bool IsKeyFrame(const uint8_t* data, size_t len);
+		};
+	} // namespace Codecs
+} // namespace RTC
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef MS_RTC_CODECS_HANDLERS_HPP
+#define MS_RTC_CODECS_HANDLERS_HPP
+
+#include "common.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		/**
+		 * Codec handlers. The one of the codec is resolved when the stream is
+		 * created so every packet goes through a pipeline specialized for it.
+		 */
+
+		struct AudioHandler
+		{
+			static constexpr bool IsAudio{ true };
+			static constexpr bool HasVP8Descriptor{ false };
+			static constexpr bool HasVP9Descriptor{ false };
+		};
+
+		struct VideoHandler
+		{
+			static constexpr bool IsAudio{ false };
+			static constexpr bool HasVP8Descriptor{ false };
+			static constexpr bool HasVP9Descriptor{ false };
+		};
+
+		struct OpusHandler : public AudioHandler
+		{
+		};
+
+		struct VP8Handler : public VideoHandler
+		{
+			static constexpr bool HasVP8Descriptor{ true };
+		};
+
+		struct VP9Handler : public VideoHandler
+		{
+			static constexpr bool HasVP9Descriptor{ true };
+		};
+
+		struct H264Handler : public VideoHandler
+		{
+		};
+	} // namespace Codecs
+} // namespace RTC
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef MS_RTC_CODECS_TOOLS_HPP
+#define MS_RTC_CODECS_TOOLS_HPP
+
+#include "common.hpp"
+#include "RTC/RtpDictionaries.hpp"
+#include "RTC/RtpPacket.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		class Tools
+		{
+		public:
+			static bool CanDetectKeyFrames(const RTC::RtpCodecMime& mime);
+			static bool IsKeyFrame(const RTC::RtpCodecMime& mime, RTC::RtpPacket* packet);
+		};
+	} // namespace Codecs
+} // namespace RTC
+
+#endif
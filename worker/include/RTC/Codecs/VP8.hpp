@@ -0,0 +1,114 @@
+#ifndef MS_RTC_CODECS_VP8_HPP
+#define MS_RTC_CODECS_VP8_HPP
+
+#include "common.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		class VP8
+		{
+		public:
+			/**
+			 * VP8 payload descriptor (RFC 7741 section 4.2).
+			 *
+			 *  0 1 2 3 4 5 6 7
+			 * +-+-+-+-+-+-+-+-+
+			 * |X|R|N|S|R| PID | (REQUIRED)
+			 * +-+-+-+-+-+-+-+-+
+			 * |I|L|T|K| RSV   | (OPTIONAL)
+			 * +-+-+-+-+-+-+-+-+
+			 * |M| PictureID   | (OPTIONAL)
+			 * +-+-+-+-+-+-+-+-+
+			 * |   PictureID   | (OPTIONAL, if M)
+			 * +-+-+-+-+-+-+-+-+
+			 * |   TL0PICIDX   | (OPTIONAL)
+			 * +-+-+-+-+-+-+-+-+
+			 * |TID|Y| KEYIDX  | (OPTIONAL)
+			 * +-+-+-+-+-+-+-+-+
+			 */
+			struct PayloadDescriptor
+			{
+				bool Parse(const uint8_t* data, size_t len);
+				void Encode(uint8_t* data, uint16_t pictureId, uint8_t tl0PicIdx) const;
+
+				// Mandatory fields.
+				bool extended{ false };
+				bool nonReference{ false };
+				bool start{ false };
+				uint8_t partitionIndex{ 0 };
+				// Optional fields.
+				bool hasPictureId{ false };
+				bool hasTwoBytesPictureId{ false };
+				bool hasTl0PicIdx{ false };
+				bool hasTlIndex{ false };
+				bool hasKeyIndex{ false };
+				uint16_t pictureId{ 0 };
+				uint8_t tl0PicIdx{ 0 };
+				uint8_t tlIndex{ 0 };
+				bool layerSync{ false };
+				uint8_t keyIndex{ 0 };
+				// Others.
+				size_t size{ 0 }; // Length of the descriptor.
+				bool isKeyFrame{ false };
+			};
+
+			/**
+			 * Drops the temporal layers above the target one. Picture IDs of the
+			 * forwarded frames are kept consecutive and, after Resync(), continue
+			 * from the last forwarded ones (i.e. when switching streams).
+			 */
+			class LayerSelector
+			{
+			public:
+				bool Select(const PayloadDescriptor& descriptor, uint16_t& pictureId, uint8_t& tl0PicIdx);
+				void SetTargetTemporalLayer(uint8_t temporalLayer);
+				uint8_t GetTargetTemporalLayer() const;
+				uint8_t GetCurrentTemporalLayer() const;
+				void Resync();
+
+			private:
+				uint8_t targetTemporalLayer{ 0 };
+				uint8_t currentTemporalLayer{ 0 };
+				// Picture of the last dropped packet.
+				bool droppingPicture{ false };
+				uint16_t droppedPictureId{ 0 };
+				// Rewriting.
+				bool resync{ true };
+				bool forwardedAny{ false };
+				uint16_t pictureIdOffset{ 0 };
+				uint8_t tl0PicIdxOffset{ 0 };
+				uint16_t lastPictureId{ 0 };
+				uint8_t lastTl0PicIdx{ 0 };
+			};
+
+		public:
+			static bool IsKeyFrame(const uint8_t* data, size_t len);
+		};
+
+		/* Inline methods. */
+
+		inline void VP8::LayerSelector::SetTargetTemporalLayer(uint8_t temporalLayer)
+		{
+			this->targetTemporalLayer = temporalLayer;
+		}
+
+		inline uint8_t VP8::LayerSelector::GetTargetTemporalLayer() const
+		{
+			return this->targetTemporalLayer;
+		}
+
+		inline uint8_t VP8::LayerSelector::GetCurrentTemporalLayer() const
+		{
+			return this->currentTemporalLayer;
+		}
+
+		inline void VP8::LayerSelector::Resync()
+		{
+			this->resync = true;
+		}
+	} // namespace Codecs
+} // namespace RTC
+
+#endif
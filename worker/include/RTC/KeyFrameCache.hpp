@@ -0,0 +1,55 @@
+#ifndef MS_RTC_KEY_FRAME_CACHE_HPP
+#define MS_RTC_KEY_FRAME_CACHE_HPP
+
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <json/json.h>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Keeps the packets of the most recent VP9 key frame and every packet
+	 * received after it, so a new subscriber can start decoding right away
+	 * instead of waiting for the publisher to answer a PLI.
+	 */
+	class KeyFrameCache
+	{
+	private:
+		struct StorageItem
+		{
+			uint8_t store[RTC::MtuSize];
+		};
+
+		struct CacheItem
+		{
+			uint32_t seq32{ 0 };
+			RTC::RtpPacket* packet{ nullptr };
+		};
+
+	public:
+		static bool IsKeyFrameStart(RTC::RtpPacket* packet);
+
+	public:
+		explicit KeyFrameCache(size_t maxPackets);
+		~KeyFrameCache();
+
+		Json::Value ToJson() const;
+		void ReceivePacket(RTC::RtpPacket* packet);
+		bool GetPackets(std::vector<RTC::RtpPacket*>& packets) const;
+		void Clear();
+
+	private:
+		void StorePacket(RTC::RtpPacket* packet);
+
+	private:
+		// Allocated by this.
+		std::vector<StorageItem> storage;
+		// Others.
+		size_t maxPackets{ 0 };
+		std::vector<CacheItem> items;
+		size_t keyFramesCached{ 0 };
+	};
+} // namespace RTC
+
+#endif
@@ -3,13 +3,13 @@
 
 #include "common.hpp"
 #include "RTC/RtpPacket.hpp"
-#include "handles/Timer.hpp"
+#include "handles/TimerWheel.hpp"
 #include <map>
 #include <vector>
 
 namespace RTC
 {
-	class NackGenerator : public Timer::Listener
+	class NackGenerator : public TimerWheel::Listener
 	{
 	public:
 		class Listener
@@ -46,18 +46,17 @@ namespace RTC
 	private:
 		void AddPacketsToNackList(uint32_t seq32Start, uint32_t seq32End);
 		std::vector<uint16_t> GetNackBatch(NackFilter filter);
-		void MayRunTimer() const;
+		void MayRunTimer();
 
-		/* Pure virtual methods inherited from Timer::Listener. */
+		/* Pure virtual methods inherited from TimerWheel::Listener. */
 	public:
-		void OnTimer(Timer* timer) override;
+		void OnTimer(TimerWheel::Handle* handle) override;
 
 	private:
 		// Passed by argument.
 		Listener* listener{ nullptr };
-		// Allocated by this.
-		Timer* timer{ nullptr };
 		// Others.
+		TimerWheel::Handle timer{ this };
 		std::map<uint32_t, NackInfo> nackList;
 		bool started{ false };
 		uint32_t lastSeq32{ 0 }; // Extended seq number of last valid packet.
@@ -0,0 +1,117 @@
+#ifndef MS_RTC_PACER_HPP
+#define MS_RTC_PACER_HPP
+
+#include "common.hpp"
+#include "RTC/RtpDataCounter.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "handles/Timer.hpp"
+#include <json/json.h>
+#include <deque>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Token bucket that paces the RTP packets sent by a Transport according to
+	 * the estimated available bitrate. Audio is never delayed, retransmissions
+	 * go before video and are limited to a percentage of the media bitrate.
+	 * Bursts of cached key frames are paced even if there is no estimation.
+	 */
+	class Pacer : public Timer::Listener
+	{
+	public:
+		/**
+		 * RTC::Transport is the Listener.
+		 */
+		class Listener
+		{
+		public:
+			virtual void OnPacerRtpPacket(RTC::Pacer* pacer, RTC::RtpPacket* packet) = 0;
+		};
+
+	public:
+		enum class Priority : uint8_t
+		{
+			AUDIO = 0,
+			RETRANSMISSION,
+			VIDEO,
+			KEY_FRAME // Video replayed from a key frame cache.
+		};
+
+	private:
+		struct StorageItem
+		{
+			uint8_t store[RTC::MtuSize];
+		};
+
+		struct QueueItem
+		{
+			StorageItem* storage{ nullptr };
+			RTC::RtpPacket* packet{ nullptr };
+			uint64_t queuedAt{ 0 };
+		};
+
+	public:
+		Pacer(Listener* listener, uint32_t retransmissionBudget);
+		~Pacer() override;
+
+		Json::Value ToJson() const;
+		void SetBitrate(uint32_t bitrate);
+		uint32_t GetBitrate() const;
+		void SendRtpPacket(RTC::RtpPacket* packet, Priority priority);
+
+	private:
+		uint32_t GetPacingBitrate() const;
+		void SetBucketSize(uint32_t bitrate);
+		void StartBurst(uint64_t now);
+		void Refill(uint64_t now);
+		bool IsRetransmissionAllowed(uint64_t now);
+		void Send(RTC::RtpPacket* packet, bool isRetransmission, uint64_t now);
+		void Enqueue(std::deque<QueueItem>& queue, RTC::RtpPacket* packet, uint64_t now);
+		void Dequeue(std::deque<QueueItem>& queue, bool isRetransmission, uint64_t now);
+		void Drain();
+		void ReleaseItem(QueueItem& item);
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		uint32_t retransmissionBudget{ 0 }; // Percentage of the media bitrate.
+		// Allocated by this.
+		Timer* timer{ nullptr };
+		std::vector<StorageItem*> freeStorage;
+		// Others.
+		uint32_t bitrate{ 0 };      // 0 means not paced.
+		uint32_t burstBitrate{ 0 }; // Used for key frame bursts if not paced.
+		int64_t tokens{ 0 };   // Bytes that can be sent right now.
+		int64_t bucketSize{ 0 };
+		uint64_t lastRefillAt{ 0 };
+		std::deque<QueueItem> retransmissionQueue;
+		std::deque<QueueItem> videoQueue;
+		RTC::RtpDataCounter mediaCounter;
+		RTC::RtpDataCounter retransmissionCounter;
+		// Stats.
+		uint64_t packetsQueued{ 0 };
+		uint64_t packetsDropped{ 0 };
+		uint64_t retransmissionsDropped{ 0 };
+		uint64_t totalQueueDelay{ 0 };
+		uint64_t maxQueueDelay{ 0 };
+	};
+
+	/* Inline methods. */
+
+	inline uint32_t Pacer::GetBitrate() const
+	{
+		return this->bitrate;
+	}
+
+	inline uint32_t Pacer::GetPacingBitrate() const
+	{
+		return this->bitrate != 0u ? this->bitrate : this->burstBitrate;
+	}
+} // namespace RTC
+
+#endif
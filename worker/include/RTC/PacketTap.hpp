@@ -0,0 +1,93 @@
+#ifndef MS_RTC_PACKET_TAP_HPP
+#define MS_RTC_PACKET_TAP_HPP
+
+#include "common.hpp"
+#include <json/json.h>
+#include <atomic>
+#include <string>
+
+namespace RTC
+{
+	/**
+	 * Single producer single consumer ring in shared memory into which the
+	 * worker copies received RTP packets for an external reader (a recorder,
+	 * a transcriber...) which opens GetPath() and maps it.
+	 *
+	 * Layout (native endianness):
+	 *
+	 *   0:   magic (uint32), version (uint32), data size (uint64).
+	 *   64:  write position (uint64), dropped packets (uint64). Producer side.
+	 *   128: read position (uint64). Consumer side.
+	 *   256: data.
+	 *
+	 * Positions only grow, the offset into the data being position % data size.
+	 * Every record is a Record header followed by the packet, padded to 8 bytes.
+	 * A record never wraps: if fewer than sizeof(Record) bytes are left before
+	 * the end of the data, or the record there has WrapLength as length, the
+	 * next one is at offset 0. The reader must load the write position with
+	 * acquire semantics and store the read position with release semantics.
+	 */
+	class PacketTap
+	{
+	public:
+		static constexpr uint32_t Magic{ 0x4D535450 }; // "MSTP".
+		static constexpr uint32_t Version{ 1 };
+		static constexpr size_t DataOffset{ 256 };
+		static constexpr uint32_t WrapLength{ 0xFFFFFFFF };
+
+	public:
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint64_t dataSize;
+			uint8_t pad1[48];
+			std::atomic<uint64_t> writePos;
+			std::atomic<uint64_t> dropped;
+			uint8_t pad2[48];
+			std::atomic<uint64_t> readPos;
+		};
+
+		struct Record
+		{
+			uint32_t rtpReceiverId;
+			uint32_t length;
+			uint64_t arrivalTime; // Milliseconds.
+		};
+
+	public:
+		explicit PacketTap(size_t dataSize);
+		~PacketTap();
+
+		Json::Value ToJson() const;
+		const std::string& GetPath() const;
+		size_t GetSize() const;
+		bool Write(uint32_t rtpReceiverId, uint64_t arrivalTime, const uint8_t* data, size_t len);
+
+	private:
+		// Allocated by this.
+		int fd{ -1 };
+		uint8_t* memory{ nullptr };
+		// Others.
+		std::string path;
+		size_t size{ 0 };
+		Header* header{ nullptr };
+		uint8_t* data{ nullptr };
+		uint64_t dataSize{ 0 };
+		size_t written{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline const std::string& PacketTap::GetPath() const
+	{
+		return this->path;
+	}
+
+	inline size_t PacketTap::GetSize() const
+	{
+		return this->size;
+	}
+} // namespace RTC
+
+#endif
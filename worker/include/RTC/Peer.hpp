@@ -2,8 +2,10 @@
 #define MS_RTC_PEER_HPP
 
 #include "common.hpp"
+#include "Channel/DumpWriter.hpp"
 #include "Channel/Notifier.hpp"
 #include "Channel/Request.hpp"
+#include "RTC/BitrateAllocator.hpp"
 #include "RTC/RTCP/Feedback.hpp"
 #include "RTC/RTCP/ReceiverReport.hpp"
 #include "RTC/RTCP/SenderReport.hpp"
@@ -11,8 +13,9 @@
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpReceiver.hpp"
 #include "RTC/RtpSender.hpp"
+#include "RTC/StatsSnapshot.hpp"
 #include "RTC/Transport.hpp"
-#include "handles/Timer.hpp"
+#include "handles/TimerWheel.hpp"
 #include <json/json.h>
 #include <string>
 #include <unordered_map>
@@ -23,7 +26,8 @@ namespace RTC
 	class Peer : public RTC::Transport::Listener,
 	             public RTC::RtpReceiver::Listener,
 	             public RTC::RtpSender::Listener,
-	             public Timer::Listener
+	             public TimerWheel::Listener,
+	             public Channel::DumpWriter::Listener
 	{
 	public:
 		class Listener
@@ -43,22 +47,50 @@ namespace RTC
 			    const RTC::Peer* peer, RTC::RtpSender* rtpSender, RTC::RTCP::FeedbackPsPacket* packet) = 0;
 			virtual void OnPeerRtcpFeedback(
 			    const RTC::Peer* peer, RTC::RtpSender* rtpSender, RTC::RTCP::FeedbackRtpPacket* packet) = 0;
+			virtual void OnPeerRtcpNackNotServed(
+			    const RTC::Peer* peer,
+			    RTC::RtpSender* rtpSender,
+			    uint32_t ssrc,
+			    const std::vector<uint16_t>& seqNumbers) = 0;
 			virtual void OnPeerRtcpSenderReport(
 			    const RTC::Peer* peer, RTC::RtpReceiver* rtpReceiver, RTC::RTCP::SenderReport* report) = 0;
 			virtual void OnFullFrameRequired(RTC::Peer* peer, RTC::RtpSender* rtpSender) = 0;
 		};
 
+	public:
+		// The Peer itself or one of its entities, dumped in a step of a dump.
+		struct DumpStep
+		{
+			enum class Kind
+			{
+				PEER = 1,
+				TRANSPORT,
+				RTP_RECEIVER,
+				RTP_SENDER
+			};
+
+			Kind kind;
+			uint32_t id;
+		};
+
 	public:
 		Peer(Listener* listener, Channel::Notifier* notifier, uint32_t peerId, std::string& peerName);
 
 	private:
-		~Peer() override;
+		virtual ~Peer();
 
 	public:
 		void Destroy();
-		Json::Value ToJson() const;
+		Json::Value ToJson(bool withEntities = true) const;
+		std::vector<DumpStep> GetDumpSteps() const;
+		void FillDumpStep(const DumpStep& step, Json::Value& data) const;
+		void FillStats(
+		    RTC::StatsSnapshot& snapshot,
+		    uint64_t now,
+		    const RTC::Transport* transport = nullptr) const;
 		void HandleRequest(Channel::Request* request);
 		bool HasCapabilities() const;
+		const RTC::RtpCapabilities& GetCapabilities() const;
 		std::vector<RTC::RtpReceiver*> GetRtpReceivers() const;
 		std::vector<RTC::RtpSender*> GetRtpSenders() const;
 		const std::unordered_map<uint32_t, RTC::Transport*>& GetTransports() const;
@@ -70,7 +102,7 @@ namespace RTC
 		void AddRtpSender(
 		    RTC::RtpSender* rtpSender, RTC::RtpParameters* rtpParameters, uint32_t associatedRtpReceiverId);
 		RTC::RtpSender* GetRtpSender(uint32_t ssrc) const;
-		void SendRtcp(uint64_t now);
+		void AllocateBitrate();
 
 	private:
 		RTC::Transport* GetTransportFromRequest(
@@ -79,13 +111,16 @@ namespace RTC
 		    Channel::Request* request, uint32_t* rtpReceiverId = nullptr) const;
 		RTC::RtpSender* GetRtpSenderFromRequest(
 		    Channel::Request* request, uint32_t* rtpSenderId = nullptr) const;
+		void AllocateBitrate(RTC::Transport* transport);
 
 		/* Pure virtual methods inherited from RTC::Transport::Listener. */
 	public:
 		void OnTransportConnected(RTC::Transport* transport) override;
 		void OnTransportClosed(RTC::Transport* transport) override;
-		void OnTransportRtcpPacket(RTC::Transport* transport, RTC::RTCP::Packet* packet) override;
+		void OnTransportRtcpPacket(
+		    RTC::Transport* transport, const RTC::RTCP::CompoundPacketView& compoundPacket) override;
 		void OnTransportFullFrameRequired(RTC::Transport* transport) override;
+		void OnTransportAvailableBitrateChange(RTC::Transport* transport, uint32_t availableBitrate) override;
 
 		/* Pure virtual methods inherited from RTC::RtpReceiver::Listener. */
 	public:
@@ -98,10 +133,15 @@ namespace RTC
 	public:
 		void OnRtpSenderClosed(RTC::RtpSender* rtpSender) override;
 		void OnRtpSenderFullFrameRequired(RTC::RtpSender* rtpSender) override;
+		void OnRtpSenderBitrateAllocationRequired(RTC::RtpSender* rtpSender) override;
 
-		/* Pure virtual methods inherited from Timer::Listener. */
+		/* Pure virtual methods inherited from TimerWheel::Listener. */
 	public:
-		void OnTimer(Timer* timer) override;
+		void OnTimer(TimerWheel::Handle* handle) override;
+
+		/* Pure virtual methods inherited from Channel::DumpWriter::Listener. */
+	public:
+		bool OnDumpWriterStep(Channel::DumpWriter* dumpWriter, size_t step, Json::Value& data) override;
 
 	public:
 		// Passed by argument.
@@ -113,12 +153,17 @@ namespace RTC
 		Listener* listener{ nullptr };
 		Channel::Notifier* notifier{ nullptr };
 		// Others.
-		Timer* timer{ nullptr };
+		// Allocates the bitrate of every Transport again once the layer bitrates
+		// of the RtpSenders have been updated.
+		TimerWheel::Handle allocationTimer{ this };
 		bool hasCapabilities{ false };
 		RTC::RtpCapabilities capabilities;
 		std::unordered_map<uint32_t, RTC::Transport*> transports;
 		std::unordered_map<uint32_t, RTC::RtpReceiver*> rtpReceivers;
 		std::unordered_map<uint32_t, RTC::RtpSender*> rtpSenders;
+		std::vector<RTC::BitrateAllocator::Stream> allocatedStreams;
+		// Ongoing dumps with the entities they dump, one per step.
+		std::unordered_map<Channel::DumpWriter*, std::vector<DumpStep>> dumpWriters;
 	};
 
 	/* Inline methods. */
@@ -128,6 +173,11 @@ namespace RTC
 		return this->hasCapabilities;
 	}
 
+	inline const RTC::RtpCapabilities& Peer::GetCapabilities() const
+	{
+		return this->capabilities;
+	}
+
 	inline std::vector<RTC::RtpReceiver*> Peer::GetRtpReceivers() const
 	{
 		std::vector<RTC::RtpReceiver*> rtpReceivers;
@@ -77,15 +77,16 @@ namespace RTC
 		public:
 			enum class MessageType : uint8_t
 			{
-				NACK   = 1,
-				TMMBR  = 3,
-				TMMBN  = 4,
-				SR_REQ = 5,
-				RAMS   = 6,
-				TLLEI  = 7,
-				ECN    = 8,
-				PS     = 9,
-				EXT    = 31
+				NACK      = 1,
+				TMMBR     = 3,
+				TMMBN     = 4,
+				SR_REQ    = 5,
+				RAMS      = 6,
+				TLLEI     = 7,
+				ECN       = 8,
+				PS        = 9,
+				TRANSPORT = 15,
+				EXT       = 31
 			};
 		};
 
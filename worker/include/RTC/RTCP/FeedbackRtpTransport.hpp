@@ -0,0 +1,153 @@
+#ifndef MS_RTC_RTCP_FEEDBACK_RTP_TRANSPORT_HPP
+#define MS_RTC_RTCP_FEEDBACK_RTP_TRANSPORT_HPP
+
+#include "common.hpp"
+#include "RTC/RTCP/FeedbackRtp.hpp"
+#include <vector>
+
+/* draft-holmer-rmcat-transport-wide-cc-extensions-01
+ * RTCP message for transport-wide congestion control feedback
+
+    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   |V=2|P|  FMT=15 |    PT=205     |           length              |
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+0  |                     SSRC of packet sender                     |
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+4  |                      SSRC of media source                     |
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+8  |      base sequence number     |      packet status count      |
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+12 |                 reference time                | fb pkt. count |
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+16 |          packet chunk         |         packet chunk          |
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   .                                                               .
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   |         packet chunk          |  recv delta   |  recv delta   |
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   .                                                               .
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+   |           recv delta          |  recv delta   | zero padding  |
+   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ */
+
+namespace RTC
+{
+	namespace RTCP
+	{
+		class FeedbackRtpTransportPacket : public FeedbackRtpPacket
+		{
+		public:
+			enum class Status : uint8_t
+			{
+				NOT_RECEIVED = 0,
+				SMALL_DELTA  = 1,
+				LARGE_DELTA  = 2
+			};
+
+			struct PacketResult
+			{
+				uint16_t sequenceNumber{ 0 };
+				bool received{ false };
+				int64_t receivedAt{ 0 }; // Arrival time (ms) in the reference time base.
+			};
+
+		public:
+			static const FeedbackRtp::MessageType messageType{ FeedbackRtp::MessageType::TRANSPORT };
+			// Reference time unit (ms).
+			static constexpr int64_t ReferenceTimeUnit{ 64 };
+			// Receive delta unit (us).
+			static constexpr int64_t DeltaUnit{ 250 };
+
+		public:
+			static FeedbackRtpTransportPacket* Parse(const uint8_t* data, size_t len);
+			static bool ParsePacketResults(
+			    const uint8_t* data, size_t len, std::vector<PacketResult>& results);
+
+		public:
+			// Parsed Report. Points to an external data.
+			explicit FeedbackRtpTransportPacket(CommonHeader* commonHeader);
+			FeedbackRtpTransportPacket(uint32_t senderSsrc, uint32_t mediaSsrc);
+			~FeedbackRtpTransportPacket() override = default;
+
+			bool IsCorrect() const;
+			uint16_t GetBaseSequenceNumber() const;
+			uint16_t GetPacketStatusCount() const;
+			uint32_t GetReferenceTime() const;
+			uint8_t GetFeedbackPacketCount() const;
+			void SetBase(uint16_t baseSequenceNumber, uint32_t referenceTime, uint8_t feedbackPacketCount);
+			bool AddPacket(bool received, int32_t delta);
+			void GetPacketResults(std::vector<PacketResult>& results) const;
+
+			/* Pure virtual methods inherited from Packet. */
+		public:
+			void Dump() const override;
+			size_t Serialize(uint8_t* buffer) override;
+			size_t GetSize() const override;
+
+		private:
+			size_t FillChunks(uint8_t* buffer) const;
+
+		private:
+			uint16_t baseSequenceNumber{ 0 };
+			uint32_t referenceTime{ 0 }; // 24 bits, in ReferenceTimeUnit.
+			uint8_t feedbackPacketCount{ 0 };
+			std::vector<Status> statuses;
+			std::vector<int16_t> deltas; // One per received packet, in DeltaUnit.
+			size_t deltasSize{ 0 };
+			bool isCorrect{ true };
+		};
+
+		/* Inline instance methods. */
+
+		inline FeedbackRtpTransportPacket::FeedbackRtpTransportPacket(
+		    uint32_t senderSsrc, uint32_t mediaSsrc)
+		    : FeedbackRtpPacket(messageType, senderSsrc, mediaSsrc)
+		{
+		}
+
+		inline bool FeedbackRtpTransportPacket::IsCorrect() const
+		{
+			return this->isCorrect;
+		}
+
+		inline uint16_t FeedbackRtpTransportPacket::GetBaseSequenceNumber() const
+		{
+			return this->baseSequenceNumber;
+		}
+
+		inline uint16_t FeedbackRtpTransportPacket::GetPacketStatusCount() const
+		{
+			return static_cast<uint16_t>(this->statuses.size());
+		}
+
+		inline uint32_t FeedbackRtpTransportPacket::GetReferenceTime() const
+		{
+			return this->referenceTime;
+		}
+
+		inline uint8_t FeedbackRtpTransportPacket::GetFeedbackPacketCount() const
+		{
+			return this->feedbackPacketCount;
+		}
+
+		inline void FeedbackRtpTransportPacket::SetBase(
+		    uint16_t baseSequenceNumber, uint32_t referenceTime, uint8_t feedbackPacketCount)
+		{
+			this->baseSequenceNumber  = baseSequenceNumber;
+			this->referenceTime       = referenceTime & 0x00FFFFFF;
+			this->feedbackPacketCount = feedbackPacketCount;
+		}
+
+		inline size_t FeedbackRtpTransportPacket::GetSize() const
+		{
+			size_t size = FeedbackRtpPacket::GetSize() + 8 + (FillChunks(nullptr) * 2) + this->deltasSize;
+
+			// Pad to 32 bits.
+			return (size + 3) & ~static_cast<size_t>(3);
+		}
+	} // namespace RTCP
+} // namespace RTC
+
+#endif
@@ -0,0 +1,282 @@
+#ifndef MS_RTC_RTCP_PACKET_VIEW_HPP
+#define MS_RTC_RTCP_PACKET_VIEW_HPP
+
+#include "common.hpp"
+#include "Utils.hpp"
+#include "RTC/RTCP/Feedback.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include "RTC/RTCP/Packet.hpp"
+#include "RTC/RTCP/ReceiverReport.hpp"
+#include "RTC/RTCP/SenderReport.hpp"
+
+namespace RTC
+{
+	namespace RTCP
+	{
+		/**
+		 * Non-owning view of a single RTCP packet. Accessors read the packet in
+		 * place, nothing is allocated. Those of a given type must only be called
+		 * on packets of that type.
+		 */
+		class PacketView
+		{
+		public:
+			PacketView() = default;
+			PacketView(const uint8_t* data, size_t len);
+
+			bool IsValid() const;
+			Type GetType() const;
+			uint8_t GetCount() const;
+			Packet::CommonHeader* GetHeader() const;
+			const uint8_t* GetData() const;
+			size_t GetSize() const;
+			// SR, RR and feedback.
+			uint32_t GetSsrc() const;
+			// SR.
+			SenderReport::Header* GetSenderReport() const;
+			// SR and RR.
+			size_t GetReceiverReportCount() const;
+			ReceiverReport::Header* GetReceiverReport(size_t idx) const;
+			// RTPFB and PSFB.
+			FeedbackRtp::MessageType GetRtpFeedbackType() const;
+			FeedbackPs::MessageType GetPsFeedbackType() const;
+			uint32_t GetMediaSsrc() const;
+			// RTPFB NACK.
+			size_t GetNackItemCount() const;
+			uint16_t GetNackPacketId(size_t idx) const;
+			uint16_t GetNackLostPacketBitmask(size_t idx) const;
+			// RTPFB transport feedback.
+			bool GetTransportFeedbackResults(
+			    std::vector<FeedbackRtpTransportPacket::PacketResult>& results) const;
+			// PSFB FIR.
+			size_t GetFirItemCount() const;
+			uint32_t GetFirItemSsrc(size_t idx) const;
+			uint8_t GetFirItemSequenceNumber(size_t idx) const;
+			// PSFB REMB.
+			bool IsRemb() const;
+			uint64_t GetRembBitrate() const;
+			size_t GetRembSsrcCount() const;
+
+		private:
+			uint8_t* data{ nullptr };
+			size_t size{ 0 };
+		};
+
+		/**
+		 * Walks a compound RTCP packet in place. Iteration stops at the first
+		 * invalid packet, those before it are still given.
+		 */
+		class CompoundPacketView
+		{
+		public:
+			class Iterator
+			{
+			public:
+				Iterator() = default;
+				Iterator(const uint8_t* data, size_t len);
+
+				const PacketView& operator*() const;
+				const PacketView* operator->() const;
+				Iterator& operator++();
+				bool operator==(const Iterator& other) const;
+				bool operator!=(const Iterator& other) const;
+
+			private:
+				void Load();
+
+			private:
+				const uint8_t* data{ nullptr };
+				size_t len{ 0 };
+				PacketView packet;
+			};
+
+		public:
+			CompoundPacketView(const uint8_t* data, size_t len);
+
+			bool IsValid() const;
+			Iterator Begin() const;
+			Iterator End() const;
+
+		private:
+			const uint8_t* data{ nullptr };
+			size_t len{ 0 };
+		};
+
+		/* Inline instance methods. */
+
+		inline PacketView::PacketView(const uint8_t* data, size_t len)
+		    : data(const_cast<uint8_t*>(data)), size(len)
+		{
+		}
+
+		inline Type PacketView::GetType() const
+		{
+			return Type(GetHeader()->packetType);
+		}
+
+		inline uint8_t PacketView::GetCount() const
+		{
+			return GetHeader()->count;
+		}
+
+		inline Packet::CommonHeader* PacketView::GetHeader() const
+		{
+			return reinterpret_cast<Packet::CommonHeader*>(this->data);
+		}
+
+		inline const uint8_t* PacketView::GetData() const
+		{
+			return this->data;
+		}
+
+		inline size_t PacketView::GetSize() const
+		{
+			return this->size;
+		}
+
+		inline uint32_t PacketView::GetSsrc() const
+		{
+			return Utils::Byte::Get4Bytes(this->data, sizeof(Packet::CommonHeader));
+		}
+
+		inline SenderReport::Header* PacketView::GetSenderReport() const
+		{
+			return reinterpret_cast<SenderReport::Header*>(this->data + sizeof(Packet::CommonHeader));
+		}
+
+		inline size_t PacketView::GetReceiverReportCount() const
+		{
+			return GetCount();
+		}
+
+		inline ReceiverReport::Header* PacketView::GetReceiverReport(size_t idx) const
+		{
+			// Report blocks follow the sender info in a SR, the sender SSRC in a RR.
+			size_t offset = sizeof(Packet::CommonHeader) +
+			                (GetType() == Type::SR ? sizeof(SenderReport::Header) : sizeof(uint32_t));
+
+			return reinterpret_cast<ReceiverReport::Header*>(
+			    this->data + offset + (idx * sizeof(ReceiverReport::Header)));
+		}
+
+		inline FeedbackRtp::MessageType PacketView::GetRtpFeedbackType() const
+		{
+			return FeedbackRtp::MessageType(GetCount());
+		}
+
+		inline FeedbackPs::MessageType PacketView::GetPsFeedbackType() const
+		{
+			return FeedbackPs::MessageType(GetCount());
+		}
+
+		inline uint32_t PacketView::GetMediaSsrc() const
+		{
+			return Utils::Byte::Get4Bytes(this->data, sizeof(Packet::CommonHeader) + 4);
+		}
+
+		inline size_t PacketView::GetNackItemCount() const
+		{
+			return (this->size - sizeof(Packet::CommonHeader) - sizeof(FeedbackRtpPacket::Header)) / 4;
+		}
+
+		inline uint16_t PacketView::GetNackPacketId(size_t idx) const
+		{
+			return Utils::Byte::Get2Bytes(
+			    this->data, sizeof(Packet::CommonHeader) + sizeof(FeedbackRtpPacket::Header) + (idx * 4));
+		}
+
+		inline uint16_t PacketView::GetNackLostPacketBitmask(size_t idx) const
+		{
+			return Utils::Byte::Get2Bytes(
+			    this->data,
+			    sizeof(Packet::CommonHeader) + sizeof(FeedbackRtpPacket::Header) + (idx * 4) + 2);
+		}
+
+		inline bool PacketView::GetTransportFeedbackResults(
+		    std::vector<FeedbackRtpTransportPacket::PacketResult>& results) const
+		{
+			return FeedbackRtpTransportPacket::ParsePacketResults(this->data, this->size, results);
+		}
+
+		inline size_t PacketView::GetFirItemCount() const
+		{
+			// SSRC, sequence number and reserved bytes.
+			return (this->size - sizeof(Packet::CommonHeader) - sizeof(FeedbackPsPacket::Header)) / 8;
+		}
+
+		inline uint32_t PacketView::GetFirItemSsrc(size_t idx) const
+		{
+			return Utils::Byte::Get4Bytes(
+			    this->data, sizeof(Packet::CommonHeader) + sizeof(FeedbackPsPacket::Header) + (idx * 8));
+		}
+
+		inline uint8_t PacketView::GetFirItemSequenceNumber(size_t idx) const
+		{
+			return this->data
+			    [sizeof(Packet::CommonHeader) + sizeof(FeedbackPsPacket::Header) + (idx * 8) + 4];
+		}
+
+		inline size_t PacketView::GetRembSsrcCount() const
+		{
+			return this->data[sizeof(Packet::CommonHeader) + sizeof(FeedbackPsPacket::Header) + 4];
+		}
+
+		inline CompoundPacketView::Iterator::Iterator(const uint8_t* data, size_t len)
+		    : data(data), len(len)
+		{
+			Load();
+		}
+
+		inline const PacketView& CompoundPacketView::Iterator::operator*() const
+		{
+			return this->packet;
+		}
+
+		inline const PacketView* CompoundPacketView::Iterator::operator->() const
+		{
+			return &this->packet;
+		}
+
+		inline CompoundPacketView::Iterator& CompoundPacketView::Iterator::operator++()
+		{
+			this->data += this->packet.GetSize();
+			this->len -= this->packet.GetSize();
+
+			Load();
+
+			return *this;
+		}
+
+		inline bool CompoundPacketView::Iterator::operator==(const Iterator& other) const
+		{
+			return this->data == other.data;
+		}
+
+		inline bool CompoundPacketView::Iterator::operator!=(const Iterator& other) const
+		{
+			return this->data != other.data;
+		}
+
+		inline CompoundPacketView::CompoundPacketView(const uint8_t* data, size_t len)
+		    : data(data), len(len)
+		{
+		}
+
+		inline bool CompoundPacketView::IsValid() const
+		{
+			return Begin() != End();
+		}
+
+		inline CompoundPacketView::Iterator CompoundPacketView::Begin() const
+		{
+			return Iterator(this->data, this->len);
+		}
+
+		inline CompoundPacketView::Iterator CompoundPacketView::End() const
+		{
+			return Iterator();
+		}
+	} // namespace RTCP
+} // namespace RTC
+
+#endif
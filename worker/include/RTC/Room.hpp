@@ -2,8 +2,10 @@
 #define MS_RTC_ROOM_HPP
 
 #include "common.hpp"
+#include "Channel/DumpWriter.hpp"
 #include "Channel/Notifier.hpp"
 #include "Channel/Request.hpp"
+#include "RTC/ActiveSpeakerDetector.hpp"
 #include "RTC/Peer.hpp"
 #include "RTC/RTCP/Feedback.hpp"
 #include "RTC/RTCP/ReceiverReport.hpp"
@@ -17,14 +19,14 @@
 #include <json/json.h>
 #include <unordered_map>
 #include <unordered_set>
-#include <map>
+#include <utility>
 #include <vector>
 
-namespace VP9{class VP9LayerSelector; class VP9AudioLevelSelector;}
-
 namespace RTC
 {
-	class Room : public RTC::Peer::Listener, public Timer::Listener
+	class Room : public RTC::Peer::Listener,
+	             public Timer::Listener,
+	             public Channel::DumpWriter::Listener
 	{
 	public:
 		class Listener
@@ -33,6 +35,23 @@ namespace RTC
 			virtual void OnRoomClosed(RTC::Room* room) = 0;
 		};
 
+	private:
+		// Video stream sent to a Peer with the video of the dominant speaker by a
+		// single RtpSender. Its source RtpReceiver is switched to the target one
+		// on a key frame.
+		struct ActiveSpeakerStream
+		{
+			const RTC::Peer* peer{ nullptr };
+			RTC::RtpParameters* rtpParameters{ nullptr };
+			RTC::RtpCodecMime mime;
+			uint8_t payloadType{ 0 };
+			const RTC::RtpReceiver* source{ nullptr };
+			uint32_t sourceSsrc{ 0 };
+			const RTC::RtpReceiver* target{ nullptr };
+			uint32_t targetSsrc{ 0 };
+			uint64_t lastKeyFrameRequestAt{ 0 };
+		};
+
 	public:
 		static void ClassInit();
 
@@ -48,15 +67,36 @@ namespace RTC
 
 	public:
 		void Destroy();
-		Json::Value ToJson() const;
+		Json::Value ToJson(bool withPeers = true) const;
 		void HandleRequest(Channel::Request* request);
 		const RTC::RtpCapabilities& GetCapabilities() const;
 
 	private:
 		RTC::Peer* GetPeerFromRequest(Channel::Request* request, uint32_t* peerId = nullptr) const;
 		void SetCapabilities(std::vector<RTC::RtpCodecParameters>& mediaCodecs);
-		void AddRtpSenderForRtpReceiver(RTC::Peer* senderPeer, const RTC::RtpReceiver* rtpReceiver);
-        std::string peerByReceiver(const RTC::RtpReceiver* rtpReceiver) const;
+		void AddRtpSenderForRtpReceiver(
+		    RTC::Peer* senderPeer, const RTC::Peer* receiverPeer, const RTC::RtpReceiver* rtpReceiver);
+		const RTC::Peer* GetPeerFromRtpReceiver(const RTC::RtpReceiver* rtpReceiver) const;
+		bool IsSpeakerDetectionEnabled() const;
+		void UpdateSpeakerDetection(bool wasEnabled);
+		void UpdateDominantSpeaker();
+		void UpdateLastNAudio(const RTC::RtpReceiver* rtpReceiver, uint64_t now);
+		bool PauseLeastActiveAudio();
+		bool IsLastNAudioCandidate(const RTC::RtpReceiver* rtpReceiver, uint64_t now);
+		void ResumeRtpSenders(const RTC::RtpReceiver* rtpReceiver);
+		void UpdateLastNVideo(const RTC::Peer* peer, uint64_t now);
+		bool PauseLeastActiveVideo();
+		void FillLastNVideo();
+		void SetPeerVideoPaused(const RTC::Peer* peer, bool paused);
+		void AllocateBitrate();
+		void UpdateActiveSpeakerRtpSenders();
+		RTC::RtpSender* CreateActiveSpeakerRtpSender(RTC::Peer* peer);
+		const RTC::RtpReceiver* GetActiveSpeakerSource(const ActiveSpeakerStream& stream) const;
+		void UpdateActiveSpeakerStreams();
+		void UpdateActiveSpeakerStream(RTC::RtpSender* rtpSender, ActiveSpeakerStream& stream);
+		void SwitchActiveSpeakerSource(
+		    RTC::RtpSender* rtpSender, ActiveSpeakerStream& stream, uint32_t ssrc);
+		void SendActiveSpeakerRtpPacket(const RTC::RtpReceiver* rtpReceiver, RTC::RtpPacket* packet);
 
 		/* Pure virtual methods inherited from RTC::Peer::Listener. */
 	public:
@@ -73,6 +113,11 @@ namespace RTC
 		    const RTC::Peer* peer, RTC::RtpSender* rtpSender, RTC::RTCP::FeedbackPsPacket* packet) override;
 		void OnPeerRtcpFeedback(
 		    const RTC::Peer* peer, RTC::RtpSender* rtpSender, RTC::RTCP::FeedbackRtpPacket* packet) override;
+		void OnPeerRtcpNackNotServed(
+		    const RTC::Peer* peer,
+		    RTC::RtpSender* rtpSender,
+		    uint32_t ssrc,
+		    const std::vector<uint16_t>& seqNumbers) override;
 		void OnPeerRtcpSenderReport(
 		    const RTC::Peer* peer, RTC::RtpReceiver* rtpReceiver, RTC::RTCP::SenderReport* report) override;
 		void OnFullFrameRequired(RTC::Peer* peer, RTC::RtpSender* rtpSender) override;
@@ -81,6 +126,10 @@ namespace RTC
 	public:
 		void OnTimer(Timer* timer) override;
 
+		/* Pure virtual methods inherited from Channel::DumpWriter::Listener. */
+	public:
+		bool OnDumpWriterStep(Channel::DumpWriter* dumpWriter, size_t step, Json::Value& data) override;
+
 	public:
 		// Passed by argument.
 		uint32_t roomId{ 0 };
@@ -96,22 +145,28 @@ namespace RTC
 		std::unordered_map<uint32_t, RTC::Peer*> peers;
 		std::unordered_map<const RTC::RtpReceiver*, std::unordered_set<RTC::RtpSender*>> mapRtpReceiverRtpSenders;
 		std::unordered_map<const RTC::RtpSender*, const RTC::RtpReceiver*> mapRtpSenderRtpReceiver;
-        std::unordered_map<const RTC::RtpReceiver*, VP9::VP9LayerSelector*> mapRtpReceiverLayerSelector;
-        std::unordered_map<const RTC::RtpReceiver*, VP9::VP9AudioLevelSelector*> mapRtpReceiverAudioLevelSelector;
-        struct AudioLevelInfo
-        {
-            std::vector<int8_t> currentTmpValues;
-            int8_t minValue { 127 };
-            int8_t maxValue { -127 };
-            int8_t value;
-            int8_t normalizedValue;
-        };
-        std::unordered_map<const RTC::RtpReceiver*, AudioLevelInfo> mapRtpReceiverAudioLevels;
-        std::map<int, const RTC::RtpReceiver*> voiceSpeakers;
-        std::map<const RTC::RtpReceiver*, std::string> mapRtpReceiverPeer;
-        bool needToFilterLayers{ false };
-        bool needToFilterAudioLevels{ false };
+		RTC::ActiveSpeakerDetector activeSpeakerDetector;
+		const RTC::RtpReceiver* dominantSpeaker{ nullptr };
+		const RTC::Peer* dominantSpeakerPeer{ nullptr };
 		bool audioLevelsEventEnabled{ false };
+		// Maximum number of forwarded audio streams (0 means all of them) and the
+		// forwarded ones (those of the most recently active speakers) with the
+		// time they were last active.
+		size_t lastNAudio{ 0 };
+		std::unordered_map<const RTC::RtpReceiver*, uint64_t> lastNAudioRtpReceivers;
+		// Audio streams out of the last-N forwarded while the speaker detection
+		// decides whether they are speaking, with the time they started.
+		std::unordered_map<const RTC::RtpReceiver*, uint64_t> lastNAudioCandidates;
+		// Maximum number of Peers whose video is forwarded (0 means all of them),
+		// the forwarded ones and the time every Peer last spoke.
+		size_t lastNVideo{ 0 };
+		std::unordered_set<const RTC::Peer*> lastNVideoPeers;
+		std::unordered_map<const RTC::Peer*, uint64_t> mapPeerSpeechTime;
+		// Active speaker streams indexed by their (virtual) RtpSender.
+		std::unordered_map<RTC::RtpSender*, ActiveSpeakerStream> activeSpeakerStreams;
+		// Ongoing dumps with the Peer ids and the Peer steps they dump, one per step.
+		std::unordered_map<Channel::DumpWriter*, std::vector<std::pair<uint32_t, RTC::Peer::DumpStep>>>
+		    dumpWriters;
 	};
 
 	/* Inline static methods. */
@@ -120,6 +175,16 @@ namespace RTC
 	{
 		return this->capabilities;
 	}
+
+	/**
+	 * The dominant speaker identification is needed by the "audiolevels" event,
+	 * the last-N audio and video and the active speaker streams.
+	 */
+	inline bool Room::IsSpeakerDetectionEnabled() const
+	{
+		return this->audioLevelsEventEnabled || this->lastNAudio != 0 || this->lastNVideo != 0 ||
+		       !this->activeSpeakerStreams.empty();
+	}
 } // namespace RTC
 
 #endif
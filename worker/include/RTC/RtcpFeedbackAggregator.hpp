@@ -0,0 +1,78 @@
+#ifndef MS_RTC_RTCP_FEEDBACK_AGGREGATOR_HPP
+#define MS_RTC_RTCP_FEEDBACK_AGGREGATOR_HPP
+
+#include "common.hpp"
+#include "handles/TimerWheel.hpp"
+#include <json/json.h>
+#include <map>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Collects the feedback that every RtpSender of a RtpReceiver wants to send
+	 * upstream and turns it into, at most, one NACK per aggregation window and
+	 * one key frame request per minimum interval, regardless of the number of
+	 * subscribers.
+	 */
+	class RtcpFeedbackAggregator : public TimerWheel::Listener
+	{
+	public:
+		/**
+		 * RTC::RtpReceiver is the Listener.
+		 */
+		class Listener
+		{
+		public:
+			virtual void OnAggregatedNackRequired(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers) = 0;
+			virtual void OnAggregatedKeyFrameRequired(uint32_t ssrc) = 0;
+		};
+
+	private:
+		struct StreamInfo
+		{
+			// Sequence numbers waiting for the aggregation window to expire.
+			std::vector<uint16_t> pendingNacks;
+			// Time at which each sequence number was last requested upstream.
+			std::map<uint16_t, uint64_t> nackedAt;
+			uint64_t keyFrameRequestedAt{ 0 };
+			bool keyFrameRequestPending{ false };
+		};
+
+	public:
+		RtcpFeedbackAggregator(Listener* listener, uint32_t nackWindow, uint32_t keyFrameMinInterval);
+		~RtcpFeedbackAggregator() override;
+
+		Json::Value ToJson() const;
+		void ReceiveNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers);
+		void RegisterSentNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers);
+		bool ReceiveKeyFrameRequest(uint32_t ssrc);
+		void RegisterSentKeyFrameRequest(uint32_t ssrc);
+		void Clear();
+
+	private:
+		bool IsRecentlyNacked(StreamInfo& streamInfo, uint16_t seq, uint64_t now) const;
+		void FlushNacks();
+		void FlushKeyFrameRequests();
+
+		/* Pure virtual methods inherited from TimerWheel::Listener. */
+	public:
+		void OnTimer(TimerWheel::Handle* handle) override;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		uint32_t nackWindow{ 0 };
+		uint32_t keyFrameMinInterval{ 0 };
+		// Others.
+		TimerWheel::Handle nackTimer{ this };
+		TimerWheel::Handle keyFrameTimer{ this };
+		std::map<uint32_t, StreamInfo> streams;
+		uint64_t nacksReceived{ 0 };
+		uint64_t nacksForwarded{ 0 };
+		uint64_t keyFrameRequestsReceived{ 0 };
+		uint64_t keyFrameRequestsForwarded{ 0 };
+	};
+} // namespace RTC
+
+#endif
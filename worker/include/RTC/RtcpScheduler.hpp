@@ -0,0 +1,125 @@
+#ifndef MS_RTC_RTCP_SCHEDULER_HPP
+#define MS_RTC_RTCP_SCHEDULER_HPP
+
+#include "common.hpp"
+#include "handles/TimerWheel.hpp"
+#include "RTC/RTCP/ReceiverReport.hpp"
+#include "RTC/RTCP/SenderReport.hpp"
+#include <json/json.h>
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Sends the RTCP reports of a Transport. Every reporter (RtpSender or
+	 * RtpReceiver) is given its own randomized RFC 3550 interval and the reports
+	 * due at the same time are serialized into as few compound packets as
+	 * possible. NACK and REMB feedback is sent right away. Everything is written
+	 * into static buffers, no RTCP object is allocated.
+	 *
+	 * Every compound packet carries a SDES CNAME (RFC 3550 section 6.1), that
+	 * of the last SR if the packet has no SR itself.
+	 */
+	class RtcpScheduler : public TimerWheel::Listener
+	{
+	public:
+		// Leaves room for the SRTCP, UDP, IP and TURN overheads within the MTU.
+		static constexpr size_t MaxPacketSize{ 1200 };
+		// SDES chunk with a CNAME (SSRC, item type and length, up to 255 bytes
+		// and at least one null octet, padded to 32 bits).
+		static constexpr size_t MaxCnameChunkSize{ 264 };
+
+	public:
+		/**
+		 * RTC::Transport is the Listener.
+		 */
+		class Listener
+		{
+		public:
+			virtual void OnRtcpSchedulerPacket(
+			    RTC::RtcpScheduler* rtcpScheduler, const uint8_t* data, size_t len) = 0;
+		};
+
+		/**
+		 * RTC::RtpSender and RTC::RtpReceiver are Reporters.
+		 */
+		class Reporter
+		{
+		public:
+			virtual ~Reporter() = default;
+
+		public:
+			virtual void OnRtcpSchedulerReport(RTC::RtcpScheduler* rtcpScheduler, uint64_t now) = 0;
+		};
+
+	private:
+		struct ReporterInfo
+		{
+			Reporter* reporter{ nullptr };
+			uint16_t maxInterval{ 0 };
+			uint64_t nextReportAt{ 0 };
+		};
+
+	public:
+		explicit RtcpScheduler(Listener* listener);
+		~RtcpScheduler() override;
+
+		Json::Value ToJson() const;
+		void AddReporter(Reporter* reporter, uint16_t maxInterval);
+		void RemoveReporter(Reporter* reporter);
+		void SetBitrate(uint32_t bitrate);
+		void AddSenderReport(RTC::RTCP::SenderReport* report, const std::string& cname);
+		void AddReceiverReport(RTC::RTCP::ReceiverReport* report);
+		void SendNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers);
+		void SendRemb(uint32_t bitrate, const std::vector<uint32_t>& ssrcs);
+
+	private:
+		uint64_t GetInterval(uint16_t maxInterval) const;
+		size_t GetSize() const;
+		void Flush();
+		void MayRunTimer();
+
+		/* Pure virtual methods inherited from TimerWheel::Listener. */
+	public:
+		void OnTimer(TimerWheel::Handle* handle) override;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Others.
+		TimerWheel::Handle timer{ this };
+		std::vector<ReporterInfo> reporters;
+		bool reporting{ false };
+		// Session bandwidth (bps).
+		uint32_t bitrate{ 0 };
+		// RFC 3550 avg_rtcp_size (bytes), including UDP and IP headers.
+		double avgPacketSize{ 0 };
+		// Compound packet being built.
+		size_t senderReportsSize{ 0 };
+		size_t receiverReportCount{ 0 };
+		size_t sdesSize{ 0 };
+		size_t sdesChunkCount{ 0 };
+		// SDES CNAME chunk of the last SR, for compound packets without SR.
+		uint8_t cnameChunk[MaxCnameChunkSize];
+		size_t cnameChunkSize{ 0 };
+		// Stats.
+		uint64_t numCompoundPackets{ 0 };
+		uint64_t numSenderReports{ 0 };
+		uint64_t numReceiverReports{ 0 };
+		uint64_t numNacks{ 0 };
+		uint64_t numRembs{ 0 };
+	};
+
+	/* Inline methods. */
+
+	/**
+	 * Session bandwidth used to compute the report intervals.
+	 */
+	inline void RtcpScheduler::SetBitrate(uint32_t bitrate)
+	{
+		this->bitrate = bitrate;
+	}
+} // namespace RTC
+
+#endif
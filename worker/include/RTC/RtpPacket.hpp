@@ -113,6 +113,8 @@ namespace RTC
 		uint8_t* GetExtension(RtpHeaderExtensionUri::Type uri, uint8_t* len) const;
 		bool ReadAudioLevel(uint8_t* volume, bool* voice) const;
 		bool ReadAbsSendTime(uint32_t* time) const;
+		bool ReadTransportWideCc01(uint16_t* wideSeqNumber) const;
+		bool UpdateTransportWideCc01(uint16_t wideSeqNumber);
 		uint8_t* GetPayload() const;
 		size_t GetPayloadLength() const;
 		void Serialize(uint8_t* buffer);
@@ -291,7 +293,7 @@ namespace RTC
 			if (this->twoBytesExtensions.find(id) == this->twoBytesExtensions.end())
 				return nullptr;
 
-			*len = this->oneByteExtensions.at(id)->len;
+			*len = this->twoBytesExtensions.at(id)->len;
 
 			return this->twoBytesExtensions.at(id)->value;
 		}
@@ -333,6 +335,36 @@ namespace RTC
 		return true;
 	}
 
+	inline bool RtpPacket::ReadTransportWideCc01(uint16_t* wideSeqNumber) const
+	{
+		uint8_t extenLen;
+		uint8_t* extenValue;
+
+		extenValue = GetExtension(RtpHeaderExtensionUri::Type::TRANSPORT_WIDE_CC_01, &extenLen);
+
+		if (!extenValue || extenLen != 2)
+			return false;
+
+		*wideSeqNumber = Utils::Byte::Get2Bytes(extenValue, 0);
+
+		return true;
+	}
+
+	inline bool RtpPacket::UpdateTransportWideCc01(uint16_t wideSeqNumber)
+	{
+		uint8_t extenLen;
+		uint8_t* extenValue;
+
+		extenValue = GetExtension(RtpHeaderExtensionUri::Type::TRANSPORT_WIDE_CC_01, &extenLen);
+
+		if (!extenValue || extenLen != 2)
+			return false;
+
+		Utils::Byte::Set2Bytes(extenValue, 0, wideSeqNumber);
+
+		return true;
+	}
+
 	inline uint8_t* RtpPacket::GetPayload() const
 	{
 		return this->payload;
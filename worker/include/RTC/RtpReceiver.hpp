@@ -4,15 +4,21 @@
 #include "common.hpp"
 #include "Channel/Notifier.hpp"
 #include "Channel/Request.hpp"
-#include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/Feedback.hpp"
 #include "RTC/RTCP/ReceiverReport.hpp"
+#include "RTC/KeyFrameCache.hpp"
+#include "RTC/PacketTap.hpp"
+#include "RTC/RtcpFeedbackAggregator.hpp"
+#include "RTC/RtcpScheduler.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpStreamRecv.hpp"
+#include "RTC/StatsSnapshot.hpp"
 #include <json/json.h>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace RTC
 {
@@ -20,7 +26,9 @@ namespace RTC
 	// the corresponding header files.
 	class Transport;
 
-	class RtpReceiver : public RtpStreamRecv::Listener
+	class RtpReceiver : public RtpStreamRecv::Listener,
+	                    public RtcpFeedbackAggregator::Listener,
+	                    public RtcpScheduler::Reporter
 	{
 	public:
 		/**
@@ -40,7 +48,7 @@ namespace RTC
 		    Listener* listener, Channel::Notifier* notifier, uint32_t rtpReceiverId, RTC::Media::Kind kind);
 
 	private:
-		virtual ~RtpReceiver();
+		~RtpReceiver() override;
 
 	public:
 		void Destroy();
@@ -52,20 +60,36 @@ namespace RTC
 		RTC::RtpParameters* GetParameters() const;
 		void ReceiveRtpPacket(RTC::RtpPacket* packet);
 		void ReceiveRtcpSenderReport(RTC::RTCP::SenderReport* report);
-		void GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now);
 		void ReceiveRtcpFeedback(RTC::RTCP::FeedbackPsPacket* packet) const;
 		void ReceiveRtcpFeedback(RTC::RTCP::FeedbackRtpPacket* packet) const;
+		void ReceiveNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers) const;
 		void RequestFullFrame() const;
+		bool GetKeyFrame(uint32_t ssrc, std::vector<RTC::RtpPacket*>& packets) const;
+		RTC::RtpCodecMime::Subtype GetCodecSubtype(uint8_t payloadType) const;
+		const std::vector<std::pair<uint16_t, uint16_t>>& GetSpatialLayerResolutions() const;
+		void FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const;
 
 	private:
 		void CreateRtpStream(RTC::RtpEncodingParameters& encoding);
+		RTC::RtpStreamRecv* CreateRtpStreamByRid(RTC::RtpPacket* packet);
 		void ClearRtpStreams();
+		void SendNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers) const;
+		void UpdateSpatialLayerResolutions(RTC::RtpPacket* packet);
 
 		/* Pure virtual methods inherited from RTC::RtpStreamRecv::Listener. */
 	public:
 		void OnNackRequired(RTC::RtpStreamRecv* rtpStream, const std::vector<uint16_t>& seqNumbers) override;
 		void OnPliRequired(RTC::RtpStreamRecv* rtpStream) override;
 
+		/* Pure virtual methods inherited from RTC::RtcpFeedbackAggregator::Listener. */
+	public:
+		void OnAggregatedNackRequired(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers) override;
+		void OnAggregatedKeyFrameRequired(uint32_t ssrc) override;
+
+		/* Pure virtual methods inherited from RTC::RtcpScheduler::Reporter. */
+	public:
+		void OnRtcpSchedulerReport(RTC::RtcpScheduler* rtcpScheduler, uint64_t now) override;
+
 	public:
 		// Passed by argument.
 		uint32_t rtpReceiverId{ 0 };
@@ -79,35 +103,47 @@ namespace RTC
 		// Allocated by this.
 		RTC::RtpParameters* rtpParameters{ nullptr };
 		std::map<uint32_t, RTC::RtpStreamRecv*> rtpStreams;
+		RTC::RtcpFeedbackAggregator* feedbackAggregator{ nullptr };
+		std::map<uint32_t, RTC::KeyFrameCache*> keyFrameCaches;
+		RTC::PacketTap* packetTap{ nullptr };
 		// Others.
 		bool rtpRawEventEnabled{ false };
 		bool rtpObjectEventEnabled{ false };
-		// Timestamp when last RTCP was sent.
-		uint64_t lastRtcpSentTime{ 0 };
+		// Maximum interval between RTCP reports.
 		uint16_t maxRtcpInterval{ 0 };
+		// RTP stream id (RID) header extension id (0 if none), used to match
+		// simulcast encodings with no SSRC.
+		uint8_t ridExtensionId{ 0 };
+		// Codec of every payload type, resolved when the parameters are set.
+		RTC::RtpCodecMime::Subtype codecSubtypes[128]{};
+		// Width/height of each VP9 spatial layer as announced in the last
+		// scalability structure.
+		std::vector<std::pair<uint16_t, uint16_t>> spatialLayerResolutions;
 	};
 
 	/* Inline methods. */
 
-	inline void RtpReceiver::SetTransport(RTC::Transport* transport)
+	inline RTC::Transport* RtpReceiver::GetTransport() const
 	{
-		this->transport = transport;
+		return this->transport;
 	}
 
-	inline RTC::Transport* RtpReceiver::GetTransport() const
+	inline RTC::RtpParameters* RtpReceiver::GetParameters() const
 	{
-		return this->transport;
+		return this->rtpParameters;
 	}
 
-	inline void RtpReceiver::RemoveTransport(RTC::Transport* transport)
+	/**
+	 * Codec negotiated for the given payload type (UNSET if none).
+	 */
+	inline RTC::RtpCodecMime::Subtype RtpReceiver::GetCodecSubtype(uint8_t payloadType) const
 	{
-		if (this->transport == transport)
-			this->transport = nullptr;
+		return this->codecSubtypes[payloadType & 0x7F];
 	}
 
-	inline RTC::RtpParameters* RtpReceiver::GetParameters() const
+	inline const std::vector<std::pair<uint16_t, uint16_t>>& RtpReceiver::GetSpatialLayerResolutions() const
 	{
-		return this->rtpParameters;
+		return this->spatialLayerResolutions;
 	}
 
 	inline void RtpReceiver::ReceiveRtcpSenderReport(RTC::RTCP::SenderReport* report)
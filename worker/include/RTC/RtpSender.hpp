@@ -4,22 +4,39 @@
 #include "common.hpp"
 #include "Channel/Notifier.hpp"
 #include "Channel/Request.hpp"
-#include "RTC/RTCP/CompoundPacket.hpp"
-#include "RTC/RTCP/FeedbackRtpNack.hpp"
+#include "RTC/Codecs/VP8.hpp"
+#include "RTC/RTCP/PacketView.hpp"
 #include "RTC/RTCP/ReceiverReport.hpp"
-#include "RTC/RTCP/Sdes.hpp"
+#include "RTC/RtcpScheduler.hpp"
 #include "RTC/RtpDataCounter.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpStreamSend.hpp"
+#include "RTC/StatsSnapshot.hpp"
 #include "RTC/Transport.hpp"
+#include "RTC/VP9Filter.hpp"
 #include <json/json.h>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace RTC
 {
-	class RtpSender
+	class RtpSender : public RTC::RtcpScheduler::Reporter
 	{
+	public:
+		static constexpr uint8_t MaxSpatialLayers{ 3 };
+		static constexpr uint8_t MaxTemporalLayers{ 3 };
+
+	private:
+		struct SeqHistoryItem
+		{
+			uint16_t inputSeq{ 0 };
+			uint16_t seqOffset{ 0 };
+			bool valid{ false };
+			bool dropped{ false };
+		};
+
 	public:
 		/**
 		 * RTC::Peer is the Listener.
@@ -27,16 +44,24 @@ namespace RTC
 		class Listener
 		{
 		public:
-			virtual void OnRtpSenderClosed(RtpSender* rtpSender)            = 0;
-			virtual void OnRtpSenderFullFrameRequired(RtpSender* rtpSender) = 0;
+			virtual void OnRtpSenderClosed(RtpSender* rtpSender)                    = 0;
+			virtual void OnRtpSenderFullFrameRequired(RtpSender* rtpSender)         = 0;
+			virtual void OnRtpSenderBitrateAllocationRequired(RtpSender* rtpSender) = 0;
 		};
 
+	public:
+		static uint8_t GetSpatialLayerForSize(
+		    const std::vector<std::pair<uint16_t, uint16_t>>& resolutions,
+		    uint16_t width,
+		    uint16_t height,
+		    uint8_t maxSpatialLayer);
+
 	public:
 		RtpSender(
 		    Listener* listener, Channel::Notifier* notifier, uint32_t rtpSenderId, RTC::Media::Kind kind);
 
 	private:
-		virtual ~RtpSender();
+		~RtpSender() override;
 
 	public:
 		void Destroy();
@@ -50,16 +75,60 @@ namespace RTC
 		RTC::RtpParameters* GetParameters() const;
 		bool GetActive() const;
 		void SendRtpPacket(RTC::RtpPacket* packet);
-		void GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now);
-		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket);
+		void SendKeyFrame(const std::vector<RTC::RtpPacket*>& packets);
+		void Resync();
+		void ReceiveNack(
+		    const RTC::RTCP::PacketView& nackPacket, std::vector<uint16_t>& missingSeqNumbers);
 		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report);
+		void ReceiveKeyFrameRequest();
+		void FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const;
 		uint32_t GetTransmissionRate(uint64_t now);
+		uint32_t GetAvailableBitrate() const;
+		bool HasLayers() const;
+		void SetPreferredLayers(uint8_t spatialLayer, uint8_t temporalLayer);
+		uint8_t GetPreferredSpatialLayer() const;
+		uint8_t GetPreferredTemporalLayer() const;
+		void SetSpatialLayerResolutions(
+		    const std::vector<std::pair<uint16_t, uint16_t>>* spatialLayerResolutions);
+		void SetMaxResolution(uint16_t width, uint16_t height);
+		uint8_t GetMaxSpatialLayer() const;
+		void SetTargetLayers(uint8_t spatialLayer, uint8_t temporalLayer);
+		uint8_t GetTargetSpatialLayer() const;
+		uint8_t GetTargetTemporalLayer() const;
+		uint32_t GetTargetSsrc() const;
+		uint32_t GetLayersBitrate(uint8_t spatialLayer, uint8_t temporalLayer) const;
+		void SetPinned(bool pinned);
+		bool GetPinned() const;
+		void SetActiveSpeaker(bool activeSpeaker);
+		bool GetActiveSpeaker() const;
+		void SetPaused(bool paused);
+		bool GetPaused() const;
+		void SetVirtual();
+		bool IsVirtual() const;
 
 	private:
 		void CreateRtpStream(RTC::RtpEncodingParameters& encoding);
+		template<typename Handler>
+		void ForwardRtpPacket(RTC::RtpPacket* packet);
 		void RetransmitRtpPacket(RTC::RtpPacket* packet);
+		bool SelectLayers(RTC::RtpPacket* packet, bool& marker);
+		bool SelectVP8Layers(
+		    RTC::RtpPacket* packet,
+		    const RTC::Codecs::VP8::PayloadDescriptor& descriptor,
+		    uint16_t& pictureId,
+		    uint8_t& tl0PicIdx);
+		bool SelectEncoding(RTC::RtpPacket* packet, uint8_t temporalLayer);
+		bool ApplyPause(RTC::RtpPacket* packet);
+		bool MapSequenceNumber(uint16_t seq, bool drop, uint16_t& mappedSeq);
+		void ContinueFrom(RTC::RtpPacket* packet);
+		void AccountLayerBytes(uint8_t spatialLayer, uint8_t temporalLayer, size_t size);
+		void UpdateLayerBitrates(uint64_t now);
 		void EmitActiveChange() const;
 
+		/* Pure virtual methods inherited from RTC::RtcpScheduler::Reporter. */
+	public:
+		void OnRtcpSchedulerReport(RTC::RtcpScheduler* rtcpScheduler, uint64_t now) override;
+
 	public:
 		// Passed by argument.
 		uint32_t rtpSenderId{ 0 };
@@ -71,18 +140,75 @@ namespace RTC
 		Channel::Notifier* notifier{ nullptr };
 		RTC::Transport* transport{ nullptr };
 		RTC::RtpCapabilities* peerCapabilities{ nullptr };
+		// Owned by the associated RtpReceiver, which outlives this RtpSender.
+		const std::vector<std::pair<uint16_t, uint16_t>>* spatialLayerResolutions{ nullptr };
+		const RTC::RtpParameters* receiverRtpParameters{ nullptr };
 		// Allocated by this.
 		RTC::RtpParameters* rtpParameters{ nullptr };
 		RTC::RtpStreamSend* rtpStream{ nullptr };
+		VP9::VP9LayerSelector* layerSelector{ nullptr };
+		RTC::Codecs::VP8::LayerSelector* vp8LayerSelector{ nullptr };
 		// Others.
 		std::unordered_set<uint8_t> supportedPayloadTypes;
 		// Whether this RtpSender is valid according to Peer capabilities.
 		bool available{ false };
 		// Whether this RtpSender has been disabled by the app.
 		bool disabled{ false };
-		// Timestamp when last RTCP was sent.
-		uint64_t lastRtcpSentTime{ 0 };
+		// Maximum interval between RTCP reports.
 		uint16_t maxRtcpInterval{ 0 };
+		RTC::RtpCodecMime mime;
+		// Send pipeline of the codec handler, resolved when the RtpStreamSend is
+		// created.
+		void (RtpSender::*forwardRtpPacket)(RTC::RtpPacket* packet){ nullptr };
+		// Offsets added to the sequence number and timestamp of every sent packet
+		// so a cached key frame can be inserted without breaking continuity.
+		uint16_t seqOffset{ 0 };
+		uint32_t timestampOffset{ 0 };
+		// Highest sequence number and timestamp sent (after applying offsets).
+		bool sentAnyPacket{ false };
+		uint16_t lastSentSeq{ 0 };
+		uint32_t lastSentTimestamp{ 0 };
+		uint64_t lastSentAt{ 0 };
+		// Whether the packets being sent come from a key frame cache.
+		bool sendingKeyFrame{ false };
+		// Whether the next packet must continue from the last sent one because
+		// the packets in between were not given to this RtpSender.
+		bool syncRequired{ false };
+		// VP9 (or VP8 temporal) layers. The targets are set by the bitrate
+		// allocation of the Peer and never exceed the preferred ones.
+		uint8_t preferredSpatialLayer{ 0 };
+		uint8_t preferredTemporalLayer{ 0 };
+		uint8_t targetSpatialLayer{ 0 };
+		uint8_t targetTemporalLayer{ 0 };
+		size_t layerBytes[MaxSpatialLayers][MaxTemporalLayers]{};
+		uint32_t layerBitrates[MaxSpatialLayers][MaxTemporalLayers]{};
+		uint64_t lastLayerBitratesAt{ 0 };
+		size_t layerPacketsDropped{ 0 };
+		// Sequence number offsets applied to the recent packets (indexed by their
+		// original sequence number), so packets arriving out of order are mapped
+		// right once layer packets have been dropped. Just used if there are
+		// layers.
+		std::vector<SeqHistoryItem> seqHistory;
+		bool seqHistoryStarted{ false };
+		uint16_t maxInputSeq{ 0 };
+		// Simulcast. The encodings of the RtpReceiver (from lowest to highest
+		// quality) are the spatial layers, switched on key frames.
+		bool simulcast{ false };
+		uint8_t currentEncodingIdx{ 0 };
+		uint64_t lastKeyFrameRequestAt{ 0 };
+		// Size at which the remote Peer renders the video (0 if unknown).
+		uint16_t maxWidth{ 0 };
+		uint16_t maxHeight{ 0 };
+		// Allocation priority.
+		bool pinned{ false };
+		bool activeSpeaker{ false };
+		// Video paused by the Room (unless pinned) and whether it is being
+		// forwarded, which changes at frame boundaries.
+		bool paused{ false };
+		bool forwarding{ true };
+		// Whether the stream is fed by the Room with packets of different
+		// RtpReceivers (any SSRC), as the active speaker stream.
+		bool isVirtual{ false };
 		// RTP counters.
 		RTC::RtpDataCounter transmittedCounter;
 		// TODO: keep track of retransmitted data too.
@@ -95,8 +221,14 @@ namespace RTC
 	{
 		bool wasActive = this->GetActive();
 
+		if (this->transport != nullptr)
+			this->transport->GetRtcpScheduler()->RemoveReporter(this);
+
 		this->transport = transport;
 
+		if (this->transport != nullptr)
+			this->transport->GetRtcpScheduler()->AddReporter(this, this->maxRtcpInterval);
+
 		if (wasActive != this->GetActive())
 			EmitActiveChange();
 	}
@@ -111,7 +243,10 @@ namespace RTC
 		bool wasActive = this->GetActive();
 
 		if (this->transport == transport)
+		{
+			this->transport->GetRtcpScheduler()->RemoveReporter(this);
 			this->transport = nullptr;
+		}
 
 		if (wasActive != this->GetActive())
 			EmitActiveChange();
@@ -127,10 +262,112 @@ namespace RTC
 		return (this->available && this->transport && !this->disabled);
 	}
 
+	/**
+	 * Called when the stream is resumed after some of its packets were not
+	 * given to this RtpSender, so the following ones keep the sequence numbers
+	 * and timestamps consecutive.
+	 */
+	inline void RtpSender::Resync()
+	{
+		this->syncRequired = true;
+	}
+
 	inline uint32_t RtpSender::GetTransmissionRate(uint64_t now)
 	{
 		return this->transmittedCounter.GetRate(now);
 	}
+
+	/**
+	 * Bitrate available in the transport, shared by all the RtpSenders of the
+	 * Peer. 0 if unknown.
+	 */
+	inline uint32_t RtpSender::GetAvailableBitrate() const
+	{
+		if (this->transport == nullptr)
+			return 0;
+
+		return this->transport->GetAvailableBitrate();
+	}
+
+	inline bool RtpSender::HasLayers() const
+	{
+		return this->layerSelector != nullptr || this->vp8LayerSelector != nullptr || this->simulcast;
+	}
+
+	inline uint8_t RtpSender::GetPreferredSpatialLayer() const
+	{
+		return this->preferredSpatialLayer;
+	}
+
+	inline uint8_t RtpSender::GetPreferredTemporalLayer() const
+	{
+		return this->preferredTemporalLayer;
+	}
+
+	inline void RtpSender::SetSpatialLayerResolutions(
+	    const std::vector<std::pair<uint16_t, uint16_t>>* spatialLayerResolutions)
+	{
+		this->spatialLayerResolutions = spatialLayerResolutions;
+	}
+
+	inline uint8_t RtpSender::GetTargetSpatialLayer() const
+	{
+		return this->targetSpatialLayer;
+	}
+
+	inline uint8_t RtpSender::GetTargetTemporalLayer() const
+	{
+		return this->targetTemporalLayer;
+	}
+
+	/**
+	 * SSRC of the RtpReceiver stream whose key frames are needed.
+	 */
+	inline uint32_t RtpSender::GetTargetSsrc() const
+	{
+		if (this->simulcast && this->targetSpatialLayer < this->receiverRtpParameters->encodings.size())
+			return this->receiverRtpParameters->encodings[this->targetSpatialLayer].ssrc;
+
+		return this->rtpParameters->encodings[0].ssrc;
+	}
+
+	inline bool RtpSender::GetPinned() const
+	{
+		return this->pinned;
+	}
+
+	inline void RtpSender::SetActiveSpeaker(bool activeSpeaker)
+	{
+		this->activeSpeaker = activeSpeaker;
+	}
+
+	inline bool RtpSender::GetActiveSpeaker() const
+	{
+		return this->activeSpeaker;
+	}
+
+	inline void RtpSender::SetPaused(bool paused)
+	{
+		this->paused = paused;
+	}
+
+	/**
+	 * Pinned video is never paused.
+	 */
+	inline bool RtpSender::GetPaused() const
+	{
+		return this->paused && !this->pinned;
+	}
+
+	inline void RtpSender::SetVirtual()
+	{
+		this->isVirtual = true;
+	}
+
+	inline bool RtpSender::IsVirtual() const
+	{
+		return this->isVirtual;
+	}
 } // namespace RTC
 
 #endif
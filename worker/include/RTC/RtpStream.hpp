@@ -21,10 +21,30 @@ namespace RTC
 			uint32_t clockRate{ 0 };
 			bool useNack{ false };
 			bool usePli{ false };
-			uint8_t ssrcAudioLevelId{ 0 }; // 0 means no ssrc-audio-level id.
-			uint8_t absSendTimeId{ 0 };    // 0 means no abs-send-time id.
+			uint8_t ssrcAudioLevelId{ 0 };    // 0 means no ssrc-audio-level id.
+			uint8_t absSendTimeId{ 0 };       // 0 means no abs-send-time id.
+			uint8_t transportWideCc01Id{ 0 }; // 0 means no transport-wide-cc-01 id.
 		};
 
+	public:
+		// Plain counters updated on the packet path, so they can be polled often.
+		struct Stats
+		{
+			size_t packets{ 0 };
+			size_t bytes{ 0 };
+			uint32_t packetsLost{ 0 };
+			uint8_t fractionLost{ 0 };
+			uint32_t jitter{ 0 }; // In ms.
+			uint32_t rtt{ 0 };    // In ms.
+			uint32_t nackPackets{ 0 };
+			uint32_t keyFrameRequests{ 0 };
+			uint32_t retransmittedPackets{ 0 };
+			uint32_t bitrate{ 0 }; // In bps, over the last BitratePeriod.
+		};
+
+	public:
+		static constexpr uint64_t BitratePeriod{ 1000 }; // In ms.
+
 	public:
 		explicit RtpStream(RTC::RtpStream::Params& params);
 		virtual ~RtpStream();
@@ -32,6 +52,7 @@ namespace RTC
 		virtual Json::Value ToJson() const = 0;
 		uint32_t GetSsrc();
 		virtual bool ReceivePacket(RTC::RtpPacket* packet);
+		virtual Stats GetStats(uint64_t now) const;
 
 	private:
 		void InitSeq(uint16_t seq);
@@ -57,6 +78,9 @@ namespace RTC
 		uint32_t receivedPrior{ 0 }; // Packet received at last interval.
 		// Others.
 		uint32_t maxTimestamp{ 0 }; // Highest timestamp seen.
+		Stats stats;
+		uint64_t bitratePeriodStart{ 0 }; // Time (ms) when the current bitrate period started.
+		size_t bitratePeriodBytes{ 0 };   // Bytes received in the current bitrate period.
 	};
 
 	/* Inline instance methods. */
@@ -25,12 +25,14 @@ namespace RTC
 
 		Json::Value ToJson() const override;
 		bool ReceivePacket(RTC::RtpPacket* packet) override;
-		RTC::RTCP::ReceiverReport* GetRtcpReceiverReport();
+		Stats GetStats(uint64_t now) const override;
+		void FillRtcpReceiverReport(RTC::RTCP::ReceiverReport* report);
 		void ReceiveRtcpSenderReport(RTC::RTCP::SenderReport* report);
 		void RequestFullFrame();
 
 	private:
 		void CalculateJitter(uint32_t rtpTimestamp);
+		void RequestPli();
 
 		/* Pure virtual methods inherited from RtpStream. */
 	protected:
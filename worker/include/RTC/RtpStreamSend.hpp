@@ -31,10 +31,12 @@ namespace RTC
 
 		Json::Value ToJson() const override;
 		bool ReceivePacket(RTC::RtpPacket* packet) override;
+		Stats GetStats(uint64_t now) const override;
 		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report);
+		void ReceiveKeyFrameRequest();
 		void RequestRtpRetransmission(
 		    uint16_t seq, uint16_t bitmask, std::vector<RTC::RtpPacket*>& container);
-		RTC::RTCP::SenderReport* GetRtcpSenderReport(uint64_t now);
+		bool FillRtcpSenderReport(RTC::RTCP::SenderReport* report, uint64_t now) const;
 		uint32_t GetRtt() const;
 
 	private:
@@ -55,12 +57,18 @@ namespace RTC
 		uint64_t lastPacketTimeMs{ 0 };       // Time (MS) when the last packet was received.
 		uint32_t lastPacketRtpTimestamp{ 0 }; // RTP Timestamp of the last packet.
 		uint32_t rtt{ 0 };                    // Round trip time.
+		int32_t remoteTotalLost{ 0 };         // As given in the last Receiver Report.
 	};
 
 	inline uint32_t RtpStreamSend::GetRtt() const
 	{
 		return this->rtt;
 	}
+
+	inline void RtpStreamSend::ReceiveKeyFrameRequest()
+	{
+		this->stats.keyFrameRequests++;
+	}
 } // namespace RTC
 
 #endif
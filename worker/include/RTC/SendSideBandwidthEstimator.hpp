@@ -0,0 +1,99 @@
+#ifndef MS_RTC_SEND_SIDE_BANDWIDTH_ESTIMATOR_HPP
+#define MS_RTC_SEND_SIDE_BANDWIDTH_ESTIMATOR_HPP
+
+#include "common.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include "RTC/RTCP/PacketView.hpp"
+#include "RTC/RemoteBitrateEstimator/AimdRateControl.hpp"
+#include "RTC/RemoteBitrateEstimator/InterArrival.hpp"
+#include "RTC/RemoteBitrateEstimator/OveruseDetector.hpp"
+#include "RTC/RemoteBitrateEstimator/OveruseEstimator.hpp"
+#include "RTC/RtpDataCounter.hpp"
+#include <json/json.h>
+#include <deque>
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Estimates the bitrate available towards the remote receiver of a
+	 * Transport. Every sent packet carrying the transport-wide sequence number
+	 * is recorded, and the transport feedback returned by the receiver drives a
+	 * delay based controller (same as the remote estimator but using our send
+	 * times) and a loss based one. REMB, if received, caps the estimate.
+	 */
+	class SendSideBandwidthEstimator
+	{
+	public:
+		/**
+		 * RTC::Transport is the Listener.
+		 */
+		class Listener
+		{
+		public:
+			virtual void OnSendSideBandwidthEstimation(
+			    RTC::SendSideBandwidthEstimator* sendSideBandwidthEstimator, uint32_t availableBitrate) = 0;
+		};
+
+	private:
+		struct SentPacket
+		{
+			uint64_t sentAt{ 0 };
+			size_t size{ 0 };
+			bool reported{ false };
+		};
+
+	public:
+		explicit SendSideBandwidthEstimator(Listener* listener);
+
+		Json::Value ToJson() const;
+		uint16_t RtpPacketSent(size_t size, uint64_t now);
+		void ReceiveTransportFeedback(const RTC::RTCP::PacketView& feedback, uint64_t now);
+		void ReceiveRemb(uint32_t bitrate, uint64_t now);
+		uint32_t GetAvailableBitrate() const;
+
+	private:
+		void UpdateDelayBasedBitrate(uint64_t now);
+		void UpdateLossBasedBitrate(uint64_t now);
+		void UpdateAvailableBitrate();
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Others.
+		std::deque<SentPacket> sentPackets;
+		int64_t nextWideSeq{ 0 }; // Unwrapped wide seq number of the next sent packet.
+		std::vector<RTC::RTCP::FeedbackRtpTransportPacket::PacketResult> packetResults;
+		// Delay based.
+		RTC::InterArrival interArrival;
+		RTC::OveruseEstimator overuseEstimator;
+		RTC::OveruseDetector overuseDetector;
+		RTC::AimdRateControl rateControl;
+		RTC::RateCalculator ackedBitrate;
+		uint64_t lastDelayUpdateAt{ 0 };
+		uint32_t delayBasedBitrate{ 0 };
+		// Loss based.
+		size_t lossWindowPackets{ 0 };
+		size_t lossWindowLost{ 0 };
+		uint64_t lastLossIncreaseAt{ 0 };
+		uint64_t lastLossDecreaseAt{ 0 };
+		uint8_t fractionLost{ 0 }; // 0 - 255, as in RTCP receiver reports.
+		uint32_t lossBasedBitrate{ 0 };
+		// Others.
+		uint32_t rembBitrate{ 0 };
+		uint32_t availableBitrate{ 0 };
+		size_t packetsSent{ 0 };
+		size_t packetsAcked{ 0 };
+		size_t packetsLost{ 0 };
+		size_t feedbackPacketsReceived{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline uint32_t SendSideBandwidthEstimator::GetAvailableBitrate() const
+	{
+		return this->availableBitrate;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef MS_RTC_STATS_SNAPSHOT_HPP
+#define MS_RTC_STATS_SNAPSHOT_HPP
+
+#include "common.hpp"
+#include "RTC/RtpDictionaries.hpp"
+#include "RTC/RtpStream.hpp"
+#include <vector>
+
+namespace RTC
+{
+	/**
+	 * Compact binary snapshot of the stats of many RTP streams, as sent to Node
+	 * by the getStats requests. Every field is big-endian.
+	 *
+	 * Header (HeaderSize bytes):
+	 *
+	 *   0  u8   version
+	 *   1  u8   record size
+	 *   2  u16  reserved
+	 *   4  u32  number of records
+	 *   8  u64  time (ms)
+	 *
+	 * Record (RecordSize bytes):
+	 *
+	 *   0  u32  RtpReceiver or RtpSender id
+	 *   4  u32  ssrc
+	 *   8  u8   direction
+	 *   9  u8   media kind
+	 *   10 u8   target spatial layer (NoLayer if none)
+	 *   11 u8   target temporal layer (NoLayer if none)
+	 *   12 u32  packets
+	 *   16 u64  bytes
+	 *   24 u32  packets lost
+	 *   28 u8   fraction lost (1/256 units)
+	 *   29 u8   reserved (3 bytes)
+	 *   32 u32  jitter (ms)
+	 *   36 u32  rtt (ms)
+	 *   40 u32  NACKed packets
+	 *   44 u32  key frame requests
+	 *   48 u32  retransmitted packets
+	 *   52 u32  bitrate (bps)
+	 */
+	class StatsSnapshot
+	{
+	public:
+		static constexpr uint8_t Version{ 1 };
+		static constexpr size_t HeaderSize{ 16 };
+		static constexpr size_t RecordSize{ 56 };
+		static constexpr uint8_t NoLayer{ 0xFF };
+
+	public:
+		enum class Direction : uint8_t
+		{
+			RECEIVE = 0,
+			SEND
+		};
+
+	public:
+		explicit StatsSnapshot(uint64_t now);
+
+		void Add(
+		    uint32_t ownerId,
+		    uint32_t ssrc,
+		    Direction direction,
+		    RTC::Media::Kind kind,
+		    uint8_t spatialLayer,
+		    uint8_t temporalLayer,
+		    const RTC::RtpStream::Stats& stats);
+		const uint8_t* GetData() const;
+		size_t GetSize() const;
+		size_t GetCount() const;
+
+	private:
+		std::vector<uint8_t> data;
+		size_t count{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline const uint8_t* StatsSnapshot::GetData() const
+	{
+		return this->data.data();
+	}
+
+	inline size_t StatsSnapshot::GetSize() const
+	{
+		return this->data.size();
+	}
+
+	inline size_t StatsSnapshot::GetCount() const
+	{
+		return this->count;
+	}
+} // namespace RTC
+
+#endif
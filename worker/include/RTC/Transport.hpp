@@ -2,25 +2,31 @@
 #define MS_RTC_TRANSPORT_HPP
 
 #include "common.hpp"
+#include "Channel/DumpWriter.hpp"
 #include "Channel/Notifier.hpp"
 #include "Channel/Request.hpp"
 #include "RTC/DtlsTransport.hpp"
 #include "RTC/IceCandidate.hpp"
 #include "RTC/IceServer.hpp"
-#include "RTC/RTCP/CompoundPacket.hpp"
+#include "RTC/Pacer.hpp"
 #include "RTC/RTCP/Packet.hpp"
+#include "RTC/RTCP/PacketView.hpp"
 #include "RTC/RemoteBitrateEstimator/RemoteBitrateEstimatorAbsSendTime.hpp"
+#include "RTC/RtcpScheduler.hpp"
 #include "RTC/RtpListener.hpp"
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpReceiver.hpp"
+#include "RTC/SendSideBandwidthEstimator.hpp"
 #include "RTC/SrtpSession.hpp"
 #include "RTC/StunMessage.hpp"
 #include "RTC/TcpConnection.hpp"
 #include "RTC/TcpServer.hpp"
+#include "RTC/TransportFeedbackGenerator.hpp"
 #include "RTC/TransportTuple.hpp"
 #include "RTC/UdpSocket.hpp"
 #include <json/json.h>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace RTC
@@ -30,16 +36,24 @@ namespace RTC
 	                  public RTC::TcpConnection::Listener,
 	                  public RTC::IceServer::Listener,
 	                  public RTC::DtlsTransport::Listener,
-	                  public RTC::RemoteBitrateEstimator::Listener
+	                  public RTC::RemoteBitrateEstimator::Listener,
+	                  public RTC::Pacer::Listener,
+	                  public RTC::TransportFeedbackGenerator::Listener,
+	                  public RTC::SendSideBandwidthEstimator::Listener,
+	                  public RTC::RtcpScheduler::Listener,
+	                  public Channel::DumpWriter::Listener
 	{
 	public:
 		class Listener
 		{
 		public:
-			virtual void OnTransportConnected(RTC::Transport* transport)                             = 0;
-			virtual void OnTransportClosed(RTC::Transport* transport)                                = 0;
-			virtual void OnTransportRtcpPacket(RTC::Transport* transport, RTC::RTCP::Packet* packet) = 0;
-			virtual void OnTransportFullFrameRequired(RTC::Transport* transport)                     = 0;
+			virtual void OnTransportConnected(RTC::Transport* transport) = 0;
+			virtual void OnTransportClosed(RTC::Transport* transport)    = 0;
+			virtual void OnTransportRtcpPacket(
+			    RTC::Transport* transport, const RTC::RTCP::CompoundPacketView& compoundPacket) = 0;
+			virtual void OnTransportFullFrameRequired(RTC::Transport* transport) = 0;
+			virtual void OnTransportAvailableBitrateChange(
+			    RTC::Transport* transport, uint32_t availableBitrate) = 0;
 		};
 
 	public:
@@ -50,19 +64,30 @@ namespace RTC
 
 	public:
 		void Destroy();
-		Json::Value ToJson() const;
+		Json::Value ToJson(bool withRtpListener = true) const;
 		void HandleRequest(Channel::Request* request);
 		void AddRtpReceiver(RTC::RtpReceiver* rtpReceiver);
 		void RemoveRtpReceiver(const RTC::RtpReceiver* rtpReceiver);
-		void SendRtpPacket(RTC::RtpPacket* packet);
+		void SendRtpPacket(RTC::RtpPacket* packet, RTC::Pacer::Priority priority);
 		void SendRtcpPacket(RTC::RTCP::Packet* packet);
-		void SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet);
+		void ReceiveRtpPacketArrival(const RTC::RtpPacket* packet);
 		RTC::RtpReceiver* GetRtpReceiver(uint32_t ssrc);
 		bool IsConnected() const;
 		void EnableRemb();
 		bool HasRemb();
+		void EnableTransportCc();
+		bool HasTransportCc() const;
+		void ReceiveRtcpRemb(uint64_t bitrate);
+		void ReceiveRtcpTransportFeedback(const RTC::RTCP::PacketView& feedback);
+		uint32_t GetAvailableBitrate() const;
+		RTC::RtcpScheduler* GetRtcpScheduler() const;
 
 	private:
+		void SetUpIce(Json::Value& data);
+		void SetUpPlainRtp(Json::Value& data);
+		void SetRemoteParameters(const std::string& ip, uint16_t port);
+		void SetPlainTuple(const struct sockaddr* remoteAddr);
+		bool IsValidPlainTuple(const RTC::TransportTuple* tuple);
 		void MayRunDtlsTransport();
 
 		/* Private methods to unify UDP and TCP behavior. */
@@ -123,6 +148,31 @@ namespace RTC
 	public:
 		void OnReceiveBitrateChanged(const std::vector<uint32_t>& ssrcs, uint32_t bitrate) override;
 
+		/* Pure virtual methods inherited from RTC::Pacer::Listener. */
+	public:
+		void OnPacerRtpPacket(RTC::Pacer* pacer, RTC::RtpPacket* packet) override;
+
+		/* Pure virtual methods inherited from RTC::TransportFeedbackGenerator::Listener. */
+	public:
+		void OnTransportFeedback(
+		    RTC::TransportFeedbackGenerator* transportFeedbackGenerator,
+		    RTC::RTCP::FeedbackRtpTransportPacket* packet) override;
+
+		/* Pure virtual methods inherited from RTC::SendSideBandwidthEstimator::Listener. */
+	public:
+		void OnSendSideBandwidthEstimation(
+		    RTC::SendSideBandwidthEstimator* sendSideBandwidthEstimator,
+		    uint32_t availableBitrate) override;
+
+		/* Pure virtual methods inherited from RTC::RtcpScheduler::Listener. */
+	public:
+		void OnRtcpSchedulerPacket(
+		    RTC::RtcpScheduler* rtcpScheduler, const uint8_t* data, size_t len) override;
+
+		/* Pure virtual methods inherited from Channel::DumpWriter::Listener. */
+	public:
+		bool OnDumpWriterStep(Channel::DumpWriter* dumpWriter, size_t step, Json::Value& data) override;
+
 	public:
 		// Passed by argument.
 		uint32_t transportId{ 0 };
@@ -138,6 +188,9 @@ namespace RTC
 		RTC::DtlsTransport* dtlsTransport{ nullptr };
 		RTC::SrtpSession* srtpRecvSession{ nullptr };
 		RTC::SrtpSession* srtpSendSession{ nullptr };
+		RTC::Pacer* pacer{ nullptr };
+		RTC::SendSideBandwidthEstimator* sendSideBandwidthEstimator{ nullptr };
+		RTC::RtcpScheduler* rtcpScheduler{ nullptr };
 		// Others.
 		bool allocated{ false };
 		// Others (ICE).
@@ -146,6 +199,10 @@ namespace RTC
 		// Others (DTLS).
 		bool remoteDtlsParametersGiven{ false };
 		RTC::DtlsTransport::Role dtlsLocalRole{ RTC::DtlsTransport::Role::AUTO };
+		// Others (plain RTP, no ICE, DTLS nor SRTP).
+		bool plainRtp{ false };
+		bool comedia{ false };
+		RTC::TransportTuple* plainTuple{ nullptr };
 		// Others (RtpListener).
 		RtpListener rtpListener;
 		// REMB and bitrate stuff.
@@ -153,6 +210,10 @@ namespace RTC
 		uint32_t maxBitrate{ 0 };
 		uint32_t effectiveMaxBitrate{ 0 };
 		uint64_t lastEffectiveMaxBitrateAt{ 0 };
+		// Transport-cc stuff.
+		std::unique_ptr<RTC::TransportFeedbackGenerator> transportFeedbackGenerator;
+		// Ongoing dumps.
+		std::unordered_set<Channel::DumpWriter*> dumpWriters;
 	};
 
 	/* Inline instance methods. */
@@ -174,6 +235,9 @@ namespace RTC
 
 	inline bool Transport::IsConnected() const
 	{
+		if (this->plainRtp)
+			return this->plainTuple != nullptr;
+
 		return this->dtlsTransport->GetState() == RTC::DtlsTransport::DtlsState::CONNECTED;
 	}
 
@@ -192,6 +256,32 @@ namespace RTC
 		else
 			return false;
 	}
+
+	inline void Transport::EnableTransportCc()
+	{
+		if (!this->transportFeedbackGenerator)
+		{
+			this->transportFeedbackGenerator.reset(new RTC::TransportFeedbackGenerator(this));
+		}
+	}
+
+	inline bool Transport::HasTransportCc() const
+	{
+		return static_cast<bool>(this->transportFeedbackGenerator);
+	}
+
+	/**
+	 * Estimated bitrate available towards the remote peer, 0 if unknown.
+	 */
+	inline uint32_t Transport::GetAvailableBitrate() const
+	{
+		return this->sendSideBandwidthEstimator->GetAvailableBitrate();
+	}
+
+	inline RTC::RtcpScheduler* Transport::GetRtcpScheduler() const
+	{
+		return this->rtcpScheduler;
+	}
 } // namespace RTC
 
 #endif
@@ -0,0 +1,63 @@
+#ifndef MS_RTC_TRANSPORT_FEEDBACK_GENERATOR_HPP
+#define MS_RTC_TRANSPORT_FEEDBACK_GENERATOR_HPP
+
+#include "common.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include "handles/Timer.hpp"
+#include <json/json.h>
+#include <map>
+
+namespace RTC
+{
+	/**
+	 * Records the arrival time of every packet carrying the transport-wide
+	 * sequence number and periodically reports them to the remote sender in
+	 * RTCP transport feedback packets, so it can estimate the uplink bitrate.
+	 */
+	class TransportFeedbackGenerator : public Timer::Listener
+	{
+	public:
+		/**
+		 * RTC::Transport is the Listener.
+		 */
+		class Listener
+		{
+		public:
+			virtual void OnTransportFeedback(
+			    RTC::TransportFeedbackGenerator* transportFeedbackGenerator,
+			    RTC::RTCP::FeedbackRtpTransportPacket* packet) = 0;
+		};
+
+	public:
+		explicit TransportFeedbackGenerator(Listener* listener);
+		~TransportFeedbackGenerator() override;
+
+		Json::Value ToJson() const;
+		void IncomingPacket(uint64_t arrivalTime, uint32_t ssrc, uint16_t wideSeqNumber);
+
+	private:
+		void SendFeedback();
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Allocated by this.
+		Timer* timer{ nullptr };
+		// Others.
+		// Arrival times (us) indexed by unwrapped wide seq number.
+		std::map<int64_t, uint64_t> arrivalTimes;
+		bool started{ false };
+		int64_t lastWideSeq{ 0 };   // Highest unwrapped wide seq number received.
+		int64_t nextWideSeq{ 0 };   // First unwrapped wide seq number not reported yet.
+		uint32_t mediaSsrc{ 0 };    // Ssrc of the last received packet.
+		uint8_t feedbackPacketCount{ 0 };
+		size_t packetsReceived{ 0 };
+		size_t feedbackPacketsSent{ 0 };
+	};
+} // namespace RTC
+
+#endif
@@ -2,7 +2,6 @@
 #define MS_RTC_VP9_FILTER_HPP
 
 #include "RTC/RtpPacket.hpp"
-#include "handles/Timer.hpp"
 #include <vector>
 
 
@@ -281,6 +280,7 @@ namespace VP9
         void SelectSpatialLayer(uint8_t id);
         
         bool Select(RTC::RtpPacket *packet,uint32_t &extSeqNum,bool &mark);
+        bool Select(RTC::RtpPacket *packet,const VP9PayloadDescription &desc,uint32_t &extSeqNum,bool &mark);
         
         uint8_t GetTemporalLayer() const	{ return temporalLayerId; }
         uint8_t GetSpatialLayer()	const	{ return spatialLayerId;  }
@@ -292,22 +292,6 @@ namespace VP9
         uint8_t nextSpatialLayerId;
         uint32_t dropped;
     };
-    
-    class VP9AudioLevelSelector : public Timer::Listener
-    {
-    public:
-        VP9AudioLevelSelector();
-        ~VP9AudioLevelSelector();
-        bool Select(RTC::RtpPacket *packet, bool forceSelect, uint32_t &extSeqNum,bool &mark);
-        inline void OnTimer(Timer* timer) override;
-        
-    private:
-        Timer* dropTimer{ nullptr };
-        Timer* keepTimer{ nullptr };
-        uint32_t dropped;
-        uint32_t lastFilteredPacketNumber;
-    };
-
 }
 
 #endif
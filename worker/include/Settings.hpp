@@ -38,8 +38,14 @@ public:
         uint16_t vp9MinSpartial{ 0 };
         uint16_t vp9MinTemporial{ 0 };
         bool needToFilterAudioLevels{ false };
+		uint32_t nackAggregationWindow{ 20 };
+		uint32_t keyFrameRequestMinInterval{ 500 };
+		uint32_t keyFrameCacheSize{ 0 };
+		uint32_t retransmissionBudget{ 30 };
 		std::string dtlsCertificateFile;
 		std::string dtlsPrivateKeyFile;
+		// Encode the Channel messages in binary instead of JSON.
+		bool binaryChannel{ false };
 		// Private fields.
 		bool hasIPv4{ false };
 		bool hasIPv6{ false };
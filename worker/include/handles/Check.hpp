@@ -0,0 +1,55 @@
+#ifndef MS_CHECK_HPP
+#define MS_CHECK_HPP
+
+#include "common.hpp"
+#include <uv.h>
+
+/**
+ * Runs the listener once per loop iteration, right after polling for I/O,
+ * while started.
+ */
+class Check
+{
+public:
+	class Listener
+	{
+	public:
+		virtual ~Listener() = default;
+
+	public:
+		virtual void OnCheck(Check* check) = 0;
+	};
+
+public:
+	explicit Check(Listener* listener);
+	Check& operator=(const Check&) = delete;
+	Check(const Check&)            = delete;
+
+private:
+	~Check() = default;
+
+public:
+	void Destroy();
+	void Start();
+	void Stop();
+	bool IsActive() const;
+
+	/* Callbacks fired by UV events. */
+public:
+	void OnUvCheck();
+
+private:
+	// Passed by argument.
+	Listener* listener{ nullptr };
+	// Allocated by this.
+	uv_check_t* uvHandle{ nullptr };
+};
+
+/* Inline methods. */
+
+inline bool Check::IsActive() const
+{
+	return uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) != 0;
+}
+
+#endif
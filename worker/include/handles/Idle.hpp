@@ -0,0 +1,55 @@
+#ifndef MS_IDLE_HPP
+#define MS_IDLE_HPP
+
+#include "common.hpp"
+#include <uv.h>
+
+/**
+ * Runs the listener once per loop iteration, right before polling for I/O,
+ * while started. Meanwhile the loop does not block waiting for I/O.
+ */
+class Idle
+{
+public:
+	class Listener
+	{
+	public:
+		virtual ~Listener() = default;
+
+	public:
+		virtual void OnIdle(Idle* idle) = 0;
+	};
+
+public:
+	explicit Idle(Listener* listener);
+	Idle& operator=(const Idle&) = delete;
+	Idle(const Idle&)            = delete;
+
+private:
+	~Idle() = default;
+
+public:
+	void Destroy();
+	void Start();
+	void Stop();
+	bool IsActive() const;
+
+	/* Callbacks fired by UV events. */
+public:
+	void OnUvIdle();
+
+private:
+	// Passed by argument.
+	Listener* listener{ nullptr };
+	// Allocated by this.
+	uv_idle_t* uvHandle{ nullptr };
+};
+
+/* Inline methods. */
+
+inline bool Idle::IsActive() const
+{
+	return uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) != 0;
+}
+
+#endif
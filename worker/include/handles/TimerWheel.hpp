@@ -0,0 +1,104 @@
+#ifndef MS_TIMER_WHEEL_HPP
+#define MS_TIMER_WHEEL_HPP
+
+#include "common.hpp"
+#include <json/json.h>
+#include <uv.h>
+
+/**
+ * Worker-wide hierarchical timing wheel (Varghese and Lauck) driven by a
+ * single uv timer. Timers are intrusive handles (no allocation) that are
+ * started and stopped in constant time. Levels have 256 slots of 1 ms, 256 ms,
+ * 65.5 s and 4.7 h, and timers are moved to a lower level when its slot is
+ * reached.
+ */
+class TimerWheel
+{
+public:
+	static constexpr uint8_t Levels{ 4 };
+	static constexpr uint16_t SlotsPerLevel{ 256 };
+
+public:
+	class Handle;
+
+	class Listener
+	{
+	public:
+		virtual ~Listener() = default;
+
+	public:
+		virtual void OnTimer(TimerWheel::Handle* handle) = 0;
+	};
+
+	class Handle
+	{
+		friend class TimerWheel;
+
+	public:
+		explicit Handle(Listener* listener);
+		Handle& operator=(const Handle&) = delete;
+		Handle(const Handle&)            = delete;
+		~Handle();
+
+	public:
+		void Start(uint64_t timeout, uint64_t repeat = 0);
+		void Stop();
+		bool IsActive() const;
+
+	private:
+		// Passed by argument.
+		Listener* listener{ nullptr };
+		// Others.
+		uint64_t expiresAt{ 0 };
+		uint64_t repeat{ 0 };
+		Handle** slot{ nullptr };
+		Handle* prev{ nullptr };
+		Handle* next{ nullptr };
+		uint8_t level{ 0 };
+	};
+
+public:
+	static void ClassInit();
+	static void ClassDestroy();
+	static Json::Value ToJson();
+
+	/* Callbacks fired by UV events. */
+public:
+	static void OnUvTimer();
+
+private:
+	static void Insert(Handle* handle);
+	static void Remove(Handle* handle);
+	static void Advance(uint64_t now);
+	static void Cascade(uint8_t level, uint16_t index);
+	static uint64_t GetNextEventTime();
+	static void Schedule(uint64_t time);
+	static void Unschedule();
+
+private:
+	static uv_timer_t* uvHandle;
+	static Handle* slots[Levels][SlotsPerLevel];
+	// Time (ms) up to which slots have been processed.
+	static uint64_t currentTime;
+	// Time (ms) at which the uv timer fires (if armed).
+	static bool armed;
+	static uint64_t armedTime;
+	// Occupancy.
+	static size_t numHandles;
+	static size_t numLevelHandles[Levels];
+	// Work counters.
+	static uint64_t numWakeups;
+	static uint64_t numTicks;
+	static uint64_t numExpired;
+	static uint64_t numCascaded;
+	static size_t maxExpiredPerWakeup;
+};
+
+/* Inline methods. */
+
+inline bool TimerWheel::Handle::IsActive() const
+{
+	return this->slot != nullptr;
+}
+
+#endif
@@ -27,6 +27,7 @@ protected:
 public:
 	void Destroy();
 	bool IsClosing() const;
+	size_t GetWriteQueueSize() const;
 	void Write(const uint8_t* data, size_t len);
 	void Write(const std::string& data);
 
@@ -67,6 +68,14 @@ inline bool UnixStreamSocket::IsClosing() const
 	return this->isClosing;
 }
 
+/**
+ * Bytes given to Write() that the peer has not read yet.
+ */
+inline size_t UnixStreamSocket::GetWriteQueueSize() const
+{
+	return this->uvHandle->write_queue_size;
+}
+
 inline void UnixStreamSocket::Write(const std::string& data)
 {
 	Write(reinterpret_cast<const uint8_t*>(data.c_str()), data.size());
@@ -16,18 +16,28 @@
       'src/DepLibUV.cpp',
       'src/DepOpenSSL.cpp',
       'src/Logger.cpp',
+      'src/LatencyProbes.cpp',
       'src/Loop.cpp',
       'src/Settings.cpp',
+      'src/Channel/BinaryCodec.cpp',
+      'src/Channel/DumpWriter.cpp',
       'src/Channel/Notifier.cpp',
       'src/Channel/Request.cpp',
       'src/Channel/UnixStreamSocket.cpp',
+      'src/RTC/ActiveSpeakerDetector.cpp',
+      'src/RTC/BitrateAllocator.cpp',
       'src/RTC/DtlsTransport.cpp',
       'src/RTC/IceCandidate.cpp',
       'src/RTC/IceServer.cpp',
+      'src/RTC/KeyFrameCache.cpp',
       'src/RTC/NackGenerator.cpp',
+      'src/RTC/Pacer.cpp',
+      'src/RTC/PacketTap.cpp',
       'src/RTC/Peer.cpp',
       'src/RTC/Room.cpp',
       'src/RTC/VP9Filter.cpp',
+      'src/RTC/RtcpFeedbackAggregator.cpp',
+      'src/RTC/RtcpScheduler.cpp',
       'src/RTC/RtpListener.cpp',
       'src/RTC/RtpPacket.cpp',
       'src/RTC/RtpReceiver.cpp',
@@ -36,13 +46,19 @@
       'src/RTC/RtpStreamRecv.cpp',
       'src/RTC/RtpStreamSend.cpp',
       'src/RTC/RtpDataCounter.cpp',
+      'src/RTC/SendSideBandwidthEstimator.cpp',
       'src/RTC/SrtpSession.cpp',
+      'src/RTC/StatsSnapshot.cpp',
       'src/RTC/StunMessage.cpp',
       'src/RTC/TcpConnection.cpp',
       'src/RTC/TcpServer.cpp',
       'src/RTC/Transport.cpp',
+      'src/RTC/TransportFeedbackGenerator.cpp',
       'src/RTC/TransportTuple.cpp',
       'src/RTC/UdpSocket.cpp',
+      'src/RTC/Codecs/H264.cpp',
+      'src/RTC/Codecs/Tools.cpp',
+      'src/RTC/Codecs/VP8.cpp',
       'src/RTC/RtpDictionaries/Media.cpp',
       'src/RTC/RtpDictionaries/Parameters.cpp',
       'src/RTC/RtpDictionaries/RtcpFeedback.cpp',
@@ -58,7 +74,7 @@
       'src/RTC/RtpDictionaries/RtpParameters.cpp',
       'src/RTC/RtpDictionaries/RtpRtxParameters.cpp',
       'src/RTC/RTCP/Packet.cpp',
-      'src/RTC/RTCP/CompoundPacket.cpp',
+      'src/RTC/RTCP/PacketView.cpp',
       'src/RTC/RTCP/SenderReport.cpp',
       'src/RTC/RTCP/ReceiverReport.cpp',
       'src/RTC/RTCP/Sdes.cpp',
@@ -68,6 +84,7 @@
       'src/RTC/RTCP/FeedbackRtp.cpp',
       'src/RTC/RTCP/FeedbackRtpNack.cpp',
       'src/RTC/RTCP/FeedbackRtpTmmb.cpp',
+      'src/RTC/RTCP/FeedbackRtpTransport.cpp',
       'src/RTC/RTCP/FeedbackRtpSrReq.cpp',
       'src/RTC/RTCP/FeedbackRtpTllei.cpp',
       'src/RTC/RTCP/FeedbackRtpEcn.cpp',
@@ -89,10 +106,13 @@
       'src/Utils/Crypto.cpp',
       'src/Utils/File.cpp',
       'src/Utils/IP.cpp',
+      'src/handles/Check.cpp',
+      'src/handles/Idle.cpp',
       'src/handles/SignalsHandler.cpp',
       'src/handles/TcpConnection.cpp',
       'src/handles/TcpServer.cpp',
       'src/handles/Timer.cpp',
+      'src/handles/TimerWheel.cpp',
       'src/handles/UdpSocket.cpp',
       'src/handles/UnixStreamSocket.cpp',
       # C++ include files
@@ -100,24 +120,34 @@
       'include/DepLibUV.hpp',
       'include/DepOpenSSL.hpp',
       'include/LogLevel.hpp',
+      'include/LatencyProbes.hpp',
       'include/Logger.hpp',
       'include/Loop.hpp',
       'include/MediaSoupError.hpp',
       'include/Settings.hpp',
       'include/Utils.hpp',
       'include/common.hpp',
+      'include/Channel/BinaryCodec.hpp',
+      'include/Channel/DumpWriter.hpp',
       'include/Channel/Notifier.hpp',
       'include/Channel/Request.hpp',
       'include/Channel/UnixStreamSocket.hpp',
+      'include/RTC/ActiveSpeakerDetector.hpp',
+      'include/RTC/BitrateAllocator.hpp',
       'include/RTC/DtlsTransport.hpp',
       'include/RTC/IceCandidate.hpp',
       'include/RTC/IceServer.hpp',
+      'include/RTC/KeyFrameCache.hpp',
       'include/RTC/NackGenerator.hpp',
+      'include/RTC/Pacer.hpp',
+      'include/RTC/PacketTap.hpp',
       'include/RTC/Parameters.hpp',
       'include/RTC/Peer.hpp',
       'include/RTC/Room.hpp',
       'include/RTC/VP9Filter.hpp',
       'include/RTC/RtpDictionaries.hpp',
+      'include/RTC/RtcpFeedbackAggregator.hpp',
+      'include/RTC/RtcpScheduler.hpp',
       'include/RTC/RtpListener.hpp',
       'include/RTC/RtpPacket.hpp',
       'include/RTC/RtpReceiver.hpp',
@@ -126,15 +156,22 @@
       'include/RTC/RtpStreamRecv.hpp',
       'include/RTC/RtpStreamSend.hpp',
       'include/RTC/RtpDataCounter.hpp',
+      'include/RTC/SendSideBandwidthEstimator.hpp',
       'include/RTC/SrtpSession.hpp',
+      'include/RTC/StatsSnapshot.hpp',
       'include/RTC/StunMessage.hpp',
       'include/RTC/TcpConnection.hpp',
       'include/RTC/TcpServer.hpp',
       'include/RTC/Transport.hpp',
+      'include/RTC/TransportFeedbackGenerator.hpp',
       'include/RTC/TransportTuple.hpp',
       'include/RTC/UdpSocket.hpp',
+      'include/RTC/Codecs/H264.hpp',
+      'include/RTC/Codecs/Handlers.hpp',
+      'include/RTC/Codecs/Tools.hpp',
+      'include/RTC/Codecs/VP8.hpp',
       'include/RTC/RTCP/Packet.hpp',
-      'include/RTC/RTCP/CompoundPacket.hpp',
+      'include/RTC/RTCP/PacketView.hpp',
       'include/RTC/RTCP/SenderReport.hpp',
       'include/RTC/RTCP/ReceiverReport.hpp',
       'include/RTC/RTCP/Sdes.hpp',
@@ -145,6 +182,7 @@
       'include/RTC/RTCP/FeedbackRtp.hpp',
       'include/RTC/RTCP/FeedbackRtpNack.hpp',
       'include/RTC/RTCP/FeedbackRtpTmmb.hpp',
+      'include/RTC/RTCP/FeedbackRtpTransport.hpp',
       'include/RTC/RTCP/FeedbackRtpSrReq.hpp',
       'include/RTC/RTCP/FeedbackRtpTllei.hpp',
       'include/RTC/RTCP/FeedbackRtpEcn.hpp',
@@ -164,10 +202,13 @@
       'include/RTC/RemoteBitrateEstimator/RemoteBitrateEstimator.hpp',
       'include/RTC/RemoteBitrateEstimator/RemoteBitrateEstimatorAbsSendTime.hpp',
       'include/RTC/RemoteBitrateEstimator/RemoteBitrateEstimatorSingleStream.hpp',
+      'include/handles/Check.hpp',
+      'include/handles/Idle.hpp',
       'include/handles/SignalsHandler.hpp',
       'include/handles/TcpConnection.hpp',
       'include/handles/TcpServer.hpp',
       'include/handles/Timer.hpp',
+      'include/handles/TimerWheel.hpp',
       'include/handles/UdpSocket.hpp',
       'include/handles/UnixStreamSocket.hpp'
     ],
@@ -209,6 +250,10 @@
         ]
       }],
 
+      [ 'mediasoup_latency_probes == "true"', {
+        'defines': [ 'MS_LATENCY_PROBES' ]
+      }],
+
       [ 'OS == "linux" and mediasoup_asan == "true"', {
         'cflags': [ '-fsanitize=address' ],
         'ldflags': [ '-fsanitize=address' ]
@@ -260,9 +305,27 @@
         'test/test-rtcp.cpp',
         'test/test-bitrate.cpp',
         'test/test-rtpstreamrecv.cpp',
+        'test/test-rtcpfeedbackaggregator.cpp',
+        'test/test-rtcpscheduler.cpp',
+        'test/test-keyframecache.cpp',
+        'test/test-pacer.cpp',
+        'test/test-packettap.cpp',
+        'test/test-sendsidebandwidthestimator.cpp',
+        'test/test-transportfeedbackgenerator.cpp',
+        'test/test-bitrateallocator.cpp',
+        'test/test-codecs.cpp',
+        'test/test-activespeakerdetector.cpp',
+        'test/test-timerwheel.cpp',
+        'test/test-binarycodec.cpp',
+        'test/test-statssnapshot.cpp',
+        'test/test-latencyprobes.cpp',
+        'test/test-channel.cpp',
+        'test/benchmark-rtcp.cpp',
+        'test/benchmark-channel.cpp',
         # C++ include files
         'test/catch.hpp',
-        'test/helpers.hpp'
+        'test/helpers.hpp',
+        'test/include/rtcpfixtures.hpp'
       ]
     }
   ]
@@ -99,6 +99,12 @@ if __name__ == '__main__':
   else:
     args.append('-Dmediasoup_asan=false')
 
+  if 'no-latency-probes' in args:
+    args.append('-Dmediasoup_latency_probes=false')
+    args = filter(lambda arg: arg != 'no-latency-probes', args)
+  else:
+    args.append('-Dmediasoup_latency_probes=true')
+
   args.append('-Dnode_byteorder=' + sys.byteorder)
 
   gyp_args = list(args)
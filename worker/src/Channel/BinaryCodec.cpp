@@ -0,0 +1,380 @@
+#define MS_CLASS "Channel::BinaryCodec"
+// #define MS_LOG_DEV
+
+#include "Channel/BinaryCodec.hpp"
+#include "Logger.hpp"
+#include <cstring> // std::memcpy(), std::strlen()
+#include <string>
+
+namespace Channel
+{
+	/* Static. */
+
+	// Nesting of arrays and objects allowed when decoding.
+	static constexpr size_t MaxDepth{ 64 };
+
+	using Tag = BinaryCodec::Tag;
+
+	static bool readVarint(const uint8_t* data, size_t len, size_t& pos, uint64_t& value)
+	{
+		value = 0;
+
+		for (uint8_t shift{ 0 }; shift < 64; shift += 7)
+		{
+			if (pos >= len)
+				return false;
+
+			uint8_t byte = data[pos++];
+
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+			if ((byte & 0x80) == 0)
+				return true;
+		}
+
+		return false;
+	}
+
+	static bool decodeValue(
+	    const uint8_t* data, size_t len, size_t& pos, Json::Value& json, size_t depth)
+	{
+		if (pos >= len || depth > MaxDepth)
+			return false;
+
+		auto tag = Tag(data[pos++]);
+		uint64_t value;
+
+		switch (tag)
+		{
+			case Tag::NULL_VALUE:
+			{
+				json = Json::Value(Json::nullValue);
+
+				return true;
+			}
+
+			case Tag::BOOL_FALSE:
+			case Tag::BOOL_TRUE:
+			{
+				json = (tag == Tag::BOOL_TRUE);
+
+				return true;
+			}
+
+			case Tag::UINT:
+			{
+				if (!readVarint(data, len, pos, value))
+					return false;
+
+				// As the JSON reader does, so type checks work the same with both.
+				if (value <= INT64_MAX)
+					json = Json::Int64{ static_cast<int64_t>(value) };
+				else
+					json = Json::UInt64{ value };
+
+				return true;
+			}
+
+			case Tag::NEGATIVE_INT:
+			{
+				if (!readVarint(data, len, pos, value) || value > INT64_MAX)
+					return false;
+
+				json = Json::Int64{ -static_cast<int64_t>(value) - 1 };
+
+				return true;
+			}
+
+			case Tag::DOUBLE:
+			{
+				uint64_t bits{ 0 };
+				double number;
+
+				if (len - pos < sizeof(bits))
+					return false;
+
+				for (size_t i{ 0 }; i < sizeof(bits); ++i)
+				{
+					bits |= static_cast<uint64_t>(data[pos++]) << (8 * i);
+				}
+
+				std::memcpy(&number, &bits, sizeof(number));
+				json = number;
+
+				return true;
+			}
+
+			case Tag::STRING:
+			{
+				if (!readVarint(data, len, pos, value) || len - pos < value)
+					return false;
+
+				auto* begin = reinterpret_cast<const char*>(data + pos);
+
+				json = Json::Value(begin, begin + value);
+				pos += value;
+
+				return true;
+			}
+
+			case Tag::ARRAY:
+			{
+				// Every item takes at least one byte.
+				if (!readVarint(data, len, pos, value) || len - pos < value)
+					return false;
+
+				json = Json::Value(Json::arrayValue);
+
+				for (uint64_t i{ 0 }; i < value; ++i)
+				{
+					if (!decodeValue(data, len, pos, json.append(Json::nullValue), depth + 1))
+						return false;
+				}
+
+				return true;
+			}
+
+			case Tag::OBJECT:
+			{
+				// Every member takes at least two bytes.
+				if (!readVarint(data, len, pos, value) || (len - pos) / 2 < value)
+					return false;
+
+				json = Json::Value(Json::objectValue);
+
+				for (uint64_t i{ 0 }; i < value; ++i)
+				{
+					uint64_t keyLen;
+
+					if (!readVarint(data, len, pos, keyLen) || len - pos < keyLen)
+						return false;
+
+					std::string key(reinterpret_cast<const char*>(data + pos), keyLen);
+
+					pos += keyLen;
+
+					if (!decodeValue(data, len, pos, json[key], depth + 1))
+						return false;
+				}
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/* Class methods. */
+
+	/**
+	 * Writes the Marker and the given value into the buffer.
+	 * @return  Written length, 0 if it does not fit.
+	 */
+	size_t BinaryCodec::Encode(const Json::Value& json, uint8_t* buffer, size_t size)
+	{
+		MS_TRACE_STD();
+
+		Writer writer(buffer, size);
+
+		writer.WriteJson(json);
+
+		return writer.GetLength();
+	}
+
+	bool BinaryCodec::Decode(const uint8_t* data, size_t len, Json::Value& json)
+	{
+		MS_TRACE_STD();
+
+		size_t pos{ 0 };
+
+		if (!IsBinary(data, len))
+			return false;
+
+		pos++;
+
+		return decodeValue(data, len, pos, json, 0) && pos == len;
+	}
+
+	/* Writer instance methods. */
+
+	/**
+	 * The message starts with the Marker.
+	 */
+	BinaryCodec::Writer::Writer(uint8_t* buffer, size_t size) : buffer(buffer), size(size)
+	{
+		WriteByte(Marker);
+	}
+
+	void BinaryCodec::Writer::WriteNull()
+	{
+		WriteByte(static_cast<uint8_t>(Tag::NULL_VALUE));
+	}
+
+	void BinaryCodec::Writer::WriteBool(bool value)
+	{
+		WriteByte(static_cast<uint8_t>(value ? Tag::BOOL_TRUE : Tag::BOOL_FALSE));
+	}
+
+	void BinaryCodec::Writer::WriteUInt(uint64_t value)
+	{
+		WriteByte(static_cast<uint8_t>(Tag::UINT));
+		WriteVarint(value);
+	}
+
+	void BinaryCodec::Writer::WriteInt(int64_t value)
+	{
+		if (value >= 0)
+		{
+			WriteUInt(static_cast<uint64_t>(value));
+
+			return;
+		}
+
+		WriteByte(static_cast<uint8_t>(Tag::NEGATIVE_INT));
+		WriteVarint(static_cast<uint64_t>(-(value + 1)));
+	}
+
+	void BinaryCodec::Writer::WriteDouble(double value)
+	{
+		uint64_t bits;
+
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		WriteByte(static_cast<uint8_t>(Tag::DOUBLE));
+
+		for (size_t i{ 0 }; i < sizeof(bits); ++i, bits >>= 8)
+		{
+			WriteByte(static_cast<uint8_t>(bits));
+		}
+	}
+
+	void BinaryCodec::Writer::WriteString(const char* data, size_t len)
+	{
+		WriteByte(static_cast<uint8_t>(Tag::STRING));
+		WriteBytes(data, len);
+	}
+
+	void BinaryCodec::Writer::WriteArray(size_t count)
+	{
+		WriteByte(static_cast<uint8_t>(Tag::ARRAY));
+		WriteVarint(count);
+	}
+
+	void BinaryCodec::Writer::WriteObject(size_t count)
+	{
+		WriteByte(static_cast<uint8_t>(Tag::OBJECT));
+		WriteVarint(count);
+	}
+
+	void BinaryCodec::Writer::WriteKey(const char* key)
+	{
+		WriteBytes(key, std::strlen(key));
+	}
+
+	void BinaryCodec::Writer::WriteJson(const Json::Value& json)
+	{
+		switch (json.type())
+		{
+			case Json::nullValue:
+				WriteNull();
+				break;
+
+			case Json::booleanValue:
+				WriteBool(json.asBool());
+				break;
+
+			case Json::intValue:
+				WriteInt(json.asLargestInt());
+				break;
+
+			case Json::uintValue:
+				WriteUInt(json.asLargestUInt());
+				break;
+
+			case Json::realValue:
+				WriteDouble(json.asDouble());
+				break;
+
+			case Json::stringValue:
+			{
+				const char* begin;
+				const char* end;
+
+				json.getString(&begin, &end);
+				WriteString(begin, end - begin);
+
+				break;
+			}
+
+			case Json::arrayValue:
+			{
+				WriteArray(json.size());
+
+				for (auto& item : json)
+				{
+					WriteJson(item);
+				}
+
+				break;
+			}
+
+			case Json::objectValue:
+			{
+				WriteObject(json.size());
+
+				for (auto it = json.begin(); it != json.end(); ++it)
+				{
+					const char* end;
+					const char* begin = it.memberName(&end);
+
+					WriteBytes(begin, end - begin);
+					WriteJson(*it);
+				}
+
+				break;
+			}
+		}
+	}
+
+	void BinaryCodec::Writer::WriteByte(uint8_t byte)
+	{
+		// Keep counting the length once full.
+		if (this->pos >= this->size)
+		{
+			this->overflow = true;
+			this->pos++;
+
+			return;
+		}
+
+		this->buffer[this->pos++] = byte;
+	}
+
+	void BinaryCodec::Writer::WriteVarint(uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			WriteByte(static_cast<uint8_t>(value | 0x80));
+
+			value >>= 7;
+		}
+
+		WriteByte(static_cast<uint8_t>(value));
+	}
+
+	void BinaryCodec::Writer::WriteBytes(const char* data, size_t len)
+	{
+		WriteVarint(len);
+
+		if (this->pos > this->size || this->size - this->pos < len)
+		{
+			this->overflow = true;
+			this->pos += len;
+
+			return;
+		}
+
+		std::memcpy(this->buffer + this->pos, data, len);
+		this->pos += len;
+	}
+} // namespace Channel
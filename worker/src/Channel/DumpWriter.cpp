@@ -0,0 +1,64 @@
+#define MS_CLASS "Channel::DumpWriter"
+// #define MS_LOG_DEV
+
+#include "Channel/DumpWriter.hpp"
+#include "Logger.hpp"
+
+namespace Channel
+{
+	/* Instance methods. */
+
+	DumpWriter::DumpWriter(Listener* listener, Channel::Request* request) : listener(listener)
+	{
+		MS_TRACE();
+
+		// The given Request is deleted once handled, so reply through a copy.
+		this->request = new Channel::Request(*request);
+		request->replied = true;
+
+		// Run a step per loop iteration, starting with the next one.
+		this->idle = new Idle(this);
+		this->idle->Start();
+	}
+
+	DumpWriter::~DumpWriter()
+	{
+		MS_TRACE();
+
+		delete this->request;
+	}
+
+	/**
+	 * Rejects the Request if not yet replied.
+	 */
+	void DumpWriter::Destroy()
+	{
+		MS_TRACE();
+
+		if (!this->request->replied)
+			this->request->Reject("dump aborted");
+
+		this->idle->Destroy();
+
+		delete this;
+	}
+
+	inline void DumpWriter::OnIdle(Idle* /*idle*/)
+	{
+		MS_TRACE();
+
+		Json::Value data(Json::objectValue);
+
+		if (this->listener->OnDumpWriterStep(this, this->step++, data))
+		{
+			this->request->Accept(data);
+
+			Destroy();
+
+			return;
+		}
+
+		if (!data.empty())
+			this->request->AcceptPartial(data);
+	}
+} // namespace Channel
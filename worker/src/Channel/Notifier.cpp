@@ -2,55 +2,248 @@
 // #define MS_LOG_DEV
 
 #include "Channel/Notifier.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 
 namespace Channel
 {
+	/* Static. */
+
+	// Events emitted for every received RTP packet.
+	static constexpr uint32_t MaxPacketEventsPerSecond{ 2000 };
+	static constexpr size_t MessageMaxSize{ 65536 };
+	static uint8_t EncodeBuffer[MessageMaxSize];
+
 	/* Instance methods. */
 
 	Notifier::Notifier(Channel::UnixStreamSocket* channel) : channel(channel)
 	{
 		MS_TRACE();
+
+		this->rtpRawRateLimit.maxPerSecond    = MaxPacketEventsPerSecond;
+		this->rtpObjectRateLimit.maxPerSecond = MaxPacketEventsPerSecond;
 	}
 
 	void Notifier::Emit(uint32_t targetId, const std::string& event)
 	{
 		MS_TRACE();
 
-		static const Json::StaticString JsonStringTargetId{ "targetId" };
-		static const Json::StaticString JsonStringEvent{ "event" };
+		SendEvent(targetId, event, nullptr, nullptr, 0, false);
+	}
 
-		Json::Value json(Json::objectValue);
+	void Notifier::Emit(uint32_t targetId, const std::string& event, Json::Value& data)
+	{
+		MS_TRACE();
 
-		json[JsonStringTargetId] = Json::UInt{ targetId };
-		json[JsonStringEvent]    = event;
+		SendEvent(targetId, event, &data, nullptr, 0, false);
+	}
+
+	void Notifier::EmitWithBinary(
+	    uint32_t targetId,
+	    const std::string& event,
+	    Json::Value& data,
+	    const uint8_t* binaryData,
+	    size_t binaryLen)
+	{
+		MS_TRACE();
 
-		this->channel->Send(json);
+		SendEvent(targetId, event, &data, binaryData, binaryLen, false);
 	}
 
-	void Notifier::Emit(uint32_t targetId, const std::string& event, Json::Value& data)
+	void Notifier::EmitAudioLevels(uint32_t targetId, const std::vector<AudioLevel>& entries)
 	{
 		MS_TRACE();
 
-		static const Json::StaticString JsonStringTargetId{ "targetId" };
-		static const Json::StaticString JsonStringEvent{ "event" };
-		static const Json::StaticString JsonStringData{ "data" };
+		static const std::string Event{ "audiolevels" };
+		static const Json::StaticString JsonStringClass{ "class" };
+		static const Json::StaticString JsonStringEntries{ "entries" };
 
-		Json::Value json(Json::objectValue);
+		if (!this->channel->IsBinary())
+		{
+			Json::Value data(Json::objectValue);
 
-		json[JsonStringTargetId] = Json::UInt{ targetId };
-		json[JsonStringEvent]    = event;
-		json[JsonStringData]     = data;
+			data[JsonStringClass]   = "Room";
+			data[JsonStringEntries] = Json::arrayValue;
+
+			for (auto& entry : entries)
+			{
+				Json::Value jsonEntry(Json::arrayValue);
+
+				jsonEntry.append(Json::UInt{ entry.rtpReceiverId });
+				jsonEntry.append(Json::Int{ entry.level });
+
+				data[JsonStringEntries].append(jsonEntry);
+			}
+
+			SendEvent(targetId, Event, &data, nullptr, 0, false);
+
+			return;
+		}
+
+		BinaryCodec::Writer writer(EncodeBuffer, MessageMaxSize);
+
+		WriteEvent(writer, targetId, Event, 3);
+		writer.WriteKey("data");
+		writer.WriteObject(2);
+		writer.WriteKey("class");
+		writer.WriteString("Room", 4);
+		writer.WriteKey("entries");
+		writer.WriteArray(entries.size());
 
-		this->channel->Send(json);
+		for (auto& entry : entries)
+		{
+			writer.WriteArray(2);
+			writer.WriteUInt(entry.rtpReceiverId);
+			writer.WriteInt(entry.level);
+		}
+
+		this->channel->SendEvent(EncodeBuffer, writer.GetLength());
 	}
 
-	void Notifier::EmitWithBinary(
+	void Notifier::EmitRtpRaw(uint32_t targetId, const uint8_t* packet, size_t packetLen)
+	{
+		MS_TRACE();
+
+		static const std::string Event{ "rtpraw" };
+		static const Json::StaticString JsonStringClass{ "class" };
+
+		if (!IsAllowed(this->rtpRawRateLimit, Event))
+			return;
+
+		if (!this->channel->IsBinary())
+		{
+			Json::Value data(Json::objectValue);
+
+			data[JsonStringClass] = "RtpReceiver";
+
+			SendEvent(targetId, Event, &data, packet, packetLen, true);
+
+			return;
+		}
+
+		BinaryCodec::Writer writer(EncodeBuffer, MessageMaxSize);
+
+		WriteEvent(writer, targetId, Event, 4);
+		writer.WriteKey("data");
+		writer.WriteObject(1);
+		writer.WriteKey("class");
+		writer.WriteString("RtpReceiver", 11);
+		writer.WriteKey("binary");
+		writer.WriteBool(true);
+
+		this->channel->SendEvent(EncodeBuffer, writer.GetLength(), packet, packetLen, true);
+	}
+
+	void Notifier::EmitRtpObject(
+	    uint32_t targetId, const RtpObject& object, const uint8_t* payload, size_t payloadLen)
+	{
+		MS_TRACE();
+
+		static const std::string Event{ "rtpobject" };
+		static const Json::StaticString JsonStringClass{ "class" };
+		static const Json::StaticString JsonStringObject{ "object" };
+		static const Json::StaticString JsonStringPayloadType{ "payloadType" };
+		static const Json::StaticString JsonStringMarker{ "marker" };
+		static const Json::StaticString JsonStringSequenceNumber{ "sequenceNumber" };
+		static const Json::StaticString JsonStringTimestamp{ "timestamp" };
+		static const Json::StaticString JsonStringSsrc{ "ssrc" };
+
+		if (!IsAllowed(this->rtpObjectRateLimit, Event))
+			return;
+
+		if (!this->channel->IsBinary())
+		{
+			Json::Value data(Json::objectValue);
+			Json::Value jsonObject(Json::objectValue);
+
+			data[JsonStringClass] = "RtpReceiver";
+
+			jsonObject[JsonStringPayloadType]    = Json::UInt{ object.payloadType };
+			jsonObject[JsonStringMarker]         = object.marker;
+			jsonObject[JsonStringSequenceNumber] = Json::UInt{ object.sequenceNumber };
+			jsonObject[JsonStringTimestamp]      = Json::UInt{ object.timestamp };
+			jsonObject[JsonStringSsrc]           = Json::UInt{ object.ssrc };
+
+			data[JsonStringObject] = jsonObject;
+
+			SendEvent(targetId, Event, &data, payload, payloadLen, true);
+
+			return;
+		}
+
+		BinaryCodec::Writer writer(EncodeBuffer, MessageMaxSize);
+
+		WriteEvent(writer, targetId, Event, 4);
+		writer.WriteKey("data");
+		writer.WriteObject(2);
+		writer.WriteKey("class");
+		writer.WriteString("RtpReceiver", 11);
+		writer.WriteKey("object");
+		writer.WriteObject(5);
+		writer.WriteKey("payloadType");
+		writer.WriteUInt(object.payloadType);
+		writer.WriteKey("marker");
+		writer.WriteBool(object.marker);
+		writer.WriteKey("sequenceNumber");
+		writer.WriteUInt(object.sequenceNumber);
+		writer.WriteKey("timestamp");
+		writer.WriteUInt(object.timestamp);
+		writer.WriteKey("ssrc");
+		writer.WriteUInt(object.ssrc);
+		writer.WriteKey("binary");
+		writer.WriteBool(true);
+
+		this->channel->SendEvent(EncodeBuffer, writer.GetLength(), payload, payloadLen, true);
+	}
+
+	/**
+	 * Whether the rate limit of the event lets it be emitted now.
+	 */
+	bool Notifier::IsAllowed(RateLimit& rateLimit, const std::string& event)
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+
+		if (now - rateLimit.periodStart >= 1000)
+		{
+			if (rateLimit.dropped != 0)
+			{
+				MS_WARN_TAG(
+				    info,
+				    "%" PRIu32 " \"%s\" events dropped by the rate limit",
+				    rateLimit.dropped,
+				    event.c_str());
+			}
+
+			rateLimit.periodStart = now;
+			rateLimit.count       = 0;
+			rateLimit.dropped     = 0;
+		}
+
+		if (rateLimit.count >= rateLimit.maxPerSecond)
+		{
+			++rateLimit.dropped;
+
+			return false;
+		}
+
+		++rateLimit.count;
+
+		return true;
+	}
+
+	/**
+	 * Sends the event in the format of the Channel, with the given data and
+	 * binary data if not null.
+	 */
+	void Notifier::SendEvent(
 	    uint32_t targetId,
 	    const std::string& event,
-	    Json::Value& data,
+	    const Json::Value* data,
 	    const uint8_t* binaryData,
-	    size_t binaryLen)
+	    size_t binaryLen,
+	    bool droppable)
 	{
 		MS_TRACE();
 
@@ -59,14 +252,65 @@ namespace Channel
 		static const Json::StaticString JsonStringData{ "data" };
 		static const Json::StaticString JsonStringBinary{ "binary" };
 
+		size_t numMembers{ 2 };
+
+		if (data != nullptr)
+			++numMembers;
+
+		if (binaryData != nullptr)
+			++numMembers;
+
+		if (this->channel->IsBinary())
+		{
+			BinaryCodec::Writer writer(EncodeBuffer, MessageMaxSize);
+
+			WriteEvent(writer, targetId, event, numMembers);
+
+			if (data != nullptr)
+			{
+				writer.WriteKey("data");
+				writer.WriteJson(*data);
+			}
+
+			if (binaryData != nullptr)
+			{
+				writer.WriteKey("binary");
+				writer.WriteBool(true);
+			}
+
+			this->channel->SendEvent(
+			    EncodeBuffer, writer.GetLength(), binaryData, binaryLen, droppable);
+
+			return;
+		}
+
 		Json::Value json(Json::objectValue);
 
 		json[JsonStringTargetId] = Json::UInt{ targetId };
 		json[JsonStringEvent]    = event;
-		json[JsonStringData]     = data;
-		json[JsonStringBinary]   = true;
 
-		this->channel->Send(json);
-		this->channel->SendBinary(binaryData, binaryLen);
+		if (data != nullptr)
+			json[JsonStringData] = *data;
+
+		if (binaryData != nullptr)
+			json[JsonStringBinary] = true;
+
+		this->channel->SendEvent(json, binaryData, binaryLen, droppable);
+	}
+
+	/**
+	 * Starts a binary event with its targetId and event members, followed by
+	 * the given number of members in total.
+	 */
+	void Notifier::WriteEvent(
+	    BinaryCodec::Writer& writer, uint32_t targetId, const std::string& event, size_t numMembers)
+	{
+		MS_TRACE();
+
+		writer.WriteObject(numMembers);
+		writer.WriteKey("targetId");
+		writer.WriteUInt(targetId);
+		writer.WriteKey("event");
+		writer.WriteString(event);
 	}
 } // namespace Channel
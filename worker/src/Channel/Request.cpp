@@ -3,6 +3,7 @@
 
 #include "Channel/Request.hpp"
 #include "Logger.hpp"
+#include "Channel/UnixStreamSocket.hpp"
 #include "MediaSoupError.hpp"
 
 namespace Channel
@@ -12,32 +13,42 @@ namespace Channel
 	// clang-format off
 	std::unordered_map<std::string, Request::MethodId> Request::string2MethodId =
 	{
-		{ "worker.dump",                       Request::MethodId::WORKER_DUMP                          },
-		{ "worker.updateSettings",             Request::MethodId::WORKER_UPDATE_SETTINGS               },
-		{ "worker.createRoom",                 Request::MethodId::WORKER_CREATE_ROOM                   },
-		{ "room.close",                        Request::MethodId::ROOM_CLOSE                           },
-		{ "room.dump",                         Request::MethodId::ROOM_DUMP                            },
-		{ "room.createPeer",                   Request::MethodId::ROOM_CREATE_PEER                     },
-		{ "room.setAudioLevelsEvent",          Request::MethodId::ROOM_SET_AUDIO_LEVELS_EVENT          },
-		{ "peer.close",                        Request::MethodId::PEER_CLOSE                           },
-		{ "peer.dump",                         Request::MethodId::PEER_DUMP                            },
-		{ "peer.setCapabilities",              Request::MethodId::PEER_SET_CAPABILITIES                },
-		{ "peer.createTransport",              Request::MethodId::PEER_CREATE_TRANSPORT                },
-		{ "peer.createRtpReceiver",            Request::MethodId::PEER_CREATE_RTP_RECEIVER             },
-		{ "transport.close",                   Request::MethodId::TRANSPORT_CLOSE                      },
-		{ "transport.dump",                    Request::MethodId::TRANSPORT_DUMP                       },
-		{ "transport.setRemoteDtlsParameters", Request::MethodId::TRANSPORT_SET_REMOTE_DTLS_PARAMETERS },
-		{ "transport.setMaxBitrate",           Request::MethodId::TRANSPORT_SET_MAX_BITRATE            },
-		{ "transport.changeUfragPwd",          Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD           },
-		{ "rtpReceiver.close",                 Request::MethodId::RTP_RECEIVER_CLOSE                   },
-		{ "rtpReceiver.dump",                  Request::MethodId::RTP_RECEIVER_DUMP                    },
-		{ "rtpReceiver.receive",               Request::MethodId::RTP_RECEIVER_RECEIVE                 },
-		{ "rtpReceiver.setTransport",          Request::MethodId::RTP_RECEIVER_SET_TRANSPORT           },
-		{ "rtpReceiver.setRtpRawEvent",        Request::MethodId::RTP_RECEIVER_SET_RTP_RAW_EVENT       },
-		{ "rtpReceiver.setRtpObjectEvent",     Request::MethodId::RTP_RECEIVER_SET_RTP_OBJECT_EVENT    },
-		{ "rtpSender.dump",                    Request::MethodId::RTP_SENDER_DUMP                      },
-		{ "rtpSender.setTransport",            Request::MethodId::RTP_SENDER_SET_TRANSPORT             },
-		{ "rtpSender.disable",                 Request::MethodId::RTP_SENDER_DISABLE                   }
+		{ "worker.dump",                       Request::MethodId::WORKER_DUMP                           },
+		{ "worker.updateSettings",             Request::MethodId::WORKER_UPDATE_SETTINGS                },
+		{ "worker.getLatency",                 Request::MethodId::WORKER_GET_LATENCY                    },
+		{ "worker.createRoom",                 Request::MethodId::WORKER_CREATE_ROOM                    },
+		{ "room.close",                        Request::MethodId::ROOM_CLOSE                            },
+		{ "room.dump",                         Request::MethodId::ROOM_DUMP                             },
+		{ "room.getStats",                     Request::MethodId::ROOM_GET_STATS                        },
+		{ "room.createPeer",                   Request::MethodId::ROOM_CREATE_PEER                      },
+		{ "room.setAudioLevelsEvent",          Request::MethodId::ROOM_SET_AUDIO_LEVELS_EVENT           },
+		{ "room.setLastN",                     Request::MethodId::ROOM_SET_LAST_N                       },
+		{ "peer.close",                        Request::MethodId::PEER_CLOSE                            },
+		{ "peer.dump",                         Request::MethodId::PEER_DUMP                             },
+		{ "peer.setCapabilities",              Request::MethodId::PEER_SET_CAPABILITIES                 },
+		{ "peer.createTransport",              Request::MethodId::PEER_CREATE_TRANSPORT                 },
+		{ "peer.createRtpReceiver",            Request::MethodId::PEER_CREATE_RTP_RECEIVER              },
+		{ "peer.createActiveSpeakerRtpSender", Request::MethodId::PEER_CREATE_ACTIVE_SPEAKER_RTP_SENDER },
+		{ "transport.close",                   Request::MethodId::TRANSPORT_CLOSE                       },
+		{ "transport.dump",                    Request::MethodId::TRANSPORT_DUMP                        },
+		{ "transport.getStats",                Request::MethodId::TRANSPORT_GET_STATS                   },
+		{ "transport.setRemoteDtlsParameters", Request::MethodId::TRANSPORT_SET_REMOTE_DTLS_PARAMETERS  },
+		{ "transport.setMaxBitrate",           Request::MethodId::TRANSPORT_SET_MAX_BITRATE             },
+		{ "transport.changeUfragPwd",          Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD            },
+		{ "transport.setRemoteParameters",     Request::MethodId::TRANSPORT_SET_REMOTE_PARAMETERS       },
+		{ "rtpReceiver.close",                 Request::MethodId::RTP_RECEIVER_CLOSE                    },
+		{ "rtpReceiver.dump",                  Request::MethodId::RTP_RECEIVER_DUMP                     },
+		{ "rtpReceiver.receive",               Request::MethodId::RTP_RECEIVER_RECEIVE                  },
+		{ "rtpReceiver.setTransport",          Request::MethodId::RTP_RECEIVER_SET_TRANSPORT            },
+		{ "rtpReceiver.setRtpRawEvent",        Request::MethodId::RTP_RECEIVER_SET_RTP_RAW_EVENT        },
+		{ "rtpReceiver.setRtpObjectEvent",     Request::MethodId::RTP_RECEIVER_SET_RTP_OBJECT_EVENT     },
+		{ "rtpReceiver.setRtpTap",             Request::MethodId::RTP_RECEIVER_SET_RTP_TAP              },
+		{ "rtpSender.dump",                    Request::MethodId::RTP_SENDER_DUMP                       },
+		{ "rtpSender.setTransport",            Request::MethodId::RTP_SENDER_SET_TRANSPORT              },
+		{ "rtpSender.disable",                 Request::MethodId::RTP_SENDER_DISABLE                    },
+		{ "rtpSender.setPreferredLayers",      Request::MethodId::RTP_SENDER_SET_PREFERRED_LAYERS       },
+		{ "rtpSender.setPinned",               Request::MethodId::RTP_SENDER_SET_PINNED                 },
+		{ "rtpSender.setMaxResolution",        Request::MethodId::RTP_SENDER_SET_MAX_RESOLUTION         }
 	};
 	// clang-format on
 
@@ -126,6 +137,70 @@ namespace Channel
 		this->channel->Send(json);
 	}
 
+	/**
+	 * Same as above, followed by the given binary data as a fragmented message
+	 * (so it is not limited to the size of a single netstring). Its length is
+	 * given in the response, and no fragments follow if it is empty.
+	 */
+	void Request::Accept(Json::Value& data, const uint8_t* binaryData, size_t binaryLen)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringId{ "id" };
+		static const Json::StaticString JsonStringAccepted{ "accepted" };
+		static const Json::StaticString JsonStringBinary{ "binary" };
+		static const Json::StaticString JsonStringBinaryLen{ "binaryLen" };
+		static const Json::StaticString JsonStringData{ "data" };
+
+		MS_ASSERT(!this->replied, "Request already replied");
+
+		if (binaryLen > Channel::UnixStreamSocket::FragmentedMessageMaxSize)
+		{
+			Reject("binary data too big");
+
+			return;
+		}
+
+		this->replied = true;
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringId]        = Json::UInt{ this->id };
+		json[JsonStringAccepted]  = true;
+		json[JsonStringBinary]    = true;
+		json[JsonStringBinaryLen] = Json::UInt{ static_cast<uint32_t>(binaryLen) };
+		json[JsonStringData]      = data;
+
+		this->channel->Send(json);
+
+		if (binaryLen != 0)
+			this->channel->SendFragments(binaryData, binaryLen);
+	}
+
+	/**
+	 * Send part of the response data ahead of Accept(). Node appends every
+	 * array in it to the same member of the final data, and merges an object
+	 * given for an array member into the last item of that array.
+	 */
+	void Request::AcceptPartial(Json::Value& data)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringId{ "id" };
+		static const Json::StaticString JsonStringPartial{ "partial" };
+		static const Json::StaticString JsonStringData{ "data" };
+
+		MS_ASSERT(!this->replied, "Request already replied");
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringId]      = Json::UInt{ this->id };
+		json[JsonStringPartial] = true;
+		json[JsonStringData]    = data;
+
+		this->channel->Send(json);
+	}
+
 	void Request::Reject(std::string& reason)
 	{
 		MS_TRACE();
@@ -3,11 +3,12 @@
 
 #include "Channel/UnixStreamSocket.hpp"
 #include "Logger.hpp"
+#include "Channel/BinaryCodec.hpp"
 #include "MediaSoupError.hpp"
-#include <cmath>   // std::ceil()
-#include <cstdio>  // sprintf()
-#include <cstring> // std::memmove()
-#include <sstream> // std::ostringstream
+#include <algorithm> // std::min()
+#include <cstdio>    // sprintf()
+#include <cstring>   // std::memcpy(), std::memmove()
+#include <sstream>   // std::ostringstream
 extern "C" {
 #include <netstring.h>
 }
@@ -19,7 +20,47 @@ namespace Channel
 	// netstring length for a 65536 bytes payload.
 	static constexpr size_t MaxSize{ 65543 };
 	static constexpr size_t MessageMaxSize{ 65536 };
+	// Queued events above which the oldest droppable ones are dropped.
+	static constexpr size_t EventsMaxSize{ 1048576 };
+	// Bytes not yet read by Node above which queued events are held back.
+	static constexpr size_t WriteQueueMaxSize{ 1048576 };
+	// Interval at which held back events are tried again (ms).
+	static constexpr uint64_t HeldEventsRetryInterval{ 10 };
+	// Fragments start with these instead of '{' or BinaryCodec::Marker.
+	static constexpr uint8_t FragmentMarker{ 0x01 };
+	static constexpr uint8_t LastFragmentMarker{ 0x02 };
 	static uint8_t WriteBuffer[MaxSize];
+	static uint8_t EncodeBuffer[MessageMaxSize];
+
+	static inline size_t getNetstringLen(size_t nsPayloadLen)
+	{
+		size_t nsNumLen{ 1 };
+
+		for (size_t len = nsPayloadLen; len >= 10; len /= 10)
+		{
+			++nsNumLen;
+		}
+
+		return nsNumLen + nsPayloadLen + 2;
+	}
+
+	/**
+	 * Writes the netstring of the given payload into buffer, which must have
+	 * room for getNetstringLen(nsPayloadLen) bytes.
+	 * @return  Written length.
+	 */
+	static size_t writeNetstring(uint8_t* buffer, const uint8_t* nsPayload, size_t nsPayloadLen)
+	{
+		size_t nsNumLen =
+		    std::sprintf(reinterpret_cast<char*>(buffer), "%zu:", nsPayloadLen) - 1;
+
+		if (nsPayloadLen != 0)
+			std::memcpy(buffer + nsNumLen + 1, nsPayload, nsPayloadLen);
+
+		buffer[nsNumLen + nsPayloadLen + 1] = ',';
+
+		return nsNumLen + nsPayloadLen + 2;
+	}
 
 	/* Instance methods. */
 
@@ -54,6 +95,12 @@ namespace Channel
 
 			this->jsonWriter = builder.newStreamWriter();
 		}
+
+		// Flush the events once per loop iteration.
+		this->flushCheck = new Check(this);
+
+		// Retry the events held back while Node is slow to read.
+		this->flushTimer = new Timer(this);
 	}
 
 	UnixStreamSocket::~UnixStreamSocket()
@@ -62,6 +109,9 @@ namespace Channel
 
 		delete this->jsonReader;
 		delete this->jsonWriter;
+
+		this->flushCheck->Destroy();
+		this->flushTimer->Destroy();
 	}
 
 	void UnixStreamSocket::SetListener(Listener* listener)
@@ -71,6 +121,17 @@ namespace Channel
 		this->listener = listener;
 	}
 
+	/**
+	 * Encode the messages sent from now on in binary instead of JSON. Received
+	 * messages are accepted in both encodings.
+	 */
+	void UnixStreamSocket::SetBinary(bool binary)
+	{
+		MS_TRACE_STD();
+
+		this->binary = binary;
+	}
+
 	void UnixStreamSocket::Send(Json::Value& msg)
 	{
 		if (this->closed)
@@ -78,41 +139,93 @@ namespace Channel
 
 		// MS_TRACE_STD();
 
-		std::ostringstream stream;
-		std::string nsPayload;
-		size_t nsPayloadLen;
-		size_t nsNumLen;
-		size_t nsLen;
+		std::vector<uint8_t> bigPayload;
+		size_t len = Encode(msg, &bigPayload);
 
-		this->jsonWriter->write(msg, &stream);
-		nsPayload    = stream.str();
-		nsPayloadLen = nsPayload.length();
+		// Don't let the message overtake the events emitted before it.
+		FlushEvents();
 
-		if (nsPayloadLen > MessageMaxSize)
+		if (len != 0)
+			SendBinary(EncodeBuffer, len);
+		else if (!bigPayload.empty())
+			SendFragments(bigPayload.data(), bigPayload.size());
+		else
+			MS_ERROR_STD("mesage too big");
+	}
+
+	/**
+	 * Queue the event until the end of the current loop iteration, so all the
+	 * events emitted within it are written at once. Droppable events may be
+	 * dropped if Node does not read them in time.
+	 */
+	void UnixStreamSocket::SendEvent(
+	    Json::Value& msg, const uint8_t* binaryData, size_t binaryLen, bool droppable)
+	{
+		if (this->closed)
+			return;
+
+		// MS_TRACE_STD();
+
+		if (binaryLen > MessageMaxSize)
 		{
 			MS_ERROR_STD("mesage too big");
 
 			return;
 		}
 
-		if (nsPayloadLen == 0)
+		size_t len = Encode(msg);
+
+		if (len == 0)
 		{
-			nsNumLen       = 1;
-			WriteBuffer[0] = '0';
-			WriteBuffer[1] = ':';
-			WriteBuffer[2] = ',';
+			MS_ERROR_STD("mesage too big");
+
+			return;
 		}
-		else
+
+		QueueEvent(EncodeBuffer, len, binaryData, binaryLen, droppable);
+	}
+
+	/**
+	 * Same as above, with the message already encoded.
+	 */
+	void UnixStreamSocket::SendEvent(
+	    const uint8_t* msg, size_t msgLen, const uint8_t* binaryData, size_t binaryLen, bool droppable)
+	{
+		if (this->closed)
+			return;
+
+		// MS_TRACE_STD();
+
+		if (msgLen == 0 || msgLen > MessageMaxSize || binaryLen > MessageMaxSize)
 		{
-			nsNumLen = static_cast<size_t>(std::ceil(std::log10(static_cast<double>(nsPayloadLen) + 1)));
-			std::sprintf(reinterpret_cast<char*>(WriteBuffer), "%zu:", nsPayloadLen);
-			std::memcpy(WriteBuffer + nsNumLen + 1, nsPayload.c_str(), nsPayloadLen);
-			WriteBuffer[nsNumLen + nsPayloadLen + 1] = ',';
+			MS_ERROR_STD("mesage too big");
+
+			return;
 		}
 
-		nsLen = nsNumLen + nsPayloadLen + 2;
+		QueueEvent(msg, msgLen, binaryData, binaryLen, droppable);
+	}
 
-		Write(WriteBuffer, nsLen);
+	/**
+	 * Write all the queued events in a single write.
+	 */
+	void UnixStreamSocket::FlushEvents()
+	{
+		// MS_TRACE_STD();
+
+		if (this->droppedEvents != 0)
+		{
+			MS_ERROR_STD("%zu events dropped, the Channel is not being read", this->droppedEvents);
+
+			this->droppedEvents = 0;
+		}
+
+		if (this->queuedEvents.empty())
+			return;
+
+		CompactEvents();
+		Write(this->events.data(), this->events.size());
+		ClearEvents();
 	}
 
 	void UnixStreamSocket::SendLog(char* nsPayload, size_t nsPayloadLen)
@@ -122,8 +235,22 @@ namespace Channel
 
 		// MS_TRACE_STD();
 
-		size_t nsNumLen;
-		size_t nsLen;
+		if (nsPayloadLen > MessageMaxSize)
+		{
+			MS_ERROR_STD("mesage too big");
+
+			return;
+		}
+
+		size_t nsLen = writeNetstring(WriteBuffer, reinterpret_cast<uint8_t*>(nsPayload), nsPayloadLen);
+
+		Write(WriteBuffer, nsLen);
+	}
+
+	void UnixStreamSocket::SendBinary(const uint8_t* nsPayload, size_t nsPayloadLen)
+	{
+		if (this->closed)
+			return;
 
 		if (nsPayloadLen > MessageMaxSize)
 		{
@@ -132,59 +259,213 @@ namespace Channel
 			return;
 		}
 
-		if (nsPayloadLen == 0)
+		size_t nsLen = writeNetstring(WriteBuffer, nsPayload, nsPayloadLen);
+
+		Write(WriteBuffer, nsLen);
+	}
+
+	/**
+	 * Encodes the message into EncodeBuffer. If it does not fit and bigPayload
+	 * is given, it is encoded into it instead (up to FragmentedMessageMaxSize).
+	 * @return  Encoded length, 0 if too big.
+	 */
+	size_t UnixStreamSocket::Encode(Json::Value& msg, std::vector<uint8_t>* bigPayload)
+	{
+		// MS_TRACE_STD();
+
+		size_t len;
+
+		if (this->binary)
 		{
-			nsNumLen       = 1;
-			WriteBuffer[0] = '0';
-			WriteBuffer[1] = ':';
-			WriteBuffer[2] = ',';
+			BinaryCodec::Writer writer(EncodeBuffer, MessageMaxSize);
+
+			writer.WriteJson(msg);
+			len = writer.GetLength();
+
+			if (len != 0 || bigPayload == nullptr)
+				return len;
+
+			// The Writer gives the needed size, so encode it again just once.
+			if (writer.GetNeededSize() <= FragmentedMessageMaxSize)
+			{
+				bigPayload->resize(writer.GetNeededSize());
+				BinaryCodec::Encode(msg, bigPayload->data(), bigPayload->size());
+			}
 		}
 		else
 		{
-			nsNumLen = static_cast<size_t>(std::ceil(std::log10(static_cast<double>(nsPayloadLen) + 1)));
-			std::sprintf(reinterpret_cast<char*>(WriteBuffer), "%zu:", nsPayloadLen);
-			std::memcpy(WriteBuffer + nsNumLen + 1, nsPayload, nsPayloadLen);
-			WriteBuffer[nsNumLen + nsPayloadLen + 1] = ',';
+			std::ostringstream stream;
+
+			this->jsonWriter->write(msg, &stream);
+
+			std::string payload = stream.str();
+
+			len = payload.length() <= MessageMaxSize ? payload.length() : 0;
+
+			if (len != 0)
+				std::memcpy(EncodeBuffer, payload.c_str(), len);
+			else if (bigPayload != nullptr && payload.length() <= FragmentedMessageMaxSize)
+				bigPayload->assign(payload.begin(), payload.end());
 		}
 
-		nsLen = nsNumLen + nsPayloadLen + 2;
+		return len;
+	}
 
-		Write(WriteBuffer, nsLen);
+	/**
+	 * Sends a payload bigger than MessageMaxSize as consecutive fragments, which
+	 * Node joins before parsing. They are written at once, so nothing can get in
+	 * between.
+	 */
+	void UnixStreamSocket::SendFragments(const uint8_t* payload, size_t len)
+	{
+		// MS_TRACE_STD();
+
+		static constexpr size_t FragmentMaxSize{ MessageMaxSize - 1 };
+
+		for (size_t pos{ 0 }; pos < len; pos += FragmentMaxSize)
+		{
+			size_t fragmentLen = std::min(FragmentMaxSize, len - pos);
+
+			EncodeBuffer[0] = pos + fragmentLen < len ? FragmentMarker : LastFragmentMarker;
+			std::memcpy(EncodeBuffer + 1, payload + pos, fragmentLen);
+
+			SendBinary(EncodeBuffer, fragmentLen + 1);
+		}
 	}
 
-	void UnixStreamSocket::SendBinary(const uint8_t* nsPayload, size_t nsPayloadLen)
+	/**
+	 * Appends the message and the optional binary data as a single event. If
+	 * there is no room for it, the oldest droppable events are dropped, or this
+	 * one if droppable. Other events are never dropped.
+	 */
+	void UnixStreamSocket::QueueEvent(
+	    const uint8_t* msg,
+	    size_t msgLen,
+	    const uint8_t* binaryData,
+	    size_t binaryLen,
+	    bool droppable)
 	{
-		if (this->closed)
-			return;
+		// MS_TRACE_STD();
 
-		size_t nsNumLen;
-		size_t nsLen;
+		size_t eventLen = getNetstringLen(msgLen);
 
-		if (nsPayloadLen > MessageMaxSize)
+		if (binaryData != nullptr)
+			eventLen += getNetstringLen(binaryLen);
+
+		while (this->queuedSize + eventLen > EventsMaxSize && DropOldestEvent())
 		{
-			MS_ERROR_STD("mesage too big");
+		}
+
+		if (droppable && this->queuedSize + eventLen > EventsMaxSize)
+		{
+			++this->droppedEvents;
 
 			return;
 		}
 
-		if (nsPayloadLen == 0)
+		// Reclaim the room of the dropped events once it is worth moving the
+		// remaining ones.
+		if (this->events.size() - this->queuedSize > EventsMaxSize / 2)
+			CompactEvents();
+
+		size_t pos = this->events.size();
+
+		this->events.resize(pos + eventLen);
+
+		pos += writeNetstring(this->events.data() + pos, msg, msgLen);
+
+		if (binaryData != nullptr)
+			writeNetstring(this->events.data() + pos, binaryData, binaryLen);
+
+		QueuedEvent queuedEvent;
+
+		queuedEvent.len       = eventLen;
+		queuedEvent.droppable = droppable;
+
+		this->queuedEvents.push_back(queuedEvent);
+		this->queuedSize += eventLen;
+
+		this->flushCheck->Start();
+	}
+
+	/**
+	 * Drops the oldest queued event which is droppable, if any.
+	 */
+	bool UnixStreamSocket::DropOldestEvent()
+	{
+		// MS_TRACE_STD();
+
+		for (; this->nextDroppable < this->queuedEvents.size(); ++this->nextDroppable)
 		{
-			nsNumLen       = 1;
-			WriteBuffer[0] = '0';
-			WriteBuffer[1] = ':';
-			WriteBuffer[2] = ',';
+			auto& queuedEvent = this->queuedEvents[this->nextDroppable];
+
+			if (!queuedEvent.droppable)
+				continue;
+
+			queuedEvent.dropped = true;
+			this->queuedSize -= queuedEvent.len;
+			++this->droppedEvents;
+			++this->nextDroppable;
+
+			return true;
 		}
-		else
+
+		return false;
+	}
+
+	/**
+	 * Removes the dropped events, moving the remaining ones.
+	 */
+	void UnixStreamSocket::CompactEvents()
+	{
+		// MS_TRACE_STD();
+
+		if (this->events.size() == this->queuedSize)
+			return;
+
+		size_t readPos{ 0 };
+		size_t writePos{ 0 };
+		size_t numEvents{ 0 };
+		size_t nextDroppable{ 0 };
+
+		for (size_t i{ 0 }; i < this->queuedEvents.size(); ++i)
 		{
-			nsNumLen = static_cast<size_t>(std::ceil(std::log10(static_cast<double>(nsPayloadLen) + 1)));
-			std::sprintf(reinterpret_cast<char*>(WriteBuffer), "%zu:", nsPayloadLen);
-			std::memcpy(WriteBuffer + nsNumLen + 1, nsPayload, nsPayloadLen);
-			WriteBuffer[nsNumLen + nsPayloadLen + 1] = ',';
+			auto queuedEvent = this->queuedEvents[i];
+
+			if (!queuedEvent.dropped)
+			{
+				if (writePos != readPos)
+				{
+					std::memmove(
+					    this->events.data() + writePos, this->events.data() + readPos, queuedEvent.len);
+				}
+
+				writePos += queuedEvent.len;
+				this->queuedEvents[numEvents++] = queuedEvent;
+
+				if (i < this->nextDroppable)
+					++nextDroppable;
+			}
+
+			readPos += queuedEvent.len;
 		}
 
-		nsLen = nsNumLen + nsPayloadLen + 2;
+		this->events.resize(writePos);
+		this->queuedEvents.resize(numEvents);
+		this->nextDroppable = nextDroppable;
+	}
 
-		Write(WriteBuffer, nsLen);
+	void UnixStreamSocket::ClearEvents()
+	{
+		// MS_TRACE_STD();
+
+		this->events.clear();
+		this->queuedEvents.clear();
+		this->queuedSize    = 0;
+		this->nextDroppable = 0;
+
+		this->flushCheck->Stop();
+		this->flushTimer->Stop();
 	}
 
 	void UnixStreamSocket::UserOnUnixStreamRead()
@@ -271,9 +552,22 @@ namespace Channel
 
 			Json::Value json;
 			std::string jsonParseError;
+			bool parsed;
+
+			if (BinaryCodec::IsBinary(reinterpret_cast<const uint8_t*>(jsonStart), jsonLen))
+			{
+				parsed = BinaryCodec::Decode(reinterpret_cast<const uint8_t*>(jsonStart), jsonLen, json);
+
+				if (!parsed)
+					jsonParseError = "invalid binary message";
+			}
+			else
+			{
+				parsed = this->jsonReader->parse(
+				    (const char*)jsonStart, (const char*)jsonStart + jsonLen, &json, &jsonParseError);
+			}
 
-			if (this->jsonReader->parse(
-			        (const char*)jsonStart, (const char*)jsonStart + jsonLen, &json, &jsonParseError))
+			if (parsed)
 			{
 				Channel::Request* request = nullptr;
 
@@ -331,10 +625,37 @@ namespace Channel
 
 		this->closed = true;
 
+		// Nobody will read the queued events.
+		ClearEvents();
+
 		if (isClosedByPeer)
 		{
 			// Notify the listener.
 			this->listener->OnChannelUnixStreamSocketRemotelyClosed(this);
 		}
 	}
+
+	void UnixStreamSocket::OnCheck(Check* /*check*/)
+	{
+		// MS_TRACE_STD();
+
+		// Hold the events back while Node is slow to read. Make sure they are
+		// tried again even if nothing else wakes the loop up.
+		if (GetWriteQueueSize() > WriteQueueMaxSize)
+		{
+			if (!this->flushTimer->IsActive())
+				this->flushTimer->Start(HeldEventsRetryInterval);
+
+			return;
+		}
+
+		FlushEvents();
+	}
+
+	void UnixStreamSocket::OnTimer(Timer* /*timer*/)
+	{
+		// MS_TRACE_STD();
+
+		OnCheck(this->flushCheck);
+	}
 } // namespace Channel
@@ -0,0 +1,285 @@
+#define MS_CLASS "LatencyProbes"
+// #define MS_LOG_DEV
+
+#include "LatencyProbes.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupError.hpp"
+#include <algorithm> // std::min()
+#include <cmath>     // std::ceil()
+
+/* Static. */
+
+static constexpr uint64_t NsPerMs{ 1000000 };
+
+/* Static methods for UV callbacks. */
+
+inline static void onPrepare(uv_prepare_t* /*handle*/)
+{
+	LatencyProbes::OnUvPrepare();
+}
+
+inline static void onCheck(uv_check_t* /*handle*/)
+{
+	LatencyProbes::OnUvCheck();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+/* Class variables. */
+
+uv_prepare_t* LatencyProbes::uvPrepareHandle{ nullptr };
+uv_check_t* LatencyProbes::uvCheckHandle{ nullptr };
+uint64_t LatencyProbes::lastPrepareAt{ 0 };
+int LatencyProbes::pollTimeout{ -1 };
+uint64_t LatencyProbes::ioCallbacksTime{ 0 };
+LatencyProbes::Histogram LatencyProbes::histograms[NumMetrics];
+
+/* Class methods. */
+
+void LatencyProbes::ClassInit()
+{
+	MS_TRACE();
+
+#ifdef MS_LATENCY_PROBES
+	int err;
+
+	LatencyProbes::uvPrepareHandle = new uv_prepare_t;
+	LatencyProbes::uvCheckHandle   = new uv_check_t;
+
+	err = uv_prepare_init(DepLibUV::GetLoop(), LatencyProbes::uvPrepareHandle);
+	if (err != 0)
+	{
+		delete LatencyProbes::uvPrepareHandle;
+		delete LatencyProbes::uvCheckHandle;
+		LatencyProbes::uvPrepareHandle = nullptr;
+		LatencyProbes::uvCheckHandle   = nullptr;
+
+		MS_THROW_ERROR("uv_prepare_init() failed: %s", uv_strerror(err));
+	}
+
+	err = uv_check_init(DepLibUV::GetLoop(), LatencyProbes::uvCheckHandle);
+	if (err != 0)
+	{
+		delete LatencyProbes::uvCheckHandle;
+		LatencyProbes::uvCheckHandle = nullptr;
+
+		// Close the prepare handle.
+		ClassDestroy();
+
+		MS_THROW_ERROR("uv_check_init() failed: %s", uv_strerror(err));
+	}
+
+	uv_prepare_start(LatencyProbes::uvPrepareHandle, static_cast<uv_prepare_cb>(onPrepare));
+	uv_check_start(LatencyProbes::uvCheckHandle, static_cast<uv_check_cb>(onCheck));
+
+	// Don't keep the loop alive.
+	uv_unref(reinterpret_cast<uv_handle_t*>(LatencyProbes::uvPrepareHandle));
+	uv_unref(reinterpret_cast<uv_handle_t*>(LatencyProbes::uvCheckHandle));
+#endif
+}
+
+void LatencyProbes::ClassDestroy()
+{
+	MS_TRACE();
+
+	if (LatencyProbes::uvPrepareHandle != nullptr)
+	{
+		uv_close(
+		    reinterpret_cast<uv_handle_t*>(LatencyProbes::uvPrepareHandle),
+		    static_cast<uv_close_cb>(onClose));
+
+		LatencyProbes::uvPrepareHandle = nullptr;
+	}
+
+	if (LatencyProbes::uvCheckHandle != nullptr)
+	{
+		uv_close(
+		    reinterpret_cast<uv_handle_t*>(LatencyProbes::uvCheckHandle),
+		    static_cast<uv_close_cb>(onClose));
+
+		LatencyProbes::uvCheckHandle = nullptr;
+	}
+}
+
+Json::Value LatencyProbes::ToJson()
+{
+	MS_TRACE();
+
+	static const Json::StaticString JsonStringLoopIteration{ "loopIteration" };
+	static const Json::StaticString JsonStringLoopLag{ "loopLag" };
+	static const Json::StaticString JsonStringDecrypt{ "decrypt" };
+	static const Json::StaticString JsonStringParse{ "parse" };
+	static const Json::StaticString JsonStringRouting{ "routing" };
+	static const Json::StaticString JsonStringEncrypt{ "encrypt" };
+	static const Json::StaticString JsonStringSend{ "send" };
+	static const Json::StaticString JsonStringRtcpDecrypt{ "rtcpDecrypt" };
+	static const Json::StaticString JsonStringRtcpEncrypt{ "rtcpEncrypt" };
+
+	Json::Value json(Json::objectValue);
+	auto& histograms = LatencyProbes::histograms;
+
+	json[JsonStringLoopIteration] =
+	    histograms[static_cast<size_t>(Metric::LOOP_ITERATION)].ToJson();
+	json[JsonStringLoopLag] = histograms[static_cast<size_t>(Metric::LOOP_LAG)].ToJson();
+	json[JsonStringDecrypt] = histograms[static_cast<size_t>(Metric::DECRYPT)].ToJson();
+	json[JsonStringParse]   = histograms[static_cast<size_t>(Metric::PARSE)].ToJson();
+	json[JsonStringRouting] = histograms[static_cast<size_t>(Metric::ROUTING)].ToJson();
+	json[JsonStringEncrypt] = histograms[static_cast<size_t>(Metric::ENCRYPT)].ToJson();
+	json[JsonStringSend]    = histograms[static_cast<size_t>(Metric::SEND)].ToJson();
+	json[JsonStringRtcpDecrypt] = histograms[static_cast<size_t>(Metric::RTCP_DECRYPT)].ToJson();
+	json[JsonStringRtcpEncrypt] = histograms[static_cast<size_t>(Metric::RTCP_ENCRYPT)].ToJson();
+
+	return json;
+}
+
+void LatencyProbes::HandleRequest(Channel::Request* request)
+{
+	MS_TRACE();
+
+#ifdef MS_LATENCY_PROBES
+	static const Json::StaticString JsonStringReset{ "reset" };
+
+	Json::Value data = LatencyProbes::ToJson();
+
+	// Start a new interval once read, so the values are not diluted by old ones.
+	if (request->data[JsonStringReset].isBool() && request->data[JsonStringReset].asBool())
+	{
+		for (auto& histogram : LatencyProbes::histograms)
+		{
+			histogram.Reset();
+		}
+	}
+
+	request->Accept(data);
+#else
+	request->Reject("latency probes not built in");
+#endif
+}
+
+/**
+ * Called before polling for I/O, once the timers and the pending callbacks of
+ * the iteration have run.
+ */
+void LatencyProbes::OnUvPrepare()
+{
+	// MS_TRACE();
+
+	uint64_t now = uv_hrtime();
+
+	if (LatencyProbes::lastPrepareAt != 0)
+		Record(Metric::LOOP_ITERATION, now - LatencyProbes::lastPrepareAt);
+
+	LatencyProbes::lastPrepareAt   = now;
+	LatencyProbes::pollTimeout     = uv_backend_timeout(DepLibUV::GetLoop());
+	LatencyProbes::ioCallbacksTime = 0;
+}
+
+/**
+ * Called after polling for I/O and running its callbacks.
+ */
+void LatencyProbes::OnUvCheck()
+{
+	// MS_TRACE();
+
+	uint64_t elapsed = uv_hrtime() - LatencyProbes::lastPrepareAt;
+
+	Record(
+	    Metric::LOOP_LAG,
+	    GetLoopLag(elapsed, LatencyProbes::ioCallbacksTime, LatencyProbes::pollTimeout));
+}
+
+/**
+ * Lag of an iteration taking elapsed ns from poll to check. Polling beyond
+ * pollTimeout ms (never if -1) delays the timers, and the time running I/O
+ * callbacks delays the I/O ready meanwhile, so both are lag.
+ */
+uint64_t LatencyProbes::GetLoopLag(uint64_t elapsed, uint64_t ioCallbacksTime, int pollTimeout)
+{
+	// MS_TRACE();
+
+	uint64_t callbacks = std::min(ioCallbacksTime, elapsed);
+	uint64_t polled    = elapsed - callbacks;
+
+	if (pollTimeout < 0)
+		return callbacks;
+
+	uint64_t timeout = static_cast<uint64_t>(pollTimeout) * NsPerMs;
+
+	return callbacks + (polled > timeout ? polled - timeout : 0);
+}
+
+/* Instance methods. */
+
+/**
+ * Highest value of the given bucket (so percentiles are never underestimated).
+ */
+uint64_t LatencyProbes::Histogram::GetBucketMaxValue(size_t bucket)
+{
+	if (bucket < SubBuckets)
+		return bucket;
+
+	size_t msb        = (bucket / SubBuckets) + SubBucketBits - 1;
+	uint64_t mantissa = (bucket % SubBuckets) + SubBuckets;
+
+	// It wraps to the maximum value for the last bucket.
+	return ((mantissa + 1) << (msb - SubBucketBits)) - 1;
+}
+
+void LatencyProbes::Histogram::Reset()
+{
+	*this = Histogram();
+}
+
+/**
+ * @param percentile  From 0 to 100.
+ */
+uint64_t LatencyProbes::Histogram::GetPercentile(double percentile) const
+{
+	if (this->count == 0)
+		return 0;
+
+	auto target = static_cast<uint64_t>(std::ceil(percentile / 100 * this->count));
+	uint64_t accumulated{ 0 };
+
+	if (target == 0)
+		target = 1;
+
+	for (size_t bucket{ 0 }; bucket < NumBuckets; ++bucket)
+	{
+		accumulated += this->buckets[bucket];
+
+		if (accumulated >= target)
+			return std::min(GetBucketMaxValue(bucket), this->max);
+	}
+
+	return this->max;
+}
+
+Json::Value LatencyProbes::Histogram::ToJson() const
+{
+	MS_TRACE();
+
+	static const Json::StaticString JsonStringCount{ "count" };
+	static const Json::StaticString JsonStringMean{ "mean" };
+	static const Json::StaticString JsonStringP50{ "p50" };
+	static const Json::StaticString JsonStringP90{ "p90" };
+	static const Json::StaticString JsonStringP99{ "p99" };
+	static const Json::StaticString JsonStringP999{ "p999" };
+	static const Json::StaticString JsonStringMax{ "max" };
+
+	Json::Value json(Json::objectValue);
+
+	json[JsonStringCount] = Json::UInt64{ this->count };
+	json[JsonStringMean]  = Json::UInt64{ GetMean() };
+	json[JsonStringP50]   = Json::UInt64{ GetPercentile(50) };
+	json[JsonStringP90]   = Json::UInt64{ GetPercentile(90) };
+	json[JsonStringP99]   = Json::UInt64{ GetPercentile(99) };
+	json[JsonStringP999]  = Json::UInt64{ GetPercentile(99.9) };
+	json[JsonStringMax]   = Json::UInt64{ this->max };
+
+	return json;
+}
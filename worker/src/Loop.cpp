@@ -3,9 +3,11 @@
 
 #include "Loop.hpp"
 #include "DepLibUV.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
 #include "Settings.hpp"
+#include "handles/TimerWheel.hpp"
 #include <json/json.h>
 #include <cerrno>
 #include <iostream> // std::cout, std::cerr
@@ -73,9 +75,12 @@ void Loop::Close()
 	// Delete the Notifier.
 	delete this->notifier;
 
-	// Close the Channel socket.
+	// Close the Channel socket, once the events of the closed Rooms are written.
 	if (this->channel != nullptr)
+	{
+		this->channel->FlushEvents();
 		this->channel->Destroy();
+	}
 }
 
 RTC::Room* Loop::GetRoomFromRequest(Channel::Request* request, uint32_t* roomId)
@@ -137,6 +142,7 @@ void Loop::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::Req
 		{
 			static const Json::StaticString JsonStringWorkerId{ "workerId" };
 			static const Json::StaticString JsonStringRooms{ "rooms" };
+			static const Json::StaticString JsonStringTimerWheel{ "timerWheel" };
 
 			Json::Value json(Json::objectValue);
 			Json::Value jsonRooms(Json::arrayValue);
@@ -152,6 +158,8 @@ void Loop::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::Req
 
 			json[JsonStringRooms] = jsonRooms;
 
+			json[JsonStringTimerWheel] = TimerWheel::ToJson();
+
 			request->Accept(json);
 
 			break;
@@ -164,6 +172,13 @@ void Loop::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::Req
 			break;
 		}
 
+		case Channel::Request::MethodId::WORKER_GET_LATENCY:
+		{
+			LatencyProbes::HandleRequest(request);
+
+			break;
+		}
+
 		case Channel::Request::MethodId::WORKER_CREATE_ROOM:
 		{
 			static const Json::StaticString JsonStringCapabilities{ "capabilities" };
@@ -216,27 +231,36 @@ void Loop::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Channel::Req
 
 		case Channel::Request::MethodId::ROOM_CLOSE:
 		case Channel::Request::MethodId::ROOM_DUMP:
+		case Channel::Request::MethodId::ROOM_GET_STATS:
 		case Channel::Request::MethodId::ROOM_CREATE_PEER:
 		case Channel::Request::MethodId::ROOM_SET_AUDIO_LEVELS_EVENT:
+		case Channel::Request::MethodId::ROOM_SET_LAST_N:
 		case Channel::Request::MethodId::PEER_CLOSE:
 		case Channel::Request::MethodId::PEER_DUMP:
 		case Channel::Request::MethodId::PEER_SET_CAPABILITIES:
 		case Channel::Request::MethodId::PEER_CREATE_TRANSPORT:
 		case Channel::Request::MethodId::PEER_CREATE_RTP_RECEIVER:
+		case Channel::Request::MethodId::PEER_CREATE_ACTIVE_SPEAKER_RTP_SENDER:
 		case Channel::Request::MethodId::TRANSPORT_CLOSE:
 		case Channel::Request::MethodId::TRANSPORT_DUMP:
+		case Channel::Request::MethodId::TRANSPORT_GET_STATS:
 		case Channel::Request::MethodId::TRANSPORT_SET_REMOTE_DTLS_PARAMETERS:
 		case Channel::Request::MethodId::TRANSPORT_SET_MAX_BITRATE:
 		case Channel::Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD:
+		case Channel::Request::MethodId::TRANSPORT_SET_REMOTE_PARAMETERS:
 		case Channel::Request::MethodId::RTP_RECEIVER_CLOSE:
 		case Channel::Request::MethodId::RTP_RECEIVER_DUMP:
 		case Channel::Request::MethodId::RTP_RECEIVER_RECEIVE:
 		case Channel::Request::MethodId::RTP_RECEIVER_SET_TRANSPORT:
 		case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_RAW_EVENT:
 		case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_OBJECT_EVENT:
+		case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_TAP:
 		case Channel::Request::MethodId::RTP_SENDER_DUMP:
 		case Channel::Request::MethodId::RTP_SENDER_SET_TRANSPORT:
 		case Channel::Request::MethodId::RTP_SENDER_DISABLE:
+		case Channel::Request::MethodId::RTP_SENDER_SET_PREFERRED_LAYERS:
+		case Channel::Request::MethodId::RTP_SENDER_SET_PINNED:
+		case Channel::Request::MethodId::RTP_SENDER_SET_MAX_RESOLUTION:
 		{
 			RTC::Room* room;
 
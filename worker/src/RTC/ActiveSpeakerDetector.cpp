@@ -0,0 +1,320 @@
+#define MS_CLASS "RTC::ActiveSpeakerDetector"
+// #define MS_LOG_DEV
+
+#include "RTC/ActiveSpeakerDetector.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::min()
+#include <cmath>     // std::log(), std::lgamma()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Levels below this volume (-dBov) are not speech.
+	static constexpr uint8_t MaxSpeechVolume{ 70 };
+	// Width (in dB) of every immediate subband above the noise floor.
+	static constexpr uint8_t SubbandWidth{ 3 };
+	// The noise floor rises 1 dB every these frames unless lower levels come.
+	static constexpr uint8_t NoiseFloorRiseFrames{ 25 };
+	// Thresholds for a frame, medium block and long block to be active.
+	static constexpr uint8_t ActiveFrameSubbands{ 4 };
+	static constexpr uint8_t ActiveMediumBlockFrames{ 3 };
+	static constexpr uint8_t ActiveLongBlockMediumBlocks{ 3 };
+	// Streams with no audio level for this time are considered silent.
+	static constexpr uint64_t StreamTimeout{ 1000 }; // In ms.
+	// Speech activity score parameters (probability and Poisson lambda) of
+	// every time scale.
+	static constexpr double SpeechProbability{ 0.5 };
+	static constexpr double ImmediateLambda{ 0.78 };
+	static constexpr double MediumLambda{ 24 };
+	static constexpr double LongLambda{ 47 };
+	static constexpr double MinScore{ 1.0e-10 };
+	// Minimum log ratio of the challenger score over the dominant speaker score
+	// in every time scale.
+	static constexpr double ImmediateThreshold{ 3 };
+	static constexpr double MediumThreshold{ 2 };
+	static constexpr double LongThreshold{ 0 };
+
+	static double ComputeScore(uint8_t active, uint8_t total, double lambda)
+	{
+		// Binomial coefficient of (total, active) as log.
+		double logBinomial =
+		    std::lgamma(total + 1) - std::lgamma(active + 1) - std::lgamma(total - active + 1);
+		double score = logBinomial + active * std::log(SpeechProbability) +
+		               (total - active) * std::log(1 - SpeechProbability) - std::log(lambda) +
+		               lambda * active;
+
+		return std::max(score, MinScore);
+	}
+
+	/* Instance methods. */
+
+	ActiveSpeakerDetector::ActiveSpeakerDetector()
+	{
+		MS_TRACE();
+
+		for (uint8_t active{ 0 }; active <= ImmediateSubbands; ++active)
+		{
+			this->immediateScores.push_back(ComputeScore(active, ImmediateSubbands, ImmediateLambda));
+		}
+
+		for (uint8_t active{ 0 }; active <= MediumWindowBlocks; ++active)
+		{
+			this->mediumScores.push_back(ComputeScore(active, MediumWindowBlocks, MediumLambda));
+		}
+
+		for (uint8_t active{ 0 }; active <= LongWindowBlocks; ++active)
+		{
+			this->longScores.push_back(ComputeScore(active, LongWindowBlocks, LongLambda));
+		}
+	}
+
+	/**
+	 * Processes the audio level (volume as -dBov, from 0 to 127) of a packet.
+	 * Returns true if it completes a medium block with speech.
+	 */
+	bool ActiveSpeakerDetector::ReceiveLevel(uint32_t id, uint8_t volume, uint64_t now)
+	{
+		MS_TRACE();
+
+		auto& stream = this->streams[id];
+
+		volume = std::min<uint8_t>(volume, 127);
+
+		auto loudness = static_cast<uint8_t>(127 - volume);
+
+		stream.level       = (stream.level * 7 - volume) / 8;
+		stream.lastLevelAt = now;
+
+		// The noise floor follows the lowest levels and slowly rises otherwise.
+		if (!stream.hasNoiseFloor || loudness < stream.noiseFloor)
+		{
+			stream.hasNoiseFloor    = true;
+			stream.noiseFloor       = loudness;
+			stream.noiseFloorFrames = 0;
+		}
+		else if (++stream.noiseFloorFrames == NoiseFloorRiseFrames)
+		{
+			stream.noiseFloor++;
+			stream.noiseFloorFrames = 0;
+		}
+
+		// Immediate time scale.
+		uint8_t subbands = (loudness - stream.noiseFloor) / SubbandWidth;
+
+		if (volume > MaxSpeechVolume)
+			stream.immediateSubbands = 0;
+		else if (subbands > ImmediateSubbands)
+			stream.immediateSubbands = ImmediateSubbands;
+		else
+			stream.immediateSubbands = subbands;
+
+		// Medium time scale.
+		if (stream.immediateSubbands >= ActiveFrameSubbands)
+			stream.mediumBlockActiveFrames++;
+
+		if (++stream.mediumBlockFrames < MediumBlockFrames)
+			return false;
+
+		// The block leaving the window.
+		uint8_t leaving{ 0 };
+		bool mediumBlockActive = stream.mediumBlockActiveFrames >= ActiveMediumBlockFrames;
+
+		leaving = (stream.mediumHistory >> (MediumWindowBlocks - 1)) & 1;
+
+		stream.mediumBlockFrames       = 0;
+		stream.mediumBlockActiveFrames = 0;
+		stream.mediumHistory           = (stream.mediumHistory << 1) | (mediumBlockActive ? 1 : 0);
+		stream.mediumHistory &= (1 << MediumWindowBlocks) - 1;
+		stream.mediumActiveBlocks += (mediumBlockActive ? 1 : 0) - leaving;
+
+		// Long time scale.
+		if (mediumBlockActive)
+			stream.longBlockActiveMediumBlocks++;
+
+		if (++stream.longBlockMediumBlocks < LongBlockMediumBlocks)
+			return mediumBlockActive;
+
+		bool longBlockActive = stream.longBlockActiveMediumBlocks >= ActiveLongBlockMediumBlocks;
+
+		leaving = (stream.longHistory >> (LongWindowBlocks - 1)) & 1;
+
+		stream.longBlockMediumBlocks       = 0;
+		stream.longBlockActiveMediumBlocks = 0;
+		stream.longHistory                 = (stream.longHistory << 1) | (longBlockActive ? 1 : 0);
+		stream.longHistory &= (1 << LongWindowBlocks) - 1;
+		stream.longActiveBlocks += (longBlockActive ? 1 : 0) - leaving;
+
+		return mediumBlockActive;
+	}
+
+	void ActiveSpeakerDetector::RemoveStream(uint32_t id)
+	{
+		MS_TRACE();
+
+		this->streams.erase(id);
+
+		if (this->hasDominantSpeaker && this->dominantSpeaker == id)
+		{
+			this->hasDominantSpeaker     = false;
+			this->dominantSpeakerRemoved = true;
+		}
+	}
+
+	void ActiveSpeakerDetector::Clear()
+	{
+		MS_TRACE();
+
+		this->streams.clear();
+		this->hasDominantSpeaker     = false;
+		this->dominantSpeakerRemoved = false;
+	}
+
+	/**
+	 * Identifies the dominant speaker. Returns true if it changed.
+	 */
+	bool ActiveSpeakerDetector::Process(uint64_t now)
+	{
+		MS_TRACE();
+
+		bool changed = this->dominantSpeakerRemoved;
+
+		this->dominantSpeakerRemoved = false;
+
+		// Streams with no audio levels (i.e. muted) are silent.
+		for (auto& kv : this->streams)
+		{
+			auto& stream = kv.second;
+
+			if (now - stream.lastLevelAt >= StreamTimeout)
+				ResetActivity(stream);
+		}
+
+		auto dominantIt = this->hasDominantSpeaker ? this->streams.find(this->dominantSpeaker)
+		                                           : this->streams.end();
+
+		// No dominant speaker, take the most active one.
+		if (dominantIt == this->streams.end())
+		{
+			auto isMoreActive = [](const Stream& a, const Stream& b) {
+				if (a.longActiveBlocks != b.longActiveBlocks)
+					return a.longActiveBlocks > b.longActiveBlocks;
+
+				return a.mediumActiveBlocks > b.mediumActiveBlocks;
+			};
+			const Stream* best{ nullptr };
+			uint32_t bestId{ 0 };
+
+			for (auto& kv : this->streams)
+			{
+				auto& stream = kv.second;
+
+				if (stream.mediumActiveBlocks == 0)
+					continue;
+
+				if (
+				    best == nullptr || isMoreActive(stream, *best) ||
+				    (!isMoreActive(*best, stream) && kv.first < bestId))
+				{
+					best   = &stream;
+					bestId = kv.first;
+				}
+			}
+
+			if (best != nullptr)
+			{
+				this->hasDominantSpeaker = true;
+				this->dominantSpeaker    = bestId;
+				changed                  = true;
+			}
+
+			return changed;
+		}
+
+		// Otherwise look for a speaker beating the dominant one, the one with more
+		// long term activity if several.
+		auto& dominant = dominantIt->second;
+		const Stream* best{ nullptr };
+		uint32_t bestId{ 0 };
+
+		for (auto& kv : this->streams)
+		{
+			auto& stream = kv.second;
+
+			if (kv.first == this->dominantSpeaker || !Beats(stream, dominant))
+				continue;
+
+			if (
+			    best == nullptr || GetLongScore(stream) > GetLongScore(*best) ||
+			    (GetLongScore(stream) == GetLongScore(*best) && kv.first < bestId))
+			{
+				best   = &stream;
+				bestId = kv.first;
+			}
+		}
+
+		if (best != nullptr)
+		{
+			this->dominantSpeaker = bestId;
+			changed               = true;
+		}
+
+		return changed;
+	}
+
+	/**
+	 * Averaged audio level (dBov) of the stream.
+	 */
+	int8_t ActiveSpeakerDetector::GetLevel(uint32_t id) const
+	{
+		MS_TRACE();
+
+		auto it = this->streams.find(id);
+
+		if (it == this->streams.end())
+			return -127;
+
+		return static_cast<int8_t>(it->second.level);
+	}
+
+	/**
+	 * Whether the last audio level of the stream was speech.
+	 */
+	bool ActiveSpeakerDetector::IsActiveFrame(uint32_t id) const
+	{
+		MS_TRACE();
+
+		auto it = this->streams.find(id);
+
+		if (it == this->streams.end())
+			return false;
+
+		return it->second.immediateSubbands >= ActiveFrameSubbands;
+	}
+
+	void ActiveSpeakerDetector::ResetActivity(Stream& stream)
+	{
+		MS_TRACE();
+
+		stream.level                       = -127;
+		stream.immediateSubbands           = 0;
+		stream.mediumBlockFrames           = 0;
+		stream.mediumBlockActiveFrames     = 0;
+		stream.mediumHistory               = 0;
+		stream.mediumActiveBlocks          = 0;
+		stream.longBlockMediumBlocks       = 0;
+		stream.longBlockActiveMediumBlocks = 0;
+		stream.longHistory                 = 0;
+		stream.longActiveBlocks            = 0;
+	}
+
+	bool ActiveSpeakerDetector::Beats(const Stream& challenger, const Stream& dominant) const
+	{
+		MS_TRACE();
+
+		return std::log(GetImmediateScore(challenger) / GetImmediateScore(dominant)) >
+		           ImmediateThreshold &&
+		       std::log(GetMediumScore(challenger) / GetMediumScore(dominant)) > MediumThreshold &&
+		       std::log(GetLongScore(challenger) / GetLongScore(dominant)) > LongThreshold;
+	}
+} // namespace RTC
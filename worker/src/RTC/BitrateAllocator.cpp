@@ -0,0 +1,82 @@
+#define MS_CLASS "RTC::BitrateAllocator"
+// #define MS_LOG_DEV
+
+#include "RTC/BitrateAllocator.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::stable_sort()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Switching to higher layers requires some spare bitrate to not oscillate.
+	static constexpr double LayerUpgradeBitrateFactor{ 0.85 };
+
+	/* Class methods. */
+
+	/**
+	 * Sets the layers of each stream. Streams are sorted by priority.
+	 */
+	void BitrateAllocator::Allocate(uint32_t availableBitrate, std::vector<Stream>& streams)
+	{
+		MS_TRACE();
+
+		std::stable_sort(streams.begin(), streams.end(), [](const Stream& a, const Stream& b) {
+			return a.priority < b.priority;
+		});
+
+		// Unknown available bitrate, just honor the preferred layers.
+		if (availableBitrate == 0u)
+		{
+			for (auto& stream : streams)
+			{
+				stream.spatialLayer  = stream.preferredSpatialLayer;
+				stream.temporalLayer = stream.preferredTemporalLayer;
+			}
+
+			return;
+		}
+
+		int64_t remainingBitrate = availableBitrate;
+
+		// The base layer of every stream is sent even if it does not fit.
+		for (auto& stream : streams)
+		{
+			stream.spatialLayer  = 0;
+			stream.temporalLayer = 0;
+			remainingBitrate -= stream.layersBitrate[0][0];
+		}
+
+		for (auto& stream : streams)
+		{
+			uint32_t baseBitrate = stream.layersBitrate[0][0];
+			bool found{ false };
+
+			for (int sLayer = stream.preferredSpatialLayer; sLayer >= 0 && !found; --sLayer)
+			{
+				for (int tLayer = stream.preferredTemporalLayer; tLayer >= 0 && !found; --tLayer)
+				{
+					// Already allocated.
+					if (sLayer == 0 && tLayer == 0)
+						break;
+
+					uint32_t bitrate = stream.layersBitrate[sLayer][tLayer];
+					bool upgrade     = sLayer > stream.currentSpatialLayer ||
+					               (sLayer == stream.currentSpatialLayer && tLayer > stream.currentTemporalLayer);
+					auto limit = static_cast<double>(remainingBitrate + baseBitrate);
+
+					if (upgrade)
+						limit *= LayerUpgradeBitrateFactor;
+
+					if (static_cast<double>(bitrate) > limit)
+						continue;
+
+					stream.spatialLayer  = static_cast<uint8_t>(sLayer);
+					stream.temporalLayer = static_cast<uint8_t>(tLayer);
+					remainingBitrate -= bitrate - baseBitrate;
+					found = true;
+				}
+			}
+		}
+	}
+} // namespace RTC
@@ -0,0 +1,77 @@
+#define MS_CLASS "RTC::Codecs::H264"
+// #define MS_LOG_DEV
+
+#include "RTC/Codecs/H264.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		/* Static. */
+
+		// NAL unit types (RFC 6184).
+		static constexpr uint8_t NalUnitIdr{ 5 };
+		static constexpr uint8_t NalUnitSps{ 7 };
+		static constexpr uint8_t NalUnitStapA{ 24 };
+		static constexpr uint8_t NalUnitFuA{ 28 };
+
+		/* Class methods. */
+
+		/**
+		 * Whether the packet starts an IDR picture (or carries the SPS sent
+		 * before it).
+		 */
+		bool H264::IsKeyFrame(const uint8_t* data, size_t len)
+		{
+			MS_TRACE();
+
+			if (len < 2)
+				return false;
+
+			uint8_t nalUnitType = data[0] & 0x1F;
+
+			switch (nalUnitType)
+			{
+				case NalUnitIdr:
+				case NalUnitSps:
+				{
+					return true;
+				}
+
+				// Aggregation packet, check every NAL unit.
+				case NalUnitStapA:
+				{
+					size_t offset{ 1 };
+
+					while (offset + 3 <= len)
+					{
+						size_t nalUnitSize = Utils::Byte::Get2Bytes(data, offset);
+						uint8_t type       = data[offset + 2] & 0x1F;
+
+						if (type == NalUnitIdr || type == NalUnitSps)
+							return true;
+
+						offset += 2 + nalUnitSize;
+					}
+
+					return false;
+				}
+
+				// Fragmentation unit, just the first fragment.
+				case NalUnitFuA:
+				{
+					bool start = (data[1] & 0x80) != 0;
+
+					return start && (data[1] & 0x1F) == NalUnitIdr;
+				}
+
+				default:
+				{
+					return false;
+				}
+			}
+		}
+	} // namespace Codecs
+} // namespace RTC
@@ -0,0 +1,55 @@
+#define MS_CLASS "RTC::Codecs::Tools"
+// #define MS_LOG_DEV
+
+#include "RTC/Codecs/Tools.hpp"
+#include "Logger.hpp"
+#include "RTC/Codecs/H264.hpp"
+#include "RTC/Codecs/VP8.hpp"
+#include "RTC/KeyFrameCache.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		/* Class methods. */
+
+		bool Tools::CanDetectKeyFrames(const RTC::RtpCodecMime& mime)
+		{
+			MS_TRACE();
+
+			switch (mime.subtype)
+			{
+				case RTC::RtpCodecMime::Subtype::VP8:
+				case RTC::RtpCodecMime::Subtype::VP9:
+				case RTC::RtpCodecMime::Subtype::H264:
+					return true;
+
+				default:
+					return false;
+			}
+		}
+
+		/**
+		 * Whether the packet is the first one of a key frame.
+		 */
+		bool Tools::IsKeyFrame(const RTC::RtpCodecMime& mime, RTC::RtpPacket* packet)
+		{
+			MS_TRACE();
+
+			switch (mime.subtype)
+			{
+				case RTC::RtpCodecMime::Subtype::VP8:
+					return VP8::IsKeyFrame(packet->GetPayload(), packet->GetPayloadLength());
+
+				case RTC::RtpCodecMime::Subtype::VP9:
+					return RTC::KeyFrameCache::IsKeyFrameStart(packet);
+
+				case RTC::RtpCodecMime::Subtype::H264:
+					return H264::IsKeyFrame(packet->GetPayload(), packet->GetPayloadLength());
+
+				default:
+					return false;
+			}
+		}
+	} // namespace Codecs
+} // namespace RTC
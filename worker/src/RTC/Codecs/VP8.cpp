@@ -0,0 +1,213 @@
+#define MS_CLASS "RTC::Codecs::VP8"
+// #define MS_LOG_DEV
+
+#include "RTC/Codecs/VP8.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	namespace Codecs
+	{
+		/* Class methods. */
+
+		bool VP8::IsKeyFrame(const uint8_t* data, size_t len)
+		{
+			MS_TRACE();
+
+			PayloadDescriptor descriptor;
+
+			if (!descriptor.Parse(data, len))
+				return false;
+
+			return descriptor.isKeyFrame;
+		}
+
+		/* Instance methods. */
+
+		bool VP8::PayloadDescriptor::Parse(const uint8_t* data, size_t len)
+		{
+			MS_TRACE();
+
+			if (len < 1)
+				return false;
+
+			size_t offset{ 0 };
+			uint8_t byte = data[offset];
+
+			this->extended       = (byte & 0x80) != 0;
+			this->nonReference   = (byte & 0x20) != 0;
+			this->start          = (byte & 0x10) != 0;
+			this->partitionIndex = byte & 0x07;
+
+			if (this->extended)
+			{
+				if (len < ++offset + 1)
+					return false;
+
+				byte = data[offset];
+
+				this->hasPictureId = (byte & 0x80) != 0;
+				this->hasTl0PicIdx = (byte & 0x40) != 0;
+				this->hasTlIndex   = (byte & 0x20) != 0;
+				this->hasKeyIndex  = (byte & 0x10) != 0;
+			}
+
+			if (this->hasPictureId)
+			{
+				if (len < ++offset + 1)
+					return false;
+
+				byte = data[offset];
+
+				this->hasTwoBytesPictureId = (byte & 0x80) != 0;
+
+				if (this->hasTwoBytesPictureId)
+				{
+					if (len < ++offset + 1)
+						return false;
+
+					this->pictureId = ((byte & 0x7F) << 8) | data[offset];
+				}
+				else
+				{
+					this->pictureId = byte & 0x7F;
+				}
+			}
+
+			if (this->hasTl0PicIdx)
+			{
+				if (len < ++offset + 1)
+					return false;
+
+				this->tl0PicIdx = data[offset];
+			}
+
+			if (this->hasTlIndex || this->hasKeyIndex)
+			{
+				if (len < ++offset + 1)
+					return false;
+
+				byte = data[offset];
+
+				if (this->hasTlIndex)
+				{
+					this->tlIndex   = byte >> 6;
+					this->layerSync = (byte & 0x20) != 0;
+				}
+
+				if (this->hasKeyIndex)
+					this->keyIndex = byte & 0x1F;
+			}
+
+			this->size = offset + 1;
+
+			// The inverse key frame flag (P) is in the VP8 payload header, which
+			// is only present at the beginning of the first partition.
+			if (this->start && this->partitionIndex == 0 && len > this->size)
+				this->isKeyFrame = (data[this->size] & 0x01) == 0;
+
+			return true;
+		}
+
+		/**
+		 * Writes the given picture ID and TL0PICIDX into the descriptor fields
+		 * present in the packet.
+		 */
+		void VP8::PayloadDescriptor::Encode(uint8_t* data, uint16_t pictureId, uint8_t tl0PicIdx) const
+		{
+			MS_TRACE();
+
+			size_t offset{ 2 };
+
+			if (this->hasPictureId)
+			{
+				if (this->hasTwoBytesPictureId)
+				{
+					data[offset++] = 0x80 | ((pictureId >> 8) & 0x7F);
+					data[offset++] = pictureId & 0xFF;
+				}
+				else
+				{
+					data[offset++] = pictureId & 0x7F;
+				}
+			}
+
+			if (this->hasTl0PicIdx)
+				data[offset] = tl0PicIdx;
+		}
+
+		/**
+		 * Whether the packet must be forwarded. If so, the picture ID and
+		 * TL0PICIDX to write into it are returned.
+		 */
+		bool VP8::LayerSelector::Select(
+		    const PayloadDescriptor& descriptor, uint16_t& pictureId, uint8_t& tl0PicIdx)
+		{
+			MS_TRACE();
+
+			if (descriptor.hasTlIndex)
+			{
+				bool frameStart = descriptor.start && descriptor.partitionIndex == 0;
+
+				// Upper layers can be switched to on key frames and on layer sync
+				// frames (which just depend on the base layer).
+				if (descriptor.isKeyFrame)
+				{
+					this->currentTemporalLayer = this->targetTemporalLayer;
+				}
+				else if (
+				    descriptor.layerSync && descriptor.tlIndex > this->currentTemporalLayer &&
+				    descriptor.tlIndex <= this->targetTemporalLayer)
+				{
+					this->currentTemporalLayer = descriptor.tlIndex;
+				}
+				else if (frameStart && this->targetTemporalLayer < this->currentTemporalLayer)
+				{
+					this->currentTemporalLayer = this->targetTemporalLayer;
+				}
+
+				if (descriptor.tlIndex > this->currentTemporalLayer)
+				{
+					// Count every dropped picture once. The base layer is never dropped so
+					// TL0PICIDX needs no change.
+					if (
+					    descriptor.hasPictureId &&
+					    (!this->droppingPicture || descriptor.pictureId != this->droppedPictureId))
+					{
+						this->droppingPicture  = true;
+						this->droppedPictureId = descriptor.pictureId;
+						this->pictureIdOffset--;
+					}
+
+					return false;
+				}
+			}
+
+			if (this->resync)
+			{
+				this->resync = false;
+
+				if (this->forwardedAny)
+				{
+					this->pictureIdOffset = this->lastPictureId + 1 - descriptor.pictureId;
+					this->tl0PicIdxOffset = this->lastTl0PicIdx + 1 - descriptor.tl0PicIdx;
+				}
+			}
+
+			uint16_t pictureIdMask = descriptor.hasTwoBytesPictureId ? 0x7FFF : 0x7F;
+
+			pictureId = (descriptor.pictureId + this->pictureIdOffset) & pictureIdMask;
+			tl0PicIdx = descriptor.tl0PicIdx + this->tl0PicIdxOffset;
+
+			this->forwardedAny = true;
+
+			if (descriptor.hasPictureId)
+				this->lastPictureId = pictureId;
+
+			if (descriptor.hasTl0PicIdx)
+				this->lastTl0PicIdx = tl0PicIdx;
+
+			return true;
+		}
+	} // namespace Codecs
+} // namespace RTC
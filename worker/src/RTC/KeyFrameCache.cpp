@@ -0,0 +1,185 @@
+#define MS_CLASS "RTC::KeyFrameCache"
+// #define MS_LOG_DEV
+
+#include "RTC/KeyFrameCache.hpp"
+#include "Logger.hpp"
+#include "RTC/VP9Filter.hpp"
+
+namespace RTC
+{
+	/* Class methods. */
+
+	bool KeyFrameCache::IsKeyFrameStart(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		VP9::VP9PayloadDescription desc;
+
+		if (desc.Parse(packet->GetPayload(), packet->GetPayloadLength()) == 0u)
+			return false;
+
+		// First packet of a base spatial layer frame not predicted from previous
+		// pictures.
+		return desc.startOfLayerFrame && !desc.interPicturePredictedLayerFrame &&
+		       (!desc.layerIndicesPresent || desc.spatialLayerId == 0);
+	}
+
+	/* Instance methods. */
+
+	KeyFrameCache::KeyFrameCache(size_t maxPackets) : maxPackets(maxPackets)
+	{
+		MS_TRACE();
+	}
+
+	KeyFrameCache::~KeyFrameCache()
+	{
+		MS_TRACE();
+
+		Clear();
+	}
+
+	Json::Value KeyFrameCache::ToJson() const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringMaxPackets{ "maxPackets" };
+		static const Json::StaticString JsonStringPackets{ "packets" };
+		static const Json::StaticString JsonStringKeyFramesCached{ "keyFramesCached" };
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringMaxPackets]      = Json::UInt{ static_cast<uint32_t>(this->maxPackets) };
+		json[JsonStringPackets]         = Json::UInt{ static_cast<uint32_t>(this->items.size()) };
+		json[JsonStringKeyFramesCached] = Json::UInt64{ this->keyFramesCached };
+
+		return json;
+	}
+
+	/**
+	 * The packet must have been validated by its RtpStreamRecv so its extended
+	 * sequence number is set.
+	 */
+	void KeyFrameCache::ReceivePacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		uint32_t seq32 = packet->GetExtendedSequenceNumber();
+
+		if (IsKeyFrameStart(packet))
+		{
+			// Retransmission of the first packet of the cached key frame.
+			if (!this->items.empty() && this->items.front().seq32 == seq32)
+				return;
+
+			Clear();
+
+			// Allocate the storage the first time it's needed. It must be empty
+			// so no cached packet points to it when resized.
+			if (this->storage.empty())
+				this->storage.resize(this->maxPackets);
+
+			this->keyFramesCached++;
+		}
+		// Nothing to do until a key frame arrives.
+		else if (this->items.empty())
+		{
+			return;
+		}
+		// Older than the cached key frame.
+		else if (seq32 < this->items.front().seq32)
+		{
+			return;
+		}
+
+		// The picture group is too long, drop it and wait for the next key frame.
+		if (this->items.size() == this->maxPackets || packet->GetSize() > RTC::MtuSize)
+		{
+			MS_DEBUG_TAG(rtp, "cannot cache more packets, waiting for next key frame");
+
+			Clear();
+
+			return;
+		}
+
+		StorePacket(packet);
+	}
+
+	/**
+	 * Fills the given vector with the cached packets in sequence order. Returns
+	 * false if there is no complete key frame or if any packet is missing.
+	 */
+	bool KeyFrameCache::GetPackets(std::vector<RTC::RtpPacket*>& packets) const
+	{
+		MS_TRACE();
+
+		if (this->items.empty())
+			return false;
+
+		uint32_t firstSeq32 = this->items.front().seq32;
+		bool hasMarker{ false };
+
+		for (size_t idx{ 0 }; idx < this->items.size(); ++idx)
+		{
+			auto& item = this->items[idx];
+
+			if (item.seq32 != firstSeq32 + idx)
+				return false;
+
+			if (item.packet->HasMarker())
+				hasMarker = true;
+		}
+
+		// The last packet of the key frame has not been received yet.
+		if (!hasMarker)
+			return false;
+
+		packets.reserve(packets.size() + this->items.size());
+
+		for (auto& item : this->items)
+		{
+			packets.push_back(item.packet);
+		}
+
+		return true;
+	}
+
+	void KeyFrameCache::Clear()
+	{
+		MS_TRACE();
+
+		for (auto& item : this->items)
+		{
+			delete item.packet;
+		}
+
+		this->items.clear();
+	}
+
+	void KeyFrameCache::StorePacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		uint32_t seq32 = packet->GetExtendedSequenceNumber();
+
+		// Usually the packet goes at the end, so look for its position backwards.
+		auto it = this->items.end();
+
+		while (it != this->items.begin() && (it - 1)->seq32 > seq32)
+		{
+			--it;
+		}
+
+		// Duplicated packet.
+		if (it != this->items.begin() && (it - 1)->seq32 == seq32)
+			return;
+
+		CacheItem item;
+
+		// Every stored packet uses a different slot and slots are only released
+		// all together, so the next free one is always at items.size().
+		item.seq32  = seq32;
+		item.packet = packet->Clone(this->storage[this->items.size()].store);
+
+		this->items.insert(it, item);
+	}
+} // namespace RTC
@@ -20,17 +20,11 @@ namespace RTC
 	NackGenerator::NackGenerator(Listener* listener) : listener(listener), rtt(DefaultRtt)
 	{
 		MS_TRACE();
-
-		// Set the timer.
-		this->timer = new Timer(this);
 	}
 
 	NackGenerator::~NackGenerator()
 	{
 		MS_TRACE();
-
-		// Close the timer.
-		this->timer->Destroy();
 	}
 
 	void NackGenerator::ReceivePacket(RTC::RtpPacket* packet)
@@ -203,13 +197,13 @@ namespace RTC
 		return nackBatch;
 	}
 
-	inline void NackGenerator::MayRunTimer() const
+	inline void NackGenerator::MayRunTimer()
 	{
 		if (!this->nackList.empty())
-			this->timer->Start(TimerInterval);
+			this->timer.Start(TimerInterval);
 	}
 
-	inline void NackGenerator::OnTimer(Timer* /*timer*/)
+	inline void NackGenerator::OnTimer(TimerWheel::Handle* /*handle*/)
 	{
 		MS_TRACE();
 
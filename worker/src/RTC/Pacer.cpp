@@ -0,0 +1,403 @@
+#define MS_CLASS "RTC::Pacer"
+// #define MS_LOG_DEV
+
+#include "RTC/Pacer.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::max(), std::min()
+
+namespace RTC
+{
+	/* Static. */
+
+	// The bucket is filled 1.5 times faster than the estimated bitrate so short
+	// bursts are not delayed.
+	static constexpr uint64_t PacingFactorNum{ 3 };
+	static constexpr uint64_t PacingFactorDen{ 2 };
+	// Amount of data (in ms at the paced bitrate) that can be sent in a burst.
+	static constexpr uint64_t BucketDuration{ 40 };
+	static constexpr uint64_t TimerInterval{ 5 };
+	// Queued packets older than this (ms) are useless and dropped.
+	static constexpr uint64_t MaxQueueDelay{ 500 };
+	static constexpr size_t MaxQueuedPackets{ 1000 };
+	// Retransmissions are always allowed up to this bitrate (bps).
+	static constexpr uint32_t MinRetransmissionBitrate{ 64000 };
+	// Minimum bitrate (bps) of a key frame burst if there is no estimation.
+	static constexpr uint32_t MinBurstBitrate{ 2000000 };
+
+	/* Instance methods. */
+
+	Pacer::Pacer(Listener* listener, uint32_t retransmissionBudget)
+	    : listener(listener), retransmissionBudget(retransmissionBudget)
+	{
+		MS_TRACE();
+
+		// Set the timer.
+		this->timer = new Timer(this);
+	}
+
+	Pacer::~Pacer()
+	{
+		MS_TRACE();
+
+		// Close the timer.
+		this->timer->Destroy();
+
+		for (auto& item : this->retransmissionQueue)
+		{
+			ReleaseItem(item);
+		}
+
+		for (auto& item : this->videoQueue)
+		{
+			ReleaseItem(item);
+		}
+
+		for (auto* storage : this->freeStorage)
+		{
+			delete storage;
+		}
+	}
+
+	Json::Value Pacer::ToJson() const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringBitrate{ "bitrate" };
+		static const Json::StaticString JsonStringRetransmissionBudget{ "retransmissionBudget" };
+		static const Json::StaticString JsonStringQueueSize{ "queueSize" };
+		static const Json::StaticString JsonStringPacketsQueued{ "packetsQueued" };
+		static const Json::StaticString JsonStringPacketsDropped{ "packetsDropped" };
+		static const Json::StaticString JsonStringRetransmissionsDropped{ "retransmissionsDropped" };
+		static const Json::StaticString JsonStringTotalQueueDelay{ "totalQueueDelay" };
+		static const Json::StaticString JsonStringMaxQueueDelay{ "maxQueueDelay" };
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringBitrate]              = Json::UInt{ this->bitrate };
+		json[JsonStringRetransmissionBudget] = Json::UInt{ this->retransmissionBudget };
+		json[JsonStringQueueSize] =
+		    Json::UInt{ static_cast<uint32_t>(this->retransmissionQueue.size() + this->videoQueue.size()) };
+		json[JsonStringPacketsQueued]          = Json::UInt64{ this->packetsQueued };
+		json[JsonStringPacketsDropped]         = Json::UInt64{ this->packetsDropped };
+		json[JsonStringRetransmissionsDropped] = Json::UInt64{ this->retransmissionsDropped };
+		json[JsonStringTotalQueueDelay]        = Json::UInt64{ this->totalQueueDelay };
+		json[JsonStringMaxQueueDelay]          = Json::UInt64{ this->maxQueueDelay };
+
+		return json;
+	}
+
+	/**
+	 * Set the estimated available bitrate (bps). 0 disables pacing.
+	 */
+	void Pacer::SetBitrate(uint32_t bitrate)
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+
+		Refill(now);
+
+		bool wasPaced = GetPacingBitrate() != 0u;
+
+		this->bitrate      = bitrate;
+		this->burstBitrate = 0;
+
+		if (this->bitrate == 0u)
+		{
+			// Nothing is delayed anymore.
+			Drain();
+
+			return;
+		}
+
+		SetBucketSize(this->bitrate);
+
+		if (!wasPaced)
+		{
+			this->tokens       = this->bucketSize;
+			this->lastRefillAt = now;
+		}
+		else
+		{
+			this->tokens = std::min(this->tokens, this->bucketSize);
+		}
+	}
+
+	void Pacer::SendRtpPacket(RTC::RtpPacket* packet, Priority priority)
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+
+		Refill(now);
+
+		switch (priority)
+		{
+			case Priority::AUDIO:
+			{
+				Send(packet, false, now);
+
+				break;
+			}
+
+			case Priority::RETRANSMISSION:
+			{
+				if (!IsRetransmissionAllowed(now))
+				{
+					MS_DEBUG_DEV("retransmission budget exhausted, dropping packet");
+
+					this->retransmissionsDropped++;
+
+					return;
+				}
+
+				if (
+				    GetPacingBitrate() == 0u || (this->retransmissionQueue.empty() && this->tokens > 0))
+				{
+					Send(packet, true, now);
+				}
+				else
+				{
+					Enqueue(this->retransmissionQueue, packet, now);
+				}
+
+				break;
+			}
+
+			case Priority::KEY_FRAME:
+			{
+				// Do not send the whole cached picture group at once, it would
+				// most likely cause losses.
+				if (GetPacingBitrate() == 0u)
+					StartBurst(now);
+
+				if (
+				    this->retransmissionQueue.empty() && this->videoQueue.empty() && this->tokens > 0)
+				{
+					Send(packet, false, now);
+				}
+				else
+				{
+					Enqueue(this->videoQueue, packet, now);
+				}
+
+				break;
+			}
+
+			case Priority::VIDEO:
+			{
+				// Also queued while a key frame burst is being sent, so the order is
+				// kept.
+				if (
+				    GetPacingBitrate() == 0u || (this->retransmissionQueue.empty() &&
+				                                 this->videoQueue.empty() && this->tokens > 0))
+				{
+					Send(packet, false, now);
+				}
+				else
+				{
+					Enqueue(this->videoQueue, packet, now);
+				}
+
+				break;
+			}
+		}
+	}
+
+	void Pacer::SetBucketSize(uint32_t bitrate)
+	{
+		MS_TRACE();
+
+		this->bucketSize = static_cast<int64_t>(
+		    uint64_t{ bitrate } * PacingFactorNum / PacingFactorDen * BucketDuration / 8000);
+		this->bucketSize = std::max<int64_t>(this->bucketSize, 2 * RTC::MtuSize);
+	}
+
+	/**
+	 * Paces a key frame burst while there is no estimation. The bitrate is
+	 * above the current media one so the subscriber catches up with the live
+	 * stream.
+	 */
+	void Pacer::StartBurst(uint64_t now)
+	{
+		MS_TRACE();
+
+		this->burstBitrate =
+		    std::max(MinBurstBitrate, static_cast<uint32_t>(this->mediaCounter.GetRate(now)));
+
+		SetBucketSize(this->burstBitrate);
+
+		this->tokens       = this->bucketSize;
+		this->lastRefillAt = now;
+
+		// The burst is over once the queues are drained by the timer.
+		if (!this->timer->IsActive())
+			this->timer->Start(TimerInterval, TimerInterval);
+	}
+
+	void Pacer::Refill(uint64_t now)
+	{
+		MS_TRACE();
+
+		uint32_t pacingBitrate = GetPacingBitrate();
+
+		if (pacingBitrate == 0u)
+			return;
+
+		uint64_t elapsed = now - this->lastRefillAt;
+
+		this->tokens += static_cast<int64_t>(
+		    elapsed * pacingBitrate * PacingFactorNum / PacingFactorDen / 8000);
+		this->tokens       = std::min(this->tokens, this->bucketSize);
+		this->lastRefillAt = now;
+	}
+
+	bool Pacer::IsRetransmissionAllowed(uint64_t now)
+	{
+		MS_TRACE();
+
+		// 0 means no budget.
+		if (this->retransmissionBudget == 0u)
+			return true;
+
+		uint64_t mediaBitrate   = this->mediaCounter.GetRate(now);
+		uint64_t allowedBitrate = std::max<uint64_t>(
+		    MinRetransmissionBitrate, mediaBitrate * this->retransmissionBudget / 100);
+
+		return this->retransmissionCounter.GetRate(now) < allowedBitrate;
+	}
+
+	inline void Pacer::Send(RTC::RtpPacket* packet, bool isRetransmission, uint64_t /*now*/)
+	{
+		MS_TRACE();
+
+		if (GetPacingBitrate() != 0u)
+			this->tokens -= packet->GetSize();
+
+		if (isRetransmission)
+			this->retransmissionCounter.Update(packet);
+		else
+			this->mediaCounter.Update(packet);
+
+		this->listener->OnPacerRtpPacket(this, packet);
+	}
+
+	void Pacer::Enqueue(std::deque<QueueItem>& queue, RTC::RtpPacket* packet, uint64_t now)
+	{
+		MS_TRACE();
+
+		if (packet->GetSize() > RTC::MtuSize)
+		{
+			MS_WARN_TAG(
+			    rtp,
+			    "packet too big, dropping it [ssrc:%" PRIu32 ", seq:%" PRIu16 ", size:%zu]",
+			    packet->GetSsrc(),
+			    packet->GetSequenceNumber(),
+			    packet->GetSize());
+
+			this->packetsDropped++;
+
+			return;
+		}
+
+		// Drop the oldest packet if the queue is full.
+		if (queue.size() >= MaxQueuedPackets)
+		{
+			ReleaseItem(queue.front());
+			queue.pop_front();
+
+			this->packetsDropped++;
+		}
+
+		QueueItem item;
+
+		if (!this->freeStorage.empty())
+		{
+			item.storage = this->freeStorage.back();
+			this->freeStorage.pop_back();
+		}
+		else
+		{
+			item.storage = new StorageItem();
+		}
+
+		item.packet   = packet->Clone(item.storage->store);
+		item.queuedAt = now;
+
+		queue.push_back(item);
+
+		this->packetsQueued++;
+
+		if (!this->timer->IsActive())
+			this->timer->Start(TimerInterval, TimerInterval);
+	}
+
+	void Pacer::Dequeue(std::deque<QueueItem>& queue, bool isRetransmission, uint64_t now)
+	{
+		MS_TRACE();
+
+		QueueItem item = queue.front();
+		uint64_t delay = now - item.queuedAt;
+
+		queue.pop_front();
+
+		// A key frame burst is not limited by the network, so it must be sent
+		// whole however long it takes.
+		if (this->bitrate != 0u && delay > MaxQueueDelay)
+		{
+			this->packetsDropped++;
+		}
+		else
+		{
+			this->totalQueueDelay += delay;
+			this->maxQueueDelay = std::max(this->maxQueueDelay, delay);
+
+			Send(item.packet, isRetransmission, now);
+		}
+
+		ReleaseItem(item);
+	}
+
+	void Pacer::Drain()
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+
+		Refill(now);
+
+		while (GetPacingBitrate() == 0u || this->tokens > 0)
+		{
+			if (!this->retransmissionQueue.empty())
+				Dequeue(this->retransmissionQueue, true, now);
+			else if (!this->videoQueue.empty())
+				Dequeue(this->videoQueue, false, now);
+			else
+				break;
+		}
+
+		if (this->retransmissionQueue.empty() && this->videoQueue.empty())
+		{
+			this->timer->Stop();
+
+			// The key frame burst is over.
+			this->burstBitrate = 0;
+		}
+	}
+
+	inline void Pacer::ReleaseItem(QueueItem& item)
+	{
+		MS_TRACE();
+
+		delete item.packet;
+		this->freeStorage.push_back(item.storage);
+	}
+
+	inline void Pacer::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		Drain();
+	}
+} // namespace RTC
@@ -0,0 +1,160 @@
+#define MS_CLASS "RTC::PacketTap"
+// #define MS_LOG_DEV
+
+#include "RTC/PacketTap.hpp"
+#include "Logger.hpp"
+#include "MediaSoupError.hpp"
+#include <cerrno>
+#include <cstddef> // offsetof()
+#include <cstring> // std::memcpy(), std::strerror()
+#include <sys/mman.h> // mmap(), munmap()
+#include <unistd.h>   // close(), ftruncate(), getpid()
+#ifdef __linux__
+#include <sys/syscall.h> // SYS_memfd_create
+#endif
+
+namespace RTC
+{
+	/* Static. */
+
+	// MFD_CLOEXEC, not exposed by old libc headers.
+	static constexpr unsigned int MemfdCloexec{ 0x0001U };
+
+	static_assert(offsetof(PacketTap::Header, writePos) == 64, "writePos not at offset 64");
+	static_assert(offsetof(PacketTap::Header, readPos) == 128, "readPos not at offset 128");
+	static_assert(sizeof(PacketTap::Header) <= PacketTap::DataOffset, "Header too big");
+	static_assert(sizeof(PacketTap::Record) == 16, "unexpected Record size");
+
+	/* Instance methods. */
+
+	PacketTap::PacketTap(size_t dataSize)
+	{
+		MS_TRACE();
+
+		// Keep the records 8 bytes aligned.
+		this->dataSize = (dataSize + 7) & ~static_cast<size_t>(7);
+		this->size     = DataOffset + this->dataSize;
+
+#if defined(__linux__) && defined(SYS_memfd_create)
+		this->fd = static_cast<int>(syscall(SYS_memfd_create, "mediasoup-packet-tap", MemfdCloexec));
+#else
+		MS_THROW_ERROR("packet taps not supported in this platform");
+#endif
+
+		if (this->fd == -1)
+			MS_THROW_ERROR("memfd_create() failed: %s", std::strerror(errno));
+
+		if (ftruncate(this->fd, this->size) == -1)
+		{
+			int error = errno;
+
+			close(this->fd);
+
+			MS_THROW_ERROR("ftruncate() failed: %s", std::strerror(error));
+		}
+
+		void* memory = mmap(nullptr, this->size, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+
+		if (memory == MAP_FAILED)
+		{
+			int error = errno;
+
+			close(this->fd);
+
+			MS_THROW_ERROR("mmap() failed: %s", std::strerror(error));
+		}
+
+		this->memory = static_cast<uint8_t*>(memory);
+		this->header = reinterpret_cast<Header*>(this->memory);
+		this->data   = this->memory + DataOffset;
+
+		// The memory comes zeroed.
+		this->header->magic    = Magic;
+		this->header->version  = Version;
+		this->header->dataSize = this->dataSize;
+
+		this->path = "/proc/" + std::to_string(getpid()) + "/fd/" + std::to_string(this->fd);
+	}
+
+	PacketTap::~PacketTap()
+	{
+		MS_TRACE();
+
+		munmap(this->memory, this->size);
+		close(this->fd);
+	}
+
+	Json::Value PacketTap::ToJson() const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringPath{ "path" };
+		static const Json::StaticString JsonStringSize{ "size" };
+		static const Json::StaticString JsonStringWritten{ "written" };
+		static const Json::StaticString JsonStringDropped{ "dropped" };
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringPath]    = this->path;
+		json[JsonStringSize]    = Json::UInt64{ this->size };
+		json[JsonStringWritten] = Json::UInt64{ this->written };
+		json[JsonStringDropped] = Json::UInt64{ this->header->dropped.load(std::memory_order_relaxed) };
+
+		return json;
+	}
+
+	/**
+	 * Copies the packet into the ring.
+	 * @return  false if the reader has not left room for it, so it is dropped.
+	 */
+	bool PacketTap::Write(
+	    uint32_t rtpReceiverId, uint64_t arrivalTime, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		size_t recordLen  = sizeof(Record) + ((len + 7) & ~static_cast<size_t>(7));
+		uint64_t writePos = this->header->writePos.load(std::memory_order_relaxed);
+		uint64_t readPos  = this->header->readPos.load(std::memory_order_acquire);
+		size_t offset     = writePos % this->dataSize;
+		size_t tail       = this->dataSize - offset;
+		// The tail is skipped if the record does not fit into it.
+		size_t needed = tail < recordLen ? tail + recordLen : recordLen;
+
+		if (readPos > writePos || writePos - readPos + needed > this->dataSize)
+		{
+			this->header->dropped.fetch_add(1, std::memory_order_relaxed);
+
+			return false;
+		}
+
+		if (tail < recordLen)
+		{
+			if (tail >= sizeof(Record))
+			{
+				auto* wrap = reinterpret_cast<Record*>(this->data + offset);
+
+				wrap->rtpReceiverId = rtpReceiverId;
+				wrap->length        = WrapLength;
+				wrap->arrivalTime   = arrivalTime;
+			}
+
+			writePos += tail;
+			offset = 0;
+		}
+
+		auto* record = reinterpret_cast<Record*>(this->data + offset);
+
+		record->rtpReceiverId = rtpReceiverId;
+		record->length        = static_cast<uint32_t>(len);
+		record->arrivalTime   = arrivalTime;
+
+		std::memcpy(this->data + offset + sizeof(Record), data, len);
+
+		// Publish the record.
+		this->header->writePos.store(writePos + recordLen, std::memory_order_release);
+
+		++this->written;
+
+		return true;
+	}
+} // namespace RTC
@@ -5,14 +5,17 @@
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
-#include "RTC/RTCP/CompoundPacket.hpp"
-#include "RTC/RTCP/FeedbackPsRemb.hpp"
-#include "RTC/RTCP/FeedbackRtpNack.hpp"
-#include "RTC/RTCP/Sdes.hpp"
+#include "RTC/RTCP/FeedbackPsPli.hpp"
 #include "RTC/RtpDictionaries.hpp"
+#include "Utils.hpp"
 
 namespace RTC
 {
+	/* Static. */
+
+	// Same as the period of the RtpSender layer bitrates measurement.
+	static constexpr uint64_t AllocationInterval{ 1000 }; // In ms.
+
 	/* Instance methods. */
 
 	Peer::Peer(Listener* listener, Channel::Notifier* notifier, uint32_t peerId, std::string& peerName)
@@ -20,18 +23,12 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->timer = new Timer(this);
-
-		// Start the RTCP timer.
-		this->timer->Start(static_cast<uint64_t>(RTC::RTCP::MaxVideoIntervalMs / 2));
+		this->allocationTimer.Start(AllocationInterval, AllocationInterval);
 	}
 
 	Peer::~Peer()
 	{
 		MS_TRACE();
-
-		// Destroy the RTCP timer.
-		this->timer->Destroy();
 	}
 
 	void Peer::Destroy()
@@ -42,6 +39,17 @@ namespace RTC
 
 		Json::Value eventData(Json::objectValue);
 
+		this->allocationTimer.Stop();
+
+		// Abort the ongoing dumps.
+		for (auto it = this->dumpWriters.begin(); it != this->dumpWriters.end();)
+		{
+			auto* dumpWriter = it->first;
+
+			it = this->dumpWriters.erase(it);
+			dumpWriter->Destroy();
+		}
+
 		// Close all the RtpReceivers.
 		for (auto it = this->rtpReceivers.begin(); it != this->rtpReceivers.end();)
 		{
@@ -81,7 +89,11 @@ namespace RTC
 		delete this;
 	}
 
-	Json::Value Peer::ToJson() const
+	/**
+	 * Without its entities the arrays of Transports, RtpReceivers and RtpSenders
+	 * are left empty, to be filled by FillDumpStep().
+	 */
+	Json::Value Peer::ToJson(bool withEntities) const
 	{
 		MS_TRACE();
 
@@ -107,34 +119,145 @@ namespace RTC
 		if (this->hasCapabilities)
 			json[JsonStringCapabilities] = this->capabilities.ToJson();
 
-		// Add `transports`.
+		if (withEntities)
+		{
+			// Add `transports`.
+			for (auto& kv : this->transports)
+			{
+				auto* transport = kv.second;
+
+				jsonTransports.append(transport->ToJson());
+			}
+
+			// Add `rtpReceivers`.
+			for (auto& kv : this->rtpReceivers)
+			{
+				auto* rtpReceiver = kv.second;
+
+				jsonRtpReceivers.append(rtpReceiver->ToJson());
+			}
+
+			// Add `rtpSenders`.
+			for (auto& kv : this->rtpSenders)
+			{
+				auto* rtpSender = kv.second;
+
+				jsonRtpSenders.append(rtpSender->ToJson());
+			}
+		}
+		json[JsonStringTransports]   = jsonTransports;
+		json[JsonStringRtpReceivers] = jsonRtpReceivers;
+		json[JsonStringRtpSenders]   = jsonRtpSenders;
+
+		return json;
+	}
+
+	/**
+	 * A step per Transport, RtpReceiver and RtpSender of the Peer.
+	 */
+	std::vector<Peer::DumpStep> Peer::GetDumpSteps() const
+	{
+		MS_TRACE();
+
+		std::vector<DumpStep> steps;
+
+		steps.reserve(this->transports.size() + this->rtpReceivers.size() + this->rtpSenders.size());
+
 		for (auto& kv : this->transports)
 		{
-			auto* transport = kv.second;
+			steps.push_back({ DumpStep::Kind::TRANSPORT, kv.first });
+		}
+
+		for (auto& kv : this->rtpReceivers)
+		{
+			steps.push_back({ DumpStep::Kind::RTP_RECEIVER, kv.first });
+		}
+
+		for (auto& kv : this->rtpSenders)
+		{
+			steps.push_back({ DumpStep::Kind::RTP_SENDER, kv.first });
+		}
+
+		return steps;
+	}
+
+	/**
+	 * Sets data to the Peer without its entities, or appends the entity of the
+	 * step to its array in data unless it has been closed meanwhile.
+	 */
+	void Peer::FillDumpStep(const DumpStep& step, Json::Value& data) const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringTransports{ "transports" };
+		static const Json::StaticString JsonStringRtpReceivers{ "rtpReceivers" };
+		static const Json::StaticString JsonStringRtpSenders{ "rtpSenders" };
+
+		switch (step.kind)
+		{
+			case DumpStep::Kind::PEER:
+			{
+				data = ToJson(false);
+
+				break;
+			}
+
+			case DumpStep::Kind::TRANSPORT:
+			{
+				auto it = this->transports.find(step.id);
+
+				if (it != this->transports.end())
+					data[JsonStringTransports].append(it->second->ToJson());
+
+				break;
+			}
 
-			jsonTransports.append(transport->ToJson());
+			case DumpStep::Kind::RTP_RECEIVER:
+			{
+				auto it = this->rtpReceivers.find(step.id);
+
+				if (it != this->rtpReceivers.end())
+					data[JsonStringRtpReceivers].append(it->second->ToJson());
+
+				break;
+			}
+
+			case DumpStep::Kind::RTP_SENDER:
+			{
+				auto it = this->rtpSenders.find(step.id);
+
+				if (it != this->rtpSenders.end())
+					data[JsonStringRtpSenders].append(it->second->ToJson());
+
+				break;
+			}
 		}
-		json[JsonStringTransports] = jsonTransports;
+	}
+
+	/**
+	 * Adds the stats of every stream of the Peer, or just of those using the
+	 * given Transport, to the snapshot.
+	 */
+	void Peer::FillStats(
+	    RTC::StatsSnapshot& snapshot, uint64_t now, const RTC::Transport* transport) const
+	{
+		MS_TRACE();
 
-		// Add `rtpReceivers`.
 		for (auto& kv : this->rtpReceivers)
 		{
 			auto* rtpReceiver = kv.second;
 
-			jsonRtpReceivers.append(rtpReceiver->ToJson());
+			if (transport == nullptr || rtpReceiver->GetTransport() == transport)
+				rtpReceiver->FillStats(snapshot, now);
 		}
-		json[JsonStringRtpReceivers] = jsonRtpReceivers;
 
-		// Add `rtpSenders`.
 		for (auto& kv : this->rtpSenders)
 		{
 			auto* rtpSender = kv.second;
 
-			jsonRtpSenders.append(rtpSender->ToJson());
+			if (transport == nullptr || rtpSender->GetTransport() == transport)
+				rtpSender->FillStats(snapshot, now);
 		}
-		json[JsonStringRtpSenders] = jsonRtpSenders;
-
-		return json;
 	}
 
 	void Peer::HandleRequest(Channel::Request* request)
@@ -160,9 +283,10 @@ namespace RTC
 
 			case Channel::Request::MethodId::PEER_DUMP:
 			{
-				auto json = ToJson();
+				// Dump a Transport, RtpReceiver or RtpSender per loop iteration.
+				auto* dumpWriter = new Channel::DumpWriter(this, request);
 
-				request->Accept(json);
+				this->dumpWriters[dumpWriter] = GetDumpSteps();
 
 				break;
 			}
@@ -335,11 +459,45 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::TRANSPORT_GET_STATS:
+			{
+				RTC::Transport* transport;
+
+				try
+				{
+					transport = GetTransportFromRequest(request);
+				}
+				catch (const MediaSoupError& error)
+				{
+					request->Reject(error.what());
+
+					return;
+				}
+
+				if (transport == nullptr)
+				{
+					request->Reject("Transport does not exist");
+
+					return;
+				}
+
+				uint64_t now = DepLibUV::GetTime();
+				RTC::StatsSnapshot snapshot(now);
+				Json::Value data(Json::objectValue);
+
+				FillStats(snapshot, now, transport);
+
+				request->Accept(data, snapshot.GetData(), snapshot.GetSize());
+
+				break;
+			}
+
 			case Channel::Request::MethodId::TRANSPORT_CLOSE:
 			case Channel::Request::MethodId::TRANSPORT_DUMP:
 			case Channel::Request::MethodId::TRANSPORT_SET_REMOTE_DTLS_PARAMETERS:
 			case Channel::Request::MethodId::TRANSPORT_SET_MAX_BITRATE:
 			case Channel::Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD:
+			case Channel::Request::MethodId::TRANSPORT_SET_REMOTE_PARAMETERS:
 			{
 				RTC::Transport* transport;
 
@@ -371,6 +529,7 @@ namespace RTC
 			case Channel::Request::MethodId::RTP_RECEIVER_RECEIVE:
 			case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_RAW_EVENT:
 			case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_OBJECT_EVENT:
+			case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_TAP:
 			{
 				RTC::RtpReceiver* rtpReceiver;
 
@@ -457,6 +616,10 @@ namespace RTC
 				if ((previousTransport != nullptr) && previousTransport->HasRemb())
 					transport->EnableRemb();
 
+				// Same for transport-cc.
+				if ((previousTransport != nullptr) && previousTransport->HasTransportCc())
+					transport->EnableTransportCc();
+
 				rtpReceiver->SetTransport(transport);
 
 				request->Accept();
@@ -541,6 +704,9 @@ namespace RTC
 			}
 
 			case Channel::Request::MethodId::RTP_SENDER_DISABLE:
+			case Channel::Request::MethodId::RTP_SENDER_SET_PREFERRED_LAYERS:
+			case Channel::Request::MethodId::RTP_SENDER_SET_PINNED:
+			case Channel::Request::MethodId::RTP_SENDER_SET_MAX_RESOLUTION:
 			{
 				RTC::RtpSender* rtpSender;
 
@@ -644,71 +810,74 @@ namespace RTC
 		return nullptr;
 	}
 
-	void Peer::SendRtcp(uint64_t now)
+	/**
+	 * Shares the available bitrate of each Transport among the RtpSenders using it.
+	 */
+	void Peer::AllocateBitrate()
 	{
 		MS_TRACE();
 
-		// For every transport:
-		// - Create a CompoundPacket.
-		// - Request every Sender and Receiver of such transport their RTCP data.
-		// - Send the CompoundPacket.
-
-		for (auto& it : this->transports)
+		for (auto& kv : this->transports)
 		{
-			std::unique_ptr<RTC::RTCP::CompoundPacket> packet(new RTC::RTCP::CompoundPacket());
-			auto* transport = it.second;
-
-			for (auto& it : this->rtpSenders)
-			{
-				auto* rtpSender = it.second;
+			auto* transport = kv.second;
 
-				if (rtpSender->GetTransport() != transport)
-					continue;
+			AllocateBitrate(transport);
+		}
+	}
 
-				rtpSender->GetRtcp(packet.get(), now);
+	void Peer::AllocateBitrate(RTC::Transport* transport)
+	{
+		MS_TRACE();
 
-				// Send one RTCP compound packet per sender report.
-				if (packet->GetSenderReportCount() != 0u)
-				{
-					// Ensure that the RTCP packet fits into the RTCP buffer.
-					if (packet->GetSize() > RTC::RTCP::BufferSize)
-					{
-						MS_WARN_TAG(rtcp, "cannot send RTCP packet, size too big (%zu bytes)", packet->GetSize());
+		this->allocatedStreams.clear();
 
-						return;
-					}
+		for (auto& kv : this->rtpSenders)
+		{
+			auto* rtpSender = kv.second;
 
-					packet->Serialize(RTC::RTCP::Buffer);
-					transport->SendRtcpCompoundPacket(packet.get());
-					// Reset the Compound packet.
-					packet.reset(new RTC::RTCP::CompoundPacket());
-				}
+			if (
+			    rtpSender->GetTransport() != transport || !rtpSender->HasLayers() ||
+			    !rtpSender->GetActive() || rtpSender->GetPaused())
+			{
+				continue;
 			}
 
-			for (auto& it : this->rtpReceivers)
-			{
-				auto* rtpReceiver = it.second;
+			RTC::BitrateAllocator::Stream stream;
 
-				if (rtpReceiver->GetTransport() != transport)
-					continue;
+			stream.rtpSender              = rtpSender;
+			stream.preferredSpatialLayer  = rtpSender->GetMaxSpatialLayer();
+			stream.preferredTemporalLayer = rtpSender->GetPreferredTemporalLayer();
+			stream.currentSpatialLayer    = rtpSender->GetTargetSpatialLayer();
+			stream.currentTemporalLayer   = rtpSender->GetTargetTemporalLayer();
 
-				rtpReceiver->GetRtcp(packet.get(), now);
-			}
+			if (rtpSender->GetActiveSpeaker())
+				stream.priority = RTC::BitrateAllocator::Priority::ACTIVE_SPEAKER;
+			else if (rtpSender->GetPinned())
+				stream.priority = RTC::BitrateAllocator::Priority::PINNED;
+			else
+				stream.priority = RTC::BitrateAllocator::Priority::THUMBNAIL;
 
-			// Send one RTCP compound with all receiver reports.
-			if (packet->GetReceiverReportCount() != 0u)
+			for (uint8_t spatialLayer{ 0 }; spatialLayer < RTC::RtpSender::MaxSpatialLayers; ++spatialLayer)
 			{
-				// Ensure that the RTCP packet fits into the RTCP buffer.
-				if (packet->GetSize() > RTC::RTCP::BufferSize)
+				for (uint8_t temporalLayer{ 0 }; temporalLayer < RTC::RtpSender::MaxTemporalLayers;
+				     ++temporalLayer)
 				{
-					MS_WARN_TAG(rtcp, "cannot send RTCP packet, size too big (%zu bytes)", packet->GetSize());
-
-					return;
+					stream.layersBitrate[spatialLayer][temporalLayer] =
+					    rtpSender->GetLayersBitrate(spatialLayer, temporalLayer);
 				}
-
-				packet->Serialize(RTC::RTCP::Buffer);
-				transport->SendRtcpCompoundPacket(packet.get());
 			}
+
+			this->allocatedStreams.push_back(stream);
+		}
+
+		if (this->allocatedStreams.empty())
+			return;
+
+		RTC::BitrateAllocator::Allocate(transport->GetAvailableBitrate(), this->allocatedStreams);
+
+		for (auto& stream : this->allocatedStreams)
+		{
+			stream.rtpSender->SetTargetLayers(stream.spatialLayer, stream.temporalLayer);
 		}
 	}
 
@@ -854,6 +1023,13 @@ namespace RTC
 		}
 	}
 
+	void Peer::OnTransportAvailableBitrateChange(RTC::Transport* transport, uint32_t /*availableBitrate*/)
+	{
+		MS_TRACE();
+
+		AllocateBitrate(transport);
+	}
+
 	void Peer::OnRtpReceiverParameters(RTC::RtpReceiver* rtpReceiver)
 	{
 		MS_TRACE();
@@ -889,37 +1065,60 @@ namespace RTC
 		this->listener->OnPeerRtpPacket(this, rtpReceiver, packet);
 	}
 
-	void Peer::OnTransportRtcpPacket(RTC::Transport* transport, RTC::RTCP::Packet* packet)
+	void Peer::OnTransportRtcpPacket(
+	    RTC::Transport* transport, const RTC::RTCP::CompoundPacketView& compoundPacket)
 	{
 		MS_TRACE();
 
-		while (packet != nullptr)
+		for (auto it = compoundPacket.Begin(); it != compoundPacket.End(); ++it)
 		{
-			switch (packet->GetType())
+			auto& packet = *it;
+
+			switch (packet.GetType())
 			{
-				/* RTCP coming from a remote receiver which must be forwarded to the corresponding remote
-				 * sender. */
+				/* RTCP coming from a remote sender which must be forwarded to the corresponding remote
+				 * receivers. */
 
-				case RTCP::Type::RR:
+				case RTCP::Type::SR:
 				{
-					auto* rr = dynamic_cast<RTCP::ReceiverReportPacket*>(packet);
-					auto it  = rr->Begin();
+					RTCP::SenderReport report(packet.GetSenderReport());
+					// Get the receiver associated to the SSRC indicated in the report.
+					auto* rtpReceiver = transport->GetRtpReceiver(report.GetSsrc());
+
+					if (rtpReceiver != nullptr)
+					{
+						this->listener->OnPeerRtcpSenderReport(this, rtpReceiver, &report);
+					}
+					else
+					{
+						MS_WARN_TAG(
+						    rtcp,
+						    "no RtpReceiver found for received Sender Report [ssrc:%" PRIu32 "]",
+						    report.GetSsrc());
+					}
+				}
 
-					for (; it != rr->End(); ++it)
+				// The report blocks of the Sender Report are handled as those of a
+				// Receiver Report.
+				// Falls through.
+				case RTCP::Type::RR:
+				{
+					// Receiver reports must be forwarded to the corresponding remote sender.
+					for (size_t i{ 0 }; i < packet.GetReceiverReportCount(); ++i)
 					{
-						auto& report    = (*it);
-						auto* rtpSender = this->GetRtpSender(report->GetSsrc());
+						RTCP::ReceiverReport report(packet.GetReceiverReport(i));
+						auto* rtpSender = this->GetRtpSender(report.GetSsrc());
 
 						if (rtpSender != nullptr)
 						{
-							this->listener->OnPeerRtcpReceiverReport(this, rtpSender, report);
+							this->listener->OnPeerRtcpReceiverReport(this, rtpSender, &report);
 						}
 						else
 						{
 							MS_WARN_TAG(
 							    rtcp,
 							    "no RtpSender found for received Receiver Report [ssrc:%" PRIu32 "]",
-							    report->GetSsrc());
+							    report.GetSsrc());
 						}
 					}
 
@@ -928,48 +1127,119 @@ namespace RTC
 
 				case RTCP::Type::PSFB:
 				{
-					auto* feedback = dynamic_cast<RTCP::FeedbackPsPacket*>(packet);
+					auto messageType = packet.GetPsFeedbackType();
 
-					switch (feedback->GetMessageType())
+					switch (messageType)
 					{
 						case RTCP::FeedbackPs::MessageType::AFB:
 						{
-							auto* afb = dynamic_cast<RTCP::FeedbackPsAfbPacket*>(feedback);
+							// REMB from the remote receiver, use it as the estimated available
+							// bitrate of the transport.
+							if (packet.IsRemb())
+							{
+								transport->ReceiveRtcpRemb(packet.GetRembBitrate());
 
-							if (afb->GetApplication() == RTCP::FeedbackPsAfbPacket::Application::REMB)
 								break;
+							}
 						}
 
-						// [[fallthrough]]; (C++17)
+						// Falls through.
 						case RTCP::FeedbackPs::MessageType::PLI:
 						case RTCP::FeedbackPs::MessageType::SLI:
 						case RTCP::FeedbackPs::MessageType::RPSI:
-						case RTCP::FeedbackPs::MessageType::FIR:
 						{
-							auto* rtpSender = this->GetRtpSender(feedback->GetMediaSsrc());
+							auto* rtpSender = this->GetRtpSender(packet.GetMediaSsrc());
 
-							if (rtpSender != nullptr)
-							{
-								// If the RtpSender is not active, drop the packet.
-								if (!rtpSender->GetActive())
-									break;
-
-								if (feedback->GetMessageType() == RTCP::FeedbackPs::MessageType::PLI)
-								{
-									MS_DEBUG_TAG(rtx, "PLI received [media ssrc:%" PRIu32 "]", feedback->GetMediaSsrc());
-								}
-
-								this->listener->OnPeerRtcpFeedback(this, rtpSender, feedback);
-							}
-							else
+							if (rtpSender == nullptr)
 							{
 								MS_WARN_TAG(
 								    rtcp,
 								    "no RtpSender found for received %s Feedback packet "
 								    "[sender ssrc:%" PRIu32 ", media ssrc:%" PRIu32 "]",
-								    RTCP::FeedbackPsPacket::MessageType2String(feedback->GetMessageType()).c_str(),
-								    feedback->GetMediaSsrc(),
-								    feedback->GetMediaSsrc());
+								    RTCP::FeedbackPsPacket::MessageType2String(messageType).c_str(),
+								    packet.GetSsrc(),
+								    packet.GetMediaSsrc());
+
+								break;
+							}
+
+							// If the RtpSender is not active, drop the packet.
+							if (!rtpSender->GetActive())
+								break;
+
+							if (messageType == RTCP::FeedbackPs::MessageType::PLI)
+							{
+								MS_DEBUG_TAG(rtx, "PLI received [media ssrc:%" PRIu32 "]", packet.GetMediaSsrc());
+
+								rtpSender->ReceiveKeyFrameRequest();
+
+								RTCP::FeedbackPsPliPacket feedback(packet.GetHeader());
+
+								this->listener->OnPeerRtcpFeedback(this, rtpSender, &feedback);
+
+								break;
+							}
+
+							// Less common requests are forwarded as parsed feedback packets.
+							RTCP::Packet* feedback =
+							    RTCP::FeedbackPsPacket::Parse(packet.GetData(), packet.GetSize());
+
+							if (feedback != nullptr)
+							{
+								this->listener->OnPeerRtcpFeedback(
+								    this, rtpSender, static_cast<RTCP::FeedbackPsPacket*>(feedback));
+
+								delete feedback;
+							}
+
+							break;
+						}
+
+						case RTCP::FeedbackPs::MessageType::FIR:
+						{
+							// Each item requests a key frame of a stream, the media SSRC is unused.
+							for (size_t idx{ 0 }; idx < packet.GetFirItemCount(); ++idx)
+							{
+								uint32_t ssrc   = packet.GetFirItemSsrc(idx);
+								auto* rtpSender = this->GetRtpSender(ssrc);
+
+								if (rtpSender == nullptr)
+								{
+									MS_WARN_TAG(
+									    rtcp,
+									    "no RtpSender found for received FIR Feedback packet "
+									    "[sender ssrc:%" PRIu32 ", ssrc:%" PRIu32 "]",
+									    packet.GetSsrc(),
+									    ssrc);
+
+									continue;
+								}
+
+								// If the RtpSender is not active, ignore the request.
+								if (!rtpSender->GetActive())
+									continue;
+
+								MS_DEBUG_TAG(rtx, "FIR received [ssrc:%" PRIu32 "]", ssrc);
+
+								rtpSender->ReceiveKeyFrameRequest();
+
+								// Request the key frame upstream with a PLI built in place.
+								uint8_t buffer[sizeof(RTCP::Packet::CommonHeader) +
+								               sizeof(RTCP::FeedbackPsPacket::Header)];
+								auto* header = reinterpret_cast<RTCP::Packet::CommonHeader*>(buffer);
+
+								header->version    = 2;
+								header->padding    = 0;
+								header->count      = static_cast<uint8_t>(RTCP::FeedbackPs::MessageType::PLI);
+								header->packetType = static_cast<uint8_t>(RTCP::Type::PSFB);
+								header->length     = htons(static_cast<uint16_t>((sizeof(buffer) / 4) - 1));
+
+								Utils::Byte::Set4Bytes(buffer, sizeof(*header), packet.GetSsrc());
+								Utils::Byte::Set4Bytes(buffer, sizeof(*header) + 4, ssrc);
+
+								RTCP::FeedbackPsPliPacket feedback(header);
+
+								this->listener->OnPeerRtcpFeedback(this, rtpSender, &feedback);
 							}
 
 							break;
@@ -987,9 +1257,9 @@ namespace RTC
 							    rtcp,
 							    "ignoring unsupported %s Feedback packet "
 							    "[sender ssrc:%" PRIu32 ", media ssrc:%" PRIu32 "]",
-							    RTCP::FeedbackPsPacket::MessageType2String(feedback->GetMessageType()).c_str(),
-							    feedback->GetMediaSsrc(),
-							    feedback->GetMediaSsrc());
+							    RTCP::FeedbackPsPacket::MessageType2String(messageType).c_str(),
+							    packet.GetSsrc(),
+							    packet.GetMediaSsrc());
 
 							break;
 						}
@@ -1000,19 +1270,26 @@ namespace RTC
 
 				case RTCP::Type::RTPFB:
 				{
-					auto* feedback = dynamic_cast<RTCP::FeedbackRtpPacket*>(packet);
+					auto messageType = packet.GetRtpFeedbackType();
 
-					switch (feedback->GetMessageType())
+					switch (messageType)
 					{
 						case RTCP::FeedbackRtp::MessageType::NACK:
 						{
-							auto* rtpSender = this->GetRtpSender(feedback->GetMediaSsrc());
+							auto* rtpSender = this->GetRtpSender(packet.GetMediaSsrc());
 
 							if (rtpSender != nullptr)
 							{
-								auto* nackPacket = dynamic_cast<RTC::RTCP::FeedbackRtpNackPacket*>(packet);
+								std::vector<uint16_t> missingSeqNumbers;
 
-								rtpSender->ReceiveNack(nackPacket);
+								rtpSender->ReceiveNack(packet, missingSeqNumbers);
+
+								// Let the Room request upstream those not in the RtpSender storage.
+								if (!missingSeqNumbers.empty())
+								{
+									this->listener->OnPeerRtcpNackNotServed(
+									    this, rtpSender, packet.GetMediaSsrc(), missingSeqNumbers);
+								}
 							}
 							else
 							{
@@ -1020,13 +1297,20 @@ namespace RTC
 								    rtcp,
 								    "no RtpSender found for received NACK Feedback packet "
 								    "[sender ssrc:%" PRIu32 ", media ssrc:%" PRIu32 "]",
-								    feedback->GetMediaSsrc(),
-								    feedback->GetMediaSsrc());
+								    packet.GetSsrc(),
+								    packet.GetMediaSsrc());
 							}
 
 							break;
 						}
 
+						case RTCP::FeedbackRtp::MessageType::TRANSPORT:
+						{
+							transport->ReceiveRtcpTransportFeedback(packet);
+
+							break;
+						}
+
 						case RTCP::FeedbackRtp::MessageType::TMMBR:
 						case RTCP::FeedbackRtp::MessageType::TMMBN:
 						case RTCP::FeedbackRtp::MessageType::SR_REQ:
@@ -1041,9 +1325,9 @@ namespace RTC
 							    rtcp,
 							    "ignoring unsupported %s Feedback packet "
 							    "[sender ssrc:%" PRIu32 ", media ssrc:%" PRIu32 "]",
-							    RTCP::FeedbackRtpPacket::MessageType2String(feedback->GetMessageType()).c_str(),
-							    feedback->GetMediaSsrc(),
-							    feedback->GetMediaSsrc());
+							    RTCP::FeedbackRtpPacket::MessageType2String(messageType).c_str(),
+							    packet.GetSsrc(),
+							    packet.GetMediaSsrc());
 
 							break;
 						}
@@ -1052,54 +1336,9 @@ namespace RTC
 					break;
 				}
 
-				/* RTCP coming from a remote sender which must be forwarded to the corresponding remote
-				 * receivers. */
-
-				case RTCP::Type::SR:
-				{
-					auto* sr = dynamic_cast<RTCP::SenderReportPacket*>(packet);
-					auto it  = sr->Begin();
-
-					// Even if Sender Report packet can only contain one report..
-					for (; it != sr->End(); ++it)
-					{
-						auto& report = (*it);
-						// Get the receiver associated to the SSRC indicated in the report.
-						auto* rtpReceiver = transport->GetRtpReceiver(report->GetSsrc());
-
-						if (rtpReceiver != nullptr)
-						{
-							this->listener->OnPeerRtcpSenderReport(this, rtpReceiver, report);
-						}
-						else
-						{
-							MS_WARN_TAG(
-							    rtcp,
-							    "no RtpReceiver found for received Sender Report [ssrc:%" PRIu32 "]",
-							    report->GetSsrc());
-						}
-					}
-
-					break;
-				}
-
 				case RTCP::Type::SDES:
 				{
-					auto* sdes = dynamic_cast<RTCP::SdesPacket*>(packet);
-					auto it    = sdes->Begin();
-
-					for (; it != sdes->End(); ++it)
-					{
-						auto& chunk = (*it);
-						// Get the receiver associated to the SSRC indicated in the chunk.
-						auto* rtpReceiver = transport->GetRtpReceiver(chunk->GetSsrc());
-
-						if (rtpReceiver == nullptr)
-						{
-							MS_WARN_TAG(
-							    rtcp, "no RtpReceiver for received SDES chunk [ssrc:%" PRIu32 "]", chunk->GetSsrc());
-						}
-					}
+					MS_DEBUG_TAG(rtcp, "ignoring received RTCP SDES");
 
 					break;
 				}
@@ -1116,11 +1355,9 @@ namespace RTC
 					MS_WARN_TAG(
 					    rtcp,
 					    "unhandled RTCP type received [type:%" PRIu8 "]",
-					    static_cast<uint8_t>(packet->GetType()));
+					    static_cast<uint8_t>(packet.GetType()));
 				}
 			}
-
-			packet = packet->GetNext();
 		}
 	}
 
@@ -1161,41 +1398,40 @@ namespace RTC
 		this->listener->OnFullFrameRequired(this, rtpSender);
 	}
 
-	void Peer::OnTimer(Timer* /*timer*/)
+	void Peer::OnRtpSenderBitrateAllocationRequired(RTC::RtpSender* rtpSender)
 	{
-		uint64_t interval = RTC::RTCP::MaxVideoIntervalMs;
-		uint32_t now      = DepLibUV::GetTime();
+		MS_TRACE();
 
-		this->SendRtcp(now);
+		if (rtpSender->GetTransport() != nullptr)
+			AllocateBitrate(rtpSender->GetTransport());
+	}
 
-		// Recalculate next RTCP interval.
-		if (!this->rtpSenders.empty())
-		{
-			// Transmission rate in kbps.
-			uint32_t rate = 0;
+	inline void Peer::OnTimer(TimerWheel::Handle* /*handle*/)
+	{
+		MS_TRACE();
 
-			// Get the RTP sending rate.
-			for (auto& kv : this->rtpSenders)
-			{
-				auto* rtpSender = kv.second;
+		// Once per Transport, rather than once per RtpSender.
+		AllocateBitrate();
+	}
 
-				rate += rtpSender->GetTransmissionRate(now) / 1000;
-			}
+	bool Peer::OnDumpWriterStep(Channel::DumpWriter* dumpWriter, size_t step, Json::Value& data)
+	{
+		MS_TRACE();
 
-			// Calculate bandwidth: 360 / transmission bandwidth in kbit/s
-			if (rate != 0u)
-				interval = 360000 / rate;
+		auto& steps = this->dumpWriters.at(dumpWriter);
 
-			if (interval > RTC::RTCP::MaxVideoIntervalMs)
-				interval = RTC::RTCP::MaxVideoIntervalMs;
+		if (step < steps.size())
+		{
+			FillDumpStep(steps[step], data);
+
+			return false;
 		}
 
-		/*
-		 * The interval between RTCP packets is varied randomly over the range
-		 * [0.5,1.5] times the calculated interval to avoid unintended synchronization
-		 * of all participants.
-		 */
-		interval *= static_cast<float>(Utils::Crypto::GetRandomUInt(5, 15)) / 10;
-		this->timer->Start(interval);
+		// The rest of the Peer goes into the final response.
+		FillDumpStep({ DumpStep::Kind::PEER, this->peerId }, data);
+
+		this->dumpWriters.erase(dumpWriter);
+
+		return true;
 	}
 } // namespace RTC
@@ -8,6 +8,7 @@
 #include "RTC/RTCP/FeedbackRtpSrReq.hpp"
 #include "RTC/RTCP/FeedbackRtpTllei.hpp"
 #include "RTC/RTCP/FeedbackRtpTmmb.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
 // Feedback PS.
 #include "Logger.hpp"
 #include "Utils.hpp"
@@ -194,15 +195,16 @@ namespace RTC
 		template<>
 		std::map<FeedbackRtp::MessageType, std::string> FeedbackPacket<FeedbackRtp>::type2String =
 		{
-			{ FeedbackRtp::MessageType::NACK,   "NACK"   },
-			{ FeedbackRtp::MessageType::TMMBR,  "TMMBR"  },
-			{ FeedbackRtp::MessageType::TMMBN,  "TMMBN"  },
-			{ FeedbackRtp::MessageType::SR_REQ, "SR_REQ" },
-			{ FeedbackRtp::MessageType::RAMS,   "RAMS"   },
-			{ FeedbackRtp::MessageType::TLLEI,  "TLLEI"  },
-			{ FeedbackRtp::MessageType::ECN,    "ECN"    },
-			{ FeedbackRtp::MessageType::PS,     "PS"     },
-			{ FeedbackRtp::MessageType::EXT,    "EXT"    }
+			{ FeedbackRtp::MessageType::NACK,      "NACK"      },
+			{ FeedbackRtp::MessageType::TMMBR,     "TMMBR"     },
+			{ FeedbackRtp::MessageType::TMMBN,     "TMMBN"     },
+			{ FeedbackRtp::MessageType::SR_REQ,    "SR_REQ"    },
+			{ FeedbackRtp::MessageType::RAMS,      "RAMS"      },
+			{ FeedbackRtp::MessageType::TLLEI,     "TLLEI"     },
+			{ FeedbackRtp::MessageType::ECN,       "ECN"       },
+			{ FeedbackRtp::MessageType::PS,        "PS"        },
+			{ FeedbackRtp::MessageType::TRANSPORT, "TRANSPORT" },
+			{ FeedbackRtp::MessageType::EXT,       "EXT"       }
 		};
 		// clang-format on
 
@@ -255,6 +257,10 @@ namespace RTC
 				case FeedbackRtp::MessageType::PS:
 					break;
 
+				case FeedbackRtp::MessageType::TRANSPORT:
+					packet = FeedbackRtpTransportPacket::Parse(data, len);
+					break;
+
 				case FeedbackRtp::MessageType::EXT:
 					break;
 
@@ -0,0 +1,507 @@
+#define MS_CLASS "RTC::RTCP::FeedbackRtpTransportPacket"
+// #define MS_LOG_DEV
+
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <algorithm> // std::min()
+#include <cstring>
+
+namespace RTC
+{
+	namespace RTCP
+	{
+		/* Static. */
+
+		// Keep the packet within a safe MTU.
+		static constexpr size_t MaxSize{ 1200 };
+		static constexpr size_t MaxRunLength{ 0x1FFF };
+		static constexpr size_t OneBitVectorSymbols{ 14 };
+		static constexpr size_t TwoBitVectorSymbols{ 7 };
+
+		/**
+		 * Walks the packet chunks of a transport feedback, whose payload starts
+		 * at the base sequence number, and gives the status of each packet.
+		 * Returns the offset of the receive deltas, or 0 if the chunks are not
+		 * valid.
+		 */
+		template<typename F>
+		static size_t ReadPacketChunks(const uint8_t* data, size_t len, F addStatus)
+		{
+			using Status = FeedbackRtpTransportPacket::Status;
+
+			size_t packetStatusCount = Utils::Byte::Get2Bytes(data, 2);
+			size_t numStatuses{ 0 };
+			size_t offset{ 8 };
+
+			while (numStatuses < packetStatusCount)
+			{
+				if (offset + 2 > len)
+				{
+					MS_WARN_TAG(rtcp, "not enough space for packet chunk, discarded");
+
+					return 0;
+				}
+
+				uint16_t chunk   = Utils::Byte::Get2Bytes(data, offset);
+				size_t remaining = packetStatusCount - numStatuses;
+
+				offset += 2;
+
+				// Run length chunk.
+				if ((chunk & 0x8000) == 0)
+				{
+					auto status      = static_cast<Status>((chunk >> 13) & 0x03);
+					size_t runLength = std::min<size_t>(chunk & 0x1FFF, remaining);
+
+					if (status > Status::LARGE_DELTA)
+					{
+						MS_WARN_TAG(rtcp, "invalid packet status, discarded");
+
+						return 0;
+					}
+
+					for (size_t idx{ 0 }; idx < runLength; ++idx)
+					{
+						addStatus(status);
+					}
+
+					numStatuses += runLength;
+				}
+				// One bit status vector chunk.
+				else if ((chunk & 0x4000) == 0)
+				{
+					size_t count = std::min(OneBitVectorSymbols, remaining);
+
+					for (size_t idx{ 0 }; idx < count; ++idx)
+					{
+						addStatus(static_cast<Status>((chunk >> (13 - idx)) & 0x01));
+					}
+
+					numStatuses += count;
+				}
+				// Two bits status vector chunk.
+				else
+				{
+					size_t count = std::min(TwoBitVectorSymbols, remaining);
+
+					for (size_t idx{ 0 }; idx < count; ++idx)
+					{
+						auto status = static_cast<Status>((chunk >> (12 - 2 * idx)) & 0x03);
+
+						if (status > Status::LARGE_DELTA)
+						{
+							MS_WARN_TAG(rtcp, "invalid packet status, discarded");
+
+							return 0;
+						}
+
+						addStatus(status);
+					}
+
+					numStatuses += count;
+				}
+			}
+
+			return offset;
+		}
+
+		/**
+		 * Reads the receive delta of a received packet and moves the offset past
+		 * it. Returns false if there is not enough space.
+		 */
+		static bool ReadReceiveDelta(
+		    const uint8_t* data,
+		    size_t len,
+		    FeedbackRtpTransportPacket::Status status,
+		    size_t& offset,
+		    int16_t& delta)
+		{
+			size_t deltaSize = (status == FeedbackRtpTransportPacket::Status::SMALL_DELTA) ? 1 : 2;
+
+			if (offset + deltaSize > len)
+			{
+				MS_WARN_TAG(rtcp, "not enough space for receive delta, discarded");
+
+				return false;
+			}
+
+			if (deltaSize == 1)
+				delta = data[offset];
+			else
+				delta = static_cast<int16_t>(Utils::Byte::Get2Bytes(data, offset));
+
+			offset += deltaSize;
+
+			return true;
+		}
+
+		/* Class methods. */
+
+		FeedbackRtpTransportPacket* FeedbackRtpTransportPacket::Parse(const uint8_t* data, size_t len)
+		{
+			MS_TRACE();
+
+			if (sizeof(CommonHeader) + sizeof(FeedbackPacket::Header) + 8 > len)
+			{
+				MS_WARN_TAG(rtcp, "not enough space for Feedback packet, discarded");
+
+				return nullptr;
+			}
+
+			auto* commonHeader = const_cast<CommonHeader*>(reinterpret_cast<const CommonHeader*>(data));
+
+			std::unique_ptr<FeedbackRtpTransportPacket> packet(
+			    new FeedbackRtpTransportPacket(commonHeader));
+
+			if (!packet->IsCorrect())
+				return nullptr;
+
+			return packet.release();
+		}
+
+		/**
+		 * Appends the results of the packets reported by the given transport
+		 * feedback without parsing it into a packet. Nothing is appended and
+		 * false is returned if it is not valid.
+		 */
+		bool FeedbackRtpTransportPacket::ParsePacketResults(
+		    const uint8_t* data, size_t len, std::vector<PacketResult>& results)
+		{
+			MS_TRACE();
+
+			if (sizeof(CommonHeader) + sizeof(FeedbackPacket::Header) + 8 > len)
+			{
+				MS_WARN_TAG(rtcp, "not enough space for transport feedback, discarded");
+
+				return false;
+			}
+
+			data += sizeof(CommonHeader) + sizeof(FeedbackPacket::Header);
+			len -= sizeof(CommonHeader) + sizeof(FeedbackPacket::Header);
+
+			uint16_t seq = Utils::Byte::Get2Bytes(data, 0);
+			// Work in DeltaUnit to not accumulate rounding errors.
+			int64_t time = static_cast<int64_t>(Utils::Byte::Get3Bytes(data, 4)) * ReferenceTimeUnit *
+			               1000 / DeltaUnit;
+			size_t first = results.size();
+
+			// The status of received packets is kept in their arrival time until
+			// their receive deltas are read.
+			size_t offset = ReadPacketChunks(data, len, [&results, &seq](Status status) {
+				PacketResult result;
+
+				result.sequenceNumber = seq++;
+				result.received       = status != Status::NOT_RECEIVED;
+				result.receivedAt     = static_cast<int64_t>(status);
+
+				results.push_back(result);
+			});
+
+			if (offset == 0)
+			{
+				results.resize(first);
+
+				return false;
+			}
+
+			for (size_t idx{ first }; idx < results.size(); ++idx)
+			{
+				auto& result = results[idx];
+				int16_t delta;
+
+				if (!result.received)
+					continue;
+
+				if (!ReadReceiveDelta(data, len, static_cast<Status>(result.receivedAt), offset, delta))
+				{
+					results.resize(first);
+
+					return false;
+				}
+
+				time += delta;
+				result.receivedAt = time * DeltaUnit / 1000;
+			}
+
+			return true;
+		}
+
+		/* Instance methods. */
+
+		FeedbackRtpTransportPacket::FeedbackRtpTransportPacket(CommonHeader* commonHeader)
+		    : FeedbackRtpPacket(commonHeader)
+		{
+			MS_TRACE();
+
+			size_t len = static_cast<size_t>(ntohs(commonHeader->length) + 1) * 4;
+
+			if (len < sizeof(CommonHeader) + sizeof(FeedbackPacket::Header) + 8)
+			{
+				MS_WARN_TAG(rtcp, "not enough space for transport feedback, discarded");
+
+				this->isCorrect = false;
+				return;
+			}
+
+			auto* data = reinterpret_cast<uint8_t*>(commonHeader) + sizeof(CommonHeader) +
+			             sizeof(FeedbackPacket::Header);
+
+			len -= sizeof(CommonHeader) + sizeof(FeedbackPacket::Header);
+
+			this->baseSequenceNumber  = Utils::Byte::Get2Bytes(data, 0);
+			this->referenceTime       = Utils::Byte::Get3Bytes(data, 4);
+			this->feedbackPacketCount = data[7];
+
+			this->statuses.reserve(Utils::Byte::Get2Bytes(data, 2));
+
+			// Packet chunks.
+			size_t offset = ReadPacketChunks(
+			    data, len, [this](Status status) { this->statuses.push_back(status); });
+
+			if (offset == 0)
+			{
+				this->isCorrect = false;
+				return;
+			}
+
+			// Receive deltas.
+			for (auto status : this->statuses)
+			{
+				if (status == Status::NOT_RECEIVED)
+					continue;
+
+				size_t deltaOffset = offset;
+				int16_t delta;
+
+				if (!ReadReceiveDelta(data, len, status, offset, delta))
+				{
+					this->isCorrect = false;
+					return;
+				}
+
+				this->deltas.push_back(delta);
+				this->deltasSize += offset - deltaOffset;
+			}
+		}
+
+		/**
+		 * Appends the status of the next packet. The delta (in DeltaUnit) is
+		 * relative to the previous received packet, or to the reference time for
+		 * the first one. Returns false if the packet cannot be added and the
+		 * feedback must be sent.
+		 */
+		bool FeedbackRtpTransportPacket::AddPacket(bool received, int32_t delta)
+		{
+			MS_TRACE();
+
+			if (this->statuses.size() == 0xFFFF)
+				return false;
+
+			Status status{ Status::NOT_RECEIVED };
+			size_t deltaSize{ 0 };
+
+			if (received)
+			{
+				if (delta >= 0 && delta <= 0xFF)
+				{
+					status    = Status::SMALL_DELTA;
+					deltaSize = 1;
+				}
+				else if (delta >= INT16_MIN && delta <= INT16_MAX)
+				{
+					status    = Status::LARGE_DELTA;
+					deltaSize = 2;
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			// Worst case, every status takes 2 bits.
+			size_t chunksSize = ((this->statuses.size() + TwoBitVectorSymbols) / TwoBitVectorSymbols) * 2;
+
+			if (
+			    FeedbackRtpPacket::GetSize() + 8 + chunksSize + this->deltasSize + deltaSize + 3 > MaxSize)
+			{
+				return false;
+			}
+
+			this->statuses.push_back(status);
+
+			if (received)
+			{
+				this->deltas.push_back(static_cast<int16_t>(delta));
+				this->deltasSize += deltaSize;
+			}
+
+			return true;
+		}
+
+		void FeedbackRtpTransportPacket::GetPacketResults(std::vector<PacketResult>& results) const
+		{
+			MS_TRACE();
+
+			// Work in DeltaUnit to not accumulate rounding errors.
+			int64_t time = static_cast<int64_t>(this->referenceTime) * ReferenceTimeUnit * 1000 / DeltaUnit;
+			uint16_t seq = this->baseSequenceNumber;
+			auto deltaIt = this->deltas.begin();
+
+			results.reserve(results.size() + this->statuses.size());
+
+			for (auto status : this->statuses)
+			{
+				PacketResult result;
+
+				result.sequenceNumber = seq++;
+
+				if (status != Status::NOT_RECEIVED)
+				{
+					time += *deltaIt;
+					++deltaIt;
+
+					result.received   = true;
+					result.receivedAt = time * DeltaUnit / 1000;
+				}
+
+				results.push_back(result);
+			}
+		}
+
+		size_t FeedbackRtpTransportPacket::Serialize(uint8_t* buffer)
+		{
+			MS_TRACE();
+
+			size_t size   = GetSize();
+			size_t offset = FeedbackRtpPacket::Serialize(buffer);
+
+			Utils::Byte::Set2Bytes(buffer, offset, this->baseSequenceNumber);
+			Utils::Byte::Set2Bytes(buffer, offset + 2, static_cast<uint16_t>(this->statuses.size()));
+			Utils::Byte::Set3Bytes(buffer, offset + 4, this->referenceTime);
+			buffer[offset + 7] = this->feedbackPacketCount;
+			offset += 8;
+
+			offset += FillChunks(buffer + offset) * 2;
+
+			auto deltaIt = this->deltas.begin();
+
+			for (auto status : this->statuses)
+			{
+				switch (status)
+				{
+					case Status::NOT_RECEIVED:
+						break;
+
+					case Status::SMALL_DELTA:
+						buffer[offset] = static_cast<uint8_t>(*deltaIt);
+						++deltaIt;
+						offset += 1;
+						break;
+
+					case Status::LARGE_DELTA:
+						Utils::Byte::Set2Bytes(buffer, offset, static_cast<uint16_t>(*deltaIt));
+						++deltaIt;
+						offset += 2;
+						break;
+				}
+			}
+
+			// Zero padding.
+			std::memset(buffer + offset, 0, size - offset);
+
+			return size;
+		}
+
+		void FeedbackRtpTransportPacket::Dump() const
+		{
+			MS_TRACE();
+
+			MS_DUMP("<FeedbackRtpTransportPacket>");
+			FeedbackRtpPacket::Dump();
+			MS_DUMP("  base sequence number  : %" PRIu16, this->baseSequenceNumber);
+			MS_DUMP("  packet status count   : %zu", this->statuses.size());
+			MS_DUMP("  reference time        : %" PRIu32, this->referenceTime);
+			MS_DUMP("  feedback packet count : %" PRIu8, this->feedbackPacketCount);
+			MS_DUMP("  received packets      : %zu", this->deltas.size());
+			MS_DUMP("</FeedbackRtpTransportPacket>");
+		}
+
+		/**
+		 * Encodes the packet statuses into packet chunks. If buffer is null just
+		 * returns the number of chunks needed.
+		 */
+		size_t FeedbackRtpTransportPacket::FillChunks(uint8_t* buffer) const
+		{
+			MS_TRACE();
+
+			size_t numStatuses = this->statuses.size();
+			size_t numChunks{ 0 };
+			size_t idx{ 0 };
+
+			while (idx < numStatuses)
+			{
+				Status status = this->statuses[idx];
+				size_t runLength{ 1 };
+
+				while (idx + runLength < numStatuses && runLength < MaxRunLength &&
+				       this->statuses[idx + runLength] == status)
+				{
+					++runLength;
+				}
+
+				size_t oneBitCount = std::min(OneBitVectorSymbols, numStatuses - idx);
+				bool oneBitFits{ true };
+
+				for (size_t n{ 0 }; n < oneBitCount; ++n)
+				{
+					if (this->statuses[idx + n] == Status::LARGE_DELTA)
+					{
+						oneBitFits = false;
+
+						break;
+					}
+				}
+
+				uint16_t chunk;
+
+				if (runLength >= OneBitVectorSymbols || (runLength >= TwoBitVectorSymbols && !oneBitFits))
+				{
+					chunk = (static_cast<uint16_t>(status) << 13) | static_cast<uint16_t>(runLength);
+					idx += runLength;
+				}
+				else if (oneBitFits)
+				{
+					chunk = 0x8000;
+
+					for (size_t n{ 0 }; n < oneBitCount; ++n)
+					{
+						chunk |= static_cast<uint16_t>(this->statuses[idx + n]) << (13 - n);
+					}
+
+					idx += oneBitCount;
+				}
+				else
+				{
+					size_t twoBitCount = std::min(TwoBitVectorSymbols, numStatuses - idx);
+
+					chunk = 0xC000;
+
+					for (size_t n{ 0 }; n < twoBitCount; ++n)
+					{
+						chunk |= static_cast<uint16_t>(this->statuses[idx + n]) << (12 - 2 * n);
+					}
+
+					idx += twoBitCount;
+				}
+
+				if (buffer != nullptr)
+					Utils::Byte::Set2Bytes(buffer, numChunks * 2, chunk);
+
+				++numChunks;
+			}
+
+			return numChunks;
+		}
+	} // namespace RTCP
+} // namespace RTC
@@ -0,0 +1,166 @@
+#define MS_CLASS "RTC::RTCP::PacketView"
+// #define MS_LOG_DEV
+
+#include "RTC/RTCP/PacketView.hpp"
+#include "Logger.hpp"
+#include "RTC/RTCP/FeedbackPsRemb.hpp"
+
+namespace RTC
+{
+	namespace RTCP
+	{
+		/* Static. */
+
+		static constexpr size_t FeedbackHeaderSize{ sizeof(Packet::CommonHeader) +
+		                                            sizeof(FeedbackPsPacket::Header) };
+		// Unique identifier, number of SSRCs and bitrate.
+		static constexpr size_t RembHeaderSize{ FeedbackHeaderSize + 8 };
+
+		/* Instance methods. */
+
+		/**
+		 * Whether the packet is big enough for what its header announces.
+		 */
+		bool PacketView::IsValid() const
+		{
+			MS_TRACE();
+
+			switch (GetType())
+			{
+				case Type::SR:
+				{
+					return this->size >= sizeof(Packet::CommonHeader) + sizeof(SenderReport::Header) +
+					                         (GetCount() * sizeof(ReceiverReport::Header));
+				}
+
+				case Type::RR:
+				{
+					return this->size >= sizeof(Packet::CommonHeader) + sizeof(uint32_t) +
+					                         (GetCount() * sizeof(ReceiverReport::Header));
+				}
+
+				case Type::BYE:
+				{
+					return this->size >= sizeof(Packet::CommonHeader) + (GetCount() * sizeof(uint32_t));
+				}
+
+				case Type::SDES:
+				case Type::APP:
+				{
+					return true;
+				}
+
+				case Type::RTPFB:
+				case Type::PSFB:
+				{
+					return this->size >= FeedbackHeaderSize;
+				}
+
+				default:
+				{
+					return false;
+				}
+			}
+		}
+
+		bool PacketView::IsRemb() const
+		{
+			MS_TRACE();
+
+			if (GetType() != Type::PSFB || GetPsFeedbackType() != FeedbackPs::MessageType::AFB)
+				return false;
+
+			if (this->size < RembHeaderSize)
+				return false;
+
+			auto identifier = Utils::Byte::Get4Bytes(this->data, FeedbackHeaderSize);
+
+			if (identifier != FeedbackPsRembPacket::uniqueIdentifier)
+				return false;
+
+			if (this->size != RembHeaderSize + (GetRembSsrcCount() * sizeof(uint32_t)))
+			{
+				MS_WARN_TAG(
+				    rtcp,
+				    "invalid payload size (%zu bytes) for the given number of ssrcs (%zu)",
+				    this->size,
+				    GetRembSsrcCount());
+
+				return false;
+			}
+
+			uint8_t exponent = this->data[FeedbackHeaderSize + 5] >> 2;
+
+			// The 18 bits mantissa must not overflow.
+			if (exponent > 64 - 18)
+			{
+				MS_WARN_TAG(rtcp, "invalid REMB bitrate exponent: %" PRIu8, exponent);
+
+				return false;
+			}
+
+			return true;
+		}
+
+		uint64_t PacketView::GetRembBitrate() const
+		{
+			MS_TRACE();
+
+			uint8_t exponent = this->data[FeedbackHeaderSize + 5] >> 2;
+			uint64_t mantissa =
+			    (static_cast<uint32_t>(this->data[FeedbackHeaderSize + 5] & 0x03) << 16) |
+			    Utils::Byte::Get2Bytes(this->data, FeedbackHeaderSize + 6);
+
+			return mantissa << exponent;
+		}
+
+		void CompoundPacketView::Iterator::Load()
+		{
+			MS_TRACE();
+
+			if (this->len == 0)
+			{
+				this->data = nullptr;
+
+				return;
+			}
+
+			if (!Packet::IsRtcp(this->data, this->len))
+			{
+				MS_WARN_TAG(rtcp, "data is not a RTCP packet");
+
+				this->data = nullptr;
+				this->len  = 0;
+
+				return;
+			}
+
+			auto* header     = reinterpret_cast<const Packet::CommonHeader*>(this->data);
+			size_t packetLen = static_cast<size_t>(ntohs(header->length) + 1) * 4;
+
+			if (this->len < packetLen)
+			{
+				MS_WARN_TAG(
+				    rtcp,
+				    "packet length exceeds remaining data [len:%zu, packet len:%zu]",
+				    this->len,
+				    packetLen);
+
+				this->data = nullptr;
+				this->len  = 0;
+
+				return;
+			}
+
+			this->packet = PacketView(this->data, packetLen);
+
+			if (!this->packet.IsValid())
+			{
+				MS_WARN_TAG(rtcp, "invalid RTCP packet [packetType:%" PRIu8 "]", header->packetType);
+
+				this->data = nullptr;
+				this->len  = 0;
+			}
+		}
+	} // namespace RTCP
+} // namespace RTC
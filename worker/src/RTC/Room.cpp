@@ -2,25 +2,51 @@
 // #define MS_LOG_DEV
 
 #include "RTC/Room.hpp"
+#include "DepLibUV.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include "Settings.hpp"
 #include "MediaSoupError.hpp"
 #include "Utils.hpp"
-#include "RTC/VP9Filter.hpp"
-#include <cmath> // std::lround()
+#include "RTC/Codecs/Tools.hpp"
+#include <algorithm> // std::find()
 #include <set>
 #include <string>
 #include <vector>
-#include <iostream>
 
 
 namespace RTC
 {
 	/* Static. */
 
-	static constexpr uint64_t AudioLevelsInterval{ 1000 }; // In ms.
-    
-    static constexpr uint8_t ActiveSpeakerVoiceDiff{ 15 }; // In ms.
+	// Interval of the dominant speaker identification.
+	static constexpr uint64_t AudioLevelsInterval{ 300 }; // In ms.
+	// Time an audio stream out of the last-N is forwarded once it starts talking
+	// (the speaker detection needs a medium block to decide) and minimum
+	// interval between those.
+	static constexpr uint64_t LastNAudioCandidateWindow{ 200 };    // In ms.
+	static constexpr uint64_t LastNAudioCandidateInterval{ 1000 }; // In ms.
+	// Minimum interval between key frame requests of an active speaker stream.
+	static constexpr uint64_t KeyFrameRequestInterval{ 1000 }; // In ms.
+
+	// Video RtpReceiver of the Peer with the given codec.
+	static const RTC::RtpReceiver* GetVideoRtpReceiver(const RTC::Peer* peer, uint8_t payloadType)
+	{
+		for (auto* rtpReceiver : peer->GetRtpReceivers())
+		{
+			auto* rtpParameters = rtpReceiver->GetParameters();
+
+			if (
+			    rtpReceiver->kind == RTC::Media::Kind::VIDEO && rtpParameters != nullptr &&
+			    !rtpParameters->encodings.empty() &&
+			    rtpParameters->encodings[0].codecPayloadType == payloadType)
+			{
+				return rtpReceiver;
+			}
+		}
+
+		return nullptr;
+	}
 
 	/* Class variables. */
 
@@ -36,7 +62,7 @@ namespace RTC
 		{
 			// NOTE: These lines are auto-generated from data/supportedCapabilities.js.
 			const std::string supportedRtpCapabilities =
-			    R"({"codecs":[{"kind":"audio","name":"audio/opus","clockRate":48000,"numChannels":2,"rtcpFeedback":[]},{"kind":"audio","name":"audio/PCMU","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/PCMA","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/ISAC","clockRate":32000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/ISAC","clockRate":16000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/G722","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/iLBC","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/SILK","clockRate":24000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/SILK","clockRate":16000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/SILK","clockRate":12000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/SILK","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/CN","clockRate":32000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/CN","clockRate":16000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/CN","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/CN","clockRate":32000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/telephone-event","clockRate":48000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/telephone-event","clockRate":32000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/telephone-event","clockRate":16000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/telephone-event","clockRate":8000,"rtcpFeedback":[]},{"kind":"video","name":"video/VP8","clockRate":90000,"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"}]},{"kind":"video","name":"video/VP9","clockRate":90000,"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"}]},{"kind":"video","name":"video/H264","clockRate":90000,"parameters":{"packetizationMode":0},"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"}]},{"kind":"video","name":"video/H264","clockRate":90000,"parameters":{"packetizationMode":1},"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"}]},{"kind":"video","name":"video/H265","clockRate":90000,"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"}]}],"headerExtensions":[{"kind":"audio","uri":"urn:ietf:params:rtp-hdrext:ssrc-audio-level","preferredId":1,"preferredEncrypt":false},{"kind":"video","uri":"urn:ietf:params:rtp-hdrext:toffset","preferredId":2,"preferredEncrypt":false},{"kind":"","uri":"http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time","preferredId":3,"preferredEncrypt":false},{"kind":"video","uri":"urn:3gpp:video-orientation","preferredId":4,"preferredEncrypt":false},{"kind":"","uri":"urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id","preferredId":5,"preferredEncrypt":false}],"fecMechanisms":[]})";
+			    R"({"codecs":[{"kind":"audio","name":"audio/opus","clockRate":48000,"numChannels":2,"rtcpFeedback":[]},{"kind":"audio","name":"audio/PCMU","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/PCMA","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/ISAC","clockRate":32000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/ISAC","clockRate":16000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/G722","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/iLBC","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/SILK","clockRate":24000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/SILK","clockRate":16000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/SILK","clockRate":12000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/SILK","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/CN","clockRate":32000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/CN","clockRate":16000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/CN","clockRate":8000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/CN","clockRate":32000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/telephone-event","clockRate":48000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/telephone-event","clockRate":32000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/telephone-event","clockRate":16000,"rtcpFeedback":[]},{"kind":"audio","name":"audio/telephone-event","clockRate":8000,"rtcpFeedback":[]},{"kind":"video","name":"video/VP8","clockRate":90000,"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"},{"type":"transport-cc"}]},{"kind":"video","name":"video/VP9","clockRate":90000,"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"},{"type":"transport-cc"}]},{"kind":"video","name":"video/H264","clockRate":90000,"parameters":{"packetizationMode":0},"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"},{"type":"transport-cc"}]},{"kind":"video","name":"video/H264","clockRate":90000,"parameters":{"packetizationMode":1},"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"},{"type":"transport-cc"}]},{"kind":"video","name":"video/H265","clockRate":90000,"rtcpFeedback":[{"type":"nack"},{"type":"nack","parameter":"pli"},{"type":"nack","parameter":"sli"},{"type":"nack","parameter":"rpsi"},{"type":"nack","parameter":"app"},{"type":"ccm","parameter":"fir"},{"type":"ack","parameter":"rpsi"},{"type":"ack","parameter":"app"},{"type":"goog-remb"},{"type":"transport-cc"}]}],"headerExtensions":[{"kind":"audio","uri":"urn:ietf:params:rtp-hdrext:ssrc-audio-level","preferredId":1,"preferredEncrypt":false},{"kind":"video","uri":"urn:ietf:params:rtp-hdrext:toffset","preferredId":2,"preferredEncrypt":false},{"kind":"","uri":"http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time","preferredId":3,"preferredEncrypt":false},{"kind":"video","uri":"urn:3gpp:video-orientation","preferredId":4,"preferredEncrypt":false},{"kind":"","uri":"urn:ietf:params:rtp-hdrext:sdes:rtp-stream-id","preferredId":5,"preferredEncrypt":false},{"kind":"","uri":"http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01","preferredId":6,"preferredEncrypt":false}],"fecMechanisms":[]})";
 
 			Json::CharReaderBuilder builder;
 			Json::Value settings = Json::nullValue;
@@ -121,20 +147,19 @@ namespace RTC
 
 		// Set the audio levels timer.
 		this->audioLevelsTimer = new Timer(this);
-        
-        // create selector if needed
-        if (Settings::configuration.vp9MinTemporial < 2 || Settings::configuration.vp9MinSpartial < 1)
-            needToFilterLayers = true;
-        
-        // audio levels filtration
-        needToFilterAudioLevels = Settings::configuration.needToFilterAudioLevels;
+
+		// Forward just the video of the dominant speaker if so configured.
+		if (Settings::configuration.needToFilterAudioLevels)
+		{
+			this->lastNVideo = 1;
+
+			UpdateSpeakerDetection(false);
+		}
 	}
 
 	Room::~Room()
 	{
 		MS_TRACE();
-        for (auto ls : mapRtpReceiverLayerSelector)
-            delete ls.second;
 	}
 
 	void Room::Destroy()
@@ -145,6 +170,15 @@ namespace RTC
 
 		Json::Value eventData(Json::objectValue);
 
+		// Abort the ongoing dumps.
+		for (auto it = this->dumpWriters.begin(); it != this->dumpWriters.end();)
+		{
+			auto* dumpWriter = it->first;
+
+			it = this->dumpWriters.erase(it);
+			dumpWriter->Destroy();
+		}
+
 		// Close all the Peers.
 		// NOTE: Upon Peer closure the onPeerClosed() method is called which
 		// removes it from the map, so this is the safe way to iterate the map
@@ -170,7 +204,7 @@ namespace RTC
 		delete this;
 	}
 
-	Json::Value Room::ToJson() const
+	Json::Value Room::ToJson(bool withPeers) const
 	{
 		MS_TRACE();
 
@@ -180,6 +214,8 @@ namespace RTC
 		static const Json::StaticString JsonStringMapRtpReceiverRtpSenders{ "mapRtpReceiverRtpSenders" };
 		static const Json::StaticString JsonStringMapRtpSenderRtpReceiver{ "mapRtpSenderRtpReceiver" };
 		static const Json::StaticString JsonStringAudioLevelsEventEnabled{ "audioLevelsEventEnabled" };
+		static const Json::StaticString JsonStringLastNAudio{ "lastNAudio" };
+		static const Json::StaticString JsonStringLastNVideo{ "lastNVideo" };
 
 		Json::Value json(Json::objectValue);
 		Json::Value jsonPeers(Json::arrayValue);
@@ -193,11 +229,14 @@ namespace RTC
 		json[JsonStringCapabilities] = this->capabilities.ToJson();
 
 		// Add `peers`.
-		for (auto& kv : this->peers)
+		if (withPeers)
 		{
-			auto* peer = kv.second;
+			for (auto& kv : this->peers)
+			{
+				auto* peer = kv.second;
 
-			jsonPeers.append(peer->ToJson());
+				jsonPeers.append(peer->ToJson());
+			}
 		}
 		json[JsonStringPeers] = jsonPeers;
 
@@ -223,6 +262,14 @@ namespace RTC
 			auto rtpSender   = kv.first;
 			auto rtpReceiver = kv.second;
 
+			// Active speaker streams may have no source.
+			if (rtpReceiver == nullptr)
+			{
+				jsonMapRtpSenderRtpReceiver[std::to_string(rtpSender->rtpSenderId)] = Json::nullValue;
+
+				continue;
+			}
+
 			jsonMapRtpSenderRtpReceiver[std::to_string(rtpSender->rtpSenderId)] =
 			    std::to_string(rtpReceiver->rtpReceiverId);
 		}
@@ -230,6 +277,10 @@ namespace RTC
 
 		json[JsonStringAudioLevelsEventEnabled] = this->audioLevelsEventEnabled;
 
+		json[JsonStringLastNAudio] = Json::UInt{ static_cast<uint32_t>(this->lastNAudio) };
+
+		json[JsonStringLastNVideo] = Json::UInt{ static_cast<uint32_t>(this->lastNVideo) };
+
 		return json;
 	}
 
@@ -256,9 +307,44 @@ namespace RTC
 
 			case Channel::Request::MethodId::ROOM_DUMP:
 			{
-				auto json = ToJson();
+				// Dump each Peer and then each of its entities in a loop iteration.
+				std::vector<std::pair<uint32_t, RTC::Peer::DumpStep>> steps;
+
+				for (auto& kv : this->peers)
+				{
+					auto peerId = kv.first;
+					auto* peer  = kv.second;
+
+					steps.emplace_back(
+					    peerId, RTC::Peer::DumpStep{ RTC::Peer::DumpStep::Kind::PEER, peerId });
+
+					for (auto& peerStep : peer->GetDumpSteps())
+					{
+						steps.emplace_back(peerId, peerStep);
+					}
+				}
+
+				auto* dumpWriter = new Channel::DumpWriter(this, request);
+
+				this->dumpWriters[dumpWriter] = std::move(steps);
+
+				break;
+			}
+
+			case Channel::Request::MethodId::ROOM_GET_STATS:
+			{
+				uint64_t now = DepLibUV::GetTime();
+				RTC::StatsSnapshot snapshot(now);
+				Json::Value data(Json::objectValue);
+
+				for (auto& kv : this->peers)
+				{
+					auto* peer = kv.second;
+
+					peer->FillStats(snapshot, now);
+				}
 
-				request->Accept(json);
+				request->Accept(data, snapshot.GetData(), snapshot.GetSize());
 
 				break;
 			}
@@ -312,6 +398,10 @@ namespace RTC
 				// Store the new Peer.
 				this->peers[peerId] = peer;
 
+				// Forward its video if there is room for it.
+				if (this->lastNVideo != 0)
+					FillLastNVideo();
+
 				MS_DEBUG_DEV("Peer created [peerId:%u, peerName:'%s']", peerId, peerName.c_str());
 
 				request->Accept();
@@ -335,23 +425,160 @@ namespace RTC
 				if (audioLevelsEventEnabled == this->audioLevelsEventEnabled)
 					return;
 
-				// Clear map of audio levels.
-				this->mapRtpReceiverAudioLevels.clear();
-                this->mapRtpReceiverAudioLevelSelector.clear();
+				bool wasEnabled = IsSpeakerDetectionEnabled();
+
+				this->audioLevelsEventEnabled = audioLevelsEventEnabled;
+
+				UpdateSpeakerDetection(wasEnabled);
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::ROOM_SET_LAST_N:
+			{
+				static const Json::StaticString JsonStringAudio{ "audio" };
+				static const Json::StaticString JsonStringVideo{ "video" };
+
+				auto& jsonAudio = request->data[JsonStringAudio];
+				auto& jsonVideo = request->data[JsonStringVideo];
+
+				// Both are optional.
+				if (!jsonAudio.isNull() && !jsonAudio.isUInt())
+				{
+					request->Reject("Request has invalid data.audio");
+
+					return;
+				}
+
+				if (!jsonVideo.isNull() && !jsonVideo.isUInt())
+				{
+					request->Reject("Request has invalid data.video");
+
+					return;
+				}
+
+				bool wasEnabled = IsSpeakerDetectionEnabled();
+
+				if (jsonVideo.isUInt())
+				{
+					this->lastNVideo = jsonVideo.asUInt();
+
+					if (this->lastNVideo == 0)
+						this->lastNVideoPeers.clear();
+
+					while (this->lastNVideoPeers.size() > this->lastNVideo && PauseLeastActiveVideo())
+					{
+						;
+					}
+
+					FillLastNVideo();
+
+					for (auto& kv : this->peers)
+					{
+						auto* peer = kv.second;
+
+						SetPeerVideoPaused(
+						    peer,
+						    this->lastNVideo != 0 &&
+						        this->lastNVideoPeers.find(peer) == this->lastNVideoPeers.end());
+					}
+
+					AllocateBitrate();
+				}
+
+				size_t lastNAudio = jsonAudio.isUInt() ? jsonAudio.asUInt() : this->lastNAudio;
+
+				this->lastNAudio = lastNAudio;
+
+				// Resume all the audio streams if disabled, otherwise pause the least
+				// recently active ones if too many.
+				if (lastNAudio == 0)
+				{
+					for (auto& kv : this->mapRtpReceiverRtpSenders)
+					{
+						auto* rtpReceiver = kv.first;
+
+						if (
+						    rtpReceiver->kind == RTC::Media::Kind::AUDIO &&
+						    this->lastNAudioRtpReceivers.find(rtpReceiver) ==
+						        this->lastNAudioRtpReceivers.end())
+						{
+							ResumeRtpSenders(rtpReceiver);
+						}
+					}
 
-				// Start or stop audio levels periodic timer.
-				if (audioLevelsEventEnabled)
-					this->audioLevelsTimer->Start(AudioLevelsInterval, AudioLevelsInterval);
+					this->lastNAudioRtpReceivers.clear();
+					this->lastNAudioCandidates.clear();
+				}
 				else
-					this->audioLevelsTimer->Stop();
+				{
+					while (this->lastNAudioRtpReceivers.size() > lastNAudio && PauseLeastActiveAudio())
+					{
+						;
+					}
+				}
 
-				this->audioLevelsEventEnabled = audioLevelsEventEnabled;
+				UpdateSpeakerDetection(wasEnabled);
 
 				request->Accept();
 
 				break;
 			}
 
+			case Channel::Request::MethodId::PEER_CREATE_ACTIVE_SPEAKER_RTP_SENDER:
+			{
+				static const Json::StaticString JsonStringRtpSenderId{ "rtpSenderId" };
+
+				RTC::Peer* peer;
+				RTC::RtpSender* rtpSender;
+
+				try
+				{
+					peer = GetPeerFromRequest(request);
+				}
+				catch (const MediaSoupError& error)
+				{
+					request->Reject(error.what());
+
+					return;
+				}
+
+				if (peer == nullptr)
+				{
+					request->Reject("Peer does not exist");
+
+					return;
+				}
+
+				if (!peer->HasCapabilities())
+				{
+					request->Reject("Peer has no capabilities");
+
+					return;
+				}
+
+				try
+				{
+					rtpSender = CreateActiveSpeakerRtpSender(peer);
+				}
+				catch (const MediaSoupError& error)
+				{
+					request->Reject(error.what());
+
+					return;
+				}
+
+				Json::Value data(Json::objectValue);
+
+				data[JsonStringRtpSenderId] = Json::UInt{ rtpSender->rtpSenderId };
+
+				request->Accept(data);
+
+				break;
+			}
+
 			case Channel::Request::MethodId::PEER_CLOSE:
 			case Channel::Request::MethodId::PEER_DUMP:
 			case Channel::Request::MethodId::PEER_SET_CAPABILITIES:
@@ -359,18 +586,24 @@ namespace RTC
 			case Channel::Request::MethodId::PEER_CREATE_RTP_RECEIVER:
 			case Channel::Request::MethodId::TRANSPORT_CLOSE:
 			case Channel::Request::MethodId::TRANSPORT_DUMP:
+			case Channel::Request::MethodId::TRANSPORT_GET_STATS:
 			case Channel::Request::MethodId::TRANSPORT_SET_REMOTE_DTLS_PARAMETERS:
 			case Channel::Request::MethodId::TRANSPORT_SET_MAX_BITRATE:
 			case Channel::Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD:
+			case Channel::Request::MethodId::TRANSPORT_SET_REMOTE_PARAMETERS:
 			case Channel::Request::MethodId::RTP_RECEIVER_CLOSE:
 			case Channel::Request::MethodId::RTP_RECEIVER_DUMP:
 			case Channel::Request::MethodId::RTP_RECEIVER_RECEIVE:
 			case Channel::Request::MethodId::RTP_RECEIVER_SET_TRANSPORT:
 			case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_RAW_EVENT:
 			case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_OBJECT_EVENT:
+			case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_TAP:
 			case Channel::Request::MethodId::RTP_SENDER_DUMP:
 			case Channel::Request::MethodId::RTP_SENDER_SET_TRANSPORT:
 			case Channel::Request::MethodId::RTP_SENDER_DISABLE:
+			case Channel::Request::MethodId::RTP_SENDER_SET_PREFERRED_LAYERS:
+			case Channel::Request::MethodId::RTP_SENDER_SET_PINNED:
+			case Channel::Request::MethodId::RTP_SENDER_SET_MAX_RESOLUTION:
 			{
 				RTC::Peer* peer;
 
@@ -509,7 +742,8 @@ namespace RTC
 		this->capabilities.fecMechanisms = Room::supportedRtpCapabilities.fecMechanisms;
 	}
 
-	inline void Room::AddRtpSenderForRtpReceiver(RTC::Peer* senderPeer, const RTC::RtpReceiver* rtpReceiver)
+	inline void Room::AddRtpSenderForRtpReceiver(
+	    RTC::Peer* senderPeer, const RTC::Peer* receiverPeer, const RTC::RtpReceiver* rtpReceiver)
 	{
 		MS_TRACE();
 
@@ -523,180 +757,856 @@ namespace RTC
 		this->mapRtpReceiverRtpSenders[rtpReceiver].insert(rtpSender);
 		this->mapRtpSenderRtpReceiver[rtpSender] = rtpReceiver;
 
+		rtpSender->SetSpatialLayerResolutions(&rtpReceiver->GetSpatialLayerResolutions());
+
+		// Last-N video.
+		if (
+		    rtpReceiver->kind == RTC::Media::Kind::VIDEO && this->lastNVideo != 0 &&
+		    this->lastNVideoPeers.find(receiverPeer) == this->lastNVideoPeers.end())
+		{
+			rtpSender->SetPaused(true);
+		}
+
 		auto rtpParameters           = rtpReceiver->GetParameters();
 		auto associatedRtpReceiverId = rtpReceiver->rtpReceiverId;
 
 		// Attach the RtpSender to the peer.
 		senderPeer->AddRtpSender(rtpSender, rtpParameters, associatedRtpReceiverId);
 	}
-    
-    std::string Room::peerByReceiver(const RTC::RtpReceiver* rtpReceiver) const
-    {
-        MS_TRACE();
-        
-        for(const auto &peer : peers)
-            for (const auto & r : peer.second->GetRtpReceivers())
-                if (r == rtpReceiver)
-                    return peer.second->peerName;
-        return std::string();
-    }
 
-	void Room::OnPeerClosed(const RTC::Peer* peer)
+	const RTC::Peer* Room::GetPeerFromRtpReceiver(const RTC::RtpReceiver* rtpReceiver) const
 	{
 		MS_TRACE();
 
-		this->peers.erase(peer->peerId);
+		for (auto& kv : this->peers)
+		{
+			auto* peer        = kv.second;
+			auto rtpReceivers = peer->GetRtpReceivers();
+
+			if (std::find(rtpReceivers.begin(), rtpReceivers.end(), rtpReceiver) != rtpReceivers.end())
+				return peer;
+		}
+
+		return nullptr;
 	}
 
-	void Room::OnPeerCapabilities(RTC::Peer* peer, RTC::RtpCapabilities* capabilities)
+	/**
+	 * Starts or stops the dominant speaker identification if needed.
+	 */
+	void Room::UpdateSpeakerDetection(bool wasEnabled)
 	{
 		MS_TRACE();
 
-		// Remove those peer's capabilities not supported by the room.
+		bool enabled = IsSpeakerDetectionEnabled();
 
-		// Remove unsupported codecs and set the same PT.
-		for (auto it = capabilities->codecs.begin(); it != capabilities->codecs.end();)
+		if (enabled == wasEnabled)
+			return;
+
+		// Clear the audio levels.
+		this->activeSpeakerDetector.Clear();
+		this->dominantSpeaker     = nullptr;
+		this->dominantSpeakerPeer = nullptr;
+
+		// Start or stop audio levels periodic timer.
+		if (enabled)
+			this->audioLevelsTimer->Start(AudioLevelsInterval, AudioLevelsInterval);
+		else
+			this->audioLevelsTimer->Stop();
+	}
+
+	/**
+	 * Applies a dominant speaker change and emits it.
+	 */
+	void Room::UpdateDominantSpeaker()
+	{
+		MS_TRACE();
+
+		this->dominantSpeaker     = nullptr;
+		this->dominantSpeakerPeer = nullptr;
+
+		if (this->activeSpeakerDetector.HasDominantSpeaker())
 		{
-			auto& peerCodecCapability = *it;
-			auto it2                  = this->capabilities.codecs.begin();
+			uint32_t rtpReceiverId = this->activeSpeakerDetector.GetDominantSpeaker();
 
-			for (; it2 != this->capabilities.codecs.end(); ++it2)
+			for (auto& kv : this->mapRtpReceiverRtpSenders)
 			{
-				auto& roomCodecCapability = *it2;
+				auto* rtpReceiver = kv.first;
 
-				if (roomCodecCapability.Matches(peerCodecCapability))
+				if (rtpReceiver->rtpReceiverId == rtpReceiverId)
 				{
-					// Set the same payload type.
-					peerCodecCapability.payloadType    = roomCodecCapability.payloadType;
-					peerCodecCapability.hasPayloadType = true;
-
-					// Remove the unsupported RTCP feedback from the given codec.
-					peerCodecCapability.ReduceRtcpFeedback(roomCodecCapability.rtcpFeedback);
+					this->dominantSpeaker     = rtpReceiver;
+					this->dominantSpeakerPeer = GetPeerFromRtpReceiver(rtpReceiver);
 
 					break;
 				}
 			}
-
-			if (it2 != this->capabilities.codecs.end())
-				++it;
-			else
-				it = capabilities->codecs.erase(it);
 		}
 
-		// Remove unsupported header extensions.
-		capabilities->ReduceHeaderExtensions(this->capabilities.headerExtensions);
+		MS_DEBUG_TAG(
+		    rtp,
+		    "dominant speaker changed [peerName:'%s']",
+		    this->dominantSpeakerPeer != nullptr ? this->dominantSpeakerPeer->peerName.c_str() : "");
 
-		// Remove unsupported FEC mechanisms.
-		capabilities->ReduceFecMechanisms(this->capabilities.fecMechanisms);
+		// The dominant speaker is always heard and seen.
+		if (this->lastNAudio != 0 && this->dominantSpeaker != nullptr)
+			UpdateLastNAudio(this->dominantSpeaker, DepLibUV::GetTime());
 
-		// Get all the ready RtpReceivers of the others Peers in the Room and
-		// create RtpSenders for this new Peer.
-		for (auto& kv : this->peers)
+		if (this->lastNVideo != 0 && this->dominantSpeakerPeer != nullptr)
+			UpdateLastNVideo(this->dominantSpeakerPeer, DepLibUV::GetTime());
+
+		UpdateActiveSpeakerRtpSenders();
+		UpdateActiveSpeakerStreams();
+
+		if (!this->audioLevelsEventEnabled)
+			return;
+
+		std::vector<Channel::Notifier::AudioLevel> entries;
+
+		if (this->dominantSpeaker != nullptr)
 		{
-			auto* receiverPeer = kv.second;
+			Channel::Notifier::AudioLevel entry;
 
-			for (auto rtpReceiver : receiverPeer->GetRtpReceivers())
-			{
-				// Skip if the RtpReceiver has not parameters.
-				if (rtpReceiver->GetParameters() == nullptr)
-					continue;
+			entry.rtpReceiverId = this->dominantSpeaker->rtpReceiverId;
+			entry.level         = this->activeSpeakerDetector.GetLevel(entry.rtpReceiverId);
 
-				AddRtpSenderForRtpReceiver(peer, rtpReceiver);
-			}
+			entries.push_back(entry);
 		}
+
+		this->notifier->EmitAudioLevels(this->roomId, entries);
 	}
 
-	void Room::OnPeerRtpReceiverParameters(const RTC::Peer* peer, RTC::RtpReceiver* rtpReceiver)
+	/**
+	 * Sets the audio of the RtpReceiver as the most recently active one. If not
+	 * forwarded yet, it replaces the least recently active one.
+	 */
+	void Room::UpdateLastNAudio(const RTC::RtpReceiver* rtpReceiver, uint64_t now)
 	{
 		MS_TRACE();
 
-		MS_ASSERT(rtpReceiver->GetParameters(), "rtpReceiver->GetParameters() returns no RtpParameters");
+		auto it = this->lastNAudioRtpReceivers.find(rtpReceiver);
 
-		// If this is a new RtpReceiver, iterate all the peers but this one and
-		// create a RtpSender associated to this RtpReceiver for each Peer.
-		if (this->mapRtpReceiverRtpSenders.find(rtpReceiver) == this->mapRtpReceiverRtpSenders.end())
+		if (it != this->lastNAudioRtpReceivers.end())
 		{
-			// Ensure the entry will exist even with an empty array.
-			this->mapRtpReceiverRtpSenders[rtpReceiver];
+			it->second = now;
 
-			for (auto& kv : this->peers)
-			{
-				auto* senderPeer = kv.second;
+			return;
+		}
 
-				// Skip receiver Peer.
-				if (senderPeer == peer)
-					continue;
+		if (this->lastNAudioRtpReceivers.size() >= this->lastNAudio && !PauseLeastActiveAudio())
+			return;
 
-				// Skip Peer with capabilities not set yet.
-				if (!senderPeer->HasCapabilities())
-					continue;
+		this->lastNAudioRtpReceivers[rtpReceiver] = now;
 
-				AddRtpSenderForRtpReceiver(senderPeer, rtpReceiver);
-			}
-		}
-		// If this is not a new RtpReceiver let's retrieve its updated parameters
-		// and update with them all the associated RtpSenders.
-		else
+		// No need to resume it if it is already forwarded as a candidate.
+		auto candidateIt = this->lastNAudioCandidates.find(rtpReceiver);
+
+		if (
+		    candidateIt == this->lastNAudioCandidates.end() ||
+		    now - candidateIt->second > LastNAudioCandidateWindow)
 		{
-			for (auto rtpSender : this->mapRtpReceiverRtpSenders[rtpReceiver])
-			{
-				// Provide the RtpSender with the parameters of the RtpReceiver.
-				rtpSender->Send(rtpReceiver->GetParameters());
-			}
+			ResumeRtpSenders(rtpReceiver);
 		}
+
+		if (candidateIt != this->lastNAudioCandidates.end())
+			this->lastNAudioCandidates.erase(candidateIt);
+
+		MS_DEBUG_TAG(rtp, "audio resumed [rtpReceiverId:%" PRIu32 "]", rtpReceiver->rtpReceiverId);
 	}
 
-	void Room::OnPeerRtpReceiverClosed(const RTC::Peer* /*peer*/, const RTC::RtpReceiver* rtpReceiver)
+	/**
+	 * Stops forwarding the audio of the least recently active speaker (never the
+	 * dominant one). Returns false if there is none.
+	 */
+	bool Room::PauseLeastActiveAudio()
 	{
 		MS_TRACE();
 
-		// If the RtpReceiver is in the map, iterate the map and close all the
-		// RtpSenders associated to the closed RtpReceiver.
-		if (this->mapRtpReceiverRtpSenders.find(rtpReceiver) != this->mapRtpReceiverRtpSenders.end())
-		{
-			// Make a copy of the set of RtpSenders given that Destroy() will be called
-			// in all of them, producing onPeerRtpSenderClosed() that will remove it
-			// from the map.
-			auto rtpSenders = this->mapRtpReceiverRtpSenders[rtpReceiver];
+		auto leastActiveIt = this->lastNAudioRtpReceivers.end();
 
-			// Safely iterate the copy of the set.
-			for (auto& rtpSender : rtpSenders)
-			{
-				rtpSender->Destroy();
-			}
+		for (auto it = this->lastNAudioRtpReceivers.begin(); it != this->lastNAudioRtpReceivers.end();
+		     ++it)
+		{
+			if (it->first == this->dominantSpeaker)
+				continue;
 
-			// Finally delete the RtpReceiver entry in the map.
-			this->mapRtpReceiverRtpSenders.erase(rtpReceiver);
+			if (leastActiveIt == this->lastNAudioRtpReceivers.end() || it->second < leastActiveIt->second)
+				leastActiveIt = it;
 		}
-        
-        // clear data
-        if (this->mapRtpReceiverLayerSelector.find(rtpReceiver) != this->mapRtpReceiverLayerSelector.end())
-        {
-            delete this->mapRtpReceiverLayerSelector.find(rtpReceiver)->second;
-            mapRtpReceiverLayerSelector.erase(this->mapRtpReceiverLayerSelector.find(rtpReceiver));
-        }
-        
-        if (this->mapRtpReceiverAudioLevels.find(rtpReceiver) != this->mapRtpReceiverAudioLevels.end())
-            mapRtpReceiverAudioLevels.erase(this->mapRtpReceiverAudioLevels.find(rtpReceiver));
-        
-        if (this->mapRtpReceiverAudioLevelSelector.find(rtpReceiver) != this->mapRtpReceiverAudioLevelSelector.end())
-        {
-            delete this->mapRtpReceiverAudioLevelSelector.find(rtpReceiver)->second;
-            mapRtpReceiverAudioLevelSelector.erase(this->mapRtpReceiverAudioLevelSelector.find(rtpReceiver));
-        }
-        
-        if (this->mapRtpReceiverPeer.find(rtpReceiver) != this->mapRtpReceiverPeer.end())
-            mapRtpReceiverPeer.erase(this->mapRtpReceiverPeer.find(rtpReceiver));
-        
-        for (std::map<int, const RTC::RtpReceiver*>::const_iterator it = voiceSpeakers.begin(); it != voiceSpeakers.end(); ++it)
-            if(it->second == rtpReceiver)
-            {
-                voiceSpeakers.erase(it);
-                break;
-            }
 
+		if (leastActiveIt == this->lastNAudioRtpReceivers.end())
+			return false;
+
+		MS_DEBUG_TAG(
+		    rtp, "audio paused [rtpReceiverId:%" PRIu32 "]", leastActiveIt->first->rtpReceiverId);
+
+		this->lastNAudioRtpReceivers.erase(leastActiveIt);
+
+		return true;
+	}
+
+	/**
+	 * Whether the audio of a RtpReceiver out of the last-N must be forwarded
+	 * anyway because it just started talking, so the beginning of the speech is
+	 * not lost while the speaker detection decides. This may exceed the last-N
+	 * for up to LastNAudioCandidateWindow every LastNAudioCandidateInterval.
+	 */
+	bool Room::IsLastNAudioCandidate(const RTC::RtpReceiver* rtpReceiver, uint64_t now)
+	{
+		MS_TRACE();
+
+		auto it = this->lastNAudioCandidates.find(rtpReceiver);
+
+		if (it != this->lastNAudioCandidates.end())
+		{
+			if (now - it->second <= LastNAudioCandidateWindow)
+				return true;
+
+			if (now - it->second < LastNAudioCandidateInterval)
+				return false;
+		}
+
+		if (!this->activeSpeakerDetector.IsActiveFrame(rtpReceiver->rtpReceiverId))
+			return false;
+
+		this->lastNAudioCandidates[rtpReceiver] = now;
+
+		ResumeRtpSenders(rtpReceiver);
+
+		return true;
+	}
+
+	/**
+	 * Lets the RtpSenders of the RtpReceiver know that the packets in between
+	 * were not forwarded.
+	 */
+	void Room::ResumeRtpSenders(const RTC::RtpReceiver* rtpReceiver)
+	{
+		MS_TRACE();
+
+		auto it = this->mapRtpReceiverRtpSenders.find(rtpReceiver);
+
+		if (it == this->mapRtpReceiverRtpSenders.end())
+			return;
+
+		for (auto* rtpSender : it->second)
+		{
+			rtpSender->Resync();
+		}
+	}
+
+	/**
+	 * Sets the Peer as the most recently active speaker. If its video is not
+	 * forwarded yet, it replaces the one of the least recently active speaker.
+	 */
+	void Room::UpdateLastNVideo(const RTC::Peer* peer, uint64_t now)
+	{
+		MS_TRACE();
+
+		this->mapPeerSpeechTime[peer] = now;
+
+		if (this->lastNVideoPeers.find(peer) != this->lastNVideoPeers.end())
+			return;
+
+		if (this->lastNVideoPeers.size() >= this->lastNVideo && !PauseLeastActiveVideo())
+			return;
+
+		this->lastNVideoPeers.insert(peer);
+
+		SetPeerVideoPaused(peer, false);
+
+		MS_DEBUG_TAG(rtp, "video resumed [peerName:'%s']", peer->peerName.c_str());
+
+		AllocateBitrate();
+	}
+
+	/**
+	 * Stops forwarding the video of the least recently active speaker (never the
+	 * dominant one). Returns false if there is none.
+	 */
+	bool Room::PauseLeastActiveVideo()
+	{
+		MS_TRACE();
+
+		const RTC::Peer* leastActivePeer{ nullptr };
+		uint64_t leastActiveSpeechTime{ 0 };
+
+		for (auto* peer : this->lastNVideoPeers)
+		{
+			if (peer == this->dominantSpeakerPeer)
+				continue;
+
+			auto it             = this->mapPeerSpeechTime.find(peer);
+			uint64_t speechTime = it != this->mapPeerSpeechTime.end() ? it->second : 0;
+
+			if (leastActivePeer == nullptr || speechTime < leastActiveSpeechTime)
+			{
+				leastActivePeer       = peer;
+				leastActiveSpeechTime = speechTime;
+			}
+		}
+
+		if (leastActivePeer == nullptr)
+			return false;
+
+		MS_DEBUG_TAG(rtp, "video paused [peerName:'%s']", leastActivePeer->peerName.c_str());
+
+		this->lastNVideoPeers.erase(leastActivePeer);
+
+		SetPeerVideoPaused(leastActivePeer, true);
+
+		return true;
+	}
+
+	/**
+	 * Forwards the video of the most recently active speakers not forwarded yet
+	 * while there is room for them.
+	 */
+	void Room::FillLastNVideo()
+	{
+		MS_TRACE();
+
+		while (this->lastNVideoPeers.size() < this->lastNVideo)
+		{
+			const RTC::Peer* mostActivePeer{ nullptr };
+			uint64_t mostActiveSpeechTime{ 0 };
+
+			for (auto& kv : this->peers)
+			{
+				auto* peer = kv.second;
+
+				if (this->lastNVideoPeers.find(peer) != this->lastNVideoPeers.end())
+					continue;
+
+				auto it             = this->mapPeerSpeechTime.find(peer);
+				uint64_t speechTime = it != this->mapPeerSpeechTime.end() ? it->second : 0;
+
+				if (mostActivePeer == nullptr || speechTime > mostActiveSpeechTime)
+				{
+					mostActivePeer       = peer;
+					mostActiveSpeechTime = speechTime;
+				}
+			}
+
+			if (mostActivePeer == nullptr)
+				return;
+
+			this->lastNVideoPeers.insert(mostActivePeer);
+
+			SetPeerVideoPaused(mostActivePeer, false);
+		}
+	}
+
+	/**
+	 * Pauses or resumes the video RtpSenders of the Peer RtpReceivers. They stop
+	 * at the next frame or wait for a key frame respectively.
+	 */
+	void Room::SetPeerVideoPaused(const RTC::Peer* peer, bool paused)
+	{
+		MS_TRACE();
+
+		for (auto* rtpReceiver : peer->GetRtpReceivers())
+		{
+			if (rtpReceiver->kind != RTC::Media::Kind::VIDEO)
+				continue;
+
+			auto it = this->mapRtpReceiverRtpSenders.find(rtpReceiver);
+
+			if (it == this->mapRtpReceiverRtpSenders.end())
+				continue;
+
+			for (auto* rtpSender : it->second)
+			{
+				rtpSender->SetPaused(paused);
+			}
+		}
+	}
+
+	void Room::AllocateBitrate()
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->peers)
+		{
+			auto* peer = kv.second;
+
+			peer->AllocateBitrate();
+		}
+	}
+
+	/**
+	 * Flags the video RtpSenders of the dominant speaker so every Peer gives
+	 * them most of its bitrate.
+	 */
+	void Room::UpdateActiveSpeakerRtpSenders()
+	{
+		MS_TRACE();
+
+		bool changed{ false };
+		std::vector<RTC::RtpReceiver*> activeSpeakerRtpReceivers;
+
+		if (this->dominantSpeakerPeer != nullptr)
+			activeSpeakerRtpReceivers = this->dominantSpeakerPeer->GetRtpReceivers();
+
+		for (auto& kv : this->mapRtpReceiverRtpSenders)
+		{
+			auto* rtpReceiver = kv.first;
+			auto& rtpSenders  = kv.second;
+
+			if (rtpReceiver->kind != RTC::Media::Kind::VIDEO)
+				continue;
+
+			bool activeSpeaker =
+			    std::find(
+			        activeSpeakerRtpReceivers.begin(), activeSpeakerRtpReceivers.end(), rtpReceiver) !=
+			    activeSpeakerRtpReceivers.end();
+
+			for (auto* rtpSender : rtpSenders)
+			{
+				if (rtpSender->GetActiveSpeaker() == activeSpeaker)
+					continue;
+
+				rtpSender->SetActiveSpeaker(activeSpeaker);
+				changed = true;
+			}
+		}
+
+		if (changed)
+			AllocateBitrate();
+	}
+
+	/**
+	 * Creates a video RtpSender for the Peer fed with the video of the dominant
+	 * speaker. It keeps its SSRC and its sequence numbers and timestamps
+	 * consecutive when the speaker changes. Just RtpReceivers with the first
+	 * video codec of the Peer can be its source.
+	 */
+	RTC::RtpSender* Room::CreateActiveSpeakerRtpSender(RTC::Peer* peer)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringCodecs{ "codecs" };
+		static const Json::StaticString JsonStringEncodings{ "encodings" };
+		static const Json::StaticString JsonStringHeaderExtensions{ "headerExtensions" };
+		static const Json::StaticString JsonStringRtcp{ "rtcp" };
+		static const Json::StaticString JsonStringSsrc{ "ssrc" };
+		static const Json::StaticString JsonStringCodecPayloadType{ "codecPayloadType" };
+		static const Json::StaticString JsonStringUri{ "uri" };
+		static const Json::StaticString JsonStringId{ "id" };
+		static const Json::StaticString JsonStringCname{ "cname" };
+
+		auto& capabilities = peer->GetCapabilities();
+		auto codecIt       = capabilities.codecs.begin();
+
+		for (; codecIt != capabilities.codecs.end(); ++codecIt)
+		{
+			if (codecIt->kind == RTC::Media::Kind::VIDEO && codecIt->mime.IsMediaCodec())
+				break;
+		}
+
+		if (codecIt == capabilities.codecs.end())
+			MS_THROW_ERROR("Peer does not support any video codec");
+
+		auto& codec = *codecIt;
+		Json::Value jsonRtpParameters(Json::objectValue);
+		Json::Value jsonEncoding(Json::objectValue);
+		Json::Value jsonRtcp(Json::objectValue);
+
+		jsonRtpParameters[JsonStringCodecs] = Json::arrayValue;
+		jsonRtpParameters[JsonStringCodecs].append(codec.ToJson());
+
+		jsonEncoding[JsonStringSsrc] = Json::UInt{ Utils::Crypto::GetRandomUInt(100000000, 999999999) };
+		jsonEncoding[JsonStringCodecPayloadType] = Json::UInt{ codec.payloadType };
+
+		jsonRtpParameters[JsonStringEncodings] = Json::arrayValue;
+		jsonRtpParameters[JsonStringEncodings].append(jsonEncoding);
+
+		jsonRtpParameters[JsonStringHeaderExtensions] = Json::arrayValue;
+
+		for (auto& headerExtension : capabilities.headerExtensions)
+		{
+			if (
+			    headerExtension.kind != RTC::Media::Kind::VIDEO &&
+			    headerExtension.kind != RTC::Media::Kind::ALL)
+			{
+				continue;
+			}
+
+			Json::Value jsonHeaderExtension(Json::objectValue);
+
+			jsonHeaderExtension[JsonStringUri] = headerExtension.uri;
+			jsonHeaderExtension[JsonStringId]  = Json::UInt{ headerExtension.preferredId };
+
+			jsonRtpParameters[JsonStringHeaderExtensions].append(jsonHeaderExtension);
+		}
+
+		jsonRtcp[JsonStringCname]         = Utils::Crypto::GetRandomString(16);
+		jsonRtpParameters[JsonStringRtcp] = jsonRtcp;
+
+		// NOTE: This may throw.
+		auto* rtpParameters = new RTC::RtpParameters(jsonRtpParameters);
+
+		uint32_t rtpSenderId = Utils::Crypto::GetRandomUInt(10000000, 99999999);
+		auto* rtpSender =
+		    new RTC::RtpSender(peer, this->notifier, rtpSenderId, RTC::Media::Kind::VIDEO);
+		bool wasEnabled = IsSpeakerDetectionEnabled();
+		auto& stream    = this->activeSpeakerStreams[rtpSender];
+
+		stream.peer          = peer;
+		stream.rtpParameters = rtpParameters;
+		stream.mime          = codec.mime;
+		stream.payloadType   = codec.payloadType;
+
+		// No source until the first key frame.
+		this->mapRtpSenderRtpReceiver[rtpSender] = nullptr;
+
+		rtpSender->SetVirtual();
+		rtpSender->SetActiveSpeaker(true);
+
+		// Attach the RtpSender to the peer.
+		peer->AddRtpSender(rtpSender, rtpParameters, 0);
+
+		UpdateSpeakerDetection(wasEnabled);
+		UpdateActiveSpeakerStream(rtpSender, stream);
+
+		return rtpSender;
+	}
+
+	/**
+	 * RtpReceiver the active speaker stream should be fed with: the one of the
+	 * dominant speaker (unless it is the Peer of the stream) or, if there is
+	 * none, the current (or pending) one or any other.
+	 */
+	const RTC::RtpReceiver* Room::GetActiveSpeakerSource(const ActiveSpeakerStream& stream) const
+	{
+		MS_TRACE();
+
+		if (this->dominantSpeakerPeer != nullptr && this->dominantSpeakerPeer != stream.peer)
+		{
+			auto* rtpReceiver = GetVideoRtpReceiver(this->dominantSpeakerPeer, stream.payloadType);
+
+			if (rtpReceiver != nullptr)
+				return rtpReceiver;
+		}
+
+		if (stream.target != nullptr)
+			return stream.target;
+
+		if (stream.source != nullptr)
+			return stream.source;
+
+		for (auto& kv : this->peers)
+		{
+			auto* peer = kv.second;
+
+			if (peer == stream.peer)
+				continue;
+
+			auto* rtpReceiver = GetVideoRtpReceiver(peer, stream.payloadType);
+
+			if (rtpReceiver != nullptr)
+				return rtpReceiver;
+		}
+
+		return nullptr;
+	}
+
+	void Room::UpdateActiveSpeakerStreams()
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->activeSpeakerStreams)
+		{
+			UpdateActiveSpeakerStream(kv.first, kv.second);
+		}
+	}
+
+	/**
+	 * Sets the RtpReceiver to switch the active speaker stream to, right away
+	 * if a key frame of it is cached. Otherwise it is requested and the switch
+	 * happens when received.
+	 */
+	void Room::UpdateActiveSpeakerStream(RTC::RtpSender* rtpSender, ActiveSpeakerStream& stream)
+	{
+		MS_TRACE();
+
+		auto* rtpReceiver = GetActiveSpeakerSource(stream);
+
+		if (rtpReceiver == stream.source)
+		{
+			stream.target = nullptr;
+
+			return;
+		}
+
+		if (rtpReceiver == stream.target)
+			return;
+
+		// The highest simulcast encoding (if signaled by SSRC).
+		stream.target     = rtpReceiver;
+		stream.targetSsrc = 0;
+
+		for (auto& encoding : rtpReceiver->GetParameters()->encodings)
+		{
+			if (encoding.ssrc != 0u)
+				stream.targetSsrc = encoding.ssrc;
+		}
+
+		MS_DEBUG_TAG(
+		    rtp,
+		    "switching active speaker stream [rtpSenderId:%" PRIu32 ", rtpReceiverId:%" PRIu32 "]",
+		    rtpSender->rtpSenderId,
+		    rtpReceiver->rtpReceiverId);
+
+		std::vector<RTC::RtpPacket*> packets;
+
+		if (stream.targetSsrc != 0u && rtpReceiver->GetKeyFrame(stream.targetSsrc, packets))
+		{
+			SwitchActiveSpeakerSource(rtpSender, stream, stream.targetSsrc);
+			rtpSender->SendKeyFrame(packets);
+
+			return;
+		}
+
+		stream.lastKeyFrameRequestAt = DepLibUV::GetTime();
+
+		rtpReceiver->RequestFullFrame();
+	}
+
+	void Room::SwitchActiveSpeakerSource(
+	    RTC::RtpSender* rtpSender, ActiveSpeakerStream& stream, uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		stream.source     = stream.target;
+		stream.sourceSsrc = ssrc;
+		stream.target     = nullptr;
+
+		this->mapRtpSenderRtpReceiver[rtpSender] = stream.source;
+
+		rtpSender->SetSpatialLayerResolutions(&stream.source->GetSpatialLayerResolutions());
+
+		// Continue from the last packet sent from the previous source.
+		rtpSender->Resync();
+	}
+
+	/**
+	 * Feeds the active speaker streams with a video packet of the RtpReceiver.
+	 */
+	void Room::SendActiveSpeakerRtpPacket(const RTC::RtpReceiver* rtpReceiver, RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->activeSpeakerStreams)
+		{
+			auto* rtpSender = kv.first;
+			auto& stream    = kv.second;
+
+			if (
+			    stream.target == rtpReceiver &&
+			    (stream.targetSsrc == 0u || packet->GetSsrc() == stream.targetSsrc))
+			{
+				if (RTC::Codecs::Tools::IsKeyFrame(stream.mime, packet))
+				{
+					SwitchActiveSpeakerSource(rtpSender, stream, packet->GetSsrc());
+				}
+				else
+				{
+					uint64_t now = DepLibUV::GetTime();
+
+					if (now - stream.lastKeyFrameRequestAt >= KeyFrameRequestInterval)
+					{
+						stream.lastKeyFrameRequestAt = now;
+
+						rtpReceiver->RequestFullFrame();
+					}
+				}
+			}
+
+			if (stream.source == rtpReceiver && packet->GetSsrc() == stream.sourceSsrc)
+				rtpSender->SendRtpPacket(packet);
+		}
+	}
+
+	void Room::OnPeerClosed(const RTC::Peer* peer)
+	{
+		MS_TRACE();
+
+		this->peers.erase(peer->peerId);
+
+		if (this->dominantSpeakerPeer == peer)
+			this->dominantSpeakerPeer = nullptr;
+
+		this->mapPeerSpeechTime.erase(peer);
+
+		// Forward the video of another Peer in its place.
+		if (this->lastNVideoPeers.erase(peer) != 0)
+		{
+			FillLastNVideo();
+			AllocateBitrate();
+		}
+	}
+
+	void Room::OnPeerCapabilities(RTC::Peer* peer, RTC::RtpCapabilities* capabilities)
+	{
+		MS_TRACE();
+
+		// Remove those peer's capabilities not supported by the room.
+
+		// Remove unsupported codecs and set the same PT.
+		for (auto it = capabilities->codecs.begin(); it != capabilities->codecs.end();)
+		{
+			auto& peerCodecCapability = *it;
+			auto it2                  = this->capabilities.codecs.begin();
+
+			for (; it2 != this->capabilities.codecs.end(); ++it2)
+			{
+				auto& roomCodecCapability = *it2;
+
+				if (roomCodecCapability.Matches(peerCodecCapability))
+				{
+					// Set the same payload type.
+					peerCodecCapability.payloadType    = roomCodecCapability.payloadType;
+					peerCodecCapability.hasPayloadType = true;
+
+					// Remove the unsupported RTCP feedback from the given codec.
+					peerCodecCapability.ReduceRtcpFeedback(roomCodecCapability.rtcpFeedback);
+
+					break;
+				}
+			}
+
+			if (it2 != this->capabilities.codecs.end())
+				++it;
+			else
+				it = capabilities->codecs.erase(it);
+		}
+
+		// Remove unsupported header extensions.
+		capabilities->ReduceHeaderExtensions(this->capabilities.headerExtensions);
+
+		// Remove unsupported FEC mechanisms.
+		capabilities->ReduceFecMechanisms(this->capabilities.fecMechanisms);
+
+		// Get all the ready RtpReceivers of the others Peers in the Room and
+		// create RtpSenders for this new Peer.
+		for (auto& kv : this->peers)
+		{
+			auto* receiverPeer = kv.second;
+
+			for (auto rtpReceiver : receiverPeer->GetRtpReceivers())
+			{
+				// Skip if the RtpReceiver has not parameters.
+				if (rtpReceiver->GetParameters() == nullptr)
+					continue;
+
+				AddRtpSenderForRtpReceiver(peer, receiverPeer, rtpReceiver);
+			}
+		}
+	}
+
+	void Room::OnPeerRtpReceiverParameters(const RTC::Peer* peer, RTC::RtpReceiver* rtpReceiver)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(rtpReceiver->GetParameters(), "rtpReceiver->GetParameters() returns no RtpParameters");
+
+		// If this is a new RtpReceiver, iterate all the peers but this one and
+		// create a RtpSender associated to this RtpReceiver for each Peer.
+		if (this->mapRtpReceiverRtpSenders.find(rtpReceiver) == this->mapRtpReceiverRtpSenders.end())
+		{
+			// Ensure the entry will exist even with an empty array.
+			this->mapRtpReceiverRtpSenders[rtpReceiver];
+
+			for (auto& kv : this->peers)
+			{
+				auto* senderPeer = kv.second;
+
+				// Skip receiver Peer.
+				if (senderPeer == peer)
+					continue;
+
+				// Skip Peer with capabilities not set yet.
+				if (!senderPeer->HasCapabilities())
+					continue;
+
+				AddRtpSenderForRtpReceiver(senderPeer, peer, rtpReceiver);
+			}
+
+			// Feed the active speaker streams with no video.
+			for (auto& kv : this->activeSpeakerStreams)
+			{
+				auto& stream = kv.second;
+
+				if (stream.source == nullptr && stream.target == nullptr)
+					UpdateActiveSpeakerStream(kv.first, stream);
+			}
+		}
+		// If this is not a new RtpReceiver let's retrieve its updated parameters
+		// and update with them all the associated RtpSenders.
+		else
+		{
+			for (auto rtpSender : this->mapRtpReceiverRtpSenders[rtpReceiver])
+			{
+				// Provide the RtpSender with the parameters of the RtpReceiver.
+				rtpSender->Send(rtpReceiver->GetParameters());
+			}
+		}
+	}
+
+	void Room::OnPeerRtpReceiverClosed(const RTC::Peer* /*peer*/, const RTC::RtpReceiver* rtpReceiver)
+	{
+		MS_TRACE();
+
+		// If the RtpReceiver is in the map, iterate the map and close all the
+		// RtpSenders associated to the closed RtpReceiver.
+		if (this->mapRtpReceiverRtpSenders.find(rtpReceiver) != this->mapRtpReceiverRtpSenders.end())
+		{
+			// Make a copy of the set of RtpSenders given that Destroy() will be called
+			// in all of them, producing onPeerRtpSenderClosed() that will remove it
+			// from the map.
+			auto rtpSenders = this->mapRtpReceiverRtpSenders[rtpReceiver];
+
+			// Safely iterate the copy of the set.
+			for (auto& rtpSender : rtpSenders)
+			{
+				rtpSender->Destroy();
+			}
+
+			// Finally delete the RtpReceiver entry in the map.
+			this->mapRtpReceiverRtpSenders.erase(rtpReceiver);
+		}
+
+		// Feed the active speaker streams with another video.
+		for (auto& kv : this->activeSpeakerStreams)
+		{
+			auto* rtpSender = kv.first;
+			auto& stream    = kv.second;
+
+			if (stream.source != rtpReceiver && stream.target != rtpReceiver)
+				continue;
+
+			if (stream.source == rtpReceiver)
+			{
+				stream.source = nullptr;
+
+				this->mapRtpSenderRtpReceiver[rtpSender] = nullptr;
+
+				rtpSender->SetSpatialLayerResolutions(nullptr);
+			}
+
+			if (stream.target == rtpReceiver)
+				stream.target = nullptr;
+
+			UpdateActiveSpeakerStream(rtpSender, stream);
+		}
         
-        
+        // clear data
+        this->activeSpeakerDetector.RemoveStream(rtpReceiver->rtpReceiverId);
+        this->lastNAudioRtpReceivers.erase(rtpReceiver);
+        this->lastNAudioCandidates.erase(rtpReceiver);
+
+        if (this->dominantSpeaker == rtpReceiver)
+            this->dominantSpeaker = nullptr;
 	}
 
 	void Room::OnPeerRtpSenderClosed(const RTC::Peer* /*peer*/, RTC::RtpSender* rtpSender)
@@ -714,103 +1624,69 @@ namespace RTC
 
 		// Also remove the entry from the sender/receiver map.
 		this->mapRtpSenderRtpReceiver.erase(rtpSender);
+
+		// Remove the active speaker stream.
+		auto it = this->activeSpeakerStreams.find(rtpSender);
+
+		if (it != this->activeSpeakerStreams.end())
+		{
+			bool wasEnabled = IsSpeakerDetectionEnabled();
+
+			delete it->second.rtpParameters;
+			this->activeSpeakerStreams.erase(it);
+
+			UpdateSpeakerDetection(wasEnabled);
+		}
 	}
 
 	void Room::OnPeerRtpPacket(const RTC::Peer* peer, RTC::RtpReceiver* rtpReceiver, RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
+		MS_LATENCY_PROBE(ROUTING);
 
 		MS_ASSERT(
 		    this->mapRtpReceiverRtpSenders.find(rtpReceiver) != this->mapRtpReceiverRtpSenders.end(),
 		    "RtpReceiver not present in the map");
         
         // Update audio levels.
-        if (this->audioLevelsEventEnabled)
+        if (IsSpeakerDetectionEnabled() && rtpReceiver->kind == RTC::Media::Kind::AUDIO)
         {
             uint8_t volume;
             bool voice;
             if (packet->ReadAudioLevel(&volume, &voice))
             {
-                const int8_t dBov = volume * -1;
-                this->mapRtpReceiverAudioLevels[rtpReceiver].currentTmpValues.push_back(dBov);
-            }
-        }
-        
-        // filter packet. Be careful here - filters may not work in the same time.
-        bool needToSendPacket = true;
-        if ((needToFilterAudioLevels || needToFilterLayers) && packet->GetPayloadType() == 101)
-        {
-            // filter by layers
-            if (needToFilterLayers)
-            {
-                {
-                    // debug info as error
-                    VP9::VP9PayloadDescription desc;
-                    if (desc.Parse(packet->GetPayload(), 1700))
-                        std::cerr << " temporal " << (int)desc.temporalLayerId << " spatial " << (int)desc.spatialLayerId << std::endl;
-                }
-                // create filter if it is not created yet
-                if (mapRtpReceiverLayerSelector.find(rtpReceiver) == mapRtpReceiverLayerSelector.end())
-                {
-                    mapRtpReceiverLayerSelector[rtpReceiver] = new VP9::VP9LayerSelector();
-                    mapRtpReceiverLayerSelector[rtpReceiver]->SelectTemporalLayer(Settings::configuration.vp9MinTemporial);
-                    mapRtpReceiverLayerSelector[rtpReceiver]->SelectSpatialLayer(Settings::configuration.vp9MinSpartial);
-                }
-                // drop packets if needed
-                uint32_t extSegNum;
-                bool mark;
-                if(mapRtpReceiverLayerSelector[rtpReceiver]->Select(packet, extSegNum, mark))
-                {
-                    packet->SetSequenceNumber(extSegNum);
-                    uint16_t cicles = extSegNum >> 16;
-                    packet->SetExtendedSequenceNumber(((uint32_t)cicles) << 16 | packet->GetSequenceNumber());
-                    packet->SetMarker(mark);
-                }
-                else
+                uint64_t now = DepLibUV::GetTime();
+                bool speaking = this->activeSpeakerDetector.ReceiveLevel(rtpReceiver->rtpReceiverId, volume, now);
+
+                // Last-N video: forward just the video of the most recently
+                // active speakers.
+                if (this->lastNVideo != 0 && speaking)
+                    UpdateLastNVideo(peer, now);
+
+                // Last-N audio: forward just the most recently active speakers
+                // (and those who just started talking). Streams without audio
+                // levels cannot be ranked, so they are always forwarded.
+                if (this->lastNAudio != 0)
                 {
-                    std::cerr << "packet was dropped for " << peerByReceiver(rtpReceiver) << " because TS filtering"<< std::endl;
-                    needToSendPacket = false;
-                }
-            }
-            // filter by audio level
-            if (needToSendPacket && needToFilterAudioLevels)
-            {
-                bool packetFromActiveSpeaker = voiceSpeakers.size() >= 1 ? false : true;
-                for (auto& speaker : voiceSpeakers)
-                    if(peerByReceiver(speaker.second) == peerByReceiver(rtpReceiver))
+                    if (speaking)
+                        UpdateLastNAudio(rtpReceiver, now);
+
+                    if (this->lastNAudioRtpReceivers.find(rtpReceiver) == this->lastNAudioRtpReceivers.end() &&
+                        !IsLastNAudioCandidate(rtpReceiver, now))
                     {
-                        packetFromActiveSpeaker = true;
-                        break;
+                        return;
                     }
-                // create filter if it is not created yet
-                if (mapRtpReceiverAudioLevelSelector.find(rtpReceiver) == mapRtpReceiverAudioLevelSelector.end())
-                    mapRtpReceiverAudioLevelSelector[rtpReceiver] = new VP9::VP9AudioLevelSelector();
-                // drop packets if needed
-                uint32_t extSegNum;
-                bool mark;
-                if(mapRtpReceiverAudioLevelSelector[rtpReceiver]->Select(packet, packetFromActiveSpeaker, extSegNum, mark))
-                {
-                    packet->SetSequenceNumber(extSegNum);
-                    uint16_t cicles = extSegNum >> 16;
-                    packet->SetExtendedSequenceNumber(((uint32_t)cicles) << 16 | packet->GetSequenceNumber());
-                    packet->SetMarker(mark);
-                    std::cerr << "packet was keept for " << peerByReceiver(rtpReceiver) << " number " << packet->GetSequenceNumber() << std::endl;
-                }
-                else
-                {
-                    std::cerr << "packet was dropped for " << peerByReceiver(rtpReceiver) << " because it is not active speaker" << std::endl;
-                    needToSendPacket = false;
                 }
             }
         }
         
-        // send packet if it was not filtered
-        if (needToSendPacket)
-        {
-            // Send the RtpPacket to all the RtpSenders associated to the RtpReceiver from which it was received.
-            for (auto& rtpSender : this->mapRtpReceiverRtpSenders[rtpReceiver])
-                rtpSender->SendRtpPacket(packet);
-        }
+        // Feed the active speaker streams.
+        if (!this->activeSpeakerStreams.empty() && rtpReceiver->kind == RTC::Media::Kind::VIDEO)
+            SendActiveSpeakerRtpPacket(rtpReceiver, packet);
+
+        // Send the RtpPacket to all the RtpSenders associated to the RtpReceiver from which it was received.
+        for (auto& rtpSender : this->mapRtpReceiverRtpSenders[rtpReceiver])
+            rtpSender->SendRtpPacket(packet);
 	}
 
 	void Room::OnPeerRtcpReceiverReport(
@@ -836,6 +1712,13 @@ namespace RTC
 
 		auto& rtpReceiver = this->mapRtpSenderRtpReceiver[rtpSender];
 
+		if (rtpReceiver == nullptr)
+			return;
+
+		// Feedback of an active speaker stream is about its current source.
+		if (rtpSender->IsVirtual())
+			packet->SetMediaSsrc(this->activeSpeakerStreams[rtpSender].sourceSsrc);
+
 		rtpReceiver->ReceiveRtcpFeedback(packet);
 	}
 
@@ -850,9 +1733,33 @@ namespace RTC
 
 		auto& rtpReceiver = this->mapRtpSenderRtpReceiver[rtpSender];
 
+		if (rtpReceiver == nullptr)
+			return;
+
+		// Feedback of an active speaker stream is about its current source.
+		if (rtpSender->IsVirtual())
+			packet->SetMediaSsrc(this->activeSpeakerStreams[rtpSender].sourceSsrc);
+
 		rtpReceiver->ReceiveRtcpFeedback(packet);
 	}
 
+	void Room::OnPeerRtcpNackNotServed(
+	    const RTC::Peer* /*peer*/,
+	    RTC::RtpSender* rtpSender,
+	    uint32_t ssrc,
+	    const std::vector<uint16_t>& seqNumbers)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(
+		    this->mapRtpSenderRtpReceiver.find(rtpSender) != this->mapRtpSenderRtpReceiver.end(),
+		    "RtpSender not present in the map");
+
+		auto& rtpReceiver = this->mapRtpSenderRtpReceiver[rtpSender];
+
+		rtpReceiver->ReceiveNack(ssrc, seqNumbers);
+	}
+
 	void Room::OnPeerRtcpSenderReport(
 	    const RTC::Peer* /*peer*/, RTC::RtpReceiver* rtpReceiver, RTC::RTCP::SenderReport* report)
 	{
@@ -874,7 +1781,32 @@ namespace RTC
 		    this->mapRtpSenderRtpReceiver.find(rtpSender) != this->mapRtpSenderRtpReceiver.end(),
 		    "RtpSender not present in the map");
 
-		auto& rtpReceiver = this->mapRtpSenderRtpReceiver[rtpSender];
+		auto& rtpReceiver   = this->mapRtpSenderRtpReceiver[rtpSender];
+		auto* rtpParameters = rtpSender->GetParameters();
+
+		// Active speaker stream with no source yet.
+		if (rtpReceiver == nullptr)
+			return;
+
+		// Video paused by the last-N, it requests a key frame once resumed.
+		if (rtpSender->GetPaused())
+			return;
+
+		// Serve the cached key frame (if any) instead of asking the publisher for
+		// a new one.
+		if (rtpParameters != nullptr)
+		{
+			std::vector<RTC::RtpPacket*> packets;
+			uint32_t ssrc = rtpSender->IsVirtual() ? this->activeSpeakerStreams[rtpSender].sourceSsrc
+			                                       : rtpSender->GetTargetSsrc();
+
+			if (rtpReceiver->GetKeyFrame(ssrc, packets))
+			{
+				rtpSender->SendKeyFrame(packets);
+
+				return;
+			}
+		}
 
 		rtpReceiver->RequestFullFrame();
 	}
@@ -882,64 +1814,55 @@ namespace RTC
 	inline void Room::OnTimer(Timer* timer)
 	{
 		MS_TRACE();
+
 		// Audio levels timer.
 		if (timer == this->audioLevelsTimer)
 		{
-            //std::cerr << "=========== on audio level timer ==================" << std::endl;
-            // calculate average value for each reciever
-            voiceSpeakers.clear();
-			for (auto& lv : this->mapRtpReceiverAudioLevels)
-			{
-                // calculate min, max and current value
-				auto& dBovs = lv.second.currentTmpValues;
-				int8_t avgdBov{ -127 };
-                lv.second.minValue = 127;
-                lv.second.maxValue = -127;
-                //std::cerr << peerByReceiver(lv.first);
-				if (!dBovs.empty())
-				{
-                    int16_t sumdBovs{ 0 };
-					for (auto& dBov : dBovs)
-                    {
-						sumdBovs += dBov;
-                        if (dBov < lv.second.minValue)
-                            lv.second.minValue = dBov;
-                        if (dBov > lv.second.maxValue)
-                            lv.second.maxValue = dBov;
-                        //std::cerr << " " << (int)dBov;
-                    }
-					avgdBov = static_cast<int8_t>(std::lround(sumdBovs / static_cast<int16_t>(dBovs.size())));
-				}
-				lv.second.value = avgdBov;
-                // Clear map for future use
-                lv.second.currentTmpValues.clear();
-                const double diff = lv.second.maxValue - lv.second.minValue; //-127 + 254 * (lv.second.value - lv.second.minValue) / (lv.second.maxValue - lv.second.minValue);
-                lv.second.normalizedValue = (int8_t)diff;
-                //std::cerr << " value " << (int)lv.second.value << " diff " << (int)lv.second.normalizedValue << std::endl;
-                if (lv.second.normalizedValue > ActiveSpeakerVoiceDiff && lv.second.value > -50)
-                    voiceSpeakers[lv.second.normalizedValue] = lv.first;
-            }
-			// Emit event.
-            static const Json::StaticString JsonStringClass{ "class" };
-            static const Json::StaticString JsonStringEntries{ "entries" };
-			Json::Value eventData(Json::objectValue);
-			eventData[JsonStringClass] = "Room";
-			eventData[JsonStringEntries] = Json::arrayValue;
-            if(voiceSpeakers.size() >= 1)
-            {
-                Json::Value entry(Json::arrayValue);
-                entry.append(Json::UInt{ voiceSpeakers.begin()->second->rtpReceiverId});
-                entry.append(Json::Int{ this->mapRtpReceiverAudioLevels[voiceSpeakers.begin()->second].value });
-                eventData[JsonStringEntries].append(entry);
-            }
-            /*for (auto& lv : this->mapRtpReceiverAudioLevels)
-            {
-                Json::Value entry(Json::arrayValue);
-                entry.append(Json::UInt{ lv.first->rtpReceiverId });
-                entry.append(Json::Int{ lv.second.normalizedValue });
-                eventData[JsonStringEntries].append(entry);
-            }*/
-			this->notifier->Emit(this->roomId, "audiolevels", eventData);
+			// Emit just if the dominant speaker changes.
+			if (!this->activeSpeakerDetector.Process(DepLibUV::GetTime()))
+				return;
+
+			UpdateDominantSpeaker();
+		}
+	}
+
+	bool Room::OnDumpWriterStep(Channel::DumpWriter* dumpWriter, size_t step, Json::Value& data)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringPeers{ "peers" };
+
+		auto& steps = this->dumpWriters.at(dumpWriter);
+
+		if (step < steps.size())
+		{
+			auto it = this->peers.find(steps[step].first);
+
+			// The Peer may have been closed meanwhile.
+			if (it == this->peers.end())
+				return false;
+
+			auto* peer     = it->second;
+			auto& peerStep = steps[step].second;
+			Json::Value peerData(Json::objectValue);
+
+			peer->FillDumpStep(peerStep, peerData);
+
+			// Node merges an object given for an array into its last item, which
+			// is the Peer dumped in a previous step.
+			if (peerStep.kind == RTC::Peer::DumpStep::Kind::PEER)
+				data[JsonStringPeers].append(peerData);
+			else if (!peerData.empty())
+				data[JsonStringPeers] = peerData;
+
+			return false;
 		}
+
+		// The rest of the Room goes into the final response.
+		data = ToJson(false);
+
+		this->dumpWriters.erase(dumpWriter);
+
+		return true;
 	}
 } // namespace RTC
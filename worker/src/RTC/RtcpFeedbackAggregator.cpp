@@ -0,0 +1,292 @@
+#define MS_CLASS "RTC::RtcpFeedbackAggregator"
+// #define MS_LOG_DEV
+
+#include "RTC/RtcpFeedbackAggregator.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::find(), std::sort()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Don't request the same sequence number upstream again before this time (ms).
+	constexpr uint64_t NackRetryInterval{ 100 };
+
+	/* Instance methods. */
+
+	RtcpFeedbackAggregator::RtcpFeedbackAggregator(
+	    Listener* listener, uint32_t nackWindow, uint32_t keyFrameMinInterval)
+	    : listener(listener), nackWindow(nackWindow), keyFrameMinInterval(keyFrameMinInterval)
+	{
+		MS_TRACE();
+	}
+
+	RtcpFeedbackAggregator::~RtcpFeedbackAggregator()
+	{
+		MS_TRACE();
+	}
+
+	Json::Value RtcpFeedbackAggregator::ToJson() const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringNacksReceived{ "nacksReceived" };
+		static const Json::StaticString JsonStringNacksForwarded{ "nacksForwarded" };
+		static const Json::StaticString JsonStringKeyFrameRequestsReceived{ "keyFrameRequestsReceived" };
+		static const Json::StaticString JsonStringKeyFrameRequestsForwarded{ "keyFrameRequestsForwarded" };
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringNacksReceived]             = Json::UInt64{ this->nacksReceived };
+		json[JsonStringNacksForwarded]            = Json::UInt64{ this->nacksForwarded };
+		json[JsonStringKeyFrameRequestsReceived]  = Json::UInt64{ this->keyFrameRequestsReceived };
+		json[JsonStringKeyFrameRequestsForwarded] = Json::UInt64{ this->keyFrameRequestsForwarded };
+
+		return json;
+	}
+
+	/**
+	 * Sequence numbers that a RtpSender could not retransmit from its own
+	 * storage. They are queued and sent upstream once the aggregation window
+	 * expires, so the same loss reported by many subscribers produces a single
+	 * NACK.
+	 */
+	void RtcpFeedbackAggregator::ReceiveNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers)
+	{
+		MS_TRACE();
+
+		uint64_t now     = DepLibUV::GetTime();
+		auto& streamInfo = this->streams[ssrc];
+
+		for (auto seq : seqNumbers)
+		{
+			this->nacksReceived++;
+
+			if (IsRecentlyNacked(streamInfo, seq, now))
+				continue;
+
+			auto& pendingNacks = streamInfo.pendingNacks;
+
+			if (std::find(pendingNacks.begin(), pendingNacks.end(), seq) != pendingNacks.end())
+				continue;
+
+			pendingNacks.push_back(seq);
+		}
+
+		if (streamInfo.pendingNacks.empty())
+			return;
+
+		if (this->nackWindow == 0u)
+			FlushNacks();
+		else if (!this->nackTimer.IsActive())
+			this->nackTimer.Start(this->nackWindow);
+	}
+
+	/**
+	 * Sequence numbers already requested upstream by the RtpReceiver itself.
+	 */
+	void RtcpFeedbackAggregator::RegisterSentNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers)
+	{
+		MS_TRACE();
+
+		uint64_t now       = DepLibUV::GetTime();
+		auto& streamInfo   = this->streams[ssrc];
+		auto& pendingNacks = streamInfo.pendingNacks;
+
+		for (auto seq : seqNumbers)
+		{
+			streamInfo.nackedAt[seq] = now;
+
+			auto it = std::find(pendingNacks.begin(), pendingNacks.end(), seq);
+
+			if (it != pendingNacks.end())
+				pendingNacks.erase(it);
+		}
+	}
+
+	/**
+	 * Returns true if the key frame request must be sent upstream now. Otherwise
+	 * a single request is sent once the minimum interval expires.
+	 */
+	bool RtcpFeedbackAggregator::ReceiveKeyFrameRequest(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		uint64_t now     = DepLibUV::GetTime();
+		auto& streamInfo = this->streams[ssrc];
+
+		this->keyFrameRequestsReceived++;
+
+		if (streamInfo.keyFrameRequestedAt != 0u &&
+		    now - streamInfo.keyFrameRequestedAt < this->keyFrameMinInterval)
+		{
+			MS_DEBUG_DEV("key frame request delayed [ssrc:%" PRIu32 "]", ssrc);
+
+			streamInfo.keyFrameRequestPending = true;
+
+			if (!this->keyFrameTimer.IsActive())
+			{
+				this->keyFrameTimer.Start(
+				    this->keyFrameMinInterval - (now - streamInfo.keyFrameRequestedAt));
+			}
+
+			return false;
+		}
+
+		streamInfo.keyFrameRequestedAt    = now;
+		streamInfo.keyFrameRequestPending = false;
+		this->keyFrameRequestsForwarded++;
+
+		return true;
+	}
+
+	/**
+	 * Key frame request sent upstream by the RtpReceiver itself.
+	 */
+	void RtcpFeedbackAggregator::RegisterSentKeyFrameRequest(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		auto& streamInfo = this->streams[ssrc];
+
+		streamInfo.keyFrameRequestedAt    = DepLibUV::GetTime();
+		streamInfo.keyFrameRequestPending = false;
+	}
+
+	void RtcpFeedbackAggregator::Clear()
+	{
+		MS_TRACE();
+
+		this->nackTimer.Stop();
+		this->keyFrameTimer.Stop();
+		this->streams.clear();
+	}
+
+	bool RtcpFeedbackAggregator::IsRecentlyNacked(StreamInfo& streamInfo, uint16_t seq, uint64_t now) const
+	{
+		MS_TRACE();
+
+		auto it = streamInfo.nackedAt.find(seq);
+
+		if (it == streamInfo.nackedAt.end())
+			return false;
+
+		if (now - it->second < NackRetryInterval)
+			return true;
+
+		streamInfo.nackedAt.erase(it);
+
+		return false;
+	}
+
+	void RtcpFeedbackAggregator::FlushNacks()
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+		std::vector<std::pair<uint32_t, std::vector<uint16_t>>> nacks;
+
+		for (auto& kv : this->streams)
+		{
+			auto ssrc          = kv.first;
+			auto& streamInfo   = kv.second;
+			auto& pendingNacks = streamInfo.pendingNacks;
+			auto& nackedAt     = streamInfo.nackedAt;
+
+			// Forget sequence numbers that can be requested again.
+			for (auto it = nackedAt.begin(); it != nackedAt.end();)
+			{
+				if (now - it->second >= NackRetryInterval)
+					it = nackedAt.erase(it);
+				else
+					++it;
+			}
+
+			if (pendingNacks.empty())
+				continue;
+
+			// Sort them taking wrap around into account so consecutive sequence
+			// numbers end up in the same NACK item.
+			uint16_t base = pendingNacks.front() - 0x8000;
+
+			std::sort(pendingNacks.begin(), pendingNacks.end(), [base](uint16_t a, uint16_t b) {
+				return static_cast<uint16_t>(a - base) < static_cast<uint16_t>(b - base);
+			});
+
+			for (auto seq : pendingNacks)
+			{
+				nackedAt[seq] = now;
+			}
+
+			this->nacksForwarded += pendingNacks.size();
+
+			nacks.emplace_back(ssrc, std::move(pendingNacks));
+			pendingNacks.clear();
+		}
+
+		for (auto& nack : nacks)
+		{
+			MS_DEBUG_TAG(
+			    rtx,
+			    "sending aggregated NACK upstream [ssrc:%" PRIu32 ", packets:%zu]",
+			    nack.first,
+			    nack.second.size());
+
+			this->listener->OnAggregatedNackRequired(nack.first, nack.second);
+		}
+	}
+
+	void RtcpFeedbackAggregator::FlushKeyFrameRequests()
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+		uint64_t nextTimeout{ 0 };
+		std::vector<uint32_t> ssrcs;
+
+		for (auto& kv : this->streams)
+		{
+			auto ssrc        = kv.first;
+			auto& streamInfo = kv.second;
+
+			if (!streamInfo.keyFrameRequestPending)
+				continue;
+
+			uint64_t elapsed = now - streamInfo.keyFrameRequestedAt;
+
+			if (elapsed >= this->keyFrameMinInterval)
+			{
+				streamInfo.keyFrameRequestedAt    = now;
+				streamInfo.keyFrameRequestPending = false;
+				this->keyFrameRequestsForwarded++;
+
+				ssrcs.push_back(ssrc);
+			}
+			else if (nextTimeout == 0u || this->keyFrameMinInterval - elapsed < nextTimeout)
+			{
+				nextTimeout = this->keyFrameMinInterval - elapsed;
+			}
+		}
+
+		if (nextTimeout != 0u)
+			this->keyFrameTimer.Start(nextTimeout);
+
+		for (auto ssrc : ssrcs)
+		{
+			MS_DEBUG_TAG(rtx, "sending delayed key frame request upstream [ssrc:%" PRIu32 "]", ssrc);
+
+			this->listener->OnAggregatedKeyFrameRequired(ssrc);
+		}
+	}
+
+	inline void RtcpFeedbackAggregator::OnTimer(TimerWheel::Handle* handle)
+	{
+		MS_TRACE();
+
+		if (handle == &this->nackTimer)
+			FlushNacks();
+		else if (handle == &this->keyFrameTimer)
+			FlushKeyFrameRequests();
+	}
+} // namespace RTC
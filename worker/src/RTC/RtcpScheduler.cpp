@@ -0,0 +1,490 @@
+#define MS_CLASS "RTC::RtcpScheduler"
+// #define MS_LOG_DEV
+
+#include "RTC/RtcpScheduler.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include "RTC/RTCP/Feedback.hpp"
+#include "RTC/RTCP/Sdes.hpp"
+#include <algorithm> // std::min(), std::max(), std::remove_if(), std::swap()
+#include <cstring>   // std::memcpy(), std::memset()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Maximum number of report blocks (or SDES chunks) in a RTCP packet.
+	static constexpr size_t MaxReportCount{ 31 };
+	static constexpr size_t HeaderSize{ sizeof(RTC::RTCP::Packet::CommonHeader) };
+	static constexpr size_t SenderReportPacketSize{ HeaderSize + sizeof(RTC::RTCP::SenderReport::Header) };
+	// Common header plus sender SSRC.
+	static constexpr size_t ReceiverReportPacketHeaderSize{ HeaderSize + 4 };
+	static constexpr size_t ReceiverReportSize{ sizeof(RTC::RTCP::ReceiverReport::Header) };
+	// Common header plus sender and media SSRCs.
+	static constexpr size_t FeedbackHeaderSize{ HeaderSize + 8 };
+	static constexpr uint32_t RembIdentifier{ 0x52454D42 }; // "REMB".
+	static constexpr size_t UdpIpOverhead{ 28 };
+	// RFC 3550 fraction of the session bandwidth used by RTCP.
+	static constexpr double RtcpBandwidthFraction{ 0.05 };
+	// RFC 3550 reduced minimum interval is 360 seconds divided by the session
+	// bandwidth in kbps.
+	static constexpr uint64_t ReducedMinInterval{ 360000 }; // In ms * kbps.
+	static constexpr uint64_t MinInterval{ 100 };           // In ms.
+	// Reports due within this time are sent along with the due ones.
+	static constexpr uint64_t ReportGroupingWindow{ 100 }; // In ms.
+
+	// Sender reports first, then the rest of the compound packet on Flush().
+	static uint8_t CompoundBuffer[RtcpScheduler::MaxPacketSize];
+	static uint8_t ReceiverReportsBuffer[RtcpScheduler::MaxPacketSize];
+	static uint8_t SdesBuffer[RtcpScheduler::MaxPacketSize];
+
+	/* Static helpers. */
+
+	static inline void writeCommonHeader(
+	    uint8_t* data, RTC::RTCP::Type type, uint8_t count, size_t size)
+	{
+		auto* header = reinterpret_cast<RTC::RTCP::Packet::CommonHeader*>(data);
+
+		header->version    = 2;
+		header->padding    = 0;
+		header->count      = count;
+		header->packetType = static_cast<uint8_t>(type);
+		header->length     = uint16_t{ htons(static_cast<uint16_t>((size / 4) - 1)) };
+	}
+
+	/* Instance methods. */
+
+	RtcpScheduler::RtcpScheduler(Listener* listener) : listener(listener)
+	{
+		MS_TRACE();
+	}
+
+	RtcpScheduler::~RtcpScheduler()
+	{
+		MS_TRACE();
+	}
+
+	Json::Value RtcpScheduler::ToJson() const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringReporters{ "reporters" };
+		static const Json::StaticString JsonStringBitrate{ "bitrate" };
+		static const Json::StaticString JsonStringAvgPacketSize{ "avgPacketSize" };
+		static const Json::StaticString JsonStringCompoundPackets{ "compoundPackets" };
+		static const Json::StaticString JsonStringSenderReports{ "senderReports" };
+		static const Json::StaticString JsonStringReceiverReports{ "receiverReports" };
+		static const Json::StaticString JsonStringNacks{ "nacks" };
+		static const Json::StaticString JsonStringRembs{ "rembs" };
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringReporters]       = Json::UInt{ static_cast<uint32_t>(this->reporters.size()) };
+		json[JsonStringBitrate]         = Json::UInt{ this->bitrate };
+		json[JsonStringAvgPacketSize]   = this->avgPacketSize;
+		json[JsonStringCompoundPackets] = Json::UInt64{ this->numCompoundPackets };
+		json[JsonStringSenderReports]   = Json::UInt64{ this->numSenderReports };
+		json[JsonStringReceiverReports] = Json::UInt64{ this->numReceiverReports };
+		json[JsonStringNacks]           = Json::UInt64{ this->numNacks };
+		json[JsonStringRembs]           = Json::UInt64{ this->numRembs };
+
+		return json;
+	}
+
+	/**
+	 * The first report of a reporter is sent after half of its interval.
+	 */
+	void RtcpScheduler::AddReporter(Reporter* reporter, uint16_t maxInterval)
+	{
+		MS_TRACE();
+
+		ReporterInfo info;
+
+		info.reporter    = reporter;
+		info.maxInterval = maxInterval;
+
+		// The new member counts for its own interval.
+		this->reporters.push_back(info);
+		this->reporters.back().nextReportAt = DepLibUV::GetTime() + GetInterval(maxInterval) / 2;
+
+		MayRunTimer();
+	}
+
+	void RtcpScheduler::RemoveReporter(Reporter* reporter)
+	{
+		MS_TRACE();
+
+		for (size_t i{ 0 }; i < this->reporters.size(); ++i)
+		{
+			if (this->reporters[i].reporter != reporter)
+				continue;
+
+			// Do not reorder the reporters while they are being iterated.
+			if (this->reporting)
+			{
+				this->reporters[i].reporter = nullptr;
+
+				return;
+			}
+
+			std::swap(this->reporters[i], this->reporters.back());
+			this->reporters.pop_back();
+
+			break;
+		}
+
+		MayRunTimer();
+	}
+
+	/**
+	 * Adds a SR and its CNAME SDES chunk to the compound packet being built,
+	 * sending it first if they do not fit.
+	 */
+	void RtcpScheduler::AddSenderReport(RTC::RTCP::SenderReport* report, const std::string& cname)
+	{
+		MS_TRACE();
+
+		// SDES items can not be longer than 255 bytes.
+		size_t cnameLength = std::min(cname.size(), size_t{ 255 });
+		// SSRC, item type and length, and at least one null octet ending the
+		// item list, padded to 32 bits.
+		size_t chunkSize = (sizeof(uint32_t) + 2 + cnameLength + 4) & ~size_t{ 3 };
+		size_t size      = SenderReportPacketSize + chunkSize;
+		// Size of the CNAME of a previous SR replaced by this one.
+		size_t replacedSize{ 0 };
+
+		if (this->sdesChunkCount == 0)
+		{
+			size += HeaderSize;
+
+			if (this->cnameChunkSize != 0)
+				replacedSize = HeaderSize + this->cnameChunkSize;
+		}
+
+		if (
+		    GetSize() + size > MaxPacketSize + replacedSize ||
+		    this->sdesChunkCount == MaxReportCount)
+		{
+			Flush();
+		}
+
+		uint8_t* data = CompoundBuffer + this->senderReportsSize;
+
+		writeCommonHeader(data, RTC::RTCP::Type::SR, 0, SenderReportPacketSize);
+		report->Serialize(data + HeaderSize);
+
+		this->senderReportsSize += SenderReportPacketSize;
+
+		uint8_t* chunk = SdesBuffer + this->sdesSize;
+
+		std::memset(chunk, 0, chunkSize);
+		Utils::Byte::Set4Bytes(chunk, 0, report->GetSsrc());
+		chunk[4] = static_cast<uint8_t>(RTC::RTCP::SdesItem::Type::CNAME);
+		chunk[5] = static_cast<uint8_t>(cnameLength);
+		std::memcpy(chunk + 6, cname.c_str(), cnameLength);
+		std::memcpy(this->cnameChunk, chunk, chunkSize);
+
+		this->cnameChunkSize = chunkSize;
+		this->sdesSize += chunkSize;
+		this->sdesChunkCount++;
+		this->numSenderReports++;
+	}
+
+	/**
+	 * Adds a RR block to the compound packet being built, sending it first if
+	 * it does not fit.
+	 */
+	void RtcpScheduler::AddReceiverReport(RTC::RTCP::ReceiverReport* report)
+	{
+		MS_TRACE();
+
+		size_t size = ReceiverReportSize;
+
+		if (this->receiverReportCount % MaxReportCount == 0)
+			size += ReceiverReportPacketHeaderSize;
+
+		if (GetSize() + size > MaxPacketSize)
+			Flush();
+
+		report->Serialize(ReceiverReportsBuffer + this->receiverReportCount * ReceiverReportSize);
+
+		this->receiverReportCount++;
+		this->numReceiverReports++;
+	}
+
+	/**
+	 * Sends the given sequence numbers in as few generic NACK items (and
+	 * packets) as possible.
+	 */
+	void RtcpScheduler::SendNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers)
+	{
+		MS_TRACE();
+
+		uint8_t* data  = RTC::RTCP::Buffer;
+		size_t offset  = FeedbackHeaderSize;
+		auto it        = seqNumbers.begin();
+		const auto end = seqNumbers.end();
+
+		while (it != end)
+		{
+			uint16_t seq = *it;
+			uint16_t bitmask{ 0 };
+
+			++it;
+
+			while (it != end)
+			{
+				uint16_t shift = *it - seq - 1;
+
+				if (shift > 15)
+					break;
+
+				bitmask |= (1 << shift);
+				++it;
+			}
+
+			Utils::Byte::Set2Bytes(data, offset, seq);
+			Utils::Byte::Set2Bytes(data, offset + 2, bitmask);
+			offset += 4;
+
+			// Send the packet if full or done.
+			if (it != end && offset + 4 <= MaxPacketSize)
+				continue;
+
+			writeCommonHeader(
+			    data,
+			    RTC::RTCP::Type::RTPFB,
+			    static_cast<uint8_t>(RTC::RTCP::FeedbackRtp::MessageType::NACK),
+			    offset);
+			Utils::Byte::Set4Bytes(data, 4, 0);
+			Utils::Byte::Set4Bytes(data, 8, ssrc);
+
+			this->listener->OnRtcpSchedulerPacket(this, data, offset);
+
+			offset = FeedbackHeaderSize;
+			this->numNacks++;
+		}
+	}
+
+	void RtcpScheduler::SendRemb(uint32_t bitrate, const std::vector<uint32_t>& ssrcs)
+	{
+		MS_TRACE();
+
+		uint8_t* data     = RTC::RTCP::Buffer;
+		size_t offset     = FeedbackHeaderSize;
+		size_t numSsrcs   = std::min(ssrcs.size(), size_t{ 255 });
+		uint32_t mantissa = bitrate;
+		uint8_t exponent{ 0 };
+
+		while (mantissa > 0x3FFFF /* max mantissa (18 bits) */)
+		{
+			mantissa >>= 1;
+			++exponent;
+		}
+
+		Utils::Byte::Set4Bytes(data, offset, RembIdentifier);
+		offset += 4;
+
+		data[offset]     = static_cast<uint8_t>(numSsrcs);
+		data[offset + 1] = (exponent << 2) | (mantissa >> 16);
+		Utils::Byte::Set2Bytes(data, offset + 2, mantissa & 0xFFFF);
+		offset += 4;
+
+		for (size_t i{ 0 }; i < numSsrcs; ++i)
+		{
+			Utils::Byte::Set4Bytes(data, offset, ssrcs[i]);
+			offset += 4;
+		}
+
+		writeCommonHeader(
+		    data,
+		    RTC::RTCP::Type::PSFB,
+		    static_cast<uint8_t>(RTC::RTCP::FeedbackPs::MessageType::AFB),
+		    offset);
+		Utils::Byte::Set4Bytes(data, 4, 0);
+		Utils::Byte::Set4Bytes(data, 8, 0);
+
+		this->listener->OnRtcpSchedulerPacket(this, data, offset);
+
+		this->numRembs++;
+	}
+
+	/**
+	 * RFC 3550 interval of a reporter, randomized over [0.5, 1.5] times the
+	 * deterministic one so reports do not get synchronized.
+	 */
+	uint64_t RtcpScheduler::GetInterval(uint16_t maxInterval) const
+	{
+		MS_TRACE();
+
+		uint64_t interval = maxInterval;
+		uint64_t kbps     = this->bitrate / 1000;
+
+		if (kbps != 0)
+		{
+			double rtcpBitrate = this->bitrate * RtcpBandwidthFraction;
+			auto members       = static_cast<double>(std::max(this->reporters.size(), size_t{ 1 }));
+			auto bandwidthInterval =
+			    static_cast<uint64_t>(members * this->avgPacketSize * 8 * 1000 / rtcpBitrate);
+
+			interval = std::max(bandwidthInterval, ReducedMinInterval / kbps);
+			interval = std::max(interval, MinInterval);
+			interval = std::min(interval, uint64_t{ maxInterval });
+		}
+
+		return interval * Utils::Crypto::GetRandomUInt(500, 1500) / 1000;
+	}
+
+	/**
+	 * Size of the compound packet being built.
+	 */
+	size_t RtcpScheduler::GetSize() const
+	{
+		size_t size = this->senderReportsSize;
+
+		if (this->receiverReportCount != 0)
+		{
+			size_t numPackets = (this->receiverReportCount + MaxReportCount - 1) / MaxReportCount;
+
+			size += numPackets * ReceiverReportPacketHeaderSize;
+			size += this->receiverReportCount * ReceiverReportSize;
+		}
+
+		if (this->sdesChunkCount != 0)
+			size += HeaderSize + this->sdesSize;
+		else if (this->cnameChunkSize != 0)
+			size += HeaderSize + this->cnameChunkSize;
+
+		return size;
+	}
+
+	/**
+	 * Completes the compound packet being built with the RR and SDES packets
+	 * and sends it.
+	 */
+	void RtcpScheduler::Flush()
+	{
+		MS_TRACE();
+
+		if (this->senderReportsSize == 0 && this->receiverReportCount == 0)
+			return;
+
+		size_t offset = this->senderReportsSize;
+
+		for (size_t i{ 0 }; i < this->receiverReportCount; i += MaxReportCount)
+		{
+			size_t count = std::min(this->receiverReportCount - i, MaxReportCount);
+			size_t size  = ReceiverReportPacketHeaderSize + count * ReceiverReportSize;
+
+			writeCommonHeader(
+			    CompoundBuffer + offset, RTC::RTCP::Type::RR, static_cast<uint8_t>(count), size);
+			Utils::Byte::Set4Bytes(CompoundBuffer, offset + 4, 0);
+			std::memcpy(
+			    CompoundBuffer + offset + ReceiverReportPacketHeaderSize,
+			    ReceiverReportsBuffer + i * ReceiverReportSize,
+			    count * ReceiverReportSize);
+
+			offset += size;
+		}
+
+		// No SR in this packet, repeat the CNAME of the last one.
+		if (this->sdesChunkCount == 0 && this->cnameChunkSize != 0)
+		{
+			std::memcpy(SdesBuffer, this->cnameChunk, this->cnameChunkSize);
+
+			this->sdesSize       = this->cnameChunkSize;
+			this->sdesChunkCount = 1;
+		}
+
+		if (this->sdesChunkCount != 0)
+		{
+			size_t size = HeaderSize + this->sdesSize;
+
+			writeCommonHeader(
+			    CompoundBuffer + offset,
+			    RTC::RTCP::Type::SDES,
+			    static_cast<uint8_t>(this->sdesChunkCount),
+			    size);
+			std::memcpy(
+			    CompoundBuffer + offset + HeaderSize,
+			    SdesBuffer,
+			    this->sdesSize);
+
+			offset += size;
+		}
+
+		this->senderReportsSize   = 0;
+		this->receiverReportCount = 0;
+		this->sdesSize            = 0;
+		this->sdesChunkCount      = 0;
+
+		// RFC 3550 avg_rtcp_size.
+		auto packetSize = static_cast<double>(offset + UdpIpOverhead);
+
+		if (this->numCompoundPackets == 0)
+			this->avgPacketSize = packetSize;
+		else
+			this->avgPacketSize += (packetSize - this->avgPacketSize) / 16;
+
+		this->numCompoundPackets++;
+
+		this->listener->OnRtcpSchedulerPacket(this, CompoundBuffer, offset);
+	}
+
+	void RtcpScheduler::MayRunTimer()
+	{
+		MS_TRACE();
+
+		if (this->reporters.empty())
+		{
+			this->timer.Stop();
+
+			return;
+		}
+
+		uint64_t now = DepLibUV::GetTime();
+		uint64_t nextReportAt{ UINT64_MAX };
+
+		for (auto& info : this->reporters)
+		{
+			nextReportAt = std::min(nextReportAt, info.nextReportAt);
+		}
+
+		this->timer.Start(nextReportAt > now ? nextReportAt - now : 0);
+	}
+
+	inline void RtcpScheduler::OnTimer(TimerWheel::Handle* /*handle*/)
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+
+		this->reporting = true;
+
+		for (size_t i{ 0 }; i < this->reporters.size(); ++i)
+		{
+			auto& info = this->reporters[i];
+
+			if (info.reporter == nullptr || info.nextReportAt > now + ReportGroupingWindow)
+				continue;
+
+			info.nextReportAt = now + GetInterval(info.maxInterval);
+
+			info.reporter->OnRtcpSchedulerReport(this, now);
+		}
+
+		this->reporting = false;
+
+		// Drop the reporters removed meanwhile.
+		this->reporters.erase(
+		    std::remove_if(
+		        this->reporters.begin(),
+		        this->reporters.end(),
+		        [](const ReporterInfo& info) { return info.reporter == nullptr; }),
+		    this->reporters.end());
+
+		Flush();
+		MayRunTimer();
+	}
+} // namespace RTC
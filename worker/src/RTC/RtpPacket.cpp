@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV
 
 #include "RTC/RtpPacket.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include <cstring> // std::memcpy()
 
@@ -12,6 +13,7 @@ namespace RTC
 	RtpPacket* RtpPacket::Parse(const uint8_t* data, size_t len)
 	{
 		MS_TRACE();
+		MS_LATENCY_PROBE(PARSE);
 
 		if (!RtpPacket::IsRtp(data, len))
 			return nullptr;
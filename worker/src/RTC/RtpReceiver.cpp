@@ -2,15 +2,23 @@
 // #define MS_LOG_DEV
 
 #include "RTC/RtpReceiver.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
+#include "Settings.hpp"
 #include "RTC/RTCP/FeedbackPsPli.hpp"
 #include "RTC/RTCP/FeedbackRtp.hpp"
-#include "RTC/RTCP/FeedbackRtpNack.hpp"
 #include "RTC/Transport.hpp"
+#include "RTC/VP9Filter.hpp"
 
 namespace RTC
 {
+	/* Static. */
+
+	// Data size limits of a packet tap.
+	static constexpr size_t MinPacketTapSize{ 65536 };
+	static constexpr size_t MaxPacketTapSize{ 67108864 };
+
 	/* Instance methods. */
 
 	RtpReceiver::RtpReceiver(
@@ -22,16 +30,28 @@ namespace RTC
 		if (this->kind == RTC::Media::Kind::AUDIO)
 			this->maxRtcpInterval = RTC::RTCP::MaxAudioIntervalMs;
 		else
-			this->maxRtcpInterval = RTC::RTCP::MaxAudioIntervalMs;
+			this->maxRtcpInterval = RTC::RTCP::MaxVideoIntervalMs;
+
+		this->feedbackAggregator = new RTC::RtcpFeedbackAggregator(
+		    this,
+		    Settings::configuration.nackAggregationWindow,
+		    Settings::configuration.keyFrameRequestMinInterval);
 	}
 
 	RtpReceiver::~RtpReceiver()
 	{
 		MS_TRACE();
 
+		if (this->transport != nullptr)
+			this->transport->GetRtcpScheduler()->RemoveReporter(this);
+
 		delete this->rtpParameters;
 
 		ClearRtpStreams();
+
+		delete this->feedbackAggregator;
+
+		delete this->packetTap;
 	}
 
 	void RtpReceiver::Destroy()
@@ -64,6 +84,10 @@ namespace RTC
 		static const Json::StaticString JsonStringRtpObjectEventEnabled{ "rtpObjectEventEnabled" };
 		static const Json::StaticString JsonStringRtpStreams{ "rtpStreams" };
 		static const Json::StaticString JsonStringRtpStream{ "rtpStream" };
+		static const Json::StaticString JsonStringFeedbackAggregator{ "feedbackAggregator" };
+		static const Json::StaticString JsonStringKeyFrameCaches{ "keyFrameCaches" };
+		static const Json::StaticString JsonStringSsrc{ "ssrc" };
+		static const Json::StaticString JsonStringRtpTap{ "rtpTap" };
 
 		Json::Value json(Json::objectValue);
 		Json::Value jsonRtpStreams(Json::arrayValue);
@@ -91,6 +115,25 @@ namespace RTC
 		}
 		json[JsonStringRtpStreams] = jsonRtpStreams;
 
+		json[JsonStringFeedbackAggregator] = this->feedbackAggregator->ToJson();
+
+		Json::Value jsonKeyFrameCaches(Json::arrayValue);
+
+		for (auto& kv : this->keyFrameCaches)
+		{
+			auto keyFrameCache     = kv.second;
+			auto jsonKeyFrameCache = keyFrameCache->ToJson();
+
+			jsonKeyFrameCache[JsonStringSsrc] = Json::UInt{ kv.first };
+			jsonKeyFrameCaches.append(jsonKeyFrameCache);
+		}
+		json[JsonStringKeyFrameCaches] = jsonKeyFrameCaches;
+
+		if (this->packetTap != nullptr)
+			json[JsonStringRtpTap] = this->packetTap->ToJson();
+		else
+			json[JsonStringRtpTap] = Json::nullValue;
+
 		return json;
 	}
 
@@ -161,6 +204,12 @@ namespace RTC
 				// Free previous RTP streams.
 				ClearRtpStreams();
 
+				// Resolve the codec of every payload type once.
+				for (auto& codec : this->rtpParameters->codecs)
+				{
+					this->codecSubtypes[codec.payloadType & 0x7F] = codec.mime.subtype;
+				}
+
 				auto data = this->rtpParameters->ToJson();
 
 				request->Accept(data);
@@ -174,6 +223,14 @@ namespace RTC
 					CreateRtpStream(encoding);
 				}
 
+				this->ridExtensionId = 0;
+
+				for (auto& exten : this->rtpParameters->headerExtensions)
+				{
+					if (exten.type == RTC::RtpHeaderExtensionUri::Type::RTP_STREAM_ID)
+						this->ridExtensionId = exten.id;
+				}
+
 				break;
 			}
 
@@ -221,6 +278,66 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::RTP_RECEIVER_SET_RTP_TAP:
+			{
+				static const Json::StaticString JsonStringEnabled{ "enabled" };
+				static const Json::StaticString JsonStringSize{ "size" };
+
+				if (!request->data[JsonStringEnabled].isBool())
+				{
+					request->Reject("Request has invalid data.enabled");
+
+					return;
+				}
+
+				if (!request->data[JsonStringEnabled].asBool())
+				{
+					delete this->packetTap;
+					this->packetTap = nullptr;
+
+					request->Accept();
+
+					return;
+				}
+
+				if (this->packetTap != nullptr)
+				{
+					request->Reject("RTP tap already enabled");
+
+					return;
+				}
+
+				auto& jsonSize = request->data[JsonStringSize];
+
+				if (!jsonSize.isUInt() || jsonSize.asUInt() < MinPacketTapSize ||
+				    jsonSize.asUInt() > MaxPacketTapSize)
+				{
+					request->Reject("Request has invalid data.size");
+
+					return;
+				}
+
+				try
+				{
+					this->packetTap = new RTC::PacketTap(jsonSize.asUInt());
+				}
+				catch (const MediaSoupError& error)
+				{
+					request->Reject(error.what());
+
+					return;
+				}
+
+				auto data = this->packetTap->ToJson();
+
+				request->Accept(data);
+
+				// Require a full frame.
+				this->RequestFullFrame();
+
+				break;
+			}
+
 			default:
 			{
 				MS_ERROR("unknown method");
@@ -230,88 +347,106 @@ namespace RTC
 		}
 	}
 
-	void RtpReceiver::ReceiveRtpPacket(RTC::RtpPacket* packet)
+	void RtpReceiver::SetTransport(RTC::Transport* transport)
 	{
 		MS_TRACE();
 
-		static const Json::StaticString JsonStringClass{ "class" };
-		static const Json::StaticString JsonStringObject{ "object" };
-		static const Json::StaticString JsonStringPayloadType{ "payloadType" };
-		static const Json::StaticString JsonStringMarker{ "marker" };
-		static const Json::StaticString JsonStringSequenceNumber{ "sequenceNumber" };
-		static const Json::StaticString JsonStringTimestamp{ "timestamp" };
-		static const Json::StaticString JsonStringSsrc{ "ssrc" };
+		if (this->transport != nullptr)
+			this->transport->GetRtcpScheduler()->RemoveReporter(this);
+
+		this->transport = transport;
+
+		if (this->transport != nullptr)
+			this->transport->GetRtcpScheduler()->AddReporter(this, this->maxRtcpInterval);
+	}
+
+	void RtpReceiver::RemoveTransport(RTC::Transport* transport)
+	{
+		MS_TRACE();
+
+		if (this->transport == nullptr || this->transport != transport)
+			return;
+
+		this->transport->GetRtcpScheduler()->RemoveReporter(this);
+		this->transport = nullptr;
+	}
+
+	void RtpReceiver::ReceiveRtpPacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
 
 		// TODO: Check if stopped, etc (not yet done).
 
 		// Find the corresponding RtpStreamRecv.
 		uint32_t ssrc = packet->GetSsrc();
 
-		if (this->rtpStreams.find(ssrc) == this->rtpStreams.end())
+		auto it = this->rtpStreams.find(ssrc);
+		RTC::RtpStreamRecv* rtpStream;
+
+		if (it != this->rtpStreams.end())
+			rtpStream = it->second;
+		else
+			rtpStream = CreateRtpStreamByRid(packet);
+
+		if (rtpStream == nullptr)
 		{
 			MS_WARN_TAG(rtp, "no RtpStream found for given RTP packet [ssrc:%" PRIu32 "]", ssrc);
 
 			return;
 		}
 
-		auto rtpStream = this->rtpStreams[ssrc];
-
 		// Process the packet.
 		// TODO: Must check what kind of packet we are checking. For example, RTX
 		// packets (once implemented) should have a different handling.
 		if (!rtpStream->ReceivePacket(packet))
 			return;
 
-		// Notify the listener.
-		this->listener->OnRtpPacket(this, packet);
-
-		// Emit "rtpraw" if enabled.
-		if (this->rtpRawEventEnabled)
-		{
-			Json::Value eventData(Json::objectValue);
+		// Feed the bandwidth estimation of the transport before the packet is
+		// forwarded.
+		if (this->transport != nullptr)
+			this->transport->ReceiveRtpPacketArrival(packet);
 
-			eventData[JsonStringClass] = "RtpReceiver";
+		if (GetCodecSubtype(packet->GetPayloadType()) == RTC::RtpCodecMime::Subtype::VP9)
+			UpdateSpatialLayerResolutions(packet);
 
-			this->notifier->EmitWithBinary(
-			    this->rtpReceiverId, "rtpraw", eventData, packet->GetData(), packet->GetSize());
-		}
+		// Feed the key frame cache before the listener may modify the packet.
+		auto it2 = this->keyFrameCaches.find(ssrc);
 
-		// Emit "rtpobject" is enabled.
-		if (this->rtpObjectEventEnabled)
+		if (it2 != this->keyFrameCaches.end())
 		{
-			Json::Value eventData(Json::objectValue);
-			Json::Value jsonObject(Json::objectValue);
+			auto keyFrameCache = it2->second;
 
-			eventData[JsonStringClass] = "RtpReceiver";
-
-			jsonObject[JsonStringPayloadType]    = Json::UInt{ packet->GetPayloadType() };
-			jsonObject[JsonStringMarker]         = packet->HasMarker();
-			jsonObject[JsonStringSequenceNumber] = Json::UInt{ packet->GetSequenceNumber() };
-			jsonObject[JsonStringTimestamp]      = Json::UInt{ packet->GetTimestamp() };
-			jsonObject[JsonStringSsrc]           = Json::UInt{ packet->GetSsrc() };
+			keyFrameCache->ReceivePacket(packet);
+		}
 
-			eventData[JsonStringObject] = jsonObject;
+		// Notify the listener.
+		this->listener->OnRtpPacket(this, packet);
 
-			this->notifier->EmitWithBinary(
-			    this->rtpReceiverId, "rtpobject", eventData, packet->GetPayload(), packet->GetPayloadLength());
+		// Copy it into the tap if enabled.
+		if (this->packetTap != nullptr)
+		{
+			this->packetTap->Write(
+			    this->rtpReceiverId, DepLibUV::GetTime(), packet->GetData(), packet->GetSize());
 		}
-	}
 
-	void RtpReceiver::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now)
-	{
-		if (static_cast<float>((now - this->lastRtcpSentTime) * 1.15) < this->maxRtcpInterval)
-			return;
+		// Emit "rtpraw" if enabled.
+		if (this->rtpRawEventEnabled)
+			this->notifier->EmitRtpRaw(this->rtpReceiverId, packet->GetData(), packet->GetSize());
 
-		for (auto& kv : this->rtpStreams)
+		// Emit "rtpobject" is enabled.
+		if (this->rtpObjectEventEnabled)
 		{
-			auto rtpStream = kv.second;
-			auto* report   = rtpStream->GetRtcpReceiverReport();
+			Channel::Notifier::RtpObject object;
 
-			report->SetSsrc(rtpStream->GetSsrc());
-			packet->AddReceiverReport(report);
-		}
+			object.payloadType    = packet->GetPayloadType();
+			object.marker         = packet->HasMarker();
+			object.sequenceNumber = packet->GetSequenceNumber();
+			object.timestamp      = packet->GetTimestamp();
+			object.ssrc           = packet->GetSsrc();
 
-		this->lastRtcpSentTime = now;
+			this->notifier->EmitRtpObject(
+			    this->rtpReceiverId, object, packet->GetPayload(), packet->GetPayloadLength());
+		}
 	}
 
 	void RtpReceiver::ReceiveRtcpFeedback(RTC::RTCP::FeedbackPsPacket* packet) const
@@ -321,6 +456,21 @@ namespace RTC
 		if (this->transport == nullptr)
 			return;
 
+		// Key frame requests from all the RtpSenders are rate limited.
+		switch (packet->GetMessageType())
+		{
+			case RTC::RTCP::FeedbackPs::MessageType::PLI:
+			case RTC::RTCP::FeedbackPs::MessageType::FIR:
+			{
+				if (!this->feedbackAggregator->ReceiveKeyFrameRequest(packet->GetMediaSsrc()))
+					return;
+
+				break;
+			}
+
+			default:;
+		}
+
 		// Ensure that the RTCP packet fits into the RTCP buffer.
 		if (packet->GetSize() > RTC::RTCP::BufferSize)
 		{
@@ -352,6 +502,16 @@ namespace RTC
 		this->transport->SendRtcpPacket(packet);
 	}
 
+	void RtpReceiver::ReceiveNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers) const
+	{
+		MS_TRACE();
+
+		if (this->rtpStreams.find(ssrc) == this->rtpStreams.end())
+			return;
+
+		this->feedbackAggregator->ReceiveNack(ssrc, seqNumbers);
+	}
+
 	void RtpReceiver::RequestFullFrame() const
 	{
 		MS_TRACE();
@@ -360,7 +520,41 @@ namespace RTC
 		{
 			auto rtpStream = kv.second;
 
-			rtpStream->RequestFullFrame();
+			if (this->feedbackAggregator->ReceiveKeyFrameRequest(rtpStream->GetSsrc()))
+				rtpStream->RequestFullFrame();
+		}
+	}
+
+	bool RtpReceiver::GetKeyFrame(uint32_t ssrc, std::vector<RTC::RtpPacket*>& packets) const
+	{
+		MS_TRACE();
+
+		auto it = this->keyFrameCaches.find(ssrc);
+
+		if (it == this->keyFrameCaches.end())
+			return false;
+
+		auto keyFrameCache = it->second;
+
+		return keyFrameCache->GetPackets(packets);
+	}
+
+	void RtpReceiver::FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->rtpStreams)
+		{
+			auto* rtpStream = kv.second;
+
+			snapshot.Add(
+			    this->rtpReceiverId,
+			    rtpStream->GetSsrc(),
+			    RTC::StatsSnapshot::Direction::RECEIVE,
+			    this->kind,
+			    RTC::StatsSnapshot::NoLayer,
+			    RTC::StatsSnapshot::NoLayer,
+			    rtpStream->GetStats(now));
 		}
 	}
 
@@ -386,8 +580,10 @@ namespace RTC
 		bool useNack{ false };
 		bool usePli{ false };
 		bool useRemb{ false };
+		bool useTransportCc{ false };
 		uint8_t ssrcAudioLevelId{ 0 };
 		uint8_t absSendTimeId{ 0 };
+		uint8_t transportWideCc01Id{ 0 };
 
 		for (auto& fb : codec.rtcpFeedback)
 		{
@@ -409,6 +605,12 @@ namespace RTC
 
 				useRemb = true;
 			}
+			else if (!useTransportCc && fb.type == "transport-cc")
+			{
+				MS_DEBUG_TAG(rbe, "enabling transport-cc feedback");
+
+				useTransportCc = true;
+			}
 		}
 
 		for (auto& exten : this->rtpParameters->headerExtensions)
@@ -423,26 +625,46 @@ namespace RTC
 			{
 				absSendTimeId = exten.id;
 			}
+
+			if (
+			    (transportWideCc01Id == 0u) &&
+			    exten.type == RTC::RtpHeaderExtensionUri::Type::TRANSPORT_WIDE_CC_01)
+			{
+				transportWideCc01Id = exten.id;
+			}
 		}
 
 		// Create stream params.
 		RTC::RtpStream::Params params;
 
-		params.ssrc             = ssrc;
-		params.payloadType      = codec.payloadType;
-		params.mime             = codec.mime;
-		params.clockRate        = codec.clockRate;
-		params.useNack          = useNack;
-		params.usePli           = usePli;
-		params.ssrcAudioLevelId = ssrcAudioLevelId;
-		params.absSendTimeId    = absSendTimeId;
+		params.ssrc                = ssrc;
+		params.payloadType         = codec.payloadType;
+		params.mime                = codec.mime;
+		params.clockRate           = codec.clockRate;
+		params.useNack             = useNack;
+		params.usePli              = usePli;
+		params.ssrcAudioLevelId    = ssrcAudioLevelId;
+		params.absSendTimeId       = absSendTimeId;
+		params.transportWideCc01Id = transportWideCc01Id;
 
 		// Create a RtpStreamRecv for receiving a media stream.
 		this->rtpStreams[ssrc] = new RTC::RtpStreamRecv(this, params);
 
+		// Create a KeyFrameCache if enabled and the codec allows detecting key frames.
+		if (Settings::configuration.keyFrameCacheSize != 0u &&
+		    codec.mime.subtype == RTC::RtpCodecMime::Subtype::VP9)
+		{
+			this->keyFrameCaches[ssrc] = new RTC::KeyFrameCache(Settings::configuration.keyFrameCacheSize);
+		}
+
 		// Enable REMB in the transport if requested.
 		if (useRemb)
 			this->transport->EnableRemb();
+
+		// Enable transport-cc feedback in the transport if requested and the
+		// transport-wide sequence number is present.
+		if (useTransportCc && transportWideCc01Id != 0u)
+			this->transport->EnableTransportCc();
 	}
 
 	void RtpReceiver::ClearRtpStreams()
@@ -457,55 +679,129 @@ namespace RTC
 		}
 
 		this->rtpStreams.clear();
+
+		for (auto& kv : this->keyFrameCaches)
+		{
+			auto keyFrameCache = kv.second;
+
+			delete keyFrameCache;
+		}
+
+		this->keyFrameCaches.clear();
+
+		this->feedbackAggregator->Clear();
+
+		for (auto& codecSubtype : this->codecSubtypes)
+		{
+			codecSubtype = RTC::RtpCodecMime::Subtype::UNSET;
+		}
+
+		this->spatialLayerResolutions.clear();
 	}
 
-	void RtpReceiver::OnNackRequired(RTC::RtpStreamRecv* rtpStream, const std::vector<uint16_t>& seqNumbers)
+	/**
+	 * Creates the RtpStreamRecv of a simulcast encoding signaled by RID once its
+	 * first packet arrives, and stores the SSRC into the encoding.
+	 */
+	RTC::RtpStreamRecv* RtpReceiver::CreateRtpStreamByRid(RTC::RtpPacket* packet)
 	{
-		if (this->transport == nullptr)
-			return;
+		MS_TRACE();
+
+		if (this->rtpParameters == nullptr || this->ridExtensionId == 0u)
+			return nullptr;
 
-		RTC::RTCP::FeedbackRtpNackPacket packet(0, rtpStream->GetSsrc());
-		auto it        = seqNumbers.begin();
-		const auto end = seqNumbers.end();
+		uint8_t* extenValue;
+		uint8_t extenLen;
 
-		while (it != end)
+		packet->AddExtensionMapping(RTC::RtpHeaderExtensionUri::Type::RTP_STREAM_ID, this->ridExtensionId);
+		extenValue = packet->GetExtension(RTC::RtpHeaderExtensionUri::Type::RTP_STREAM_ID, &extenLen);
+
+		if (extenValue == nullptr || extenLen == 0u)
+			return nullptr;
+
+		std::string rid(reinterpret_cast<const char*>(extenValue), extenLen);
+
+		for (auto& encoding : this->rtpParameters->encodings)
 		{
-			uint16_t seq;
-			uint16_t bitmask{ 0 };
+			if (encoding.ssrc != 0u || encoding.encodingId != rid)
+				continue;
 
-			seq = *it;
-			++it;
+			MS_DEBUG_TAG(
+			    rtp, "RTP stream id matched [rid:'%s', ssrc:%" PRIu32 "]", rid.c_str(), packet->GetSsrc());
 
-			while (it != end)
-			{
-				uint16_t shift = *it - seq - 1;
+			encoding.ssrc = packet->GetSsrc();
 
-				if (shift <= 15)
-				{
-					bitmask |= (1 << shift);
-					++it;
-				}
-				else
-				{
-					break;
-				}
-			}
+			CreateRtpStream(encoding);
 
-			auto nackItem = new RTC::RTCP::FeedbackRtpNackItem(seq, bitmask);
+			auto it = this->rtpStreams.find(encoding.ssrc);
 
-			packet.AddItem(nackItem);
+			return it != this->rtpStreams.end() ? it->second : nullptr;
 		}
 
-		// Ensure that the RTCP packet fits into the RTCP buffer.
-		if (packet.GetSize() > RTC::RTCP::BufferSize)
+		return nullptr;
+	}
+
+	/**
+	 * Keeps the spatial layer resolutions of the scalability structure so the
+	 * RtpSenders do not need to parse it.
+	 */
+	void RtpReceiver::UpdateSpatialLayerResolutions(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		// The scalability structure is only present (V bit) in key frames.
+		if (packet->GetPayloadLength() == 0 || (packet->GetPayload()[0] & 0x02) == 0)
+			return;
+
+		VP9::VP9PayloadDescription desc;
+
+		if (!desc.Parse(packet->GetPayload(), packet->GetPayloadLength()))
 		{
-			MS_WARN_TAG(rtx, "cannot send RTCP NACK packet, size too big (%zu bytes)", packet.GetSize());
+			MS_WARN_TAG(rtp, "invalid VP9 payload descriptor");
 
 			return;
 		}
 
-		packet.Serialize(RTC::RTCP::Buffer);
-		this->transport->SendRtcpPacket(&packet);
+		auto& scalabilityStructure = desc.scalabilityStructure;
+
+		if (!scalabilityStructure.spatialLayerFrameResolutionPresent ||
+		    scalabilityStructure.spatialLayerFrameResolutions == this->spatialLayerResolutions)
+		{
+			return;
+		}
+
+		this->spatialLayerResolutions = scalabilityStructure.spatialLayerFrameResolutions;
+
+		for (size_t spatialLayer{ 0 }; spatialLayer < this->spatialLayerResolutions.size(); ++spatialLayer)
+		{
+			MS_DEBUG_TAG(
+			    rtp,
+			    "VP9 spatial layer resolution [ssrc:%" PRIu32 ", layer:%zu, width:%" PRIu16
+			    ", height:%" PRIu16 "]",
+			    packet->GetSsrc(),
+			    spatialLayer,
+			    this->spatialLayerResolutions[spatialLayer].first,
+			    this->spatialLayerResolutions[spatialLayer].second);
+		}
+	}
+
+	void RtpReceiver::SendNack(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers) const
+	{
+		MS_TRACE();
+
+		if (this->transport == nullptr)
+			return;
+
+		this->transport->GetRtcpScheduler()->SendNack(ssrc, seqNumbers);
+	}
+
+	void RtpReceiver::OnNackRequired(RTC::RtpStreamRecv* rtpStream, const std::vector<uint16_t>& seqNumbers)
+	{
+		// Let the aggregator know so NACKs from RtpSenders for the same packets
+		// are not sent upstream again.
+		this->feedbackAggregator->RegisterSentNack(rtpStream->GetSsrc(), seqNumbers);
+
+		SendNack(rtpStream->GetSsrc(), seqNumbers);
 	}
 
 	void RtpReceiver::OnPliRequired(RTC::RtpStreamRecv* rtpStream)
@@ -513,6 +809,8 @@ namespace RTC
 		if (this->transport == nullptr)
 			return;
 
+		this->feedbackAggregator->RegisterSentKeyFrameRequest(rtpStream->GetSsrc());
+
 		RTC::RTCP::FeedbackPsPliPacket packet(0, rtpStream->GetSsrc());
 
 		packet.Serialize(RTC::RTCP::Buffer);
@@ -521,4 +819,41 @@ namespace RTC
 		this->transport->SendRtcpPacket(&packet);
 		this->transport->SendRtcpPacket(&packet);
 	}
+
+	void RtpReceiver::OnAggregatedNackRequired(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers)
+	{
+		MS_TRACE();
+
+		SendNack(ssrc, seqNumbers);
+	}
+
+	void RtpReceiver::OnAggregatedKeyFrameRequired(uint32_t ssrc)
+	{
+		MS_TRACE();
+
+		auto it = this->rtpStreams.find(ssrc);
+
+		if (it == this->rtpStreams.end())
+			return;
+
+		auto rtpStream = it->second;
+
+		rtpStream->RequestFullFrame();
+	}
+
+	void RtpReceiver::OnRtcpSchedulerReport(RTC::RtcpScheduler* rtcpScheduler, uint64_t /*now*/)
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->rtpStreams)
+		{
+			auto* rtpStream = kv.second;
+			RTC::RTCP::ReceiverReport report;
+
+			rtpStream->FillRtcpReceiverReport(&report);
+			report.SetSsrc(rtpStream->GetSsrc());
+
+			rtcpScheduler->AddReceiverReport(&report);
+		}
+	}
 } // namespace RTC
@@ -2,11 +2,16 @@
 // #define MS_LOG_DEV
 
 #include "RTC/RtpSender.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
+#include "Settings.hpp"
 #include "Utils.hpp"
-#include "RTC/RTCP/FeedbackRtpNack.hpp"
+#include "RTC/Codecs/Handlers.hpp"
+#include "RTC/Codecs/Tools.hpp"
+#include "RTC/Codecs/VP8.hpp"
 #include "RTC/RTCP/SenderReport.hpp"
+#include <algorithm> // std::min()
 #include <vector>
 
 namespace RTC
@@ -14,6 +19,46 @@ namespace RTC
 	/* Static. */
 
 	static std::vector<RTC::RtpPacket*> RtpRetransmissionContainer(18);
+	// Period of the VP9 layer (or simulcast encoding) bitrates measurement.
+	static constexpr uint64_t LayerBitratesInterval{ 1000 }; // In ms.
+	// Minimum time between key frame requests while waiting to switch the
+	// simulcast encoding.
+	static constexpr uint64_t KeyFrameRequestInterval{ 1000 }; // In ms.
+	static constexpr uint8_t NoEncoding{ 0xFF };
+	// Number of recent sequence numbers whose offset is remembered. Must be a
+	// power of two.
+	static constexpr size_t SeqHistorySize{ 512 };
+
+	/* Class methods. */
+
+	/**
+	 * Lowest spatial layer (up to the given one) whose resolution covers the
+	 * given size. The given one if none does or if the size is 0x0 (unknown).
+	 */
+	uint8_t RtpSender::GetSpatialLayerForSize(
+	    const std::vector<std::pair<uint16_t, uint16_t>>& resolutions,
+	    uint16_t width,
+	    uint16_t height,
+	    uint8_t maxSpatialLayer)
+	{
+		MS_TRACE();
+
+		if (width == 0u && height == 0u)
+			return maxSpatialLayer;
+
+		for (uint8_t spatialLayer{ 0 }; spatialLayer < maxSpatialLayer; ++spatialLayer)
+		{
+			if (spatialLayer >= resolutions.size())
+				break;
+
+			auto& resolution = resolutions[spatialLayer];
+
+			if (resolution.first >= width && resolution.second >= height)
+				return spatialLayer;
+		}
+
+		return maxSpatialLayer;
+	}
 
 	/* Instance methods. */
 
@@ -27,14 +72,24 @@ namespace RTC
 			this->maxRtcpInterval = RTC::RTCP::MaxAudioIntervalMs;
 		else
 			this->maxRtcpInterval = RTC::RTCP::MaxVideoIntervalMs;
+
+		// The settings give the default preferred VP9 layers.
+		SetPreferredLayers(
+		    static_cast<uint8_t>(Settings::configuration.vp9MinSpartial),
+		    static_cast<uint8_t>(Settings::configuration.vp9MinTemporial));
 	}
 
 	RtpSender::~RtpSender()
 	{
 		MS_TRACE();
 
+		if (this->transport != nullptr)
+			this->transport->GetRtcpScheduler()->RemoveReporter(this);
+
 		delete this->rtpParameters;
 		delete this->rtpStream;
+		delete this->layerSelector;
+		delete this->vp8LayerSelector;
 	}
 
 	void RtpSender::Destroy()
@@ -65,6 +120,20 @@ namespace RTC
 		static const Json::StaticString JsonStringActive{ "active" };
 		static const Json::StaticString JsonStringSupportedPayloadTypes{ "supportedPayloadTypes" };
 		static const Json::StaticString JsonStringRtpStream{ "rtpStream" };
+		static const Json::StaticString JsonStringLayers{ "layers" };
+		static const Json::StaticString JsonStringPreferredSpatialLayer{ "preferredSpatialLayer" };
+		static const Json::StaticString JsonStringPreferredTemporalLayer{ "preferredTemporalLayer" };
+		static const Json::StaticString JsonStringTargetSpatialLayer{ "targetSpatialLayer" };
+		static const Json::StaticString JsonStringTargetTemporalLayer{ "targetTemporalLayer" };
+		static const Json::StaticString JsonStringPacketsDropped{ "packetsDropped" };
+		static const Json::StaticString JsonStringPinned{ "pinned" };
+		static const Json::StaticString JsonStringActiveSpeaker{ "activeSpeaker" };
+		static const Json::StaticString JsonStringMaxWidth{ "maxWidth" };
+		static const Json::StaticString JsonStringMaxHeight{ "maxHeight" };
+		static const Json::StaticString JsonStringMaxSpatialLayer{ "maxSpatialLayer" };
+		static const Json::StaticString JsonStringSimulcast{ "simulcast" };
+		static const Json::StaticString JsonStringPaused{ "paused" };
+		static const Json::StaticString JsonStringVirtual{ "virtual" };
 
 		Json::Value json(Json::objectValue);
 
@@ -91,6 +160,30 @@ namespace RTC
 		if (this->rtpStream != nullptr)
 			json[JsonStringRtpStream] = this->rtpStream->ToJson();
 
+		json[JsonStringSimulcast] = this->simulcast;
+
+		json[JsonStringPaused] = !this->forwarding;
+
+		json[JsonStringVirtual] = this->isVirtual;
+
+		if (HasLayers())
+		{
+			Json::Value jsonLayers(Json::objectValue);
+
+			jsonLayers[JsonStringPreferredSpatialLayer]  = Json::UInt{ this->preferredSpatialLayer };
+			jsonLayers[JsonStringPreferredTemporalLayer] = Json::UInt{ this->preferredTemporalLayer };
+			jsonLayers[JsonStringTargetSpatialLayer]     = Json::UInt{ this->targetSpatialLayer };
+			jsonLayers[JsonStringTargetTemporalLayer]    = Json::UInt{ this->targetTemporalLayer };
+			jsonLayers[JsonStringPacketsDropped]         = Json::UInt64{ this->layerPacketsDropped };
+			jsonLayers[JsonStringPinned]                 = this->pinned;
+			jsonLayers[JsonStringActiveSpeaker]          = this->activeSpeaker;
+			jsonLayers[JsonStringMaxWidth]               = Json::UInt{ this->maxWidth };
+			jsonLayers[JsonStringMaxHeight]              = Json::UInt{ this->maxHeight };
+			jsonLayers[JsonStringMaxSpatialLayer]        = Json::UInt{ GetMaxSpatialLayer() };
+
+			json[JsonStringLayers] = jsonLayers;
+		}
+
 		return json;
 	}
 
@@ -153,6 +246,80 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::RTP_SENDER_SET_PREFERRED_LAYERS:
+			{
+				static const Json::StaticString JsonStringSpatialLayer{ "spatialLayer" };
+				static const Json::StaticString JsonStringTemporalLayer{ "temporalLayer" };
+
+				if (!request->data[JsonStringSpatialLayer].isUInt())
+				{
+					request->Reject("Request has invalid data.spatialLayer");
+
+					return;
+				}
+
+				if (!request->data[JsonStringTemporalLayer].isUInt())
+				{
+					request->Reject("Request has invalid data.temporalLayer");
+
+					return;
+				}
+
+				SetPreferredLayers(
+				    static_cast<uint8_t>(std::min(request->data[JsonStringSpatialLayer].asUInt(), 0xFFu)),
+				    static_cast<uint8_t>(std::min(request->data[JsonStringTemporalLayer].asUInt(), 0xFFu)));
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::RTP_SENDER_SET_PINNED:
+			{
+				static const Json::StaticString JsonStringPinned{ "pinned" };
+
+				if (!request->data[JsonStringPinned].isBool())
+				{
+					request->Reject("Request has invalid data.pinned");
+
+					return;
+				}
+
+				SetPinned(request->data[JsonStringPinned].asBool());
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::RTP_SENDER_SET_MAX_RESOLUTION:
+			{
+				static const Json::StaticString JsonStringWidth{ "width" };
+				static const Json::StaticString JsonStringHeight{ "height" };
+
+				if (!request->data[JsonStringWidth].isUInt())
+				{
+					request->Reject("Request has invalid data.width");
+
+					return;
+				}
+
+				if (!request->data[JsonStringHeight].isUInt())
+				{
+					request->Reject("Request has invalid data.height");
+
+					return;
+				}
+
+				SetMaxResolution(
+				    static_cast<uint16_t>(std::min(request->data[JsonStringWidth].asUInt(), 0xFFFFu)),
+				    static_cast<uint16_t>(std::min(request->data[JsonStringHeight].asUInt(), 0xFFFFu)));
+
+				request->Accept();
+
+				break;
+			}
+
 			default:
 			{
 				MS_ERROR("unknown method");
@@ -195,6 +362,20 @@ namespace RTC
 			this->rtpStream = nullptr;
 		}
 
+		// Delete previous VP9 layer selector (if any).
+		if (this->layerSelector != nullptr)
+		{
+			delete this->layerSelector;
+			this->layerSelector = nullptr;
+		}
+
+		// Delete previous VP8 layer selector (if any).
+		if (this->vp8LayerSelector != nullptr)
+		{
+			delete this->vp8LayerSelector;
+			this->vp8LayerSelector = nullptr;
+		}
+
 		// Clone given RTP parameters so we manage our own sender parameters.
 		this->rtpParameters = new RTC::RtpParameters(rtpParameters);
 
@@ -244,8 +425,8 @@ namespace RTC
 			}
 		}
 
-		// TODO: Temporal. To be refactored.
-		// Remove all the encodings but the first one.
+		// A single stream is sent to the remote Peer. With simulcast the encoding
+		// being forwarded is switched on key frames and sent with its SSRC.
 		if (encodings.size() > 1)
 		{
 			RTC::RtpEncodingParameters encoding = encodings[0];
@@ -254,6 +435,28 @@ namespace RTC
 			encodings.push_back(encoding);
 		}
 
+		this->receiverRtpParameters = rtpParameters;
+		this->simulcast             = false;
+		this->currentEncodingIdx    = NoEncoding;
+
+		if (
+		    this->kind == RTC::Media::Kind::VIDEO && rtpParameters->encodings.size() > 1 &&
+		    !encodings.empty())
+		{
+			auto& codec = this->rtpParameters->GetCodecForEncoding(encodings[0]);
+
+			if (RTC::Codecs::Tools::CanDetectKeyFrames(codec.mime))
+			{
+				this->simulcast = true;
+
+				// Encodings signaled by RID have no SSRC.
+				if (encodings[0].ssrc == 0u)
+					encodings[0].ssrc = Utils::Crypto::GetRandomUInt(100000000, 999999999);
+
+				encodings[0].encodingId.clear();
+			}
+		}
+
 		// Remove unsupported header extensions.
 		this->rtpParameters->ReduceHeaderExtensions(this->peerCapabilities->headerExtensions);
 
@@ -295,10 +498,24 @@ namespace RTC
 
 		MS_ASSERT(this->rtpStream, "no RtpStream set");
 
-		// TODO: Must refactor for simulcast.
+		(this->*forwardRtpPacket)(packet);
+	}
+
+	/**
+	 * Send pipeline specialized for the codec handler, so there is no branching
+	 * on the codec for every packet.
+	 */
+	template<typename Handler>
+	void RtpSender::ForwardRtpPacket(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
 		// Ignore the packet if the SSRC is not the single one in the sender
-		// RTP parameters.
-		if (packet->GetSsrc() != this->rtpParameters->encodings[0].ssrc)
+		// RTP parameters (unless it belongs to a simulcast encoding or this is a
+		// virtual stream).
+		if (
+		    (Handler::IsAudio || !this->simulcast) && !this->isVirtual &&
+		    packet->GetSsrc() != this->rtpParameters->encodings[0].ssrc)
 		{
 			MS_WARN_TAG(rtp, "ignoring packet with unknown SSRC [ssrc:%" PRIu32 "]", packet->GetSsrc());
 
@@ -319,50 +536,160 @@ namespace RTC
 			return;
 		}
 
+		// Parse the VP8 payload descriptor once.
+		RTC::Codecs::VP8::PayloadDescriptor vp8Descriptor;
+		bool hasVp8Descriptor =
+		    Handler::HasVP8Descriptor &&
+		    payloadType == this->rtpParameters->encodings[0].codecPayloadType &&
+		    vp8Descriptor.Parse(packet->GetPayload(), packet->GetPayloadLength());
+		uint8_t temporalLayer = hasVp8Descriptor ? vp8Descriptor.tlIndex : 0;
+
+		// Forward just the packets of the selected simulcast encoding.
+		if (!Handler::IsAudio && this->simulcast && !SelectEncoding(packet, temporalLayer))
+			return;
+
+		// Video paused by the Room (last-N) stops and resumes at frame boundaries.
+		if (!Handler::IsAudio && !ApplyPause(packet))
+			return;
+
+		// Continue from the last sent packet if the stream was paused.
+		if (this->syncRequired)
+		{
+			this->syncRequired = false;
+
+			ContinueFrom(packet);
+
+			if (this->vp8LayerSelector != nullptr)
+				this->vp8LayerSelector->Resync();
+		}
+
+		// The packet is shared with other RtpSenders, so restore its original
+		// values once sent.
+		uint32_t ssrc      = packet->GetSsrc();
+		uint16_t seq       = packet->GetSequenceNumber();
+		uint32_t seq32     = packet->GetExtendedSequenceNumber();
+		uint32_t timestamp = packet->GetTimestamp();
+		bool marker        = packet->HasMarker();
+		uint16_t wideSeqNumber;
+		bool hasWideSeqNumber = packet->ReadTransportWideCc01(&wideSeqNumber);
+
+		uint16_t pictureId{ 0 };
+		uint8_t tl0PicIdx{ 0 };
+		bool sentMarker{ marker };
+
+		// Drop the VP9 (or VP8) layers above the target ones, keeping the sequence
+		// numbers consecutive.
+		bool drop =
+		    (Handler::HasVP9Descriptor && this->layerSelector != nullptr &&
+		     !SelectLayers(packet, sentMarker)) ||
+		    (hasVp8Descriptor && !SelectVP8Layers(packet, vp8Descriptor, pictureId, tl0PicIdx));
+		uint16_t mappedSeq;
+
+		if (!MapSequenceNumber(seq, drop, mappedSeq))
+		{
+			if (drop)
+				this->layerPacketsDropped++;
+
+			return;
+		}
+
+		packet->SetSsrc(this->rtpParameters->encodings[0].ssrc);
+		packet->SetSequenceNumber(mappedSeq);
+		packet->SetTimestamp(timestamp + this->timestampOffset);
+		packet->SetMarker(sentMarker);
+
+		// Keep the VP8 picture IDs consecutive.
+		bool rewritePictureId =
+		    hasVp8Descriptor && (vp8Descriptor.hasPictureId || vp8Descriptor.hasTl0PicIdx);
+
+		if (rewritePictureId)
+			vp8Descriptor.Encode(packet->GetPayload(), pictureId, tl0PicIdx);
+
 		// Process the packet.
 		// TODO: Must check what kind of packet we are checking. For example, RTX
 		// packets (once implemented) should have a different handling.
-		if (!this->rtpStream->ReceivePacket(packet))
-			return;
+		if (this->rtpStream->ReceivePacket(packet))
+		{
+			// Send the packet. Audio is never delayed by the pacer.
+			if (Handler::IsAudio)
+				this->transport->SendRtpPacket(packet, RTC::Pacer::Priority::AUDIO);
+			else if (this->sendingKeyFrame)
+				this->transport->SendRtpPacket(packet, RTC::Pacer::Priority::KEY_FRAME);
+			else
+				this->transport->SendRtpPacket(packet, RTC::Pacer::Priority::VIDEO);
 
-		// Send the packet.
-		this->transport->SendRtpPacket(packet);
+			// Save RTP data.
+			this->transmittedCounter.Update(packet);
+
+			uint16_t sentSeq = packet->GetSequenceNumber();
+
+			if (!this->sentAnyPacket || static_cast<uint16_t>(sentSeq - this->lastSentSeq) < 0x8000)
+			{
+				this->sentAnyPacket     = true;
+				this->lastSentSeq       = sentSeq;
+				this->lastSentTimestamp = packet->GetTimestamp();
+				this->lastSentAt        = DepLibUV::GetTime();
+			}
+		}
+
+		packet->SetSsrc(ssrc);
+		packet->SetSequenceNumber(seq);
+		packet->SetExtendedSequenceNumber(seq32);
+		packet->SetTimestamp(timestamp);
+		packet->SetMarker(marker);
+
+		// The transport rewrites the transport-wide sequence number.
+		if (hasWideSeqNumber)
+			packet->UpdateTransportWideCc01(wideSeqNumber);
 
-		// Save RTP data.
-		this->transmittedCounter.Update(packet);
+		if (rewritePictureId)
+		{
+			vp8Descriptor.Encode(
+			    packet->GetPayload(), vp8Descriptor.pictureId, vp8Descriptor.tl0PicIdx);
+		}
 	}
 
-	void RtpSender::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now)
+	/**
+	 * Sends the packets of a cached key frame (and those following it). If
+	 * packets were already sent, sequence numbers and timestamps are shifted so
+	 * they continue from the last sent ones, and so will the following packets.
+	 * They are spread over time by the pacer of the Transport.
+	 */
+	void RtpSender::SendKeyFrame(const std::vector<RTC::RtpPacket*>& packets)
 	{
-		if (this->rtpStream == nullptr)
-			return;
+		MS_TRACE();
 
-		if (static_cast<float>((now - this->lastRtcpSentTime) * 1.15) < this->maxRtcpInterval)
+		if (!this->GetActive() || packets.empty())
 			return;
 
-		auto* report = this->rtpStream->GetRtcpSenderReport(now);
-		if (report == nullptr)
-			return;
+		ContinueFrom(packets.front());
 
-		// NOTE: This assumes a single stream.
-		uint32_t ssrc     = this->rtpParameters->encodings[0].ssrc;
-		std::string cname = this->rtpParameters->rtcp.cname;
+		if (this->vp8LayerSelector != nullptr)
+			this->vp8LayerSelector->Resync();
 
-		report->SetSsrc(ssrc);
-		packet->AddSenderReport(report);
+		MS_DEBUG_TAG(
+		    rtp,
+		    "sending cached key frame [ssrc:%" PRIu32 ", packets:%zu]",
+		    packets.front()->GetSsrc(),
+		    packets.size());
 
-		// Build SDES chunk for this sender.
-		auto sdesChunk = new RTC::RTCP::SdesChunk(ssrc);
-		auto sdesItem =
-		    new RTC::RTCP::SdesItem(RTC::RTCP::SdesItem::Type::CNAME, cname.size(), cname.c_str());
+		this->sendingKeyFrame = true;
 
-		sdesChunk->AddItem(sdesItem);
-		packet->AddSdesChunk(sdesChunk);
+		for (auto* packet : packets)
+		{
+			SendRtpPacket(packet);
+		}
 
-		this->lastRtcpSentTime = now;
+		this->sendingKeyFrame = false;
 	}
 
-	void RtpSender::ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket)
+	/**
+	 * Retransmits the requested packets found in the local storage. Those not
+	 * found are appended to missingSeqNumbers, in the sequence number space of
+	 * the associated RtpReceiver, so they can be requested upstream.
+	 */
+	void RtpSender::ReceiveNack(
+	    const RTC::RTCP::PacketView& nackPacket, std::vector<uint16_t>& missingSeqNumbers)
 	{
 		MS_TRACE();
 
@@ -373,12 +700,14 @@ namespace RTC
 			return;
 		}
 
-		for (auto it = nackPacket->Begin(); it != nackPacket->End(); ++it)
+		for (size_t i{ 0 }; i < nackPacket.GetNackItemCount(); ++i)
 		{
-			RTC::RTCP::FeedbackRtpNackItem* item = *it;
+			uint16_t seq     = nackPacket.GetNackPacketId(i);
+			uint16_t bitmask = nackPacket.GetNackLostPacketBitmask(i);
+			// Bit 0 is the packet id itself, bits 1..16 come from the bitmask.
+			uint32_t missingMask = 1u | (uint32_t{ bitmask } << 1);
 
-			this->rtpStream->RequestRtpRetransmission(
-			    item->GetPacketId(), item->GetLostPacketBitmask(), RtpRetransmissionContainer);
+			this->rtpStream->RequestRtpRetransmission(seq, bitmask, RtpRetransmissionContainer);
 
 			auto it2 = RtpRetransmissionContainer.begin();
 			for (; it2 != RtpRetransmissionContainer.end(); ++it2)
@@ -388,8 +717,25 @@ namespace RTC
 				if (packet == nullptr)
 					break;
 
+				uint16_t shift = packet->GetSequenceNumber() - seq;
+
+				if (shift <= 16)
+					missingMask &= ~(1u << shift);
+
 				RetransmitRtpPacket(packet);
 			}
+
+			// Sequence numbers do not map to the RtpReceiver ones once layers
+			// have been dropped, several simulcast encodings have been sent or
+			// this is a virtual stream.
+			if (this->layerPacketsDropped != 0u || this->simulcast || this->isVirtual)
+				continue;
+
+			for (uint16_t shift{ 0 }; missingMask != 0u; ++shift, missingMask >>= 1)
+			{
+				if ((missingMask & 1u) != 0u)
+					missingSeqNumbers.push_back(seq + shift - this->seqOffset);
+			}
 		}
 	}
 
@@ -407,6 +753,42 @@ namespace RTC
 		this->rtpStream->ReceiveRtcpReceiverReport(report);
 	}
 
+	void RtpSender::ReceiveKeyFrameRequest()
+	{
+		MS_TRACE();
+
+		if (this->rtpStream == nullptr)
+			return;
+
+		this->rtpStream->ReceiveKeyFrameRequest();
+	}
+
+	void RtpSender::FillStats(RTC::StatsSnapshot& snapshot, uint64_t now) const
+	{
+		MS_TRACE();
+
+		if (this->rtpStream == nullptr)
+			return;
+
+		uint8_t spatialLayer{ RTC::StatsSnapshot::NoLayer };
+		uint8_t temporalLayer{ RTC::StatsSnapshot::NoLayer };
+
+		if (HasLayers())
+		{
+			spatialLayer  = this->targetSpatialLayer;
+			temporalLayer = this->targetTemporalLayer;
+		}
+
+		snapshot.Add(
+		    this->rtpSenderId,
+		    this->rtpStream->GetSsrc(),
+		    RTC::StatsSnapshot::Direction::SEND,
+		    this->kind,
+		    spatialLayer,
+		    temporalLayer,
+		    this->rtpStream->GetStats(now));
+	}
+
 	void RtpSender::CreateRtpStream(RTC::RtpEncodingParameters& encoding)
 	{
 		MS_TRACE();
@@ -461,11 +843,72 @@ namespace RTC
 		params.ssrcAudioLevelId = ssrcAudioLevelId;
 		params.absSendTimeId    = absSendTimeId;
 
-		// Create a RtpStreamSend for sending a single media stream.
-		if (useNack)
+		// Create a RtpStreamSend for sending a single media stream. Audio is not
+		// retransmitted so its packets are not stored.
+		if (useNack && this->kind == RTC::Media::Kind::VIDEO)
 			this->rtpStream = new RTC::RtpStreamSend(params, 750);
 		else
 			this->rtpStream = new RTC::RtpStreamSend(params, 0);
+
+		this->mime = codec.mime;
+
+		// Resolve the codec handler and select the layers (or simulcast encoding)
+		// sent to this peer.
+		switch (codec.mime.subtype)
+		{
+			case RTC::RtpCodecMime::Subtype::OPUS:
+			{
+				this->forwardRtpPacket = &RtpSender::ForwardRtpPacket<RTC::Codecs::OpusHandler>;
+
+				break;
+			}
+
+			case RTC::RtpCodecMime::Subtype::VP8:
+			{
+				this->forwardRtpPacket = &RtpSender::ForwardRtpPacket<RTC::Codecs::VP8Handler>;
+				this->vp8LayerSelector = new RTC::Codecs::VP8::LayerSelector();
+
+				break;
+			}
+
+			case RTC::RtpCodecMime::Subtype::VP9:
+			{
+				this->forwardRtpPacket = &RtpSender::ForwardRtpPacket<RTC::Codecs::VP9Handler>;
+
+				if (!this->simulcast)
+					this->layerSelector = new VP9::VP9LayerSelector(0, 0);
+
+				break;
+			}
+
+			case RTC::RtpCodecMime::Subtype::H264:
+			{
+				this->forwardRtpPacket = &RtpSender::ForwardRtpPacket<RTC::Codecs::H264Handler>;
+
+				break;
+			}
+
+			default:
+			{
+				if (this->kind == RTC::Media::Kind::AUDIO)
+					this->forwardRtpPacket = &RtpSender::ForwardRtpPacket<RTC::Codecs::AudioHandler>;
+				else
+					this->forwardRtpPacket = &RtpSender::ForwardRtpPacket<RTC::Codecs::VideoHandler>;
+			}
+		}
+
+		if (HasLayers())
+		{
+			this->targetSpatialLayer  = 0;
+			this->targetTemporalLayer = 0;
+			this->layerPacketsDropped = 0;
+
+			this->seqHistory.assign(SeqHistorySize, SeqHistoryItem());
+			this->seqHistoryStarted = false;
+
+			// Until the Peer allocates the bitrate.
+			SetTargetLayers(this->preferredSpatialLayer, this->preferredTemporalLayer);
+		}
 	}
 
 	void RtpSender::RetransmitRtpPacket(RTC::RtpPacket* packet)
@@ -482,7 +925,492 @@ namespace RTC
 		MS_ASSERT(this->rtpStream, "no RtpStream set");
 
 		// Send the packet.
-		this->transport->SendRtpPacket(packet);
+		this->transport->SendRtpPacket(packet, RTC::Pacer::Priority::RETRANSMISSION);
+	}
+
+	/**
+	 * Returns false if the packet belongs to a VP9 layer not sent to this peer.
+	 * Otherwise sets the marker to send, which ends the selected layers. The
+	 * packet is not modified.
+	 */
+	bool RtpSender::SelectLayers(RTC::RtpPacket* packet, bool& marker)
+	{
+		MS_TRACE();
+
+		// Not a VP9 packet.
+		if (packet->GetPayloadType() != this->rtpParameters->encodings[0].codecPayloadType)
+			return true;
+
+		VP9::VP9PayloadDescription desc;
+
+		if (!desc.Parse(packet->GetPayload(), packet->GetPayloadLength()))
+		{
+			MS_WARN_TAG(rtp, "invalid VP9 payload descriptor");
+
+			return true;
+		}
+
+		AccountLayerBytes(desc.spatialLayerId, desc.temporalLayerId, packet->GetSize());
+
+		uint32_t extSeqNum;
+
+		return this->layerSelector->Select(packet, desc, extSeqNum, marker);
+	}
+
+	/**
+	 * Whether the VP8 packet belongs to the temporal layers being sent. If so,
+	 * the picture ID and TL0PICIDX to send are returned.
+	 */
+	bool RtpSender::SelectVP8Layers(
+	    RTC::RtpPacket* packet,
+	    const RTC::Codecs::VP8::PayloadDescriptor& descriptor,
+	    uint16_t& pictureId,
+	    uint8_t& tl0PicIdx)
+	{
+		MS_TRACE();
+
+		// Simulcast accounts the bytes per encoding.
+		if (!this->simulcast)
+			AccountLayerBytes(0, descriptor.tlIndex, packet->GetSize());
+
+		return this->vp8LayerSelector->Select(descriptor, pictureId, tl0PicIdx);
+	}
+
+	/**
+	 * Whether the packet belongs to the simulcast encoding being sent. The
+	 * target encoding replaces it on its first key frame.
+	 */
+	bool RtpSender::SelectEncoding(RTC::RtpPacket* packet, uint8_t temporalLayer)
+	{
+		MS_TRACE();
+
+		auto& encodings = this->receiverRtpParameters->encodings;
+		uint8_t encodingIdx{ 0 };
+
+		for (; encodingIdx < encodings.size() && encodingIdx < MaxSpatialLayers; ++encodingIdx)
+		{
+			if (encodings[encodingIdx].ssrc == packet->GetSsrc())
+				break;
+		}
+
+		if (encodingIdx == encodings.size() || encodingIdx == MaxSpatialLayers)
+		{
+			MS_WARN_TAG(rtp, "ignoring packet with unknown SSRC [ssrc:%" PRIu32 "]", packet->GetSsrc());
+
+			return false;
+		}
+
+		AccountLayerBytes(encodingIdx, temporalLayer, packet->GetSize());
+
+		uint64_t now = DepLibUV::GetTime();
+
+		if (encodingIdx == this->currentEncodingIdx)
+			return true;
+
+		if (encodingIdx != this->targetSpatialLayer)
+			return false;
+
+		if (!RTC::Codecs::Tools::IsKeyFrame(this->mime, packet))
+		{
+			// The request may have been lost, repeat it.
+			if (now - this->lastKeyFrameRequestAt >= KeyFrameRequestInterval)
+			{
+				this->lastKeyFrameRequestAt = now;
+				this->listener->OnRtpSenderFullFrameRequired(this);
+			}
+
+			return false;
+		}
+
+		MS_DEBUG_TAG(
+		    rtp,
+		    "switching simulcast encoding [ssrc:%" PRIu32 ", encoding:%" PRIu8 "]",
+		    packet->GetSsrc(),
+		    encodingIdx);
+
+		ContinueFrom(packet);
+
+		if (this->vp8LayerSelector != nullptr)
+			this->vp8LayerSelector->Resync();
+
+		this->currentEncodingIdx = encodingIdx;
+
+		return true;
+	}
+
+	/**
+	 * Stops forwarding the stream at the start of a frame once paused, and
+	 * resumes it on a key frame. Returns whether the packet must be forwarded.
+	 */
+	bool RtpSender::ApplyPause(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		bool paused = GetPaused();
+
+		if (this->forwarding)
+		{
+			// Packets of a new frame have a new timestamp.
+			if (
+			    paused && (!this->sentAnyPacket ||
+			               packet->GetTimestamp() + this->timestampOffset != this->lastSentTimestamp))
+			{
+				MS_DEBUG_TAG(rtp, "stream paused [ssrc:%" PRIu32 "]", packet->GetSsrc());
+
+				this->forwarding = false;
+			}
+
+			return this->forwarding;
+		}
+
+		if (paused)
+			return false;
+
+		// Resume on a key frame (unless they cannot be detected).
+		if (
+		    RTC::Codecs::Tools::CanDetectKeyFrames(this->mime) &&
+		    !RTC::Codecs::Tools::IsKeyFrame(this->mime, packet))
+		{
+			uint64_t now = DepLibUV::GetTime();
+
+			// The request may have been lost, repeat it.
+			if (now - this->lastKeyFrameRequestAt >= KeyFrameRequestInterval)
+			{
+				this->lastKeyFrameRequestAt = now;
+				this->listener->OnRtpSenderFullFrameRequired(this);
+			}
+
+			return false;
+		}
+
+		MS_DEBUG_TAG(rtp, "stream resumed [ssrc:%" PRIu32 "]", packet->GetSsrc());
+
+		this->forwarding   = true;
+		this->syncRequired = true;
+
+		return true;
+	}
+
+	/**
+	 * Computes the sequence number to send the given one with. Dropped packets
+	 * shift the following ones back, while the packets not received yet keep
+	 * their slot. Packets older than the highest received one get the offset in
+	 * effect when their slot was assigned. Returns false if the packet must not
+	 * be sent.
+	 */
+	inline bool RtpSender::MapSequenceNumber(uint16_t seq, bool drop, uint16_t& mappedSeq)
+	{
+		MS_TRACE();
+
+		// No layers, so nothing is dropped.
+		if (this->seqHistory.empty())
+		{
+			mappedSeq = seq + this->seqOffset;
+
+			return true;
+		}
+
+		if (!this->seqHistoryStarted)
+		{
+			this->seqHistoryStarted = true;
+			this->maxInputSeq       = seq - 1;
+		}
+
+		auto diff = static_cast<int16_t>(seq - this->maxInputSeq);
+
+		// Newer than any received packet.
+		if (diff > 0)
+		{
+			uint16_t firstMissing = this->maxInputSeq + 1;
+
+			if (static_cast<size_t>(diff) > SeqHistorySize)
+				firstMissing = seq - SeqHistorySize + 1;
+
+			for (uint16_t missingSeq = firstMissing; missingSeq != seq; ++missingSeq)
+			{
+				auto& item = this->seqHistory[missingSeq & (SeqHistorySize - 1)];
+
+				item.inputSeq  = missingSeq;
+				item.seqOffset = this->seqOffset;
+				item.valid     = true;
+				item.dropped   = false;
+			}
+
+			this->maxInputSeq = seq;
+
+			auto& item = this->seqHistory[seq & (SeqHistorySize - 1)];
+
+			item.inputSeq  = seq;
+			item.seqOffset = this->seqOffset;
+			item.valid     = true;
+			item.dropped   = drop;
+
+			if (drop)
+			{
+				this->seqOffset--;
+
+				return false;
+			}
+
+			mappedSeq = seq + item.seqOffset;
+
+			return true;
+		}
+
+		auto& item = this->seqHistory[seq & (SeqHistorySize - 1)];
+
+		// Too old.
+		if (static_cast<size_t>(-diff) >= SeqHistorySize || !item.valid || item.inputSeq != seq)
+			return false;
+
+		// The slot of a late packet is kept empty if it must be dropped.
+		if (drop || item.dropped)
+		{
+			item.dropped = true;
+
+			return false;
+		}
+
+		mappedSeq = seq + item.seqOffset;
+
+		return true;
+	}
+
+	/**
+	 * Shifts the sequence numbers and timestamps so the given packet (and the
+	 * following ones) continue from the last sent ones.
+	 */
+	void RtpSender::ContinueFrom(RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		// Offsets of previous packets do not apply anymore.
+		if (!this->seqHistory.empty())
+		{
+			this->seqHistory.assign(SeqHistorySize, SeqHistoryItem());
+			this->seqHistoryStarted = false;
+		}
+
+		if (!this->sentAnyPacket)
+			return;
+
+		auto& encoding    = this->rtpParameters->encodings[0];
+		auto& codec       = this->rtpParameters->GetCodecForEncoding(encoding);
+		uint64_t elapsed  = DepLibUV::GetTime() - this->lastSentAt;
+		auto timestampGap = static_cast<uint32_t>(elapsed * codec.clockRate / 1000);
+
+		if (timestampGap == 0u)
+			timestampGap = 1;
+
+		this->seqOffset       = this->lastSentSeq + 1 - packet->GetSequenceNumber();
+		this->timestampOffset = this->lastSentTimestamp + timestampGap - packet->GetTimestamp();
+	}
+
+	void RtpSender::SetPreferredLayers(uint8_t spatialLayer, uint8_t temporalLayer)
+	{
+		MS_TRACE();
+
+		this->preferredSpatialLayer  = std::min<uint8_t>(spatialLayer, MaxSpatialLayers - 1);
+		this->preferredTemporalLayer = std::min<uint8_t>(temporalLayer, MaxTemporalLayers - 1);
+
+		if (!HasLayers())
+			return;
+
+		// Lower layers are applied right away, higher ones once allocated.
+		SetTargetLayers(this->targetSpatialLayer, this->targetTemporalLayer);
+
+		this->listener->OnRtpSenderBitrateAllocationRequired(this);
+	}
+
+	/**
+	 * Sets the size at which the remote Peer renders the video, so higher
+	 * spatial layers are not sent. 0x0 means unknown.
+	 */
+	void RtpSender::SetMaxResolution(uint16_t width, uint16_t height)
+	{
+		MS_TRACE();
+
+		this->maxWidth  = width;
+		this->maxHeight = height;
+
+		if (!HasLayers())
+			return;
+
+		// Lower layers are applied right away, higher ones once allocated.
+		SetTargetLayers(this->targetSpatialLayer, this->targetTemporalLayer);
+
+		this->listener->OnRtpSenderBitrateAllocationRequired(this);
+	}
+
+	/**
+	 * Highest spatial layer worth sending: the preferred one or, if lower, the
+	 * lowest one whose resolution covers the rendered size.
+	 */
+	uint8_t RtpSender::GetMaxSpatialLayer() const
+	{
+		MS_TRACE();
+
+		// Simulcast encodings are sent as they are, their resolution is unknown.
+		if (this->simulcast)
+		{
+			size_t numEncodings =
+			    std::min<size_t>(this->receiverRtpParameters->encodings.size(), MaxSpatialLayers);
+
+			return std::min<uint8_t>(this->preferredSpatialLayer, numEncodings - 1);
+		}
+
+		// VP8 has temporal layers only.
+		if (this->layerSelector == nullptr)
+			return 0;
+
+		if (this->spatialLayerResolutions == nullptr)
+			return this->preferredSpatialLayer;
+
+		return GetSpatialLayerForSize(
+		    *this->spatialLayerResolutions,
+		    this->maxWidth,
+		    this->maxHeight,
+		    this->preferredSpatialLayer);
+	}
+
+	/**
+	 * Accounts the bytes of a layer and, periodically, updates the layer
+	 * bitrates. The Peer allocates them again on its own timer.
+	 */
+	void RtpSender::AccountLayerBytes(uint8_t spatialLayer, uint8_t temporalLayer, size_t size)
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+
+		if (spatialLayer < MaxSpatialLayers && temporalLayer < MaxTemporalLayers)
+			this->layerBytes[spatialLayer][temporalLayer] += size;
+
+		if (now - this->lastLayerBitratesAt >= LayerBitratesInterval)
+			UpdateLayerBitrates(now);
+	}
+
+	void RtpSender::UpdateLayerBitrates(uint64_t now)
+	{
+		MS_TRACE();
+
+		uint64_t elapsed = now - this->lastLayerBitratesAt;
+
+		for (uint8_t spatialLayer{ 0 }; spatialLayer < MaxSpatialLayers; ++spatialLayer)
+		{
+			for (uint8_t temporalLayer{ 0 }; temporalLayer < MaxTemporalLayers; ++temporalLayer)
+			{
+				size_t& bytes = this->layerBytes[spatialLayer][temporalLayer];
+
+				this->layerBitrates[spatialLayer][temporalLayer] =
+				    static_cast<uint32_t>(bytes * 8000 / elapsed);
+				bytes = 0;
+			}
+		}
+
+		this->lastLayerBitratesAt = now;
+	}
+
+	/**
+	 * Sets the VP9 or VP8 layers (or the simulcast encoding, as spatial layer)
+	 * sent to the remote Peer, limited to the preferred ones.
+	 */
+	void RtpSender::SetTargetLayers(uint8_t spatialLayer, uint8_t temporalLayer)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(HasLayers(), "no layers");
+
+		spatialLayer  = std::min(spatialLayer, GetMaxSpatialLayer());
+		temporalLayer = std::min(temporalLayer, this->preferredTemporalLayer);
+
+		if (spatialLayer == this->targetSpatialLayer && temporalLayer == this->targetTemporalLayer)
+			return;
+
+		MS_DEBUG_TAG(
+		    rtp,
+		    "target layers changed [spatial:%" PRIu8 ", temporal:%" PRIu8 "]",
+		    spatialLayer,
+		    temporalLayer);
+
+		bool spatialUpgrade = spatialLayer > this->targetSpatialLayer;
+
+		this->targetSpatialLayer  = spatialLayer;
+		this->targetTemporalLayer = temporalLayer;
+
+		// VP8 upper temporal layers are switched to on layer sync frames.
+		if (this->vp8LayerSelector != nullptr)
+			this->vp8LayerSelector->SetTargetTemporalLayer(temporalLayer);
+
+		// Another simulcast encoding can only be switched to on a key frame.
+		if (this->simulcast)
+		{
+			if (spatialLayer != this->currentEncodingIdx && this->GetActive())
+			{
+				this->lastKeyFrameRequestAt = DepLibUV::GetTime();
+				this->listener->OnRtpSenderFullFrameRequired(this);
+			}
+
+			return;
+		}
+
+		if (this->layerSelector == nullptr)
+			return;
+
+		this->layerSelector->SelectSpatialLayer(spatialLayer);
+		this->layerSelector->SelectTemporalLayer(temporalLayer);
+
+		// Higher spatial layers can only be switched to on a key frame.
+		if (spatialUpgrade && this->sentAnyPacket && this->GetActive())
+			this->listener->OnRtpSenderFullFrameRequired(this);
+	}
+
+	/**
+	 * Bitrate of the given layers including the lower layers they depend on.
+	 * Simulcast encodings do not depend on the lower ones.
+	 */
+	uint32_t RtpSender::GetLayersBitrate(uint8_t spatialLayer, uint8_t temporalLayer) const
+	{
+		MS_TRACE();
+
+		uint32_t bitrate{ 0 };
+
+		// Simulcast encodings do not depend on each other.
+		if (this->simulcast)
+		{
+			if (spatialLayer >= MaxSpatialLayers)
+				return bitrate;
+
+			for (uint8_t tLayer{ 0 }; tLayer <= temporalLayer && tLayer < MaxTemporalLayers; ++tLayer)
+			{
+				bitrate += this->layerBitrates[spatialLayer][tLayer];
+			}
+
+			return bitrate;
+		}
+
+		for (uint8_t sLayer{ 0 }; sLayer <= spatialLayer && sLayer < MaxSpatialLayers; ++sLayer)
+		{
+			for (uint8_t tLayer{ 0 }; tLayer <= temporalLayer && tLayer < MaxTemporalLayers; ++tLayer)
+			{
+				bitrate += this->layerBitrates[sLayer][tLayer];
+			}
+		}
+
+		return bitrate;
+	}
+
+	void RtpSender::SetPinned(bool pinned)
+	{
+		MS_TRACE();
+
+		if (pinned == this->pinned)
+			return;
+
+		this->pinned = pinned;
+
+		if (HasLayers())
+			this->listener->OnRtpSenderBitrateAllocationRequired(this);
 	}
 
 	inline void RtpSender::EmitActiveChange() const
@@ -499,4 +1427,22 @@ namespace RTC
 
 		this->notifier->Emit(this->rtpSenderId, "activechange", eventData);
 	}
+
+	void RtpSender::OnRtcpSchedulerReport(RTC::RtcpScheduler* rtcpScheduler, uint64_t now)
+	{
+		MS_TRACE();
+
+		if (this->rtpStream == nullptr)
+			return;
+
+		RTC::RTCP::SenderReport report;
+
+		if (!this->rtpStream->FillRtcpSenderReport(&report, now))
+			return;
+
+		// NOTE: This assumes a single stream.
+		report.SetSsrc(this->rtpParameters->encodings[0].ssrc);
+
+		rtcpScheduler->AddSenderReport(&report, this->rtpParameters->rtcp.cname);
+	}
 } // namespace RTC
@@ -4,6 +4,7 @@
 // #define MS_LOG_DEV
 
 #include "RTC/RtpStream.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 
 namespace RTC
@@ -65,9 +66,45 @@ namespace RTC
 		if (packet->GetTimestamp() > this->maxTimestamp)
 			this->maxTimestamp = packet->GetTimestamp();
 
+		// Update the stats.
+		uint64_t now = DepLibUV::GetTime();
+		size_t size  = packet->GetSize();
+
+		this->stats.packets++;
+		this->stats.bytes += size;
+
+		if (now - this->bitratePeriodStart >= BitratePeriod)
+		{
+			this->stats.bitrate      = RtpStream::GetStats(now).bitrate;
+			this->bitratePeriodStart = now;
+			this->bitratePeriodBytes = 0;
+		}
+
+		this->bitratePeriodBytes += size;
+
 		return true;
 	}
 
+	/**
+	 * Stats of the stream at the given time. The bitrate is the one of the last
+	 * complete period, or of the current one once it is over (0 if no packet
+	 * was received since then).
+	 */
+	RtpStream::Stats RtpStream::GetStats(uint64_t now) const
+	{
+		MS_TRACE();
+
+		Stats stats      = this->stats;
+		uint64_t elapsed = now - this->bitratePeriodStart;
+
+		if (elapsed >= 2 * BitratePeriod)
+			stats.bitrate = 0;
+		else if (elapsed >= BitratePeriod)
+			stats.bitrate = static_cast<uint32_t>(this->bitratePeriodBytes * 8000 / elapsed);
+
+		return stats;
+	}
+
 	void RtpStream::InitSeq(uint16_t seq)
 	{
 		MS_TRACE();
@@ -182,17 +219,19 @@ namespace RTC
 		static const Json::StaticString JsonStringUsePli{ "usePli" };
 		static const Json::StaticString JsonStringSsrcAudioLevelId{ "ssrcAudioLevelId" };
 		static const Json::StaticString JsonStringAbsSendTimeId{ "absSendTimeId" };
+		static const Json::StaticString JsonStringTransportWideCc01Id{ "transportWideCc01Id" };
 
 		Json::Value json(Json::objectValue);
 
-		json[JsonStringSsrc]             = Json::UInt{ this->ssrc };
-		json[JsonStringPayloadType]      = Json::UInt{ this->payloadType };
-		json[JsonStringMime]             = this->mime.name;
-		json[JsonStringClockRate]        = Json::UInt{ this->clockRate };
-		json[JsonStringUseNack]          = this->useNack;
-		json[JsonStringUsePli]           = this->usePli;
-		json[JsonStringSsrcAudioLevelId] = Json::UInt{ this->ssrcAudioLevelId };
-		json[JsonStringAbsSendTimeId]    = Json::UInt{ this->absSendTimeId };
+		json[JsonStringSsrc]                = Json::UInt{ this->ssrc };
+		json[JsonStringPayloadType]         = Json::UInt{ this->payloadType };
+		json[JsonStringMime]                = this->mime.name;
+		json[JsonStringClockRate]           = Json::UInt{ this->clockRate };
+		json[JsonStringUseNack]             = this->useNack;
+		json[JsonStringUsePli]              = this->usePli;
+		json[JsonStringSsrcAudioLevelId]    = Json::UInt{ this->ssrcAudioLevelId };
+		json[JsonStringAbsSendTimeId]       = Json::UInt{ this->absSendTimeId };
+		json[JsonStringTransportWideCc01Id] = Json::UInt{ this->transportWideCc01Id };
 
 		return json;
 	}
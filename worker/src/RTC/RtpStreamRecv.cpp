@@ -65,6 +65,12 @@ namespace RTC
 			    RtpHeaderExtensionUri::Type::ABS_SEND_TIME, this->params.absSendTimeId);
 		}
 
+		if (this->params.transportWideCc01Id != 0u)
+		{
+			packet->AddExtensionMapping(
+			    RtpHeaderExtensionUri::Type::TRANSPORT_WIDE_CC_01, this->params.transportWideCc01Id);
+		}
+
 		// Pass the packet to the NackGenerator.
 		if (this->params.useNack)
 			this->nackGenerator->ReceivePacket(packet);
@@ -72,11 +78,24 @@ namespace RTC
 		return true;
 	}
 
-	RTC::RTCP::ReceiverReport* RtpStreamRecv::GetRtcpReceiverReport()
+	RtpStream::Stats RtpStreamRecv::GetStats(uint64_t now) const
 	{
 		MS_TRACE();
 
-		auto report = new RTC::RTCP::ReceiverReport();
+		Stats stats       = RtpStream::GetStats(now);
+		uint32_t expected = (this->cycles + this->maxSeq) - this->baseSeq + 1;
+
+		if (this->started && expected > this->received)
+			stats.packetsLost = expected - this->received;
+
+		stats.jitter = this->jitter;
+
+		return stats;
+	}
+
+	void RtpStreamRecv::FillRtcpReceiverReport(RTC::RTCP::ReceiverReport* report)
+	{
+		MS_TRACE();
 
 		// Calculate Packets Expected and Lost.
 		uint32_t expected = (this->cycles + this->maxSeq) - this->baseSeq + 1;
@@ -102,6 +121,7 @@ namespace RTC
 			fractionLost = (lostInterval << 8) / expectedInterval;
 
 		report->SetFractionLost(fractionLost);
+		this->stats.fractionLost = fractionLost;
 
 		// Fill the rest of the report.
 		report->SetLastSeq(static_cast<uint32_t>(this->maxSeq) + this->cycles);
@@ -123,8 +143,6 @@ namespace RTC
 			report->SetDelaySinceLastSenderReport(0);
 			report->SetLastSenderReport(0);
 		}
-
-		return report;
 	}
 
 	void RtpStreamRecv::ReceiveRtcpSenderReport(RTC::RTCP::SenderReport* report)
@@ -146,7 +164,7 @@ namespace RTC
 			if (this->params.useNack)
 				this->nackGenerator.reset(new RTC::NackGenerator(this));
 
-			this->listener->OnPliRequired(this);
+			RequestPli();
 		}
 	}
 
@@ -159,6 +177,15 @@ namespace RTC
 
 		auto transit =
 		    static_cast<int>(DepLibUV::GetTime() - (rtpTimestamp * 1000 / this->params.clockRate));
+
+		// The first packet has no previous transit to compare with.
+		if (this->stats.packets == 1)
+		{
+			this->transit = transit;
+
+			return;
+		}
+
 		int d = transit - this->transit;
 
 		this->transit = transit;
@@ -167,6 +194,15 @@ namespace RTC
 		this->jitter += (1. / 16.) * (static_cast<double>(d) - this->jitter);
 	}
 
+	inline void RtpStreamRecv::RequestPli()
+	{
+		MS_TRACE();
+
+		this->stats.keyFrameRequests++;
+
+		this->listener->OnPliRequired(this);
+	}
+
 	void RtpStreamRecv::OnInitSeq()
 	{
 		MS_TRACE();
@@ -180,7 +216,7 @@ namespace RTC
 		{
 			MS_DEBUG_TAG(rtx, "stream initialized, triggering PLI [ssrc:%" PRIu32 "]", this->params.ssrc);
 
-			this->listener->OnPliRequired(this);
+			RequestPli();
 		}
 	}
 
@@ -197,6 +233,8 @@ namespace RTC
 		    seqNumbers[0],
 		    seqNumbers.size());
 
+		this->stats.nackPackets += seqNumbers.size();
+
 		this->listener->OnNackRequired(this, seqNumbers);
 	}
 
@@ -213,6 +251,6 @@ namespace RTC
 
 		MS_DEBUG_TAG(rtx, "triggering PLI [ssrc:%" PRIu32 "]", this->params.ssrc);
 
-		this->listener->OnPliRequired(this);
+		RequestPli();
 	}
 } // namespace RTC
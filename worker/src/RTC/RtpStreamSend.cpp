@@ -5,14 +5,19 @@
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "Utils.hpp"
+#include <algorithm> // std::min(), std::max()
+#include <bitset>    // std::bitset()
 
 namespace RTC
 {
 	/* Static. */
 
 	static constexpr uint32_t RtpSeqMod{ 1 << 16 };
-	// Don't retransmit packets older than this (ms).
-	static constexpr uint32_t MaxRetransmissionAge{ 500 };
+	// Don't retransmit packets older than this many RTTs, within the given
+	// bounds (ms).
+	static constexpr uint32_t RetransmissionAgeRtts{ 5 };
+	static constexpr uint32_t MinRetransmissionAge{ 500 };
+	static constexpr uint32_t MaxRetransmissionAge{ 2000 };
 	static constexpr uint32_t DefaultRtt{ 100 };
 
 	/* Instance methods. */
@@ -74,10 +79,31 @@ namespace RTC
 		return true;
 	}
 
+	RtpStream::Stats RtpStreamSend::GetStats(uint64_t now) const
+	{
+		MS_TRACE();
+
+		Stats stats = RtpStream::GetStats(now);
+
+		if (this->remoteTotalLost > 0)
+			stats.packetsLost = this->remoteTotalLost;
+
+		stats.rtt = this->rtt;
+
+		return stats;
+	}
+
 	void RtpStreamSend::ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report)
 	{
 		MS_TRACE();
 
+		this->remoteTotalLost    = report->GetTotalLost();
+		this->stats.fractionLost = report->GetFractionLost();
+
+		// Jitter in RTP timestamp units.
+		if (this->params.clockRate != 0u)
+			this->stats.jitter = uint64_t{ report->GetJitter() } * 1000 / this->params.clockRate;
+
 		/* Calculate RTT. */
 
 		// Get the compact NTP representation of the current timestamp.
@@ -110,6 +136,8 @@ namespace RTC
 		// Ensure the container's first element is 0.
 		container[0] = nullptr;
 
+		this->stats.nackPackets += 1 + std::bitset<16>(bitmask).count();
+
 		// If NACK is not supported, exit.
 		if (!this->params.useNack)
 		{
@@ -163,6 +191,8 @@ namespace RTC
 		// Look for each requested packet.
 		uint64_t now   = DepLibUV::GetTime();
 		uint32_t rtt   = (this->rtt != 0u ? this->rtt : DefaultRtt);
+		uint32_t maxAge =
+		    std::min(std::max(rtt * RetransmissionAgeRtts, MinRetransmissionAge), MaxRetransmissionAge);
 		uint32_t seq32 = firstSeq32;
 		bool requested{ true };
 		size_t containerIdx{ 0 };
@@ -192,8 +222,8 @@ namespace RTC
 						uint32_t diff =
 						    (this->maxTimestamp - currentPacket->GetTimestamp()) * 1000 / this->params.clockRate;
 
-						// Just provide the packet if no older than MaxRetransmissionAge ms.
-						if (diff > MaxRetransmissionAge)
+						// Just provide the packet if no older than maxAge ms.
+						if (diff > maxAge)
 						{
 							if (!tooOldPacketFound)
 							{
@@ -202,7 +232,7 @@ namespace RTC
 								    "ignoring retransmission for too old packet "
 								    "[seq:%" PRIu16 ", max age:%" PRIu32 "ms, packet age:%" PRIu32 "ms]",
 								    currentPacket->GetSequenceNumber(),
-								    MaxRetransmissionAge,
+								    maxAge,
 								    diff);
 
 								tooOldPacketFound = true;
@@ -281,18 +311,21 @@ namespace RTC
 			    MS_UINT16_TO_BINARY(origBitmask));
 		}
 
+		this->stats.retransmittedPackets += containerIdx;
+
 		// Set the next container element to null.
 		container[containerIdx] = nullptr;
 	}
 
-	RTC::RTCP::SenderReport* RtpStreamSend::GetRtcpSenderReport(uint64_t now)
+	/**
+	 * Fills the given SR with the stream stats, false if nothing was sent yet.
+	 */
+	bool RtpStreamSend::FillRtcpSenderReport(RTC::RTCP::SenderReport* report, uint64_t now) const
 	{
 		MS_TRACE();
 
 		if (received == 0u)
-			return nullptr;
-
-		auto report = new RTC::RTCP::SenderReport();
+			return false;
 
 		report->SetPacketCount(this->received);
 		report->SetOctetCount(this->receivedBytes);
@@ -309,7 +342,7 @@ namespace RTC
 
 		report->SetRtpTs(this->lastPacketRtpTimestamp + diffRtpTimestamp);
 
-		return report;
+		return true;
 	}
 
 	void RtpStreamSend::ClearBuffer()
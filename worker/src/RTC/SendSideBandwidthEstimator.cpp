@@ -0,0 +1,282 @@
+#define MS_CLASS "RTC::SendSideBandwidthEstimator"
+// #define MS_LOG_DEV
+
+#include "RTC/SendSideBandwidthEstimator.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::min(), std::max()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Sent packets are forgotten after this time or if there are too many.
+	static constexpr uint64_t MaxSentPacketAge{ 2000 }; // In ms.
+	static constexpr size_t MaxSentPackets{ 10000 };
+	// Send times are in ms so group packets sent within 5 ms.
+	static constexpr uint32_t TimestampGroupLength{ 5 };
+	static constexpr uint32_t MinBitrate{ 30000 };
+	// Loss based controller.
+	static constexpr size_t LossMinPackets{ 20 };
+	static constexpr double LossLowThreshold{ 0.02 };
+	static constexpr double LossHighThreshold{ 0.10 };
+	static constexpr uint64_t LossIncreaseInterval{ 1000 }; // In ms.
+	static constexpr uint64_t LossDecreaseInterval{ 300 };  // In ms.
+
+	/* Instance methods. */
+
+	SendSideBandwidthEstimator::SendSideBandwidthEstimator(Listener* listener)
+	    : listener(listener), interArrival(TimestampGroupLength, 1.0, true),
+	      overuseEstimator(OverUseDetectorOptions())
+	{
+		MS_TRACE();
+
+		this->rateControl.SetMinBitrate(MinBitrate);
+	}
+
+	Json::Value SendSideBandwidthEstimator::ToJson() const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringAvailableBitrate{ "availableBitrate" };
+		static const Json::StaticString JsonStringDelayBasedBitrate{ "delayBasedBitrate" };
+		static const Json::StaticString JsonStringLossBasedBitrate{ "lossBasedBitrate" };
+		static const Json::StaticString JsonStringRembBitrate{ "rembBitrate" };
+		static const Json::StaticString JsonStringFractionLost{ "fractionLost" };
+		static const Json::StaticString JsonStringPacketsSent{ "packetsSent" };
+		static const Json::StaticString JsonStringPacketsAcked{ "packetsAcked" };
+		static const Json::StaticString JsonStringPacketsLost{ "packetsLost" };
+		static const Json::StaticString JsonStringFeedbackPacketsReceived{ "feedbackPacketsReceived" };
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringAvailableBitrate]        = Json::UInt{ this->availableBitrate };
+		json[JsonStringDelayBasedBitrate]       = Json::UInt{ this->delayBasedBitrate };
+		json[JsonStringLossBasedBitrate]        = Json::UInt{ this->lossBasedBitrate };
+		json[JsonStringRembBitrate]             = Json::UInt{ this->rembBitrate };
+		json[JsonStringFractionLost]            = Json::UInt{ this->fractionLost };
+		json[JsonStringPacketsSent]             = Json::UInt64{ this->packetsSent };
+		json[JsonStringPacketsAcked]            = Json::UInt64{ this->packetsAcked };
+		json[JsonStringPacketsLost]             = Json::UInt64{ this->packetsLost };
+		json[JsonStringFeedbackPacketsReceived] = Json::UInt64{ this->feedbackPacketsReceived };
+
+		return json;
+	}
+
+	/**
+	 * Records a sent packet and returns the transport-wide sequence number that
+	 * must be written into it.
+	 */
+	uint16_t SendSideBandwidthEstimator::RtpPacketSent(size_t size, uint64_t now)
+	{
+		MS_TRACE();
+
+		// Forget packets too old to be reported.
+		while (!this->sentPackets.empty() &&
+		       (this->sentPackets.size() >= MaxSentPackets ||
+		        now - this->sentPackets.front().sentAt > MaxSentPacketAge))
+		{
+			this->sentPackets.pop_front();
+		}
+
+		SentPacket sentPacket;
+
+		sentPacket.sentAt = now;
+		sentPacket.size   = size;
+
+		this->sentPackets.push_back(sentPacket);
+		this->packetsSent++;
+
+		return static_cast<uint16_t>(this->nextWideSeq++);
+	}
+
+	void SendSideBandwidthEstimator::ReceiveTransportFeedback(
+	    const RTC::RTCP::PacketView& feedback, uint64_t now)
+	{
+		MS_TRACE();
+
+		// Read in place into a reused vector, nothing is allocated per feedback.
+		this->packetResults.clear();
+
+		if (!feedback.GetTransportFeedbackResults(this->packetResults))
+			return;
+
+		this->feedbackPacketsReceived++;
+
+		if (this->sentPackets.empty())
+			return;
+
+		int64_t lastWideSeq  = this->nextWideSeq - 1;
+		int64_t firstWideSeq = this->nextWideSeq - static_cast<int64_t>(this->sentPackets.size());
+
+		for (auto& result : this->packetResults)
+		{
+			int64_t wideSeq = lastWideSeq + static_cast<int16_t>(
+			                                    result.sequenceNumber - static_cast<uint16_t>(lastWideSeq));
+
+			// Unknown or already forgotten packet.
+			if (wideSeq < firstWideSeq || wideSeq > lastWideSeq)
+				continue;
+
+			auto& sentPacket = this->sentPackets[wideSeq - firstWideSeq];
+
+			if (sentPacket.reported)
+				continue;
+
+			sentPacket.reported = true;
+			this->lossWindowPackets++;
+
+			if (!result.received)
+			{
+				this->lossWindowLost++;
+				this->packetsLost++;
+
+				continue;
+			}
+
+			this->packetsAcked++;
+			this->ackedBitrate.Update(sentPacket.size, now);
+
+			uint32_t tsDelta;
+			int64_t tDelta;
+			int sizeDelta;
+
+			// Arrival times are in the remote clock, only their deltas matter.
+			if (this->interArrival.ComputeDeltas(
+			        static_cast<uint32_t>(sentPacket.sentAt),
+			        result.receivedAt,
+			        static_cast<int64_t>(now),
+			        sentPacket.size,
+			        &tsDelta,
+			        &tDelta,
+			        &sizeDelta))
+			{
+				auto tsDeltaMs = static_cast<double>(tsDelta);
+
+				this->overuseEstimator.Update(
+				    tDelta, tsDeltaMs, sizeDelta, this->overuseDetector.State(), static_cast<int64_t>(now));
+				this->overuseDetector.Detect(
+				    this->overuseEstimator.GetOffset(),
+				    tsDeltaMs,
+				    this->overuseEstimator.GetNumOfDeltas(),
+				    static_cast<int64_t>(now));
+			}
+		}
+
+		UpdateDelayBasedBitrate(now);
+		UpdateLossBasedBitrate(now);
+		UpdateAvailableBitrate();
+	}
+
+	void SendSideBandwidthEstimator::ReceiveRemb(uint32_t bitrate, uint64_t /*now*/)
+	{
+		MS_TRACE();
+
+		this->rembBitrate = bitrate;
+
+		UpdateAvailableBitrate();
+	}
+
+	void SendSideBandwidthEstimator::UpdateDelayBasedBitrate(uint64_t now)
+	{
+		MS_TRACE();
+
+		auto nowMs       = static_cast<int64_t>(now);
+		uint32_t acked   = this->ackedBitrate.GetRate(now);
+		bool updateDelay = false;
+
+		// Periodic update or over-use that must be reacted to right away.
+		if (this->lastDelayUpdateAt == 0 ||
+		    nowMs - static_cast<int64_t>(this->lastDelayUpdateAt) > this->rateControl.GetFeedbackInterval())
+		{
+			updateDelay = true;
+		}
+		else if (this->overuseDetector.State() == BW_OVERUSING)
+		{
+			if ((acked != 0u) && this->rateControl.TimeToReduceFurther(nowMs, acked))
+				updateDelay = true;
+		}
+
+		if (!updateDelay)
+			return;
+
+		const RateControlInput input(
+		    this->overuseDetector.State(), acked, this->overuseEstimator.GetVarNoise());
+
+		this->rateControl.Update(&input, nowMs);
+
+		uint32_t bitrate = this->rateControl.UpdateBandwidthEstimate(nowMs);
+
+		// Wait until the rate control has been initialized with the acked bitrate.
+		if (this->rateControl.ValidEstimate())
+			this->delayBasedBitrate = bitrate;
+
+		this->lastDelayUpdateAt = now;
+	}
+
+	void SendSideBandwidthEstimator::UpdateLossBasedBitrate(uint64_t now)
+	{
+		MS_TRACE();
+
+		if (this->delayBasedBitrate == 0u || this->lossWindowPackets < LossMinPackets)
+			return;
+
+		double loss = static_cast<double>(this->lossWindowLost) / this->lossWindowPackets;
+
+		this->fractionLost      = static_cast<uint8_t>(loss * 255);
+		this->lossWindowPackets = 0;
+		this->lossWindowLost    = 0;
+
+		if (this->lossBasedBitrate == 0u)
+			this->lossBasedBitrate = this->delayBasedBitrate;
+
+		if (loss < LossLowThreshold)
+		{
+			if (now - this->lastLossIncreaseAt >= LossIncreaseInterval)
+			{
+				this->lossBasedBitrate   = static_cast<uint32_t>(this->lossBasedBitrate * 1.08) + 1000;
+				this->lastLossIncreaseAt = now;
+			}
+		}
+		else if (loss > LossHighThreshold)
+		{
+			if (now - this->lastLossDecreaseAt >= LossDecreaseInterval)
+			{
+				MS_DEBUG_TAG(
+				    rbe,
+				    "high packet loss, decreasing bitrate [loss:%.2f, bitrate:%" PRIu32 "bps]",
+				    loss,
+				    this->lossBasedBitrate);
+
+				this->lossBasedBitrate   = static_cast<uint32_t>(this->lossBasedBitrate * (1 - 0.5 * loss));
+				this->lastLossDecreaseAt = now;
+			}
+		}
+
+		// Never go above the delay based estimate.
+		this->lossBasedBitrate =
+		    std::max(MinBitrate, std::min(this->lossBasedBitrate, this->delayBasedBitrate));
+	}
+
+	void SendSideBandwidthEstimator::UpdateAvailableBitrate()
+	{
+		MS_TRACE();
+
+		uint32_t bitrate = this->delayBasedBitrate;
+
+		if (this->lossBasedBitrate != 0u)
+			bitrate = std::min(bitrate, this->lossBasedBitrate);
+
+		// Without transport feedback the REMB is the only estimation.
+		if (this->rembBitrate != 0u)
+			bitrate = (bitrate == 0u) ? this->rembBitrate : std::min(bitrate, this->rembBitrate);
+
+		if (bitrate == this->availableBitrate)
+			return;
+
+		MS_DEBUG_TAG(rbe, "available bitrate changed [bitrate:%" PRIu32 "bps]", bitrate);
+
+		this->availableBitrate = bitrate;
+
+		this->listener->OnSendSideBandwidthEstimation(this, bitrate);
+	}
+} // namespace RTC
@@ -3,6 +3,7 @@
 
 #include "RTC/SrtpSession.hpp"
 #include "DepLibSRTP.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
 #include <cstring> // std::memset(), std::memcpy()
@@ -125,6 +126,7 @@ namespace RTC
 	bool SrtpSession::EncryptRtp(const uint8_t** data, size_t* len)
 	{
 		MS_TRACE();
+		MS_LATENCY_PROBE(ENCRYPT);
 
 		// Ensure that the resulting SRTP packet fits into the encrypt buffer.
 		if (*len + SRTP_MAX_TRAILER_LEN > EncryptBufferSize)
@@ -155,6 +157,7 @@ namespace RTC
 	bool SrtpSession::DecryptSrtp(const uint8_t* data, size_t* len)
 	{
 		MS_TRACE();
+		MS_LATENCY_PROBE(DECRYPT);
 
 		srtp_err_status_t err;
 
@@ -172,6 +175,7 @@ namespace RTC
 	bool SrtpSession::EncryptRtcp(const uint8_t** data, size_t* len)
 	{
 		MS_TRACE();
+		MS_LATENCY_PROBE(RTCP_ENCRYPT);
 
 		// Ensure that the resulting SRTCP packet fits into the encrypt buffer.
 		if (*len + SRTP_MAX_TRAILER_LEN > EncryptBufferSize)
@@ -202,6 +206,7 @@ namespace RTC
 	bool SrtpSession::DecryptSrtcp(const uint8_t* data, size_t* len)
 	{
 		MS_TRACE();
+		MS_LATENCY_PROBE(RTCP_DECRYPT);
 
 		srtp_err_status_t err;
 
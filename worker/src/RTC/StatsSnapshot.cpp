@@ -0,0 +1,67 @@
+#define MS_CLASS "RTC::StatsSnapshot"
+// #define MS_LOG_DEV
+
+#include "RTC/StatsSnapshot.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <limits>
+
+namespace RTC
+{
+	/* Static. */
+
+	// Counters wider than their field are saturated.
+	static inline uint32_t clamp32(size_t value)
+	{
+		return value > std::numeric_limits<uint32_t>::max() ? std::numeric_limits<uint32_t>::max()
+		                                                     : static_cast<uint32_t>(value);
+	}
+
+	/* Instance methods. */
+
+	StatsSnapshot::StatsSnapshot(uint64_t now) : data(HeaderSize, 0)
+	{
+		MS_TRACE();
+
+		this->data[0] = Version;
+		this->data[1] = RecordSize;
+		Utils::Byte::Set8Bytes(this->data.data(), 8, now);
+	}
+
+	void StatsSnapshot::Add(
+	    uint32_t ownerId,
+	    uint32_t ssrc,
+	    Direction direction,
+	    RTC::Media::Kind kind,
+	    uint8_t spatialLayer,
+	    uint8_t temporalLayer,
+	    const RTC::RtpStream::Stats& stats)
+	{
+		MS_TRACE();
+
+		size_t pos = this->data.size();
+
+		this->data.resize(pos + RecordSize, 0);
+
+		uint8_t* record = this->data.data() + pos;
+
+		Utils::Byte::Set4Bytes(record, 0, ownerId);
+		Utils::Byte::Set4Bytes(record, 4, ssrc);
+		record[8]  = static_cast<uint8_t>(direction);
+		record[9]  = static_cast<uint8_t>(kind);
+		record[10] = spatialLayer;
+		record[11] = temporalLayer;
+		Utils::Byte::Set4Bytes(record, 12, clamp32(stats.packets));
+		Utils::Byte::Set8Bytes(record, 16, stats.bytes);
+		Utils::Byte::Set4Bytes(record, 24, stats.packetsLost);
+		record[28] = stats.fractionLost;
+		Utils::Byte::Set4Bytes(record, 32, stats.jitter);
+		Utils::Byte::Set4Bytes(record, 36, stats.rtt);
+		Utils::Byte::Set4Bytes(record, 40, stats.nackPackets);
+		Utils::Byte::Set4Bytes(record, 44, stats.keyFrameRequests);
+		Utils::Byte::Set4Bytes(record, 48, stats.retransmittedPackets);
+		Utils::Byte::Set4Bytes(record, 52, stats.bitrate);
+
+		Utils::Byte::Set4Bytes(this->data.data(), 4, static_cast<uint32_t>(++this->count));
+	}
+} // namespace RTC
@@ -7,7 +7,6 @@
 #include "MediaSoupError.hpp"
 #include "Settings.hpp"
 #include "Utils.hpp"
-#include "RTC/RTCP/FeedbackPsRemb.hpp"
 #include <cmath>    // std::pow()
 #include <iterator> // std::ostream_iterator
 #include <sstream>  // std::ostringstream
@@ -47,156 +46,21 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		static const Json::StaticString JsonStringUdp{ "udp" };
-		static const Json::StaticString JsonStringTcp{ "tcp" };
-		static const Json::StaticString JsonStringPreferIPv4{ "preferIPv4" };
-		static const Json::StaticString JsonStringPreferIPv6{ "preferIPv6" };
-		static const Json::StaticString JsonStringPreferUdp{ "preferUdp" };
-		static const Json::StaticString JsonStringPreferTcp{ "preferTcp" };
-
-		bool tryIPv4udp{ true };
-		bool tryIPv6udp{ true };
-		bool tryIPv4tcp{ true };
-		bool tryIPv6tcp{ true };
-
-		bool preferIPv4{ false };
-		bool preferIPv6{ false };
-		bool preferUdp{ false };
-		bool preferTcp{ false };
-
-		if (data[JsonStringUdp].isBool())
-			tryIPv4udp = tryIPv6udp = data[JsonStringUdp].asBool();
-
-		if (data[JsonStringTcp].isBool())
-			tryIPv4tcp = tryIPv6tcp = data[JsonStringTcp].asBool();
-
-		if (data[JsonStringPreferIPv4].isBool())
-			preferIPv4 = data[JsonStringPreferIPv4].asBool();
-		if (data[JsonStringPreferIPv6].isBool())
-			preferIPv6 = data[JsonStringPreferIPv6].asBool();
-		if (data[JsonStringPreferUdp].isBool())
-			preferUdp = data[JsonStringPreferUdp].asBool();
-		if (data[JsonStringPreferTcp].isBool())
-			preferTcp = data[JsonStringPreferTcp].asBool();
-
-		// Create a ICE server.
-		this->iceServer = new RTC::IceServer(
-		    this, Utils::Crypto::GetRandomString(16), Utils::Crypto::GetRandomString(32));
-
-		// Open a IPv4 UDP socket.
-		if (tryIPv4udp && Settings::configuration.hasIPv4)
-		{
-			uint16_t localPreference = IceCandidateDefaultLocalPriority;
-
-			if (preferIPv4)
-				localPreference += IceCandidateLocalPriorityPreferFamilyIncrement;
-			if (preferUdp)
-				localPreference += IceCandidateLocalPriorityPreferProtocolIncrement;
-
-			uint32_t priority = generateIceCandidatePriority(localPreference);
-
-			try
-			{
-				auto udpSocket = new RTC::UdpSocket(this, AF_INET);
-				RTC::IceCandidate iceCandidate(udpSocket, priority);
-
-				this->udpSockets.push_back(udpSocket);
-				this->iceLocalCandidates.push_back(iceCandidate);
-			}
-			catch (const MediaSoupError& error)
-			{
-				MS_ERROR("error adding IPv4 UDP socket: %s", error.what());
-			}
-		}
-
-		// Open a IPv6 UDP socket.
-		if (tryIPv6udp && Settings::configuration.hasIPv6)
-		{
-			uint16_t localPreference = IceCandidateDefaultLocalPriority;
-
-			if (preferIPv6)
-				localPreference += IceCandidateLocalPriorityPreferFamilyIncrement;
-			if (preferUdp)
-				localPreference += IceCandidateLocalPriorityPreferProtocolIncrement;
-
-			uint32_t priority = generateIceCandidatePriority(localPreference);
-
-			try
-			{
-				auto udpSocket = new RTC::UdpSocket(this, AF_INET6);
-				RTC::IceCandidate iceCandidate(udpSocket, priority);
-
-				this->udpSockets.push_back(udpSocket);
-				this->iceLocalCandidates.push_back(iceCandidate);
-			}
-			catch (const MediaSoupError& error)
-			{
-				MS_ERROR("error adding IPv6 UDP socket: %s", error.what());
-			}
-		}
-
-		// Open a IPv4 TCP server.
-		if (tryIPv4tcp && Settings::configuration.hasIPv4)
-		{
-			uint16_t localPreference = IceCandidateDefaultLocalPriority;
-
-			if (preferIPv4)
-				localPreference += IceCandidateLocalPriorityPreferFamilyIncrement;
-			if (preferTcp)
-				localPreference += IceCandidateLocalPriorityPreferProtocolIncrement;
-
-			uint32_t priority = generateIceCandidatePriority(localPreference);
-
-			try
-			{
-				auto tcpServer = new RTC::TcpServer(this, this, AF_INET);
-				RTC::IceCandidate iceCandidate(tcpServer, priority);
-
-				this->tcpServers.push_back(tcpServer);
-				this->iceLocalCandidates.push_back(iceCandidate);
-			}
-			catch (const MediaSoupError& error)
-			{
-				MS_ERROR("error adding IPv4 TCP server: %s", error.what());
-			}
-		}
-
-		// Open a IPv6 TCP server.
-		if (tryIPv6tcp && Settings::configuration.hasIPv6)
-		{
-			uint16_t localPreference = IceCandidateDefaultLocalPriority;
+		static const Json::StaticString JsonStringPlainRtp{ "plainRtp" };
 
-			if (preferIPv6)
-				localPreference += IceCandidateLocalPriorityPreferFamilyIncrement;
-			if (preferTcp)
-				localPreference += IceCandidateLocalPriorityPreferProtocolIncrement;
-
-			uint32_t priority = generateIceCandidatePriority(localPreference);
-
-			try
-			{
-				auto tcpServer = new RTC::TcpServer(this, this, AF_INET6);
-				RTC::IceCandidate iceCandidate(tcpServer, priority);
-
-				this->tcpServers.push_back(tcpServer);
-				this->iceLocalCandidates.push_back(iceCandidate);
-			}
-			catch (const MediaSoupError& error)
-			{
-				MS_ERROR("error adding IPv6 TCP server: %s", error.what());
-			}
-		}
+		if (data[JsonStringPlainRtp].isBool() && data[JsonStringPlainRtp].asBool())
+			SetUpPlainRtp(data);
+		else
+			SetUpIce(data);
 
-		// Ensure there is at least one IP:port binding.
-		if (this->udpSockets.empty() && this->tcpServers.empty())
-		{
-			Destroy();
+		// Create the pacer.
+		this->pacer = new RTC::Pacer(this, Settings::configuration.retransmissionBudget);
 
-			MS_THROW_ERROR("could not open any IP:port");
-		}
+		// Create the send side bandwidth estimator.
+		this->sendSideBandwidthEstimator = new RTC::SendSideBandwidthEstimator(this);
 
-		// Create a DTLS agent.
-		this->dtlsTransport = new RTC::DtlsTransport(this);
+		// Create the RTCP scheduler.
+		this->rtcpScheduler = new RTC::RtcpScheduler(this);
 
 		// Hack to avoid that Destroy() above attempts to delete this.
 		this->allocated = true;
@@ -205,6 +69,10 @@ namespace RTC
 	Transport::~Transport()
 	{
 		MS_TRACE();
+
+		// Deleted once the listener has detached the RtpSenders and RtpReceivers
+		// reporting through it.
+		delete this->rtcpScheduler;
 	}
 
 	void Transport::Destroy()
@@ -215,6 +83,15 @@ namespace RTC
 
 		Json::Value eventData(Json::objectValue);
 
+		// Abort the ongoing dumps.
+		for (auto it = this->dumpWriters.begin(); it != this->dumpWriters.end();)
+		{
+			auto* dumpWriter = *it;
+
+			it = this->dumpWriters.erase(it);
+			dumpWriter->Destroy();
+		}
+
 		if (this->srtpRecvSession != nullptr)
 			this->srtpRecvSession->Destroy();
 
@@ -235,6 +112,12 @@ namespace RTC
 			server->Destroy();
 		this->tcpServers.clear();
 
+		delete this->pacer;
+
+		delete this->sendSideBandwidthEstimator;
+
+		delete this->plainTuple;
+
 		this->selectedTuple = nullptr;
 
 		// Notify.
@@ -252,11 +135,16 @@ namespace RTC
 		}
 	}
 
-	Json::Value Transport::ToJson() const
+	Json::Value Transport::ToJson(bool withRtpListener) const
 	{
 		MS_TRACE();
 
 		static const Json::StaticString JsonStringTransportId{ "transportId" };
+		static const Json::StaticString JsonStringPlainRtp{ "plainRtp" };
+		static const Json::StaticString JsonStringComedia{ "comedia" };
+		static const Json::StaticString JsonStringLocalIp{ "localIP" };
+		static const Json::StaticString JsonStringLocalPort{ "localPort" };
+		static const Json::StaticString JsonStringTuple{ "tuple" };
 		static const Json::StaticString JsonStringIceRole{ "iceRole" };
 		static const Json::StaticString JsonStringControlled{ "controlled" };
 		static const Json::StaticString JsonStringIceLocalParameters{ "iceLocalParameters" };
@@ -280,93 +168,119 @@ namespace RTC
 		static const Json::StaticString JsonStringClosed{ "closed" };
 		static const Json::StaticString JsonStringFailed{ "failed" };
 		static const Json::StaticString JsonStringUseRemb{ "useRemb" };
+		static const Json::StaticString JsonStringUseTransportCc{ "useTransportCc" };
 		static const Json::StaticString JsonStringMaxBitrate{ "maxBitrate" };
 		static const Json::StaticString JsonStringEffectiveMaxBitrate{ "effectiveMaxBitrate" };
 		static const Json::StaticString JsonStringRtpListener{ "rtpListener" };
+		static const Json::StaticString JsonStringPacer{ "pacer" };
+		static const Json::StaticString JsonStringBandwidthEstimation{ "bandwidthEstimation" };
+		static const Json::StaticString JsonStringRtcpScheduler{ "rtcpScheduler" };
 
 		Json::Value json(Json::objectValue);
 
 		json[JsonStringTransportId] = Json::UInt{ this->transportId };
 
-		// Add `iceRole` (we are always "controlled").
-		json[JsonStringIceRole] = JsonStringControlled;
-
-		// Add `iceLocalParameters`.
-		json[JsonStringIceLocalParameters][JsonStringUsernameFragment] =
-		    this->iceServer->GetUsernameFragment();
-		json[JsonStringIceLocalParameters][JsonStringPassword] = this->iceServer->GetPassword();
+		// Add `plainRtp`.
+		json[JsonStringPlainRtp] = this->plainRtp;
 
-		// Add `iceLocalCandidates`.
-		json[JsonStringIceLocalCandidates] = Json::arrayValue;
-		for (const auto& iceCandidate : this->iceLocalCandidates)
+		if (this->plainRtp)
 		{
-			json[JsonStringIceLocalCandidates].append(iceCandidate.ToJson());
-		}
+			// Add `comedia`.
+			json[JsonStringComedia] = this->comedia;
 
-		// Add `iceSelectedTuple`.
-		if (this->selectedTuple != nullptr)
-			json[JsonStringIceSelectedTuple] = this->selectedTuple->ToJson();
+			// Add `localIP` and `localPort`.
+			json[JsonStringLocalIp]   = this->udpSockets[0]->GetLocalIP();
+			json[JsonStringLocalPort] = Json::UInt{ this->udpSockets[0]->GetLocalPort() };
 
-		// Add `iceState`.
-		switch (this->iceServer->GetState())
-		{
-			case RTC::IceServer::IceState::NEW:
-				json[JsonStringIceState] = JsonStringNew;
-				break;
-			case RTC::IceServer::IceState::CONNECTED:
-				json[JsonStringIceState] = JsonStringConnected;
-				break;
-			case RTC::IceServer::IceState::COMPLETED:
-				json[JsonStringIceState] = JsonStringCompleted;
-				break;
-			case RTC::IceServer::IceState::DISCONNECTED:
-				json[JsonStringIceState] = JsonStringDisconnected;
-				break;
+			// Add `tuple`.
+			if (this->plainTuple != nullptr)
+				json[JsonStringTuple] = this->plainTuple->ToJson();
 		}
+		else
+		{
+			// Add `iceRole` (we are always "controlled").
+			json[JsonStringIceRole] = JsonStringControlled;
 
-		// Add `dtlsLocalParameters.fingerprints`.
-		json[JsonStringDtlsLocalParameters][JsonStringFingerprints] =
-		    RTC::DtlsTransport::GetLocalFingerprints();
+			// Add `iceLocalParameters`.
+			json[JsonStringIceLocalParameters][JsonStringUsernameFragment] =
+			    this->iceServer->GetUsernameFragment();
+			json[JsonStringIceLocalParameters][JsonStringPassword] = this->iceServer->GetPassword();
 
-		// Add `dtlsLocalParameters.role`.
-		switch (this->dtlsLocalRole)
-		{
-			case RTC::DtlsTransport::Role::AUTO:
-				json[JsonStringDtlsLocalParameters][JsonStringRole] = JsonStringAuto;
-				break;
-			case RTC::DtlsTransport::Role::CLIENT:
-				json[JsonStringDtlsLocalParameters][JsonStringRole] = JsonStringClient;
-				break;
-			case RTC::DtlsTransport::Role::SERVER:
-				json[JsonStringDtlsLocalParameters][JsonStringRole] = JsonStringServer;
-				break;
-			default:
-				MS_ABORT("invalid local DTLS role");
-		}
+			// Add `iceLocalCandidates`.
+			json[JsonStringIceLocalCandidates] = Json::arrayValue;
+			for (const auto& iceCandidate : this->iceLocalCandidates)
+			{
+				json[JsonStringIceLocalCandidates].append(iceCandidate.ToJson());
+			}
 
-		// Add `dtlsState`.
-		switch (this->dtlsTransport->GetState())
-		{
-			case DtlsTransport::DtlsState::NEW:
-				json[JsonStringDtlsState] = JsonStringNew;
-				break;
-			case DtlsTransport::DtlsState::CONNECTING:
-				json[JsonStringDtlsState] = JsonStringConnecting;
-				break;
-			case DtlsTransport::DtlsState::CONNECTED:
-				json[JsonStringDtlsState] = JsonStringConnected;
-				break;
-			case DtlsTransport::DtlsState::FAILED:
-				json[JsonStringDtlsState] = JsonStringFailed;
-				break;
-			case DtlsTransport::DtlsState::CLOSED:
-				json[JsonStringDtlsState] = JsonStringClosed;
-				break;
+			// Add `iceSelectedTuple`.
+			if (this->selectedTuple != nullptr)
+				json[JsonStringIceSelectedTuple] = this->selectedTuple->ToJson();
+
+			// Add `iceState`.
+			switch (this->iceServer->GetState())
+			{
+				case RTC::IceServer::IceState::NEW:
+					json[JsonStringIceState] = JsonStringNew;
+					break;
+				case RTC::IceServer::IceState::CONNECTED:
+					json[JsonStringIceState] = JsonStringConnected;
+					break;
+				case RTC::IceServer::IceState::COMPLETED:
+					json[JsonStringIceState] = JsonStringCompleted;
+					break;
+				case RTC::IceServer::IceState::DISCONNECTED:
+					json[JsonStringIceState] = JsonStringDisconnected;
+					break;
+			}
+
+			// Add `dtlsLocalParameters.fingerprints`.
+			json[JsonStringDtlsLocalParameters][JsonStringFingerprints] =
+			    RTC::DtlsTransport::GetLocalFingerprints();
+
+			// Add `dtlsLocalParameters.role`.
+			switch (this->dtlsLocalRole)
+			{
+				case RTC::DtlsTransport::Role::AUTO:
+					json[JsonStringDtlsLocalParameters][JsonStringRole] = JsonStringAuto;
+					break;
+				case RTC::DtlsTransport::Role::CLIENT:
+					json[JsonStringDtlsLocalParameters][JsonStringRole] = JsonStringClient;
+					break;
+				case RTC::DtlsTransport::Role::SERVER:
+					json[JsonStringDtlsLocalParameters][JsonStringRole] = JsonStringServer;
+					break;
+				default:
+					MS_ABORT("invalid local DTLS role");
+			}
+
+			// Add `dtlsState`.
+			switch (this->dtlsTransport->GetState())
+			{
+				case DtlsTransport::DtlsState::NEW:
+					json[JsonStringDtlsState] = JsonStringNew;
+					break;
+				case DtlsTransport::DtlsState::CONNECTING:
+					json[JsonStringDtlsState] = JsonStringConnecting;
+					break;
+				case DtlsTransport::DtlsState::CONNECTED:
+					json[JsonStringDtlsState] = JsonStringConnected;
+					break;
+				case DtlsTransport::DtlsState::FAILED:
+					json[JsonStringDtlsState] = JsonStringFailed;
+					break;
+				case DtlsTransport::DtlsState::CLOSED:
+					json[JsonStringDtlsState] = JsonStringClosed;
+					break;
+			}
 		}
 
 		// Add `useRemb`.
 		json[JsonStringUseRemb] = (static_cast<bool>(this->remoteBitrateEstimator));
 
+		// Add `useTransportCc`.
+		json[JsonStringUseTransportCc] = (static_cast<bool>(this->transportFeedbackGenerator));
+
 		// Add `maxBitrate`.
 		json[JsonStringMaxBitrate] = Json::UInt{ this->maxBitrate };
 
@@ -374,7 +288,17 @@ namespace RTC
 		json[JsonStringEffectiveMaxBitrate] = Json::UInt{ this->effectiveMaxBitrate };
 
 		// Add `rtpListener`.
-		json[JsonStringRtpListener] = this->rtpListener.ToJson();
+		if (withRtpListener)
+			json[JsonStringRtpListener] = this->rtpListener.ToJson();
+
+		// Add `pacer`.
+		json[JsonStringPacer] = this->pacer->ToJson();
+
+		// Add `bandwidthEstimation`.
+		json[JsonStringBandwidthEstimation] = this->sendSideBandwidthEstimator->ToJson();
+
+		// Add `rtcpScheduler`.
+		json[JsonStringRtcpScheduler] = this->rtcpScheduler->ToJson();
 
 		return json;
 	}
@@ -402,9 +326,10 @@ namespace RTC
 
 			case Channel::Request::MethodId::TRANSPORT_DUMP:
 			{
-				auto json = ToJson();
+				// Dump the RtpListener tables and the rest in different loop iterations.
+				auto* dumpWriter = new Channel::DumpWriter(this, request);
 
-				request->Accept(json);
+				this->dumpWriters.insert(dumpWriter);
 
 				break;
 			}
@@ -422,6 +347,13 @@ namespace RTC
 				RTC::DtlsTransport::Role remoteRole =
 				    RTC::DtlsTransport::Role::AUTO; // Default value if missing.
 
+				if (this->plainRtp)
+				{
+					request->Reject("not available in a plain RTP transport");
+
+					return;
+				}
+
 				// Ensure this method is not called twice.
 				if (this->remoteDtlsParametersGiven)
 				{
@@ -514,130 +446,508 @@ namespace RTC
 
 				// Validate request data.
 
-				if (!request->data[JsonStringBitrate].isUInt())
-				{
-					request->Reject("missing data.bitrate");
+				if (!request->data[JsonStringBitrate].isUInt())
+				{
+					request->Reject("missing data.bitrate");
+
+					return;
+				}
+
+				auto bitrate = uint32_t{ request->data[JsonStringBitrate].asUInt() };
+
+				if (bitrate < MinBitrate)
+					bitrate = MinBitrate;
+
+				this->maxBitrate = bitrate;
+
+				MS_DEBUG_TAG(rbe, "transport max bitrate set to %" PRIu32 "bps", this->maxBitrate);
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD:
+			{
+				static const Json::StaticString JsonStringUsernameFragment{ "usernameFragment" };
+				static const Json::StaticString JsonStringPassword{ "password" };
+
+				if (this->plainRtp)
+				{
+					request->Reject("not available in a plain RTP transport");
+
+					return;
+				}
+
+				std::string usernameFragment = Utils::Crypto::GetRandomString(16);
+				std::string password         = Utils::Crypto::GetRandomString(32);
+
+				this->iceServer->SetUsernameFragment(usernameFragment);
+				this->iceServer->SetPassword(password);
+
+				Json::Value data(Json::objectValue);
+
+				data[JsonStringUsernameFragment] = this->iceServer->GetUsernameFragment();
+				data[JsonStringPassword]         = this->iceServer->GetPassword();
+
+				request->Accept(data);
+
+				break;
+			}
+
+			case Channel::Request::MethodId::TRANSPORT_SET_REMOTE_PARAMETERS:
+			{
+				static const Json::StaticString JsonStringIp{ "ip" };
+				static const Json::StaticString JsonStringPort{ "port" };
+
+				if (!this->plainRtp)
+				{
+					request->Reject("not a plain RTP transport");
+
+					return;
+				}
+
+				if (!request->data[JsonStringIp].isString())
+				{
+					request->Reject("missing data.ip");
+
+					return;
+				}
+
+				if (!request->data[JsonStringPort].isUInt() ||
+				    request->data[JsonStringPort].asUInt() > UINT16_MAX)
+				{
+					request->Reject("missing data.port");
+
+					return;
+				}
+
+				try
+				{
+					SetRemoteParameters(
+					    request->data[JsonStringIp].asString(),
+					    static_cast<uint16_t>(request->data[JsonStringPort].asUInt()));
+				}
+				catch (const MediaSoupError& error)
+				{
+					request->Reject(error.what());
+
+					return;
+				}
+
+				auto data = this->plainTuple->ToJson();
+
+				request->Accept(data);
+
+				break;
+			}
+
+			default:
+			{
+				MS_ERROR("unknown method");
+
+				request->Reject("unknown method");
+			}
+		}
+	}
+
+	void Transport::SendRtpPacket(RTC::RtpPacket* packet, RTC::Pacer::Priority priority)
+	{
+		MS_TRACE();
+
+		// If there is no selected tuple do nothing.
+		if (this->selectedTuple == nullptr)
+			return;
+
+		// Ensure there is sending SRTP session.
+		if (!this->plainRtp && this->srtpSendSession == nullptr)
+		{
+			MS_WARN_DEV("ignoring RTP packet due to non sending SRTP session");
+
+			return;
+		}
+
+		this->pacer->SendRtpPacket(packet, priority);
+	}
+
+	/**
+	 * Feeds the receive side bandwidth estimation with a RTP packet received
+	 * through this transport. The RtpReceiver calls it once the packet has its
+	 * header extension mappings and before forwarding it, since the transports
+	 * of the subscribers stamp their own transport-wide sequence numbers.
+	 */
+	void Transport::ReceiveRtpPacketArrival(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		uint16_t wideSeqNumber;
+
+		// Feed the transport-cc feedback generator. The remote sender estimates the
+		// bitrate by itself so there is no need to also compute REMB.
+		// Arrival times are given in us since deltas are reported in 250 us units.
+		if (this->transportFeedbackGenerator && packet->ReadTransportWideCc01(&wideSeqNumber))
+		{
+			this->transportFeedbackGenerator->IncomingPacket(
+			    uv_hrtime() / 1000, packet->GetSsrc(), wideSeqNumber);
+		}
+		// Feed the remote bitrate estimator (REMB).
+		else if (this->remoteBitrateEstimator)
+		{
+			uint32_t absSendTime;
+
+			if (packet->ReadAbsSendTime(&absSendTime))
+			{
+				this->remoteBitrateEstimator->IncomingPacket(
+				    DepLibUV::GetTime(), packet->GetPayloadLength(), *packet, absSendTime);
+			}
+		}
+	}
+
+	void Transport::SendRtcpPacket(RTC::RTCP::Packet* packet)
+	{
+		MS_TRACE();
+
+		// If there is no selected tuple do nothing.
+		if (this->selectedTuple == nullptr)
+			return;
+
+		// Ensure there is sending SRTP session.
+		if (!this->plainRtp && this->srtpSendSession == nullptr)
+		{
+			MS_WARN_DEV("ignoring RTCP packet due to non sending SRTP session");
+
+			return;
+		}
+
+		const uint8_t* data = packet->GetData();
+		size_t len          = packet->GetSize();
+
+		if (!this->plainRtp && !this->srtpSendSession->EncryptRtcp(&data, &len))
+			return;
+
+		this->selectedTuple->Send(data, len);
+	}
+
+	void Transport::ReceiveRtcpRemb(uint64_t bitrate)
+	{
+		MS_TRACE();
+
+		MS_DEBUG_TAG(rbe, "REMB received [bitrate:%" PRIu64 "bps]", bitrate);
+
+		this->sendSideBandwidthEstimator->ReceiveRemb(
+		    static_cast<uint32_t>(std::min<uint64_t>(bitrate, UINT32_MAX)), DepLibUV::GetTime());
+	}
+
+	void Transport::ReceiveRtcpTransportFeedback(const RTC::RTCP::PacketView& feedback)
+	{
+		MS_TRACE();
+
+		this->sendSideBandwidthEstimator->ReceiveTransportFeedback(feedback, DepLibUV::GetTime());
+	}
+
+	void Transport::SetUpIce(Json::Value& data)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringUdp{ "udp" };
+		static const Json::StaticString JsonStringTcp{ "tcp" };
+		static const Json::StaticString JsonStringPreferIPv4{ "preferIPv4" };
+		static const Json::StaticString JsonStringPreferIPv6{ "preferIPv6" };
+		static const Json::StaticString JsonStringPreferUdp{ "preferUdp" };
+		static const Json::StaticString JsonStringPreferTcp{ "preferTcp" };
+
+		bool tryIPv4udp{ true };
+		bool tryIPv6udp{ true };
+		bool tryIPv4tcp{ true };
+		bool tryIPv6tcp{ true };
+
+		bool preferIPv4{ false };
+		bool preferIPv6{ false };
+		bool preferUdp{ false };
+		bool preferTcp{ false };
+
+		if (data[JsonStringUdp].isBool())
+			tryIPv4udp = tryIPv6udp = data[JsonStringUdp].asBool();
+
+		if (data[JsonStringTcp].isBool())
+			tryIPv4tcp = tryIPv6tcp = data[JsonStringTcp].asBool();
+
+		if (data[JsonStringPreferIPv4].isBool())
+			preferIPv4 = data[JsonStringPreferIPv4].asBool();
+		if (data[JsonStringPreferIPv6].isBool())
+			preferIPv6 = data[JsonStringPreferIPv6].asBool();
+		if (data[JsonStringPreferUdp].isBool())
+			preferUdp = data[JsonStringPreferUdp].asBool();
+		if (data[JsonStringPreferTcp].isBool())
+			preferTcp = data[JsonStringPreferTcp].asBool();
+
+		// Create a ICE server.
+		this->iceServer = new RTC::IceServer(
+		    this, Utils::Crypto::GetRandomString(16), Utils::Crypto::GetRandomString(32));
+
+		// Open a IPv4 UDP socket.
+		if (tryIPv4udp && Settings::configuration.hasIPv4)
+		{
+			uint16_t localPreference = IceCandidateDefaultLocalPriority;
+
+			if (preferIPv4)
+				localPreference += IceCandidateLocalPriorityPreferFamilyIncrement;
+			if (preferUdp)
+				localPreference += IceCandidateLocalPriorityPreferProtocolIncrement;
+
+			uint32_t priority = generateIceCandidatePriority(localPreference);
+
+			try
+			{
+				auto udpSocket = new RTC::UdpSocket(this, AF_INET);
+				RTC::IceCandidate iceCandidate(udpSocket, priority);
+
+				this->udpSockets.push_back(udpSocket);
+				this->iceLocalCandidates.push_back(iceCandidate);
+			}
+			catch (const MediaSoupError& error)
+			{
+				MS_ERROR("error adding IPv4 UDP socket: %s", error.what());
+			}
+		}
+
+		// Open a IPv6 UDP socket.
+		if (tryIPv6udp && Settings::configuration.hasIPv6)
+		{
+			uint16_t localPreference = IceCandidateDefaultLocalPriority;
+
+			if (preferIPv6)
+				localPreference += IceCandidateLocalPriorityPreferFamilyIncrement;
+			if (preferUdp)
+				localPreference += IceCandidateLocalPriorityPreferProtocolIncrement;
+
+			uint32_t priority = generateIceCandidatePriority(localPreference);
+
+			try
+			{
+				auto udpSocket = new RTC::UdpSocket(this, AF_INET6);
+				RTC::IceCandidate iceCandidate(udpSocket, priority);
+
+				this->udpSockets.push_back(udpSocket);
+				this->iceLocalCandidates.push_back(iceCandidate);
+			}
+			catch (const MediaSoupError& error)
+			{
+				MS_ERROR("error adding IPv6 UDP socket: %s", error.what());
+			}
+		}
+
+		// Open a IPv4 TCP server.
+		if (tryIPv4tcp && Settings::configuration.hasIPv4)
+		{
+			uint16_t localPreference = IceCandidateDefaultLocalPriority;
+
+			if (preferIPv4)
+				localPreference += IceCandidateLocalPriorityPreferFamilyIncrement;
+			if (preferTcp)
+				localPreference += IceCandidateLocalPriorityPreferProtocolIncrement;
+
+			uint32_t priority = generateIceCandidatePriority(localPreference);
+
+			try
+			{
+				auto tcpServer = new RTC::TcpServer(this, this, AF_INET);
+				RTC::IceCandidate iceCandidate(tcpServer, priority);
+
+				this->tcpServers.push_back(tcpServer);
+				this->iceLocalCandidates.push_back(iceCandidate);
+			}
+			catch (const MediaSoupError& error)
+			{
+				MS_ERROR("error adding IPv4 TCP server: %s", error.what());
+			}
+		}
+
+		// Open a IPv6 TCP server.
+		if (tryIPv6tcp && Settings::configuration.hasIPv6)
+		{
+			uint16_t localPreference = IceCandidateDefaultLocalPriority;
 
-					return;
-				}
+			if (preferIPv6)
+				localPreference += IceCandidateLocalPriorityPreferFamilyIncrement;
+			if (preferTcp)
+				localPreference += IceCandidateLocalPriorityPreferProtocolIncrement;
 
-				auto bitrate = uint32_t{ request->data[JsonStringBitrate].asUInt() };
+			uint32_t priority = generateIceCandidatePriority(localPreference);
 
-				if (bitrate < MinBitrate)
-					bitrate = MinBitrate;
+			try
+			{
+				auto tcpServer = new RTC::TcpServer(this, this, AF_INET6);
+				RTC::IceCandidate iceCandidate(tcpServer, priority);
 
-				this->maxBitrate = bitrate;
+				this->tcpServers.push_back(tcpServer);
+				this->iceLocalCandidates.push_back(iceCandidate);
+			}
+			catch (const MediaSoupError& error)
+			{
+				MS_ERROR("error adding IPv6 TCP server: %s", error.what());
+			}
+		}
 
-				MS_DEBUG_TAG(rbe, "transport max bitrate set to %" PRIu32 "bps", this->maxBitrate);
+		// Ensure there is at least one IP:port binding.
+		if (this->udpSockets.empty() && this->tcpServers.empty())
+		{
+			Destroy();
 
-				request->Accept();
+			MS_THROW_ERROR("could not open any IP:port");
+		}
 
-				break;
-			}
+		// Create a DTLS agent.
+		this->dtlsTransport = new RTC::DtlsTransport(this);
+	}
 
-			case Channel::Request::MethodId::TRANSPORT_CHANGE_UFRAG_PWD:
-			{
-				static const Json::StaticString JsonStringUsernameFragment{ "usernameFragment" };
-				static const Json::StaticString JsonStringPassword{ "password" };
+	/**
+	 * Opens a single UDP socket exchanging clear RTP and RTCP with a static
+	 * remote address, given now or later, or learnt from the first received
+	 * packet if comedia is set.
+	 */
+	void Transport::SetUpPlainRtp(Json::Value& data)
+	{
+		MS_TRACE();
 
-				std::string usernameFragment = Utils::Crypto::GetRandomString(16);
-				std::string password         = Utils::Crypto::GetRandomString(32);
+		static const Json::StaticString JsonStringPreferIPv6{ "preferIPv6" };
+		static const Json::StaticString JsonStringComedia{ "comedia" };
+		static const Json::StaticString JsonStringRemoteIp{ "remoteIP" };
+		static const Json::StaticString JsonStringRemotePort{ "remotePort" };
 
-				this->iceServer->SetUsernameFragment(usernameFragment);
-				this->iceServer->SetPassword(password);
+		int family{ AF_INET };
 
-				Json::Value data(Json::objectValue);
+		this->plainRtp = true;
 
-				data[JsonStringUsernameFragment] = this->iceServer->GetUsernameFragment();
-				data[JsonStringPassword]         = this->iceServer->GetPassword();
+		if (data[JsonStringComedia].isBool())
+			this->comedia = data[JsonStringComedia].asBool();
 
-				request->Accept(data);
+		if (!Settings::configuration.hasIPv4 ||
+		    (Settings::configuration.hasIPv6 && data[JsonStringPreferIPv6].isBool() &&
+		     data[JsonStringPreferIPv6].asBool()))
+		{
+			family = AF_INET6;
+		}
 
-				break;
-			}
+		try
+		{
+			this->udpSockets.push_back(new RTC::UdpSocket(this, family));
 
-			default:
+			if (data[JsonStringRemoteIp].isString() || data[JsonStringRemotePort].isUInt())
 			{
-				MS_ERROR("unknown method");
+				if (!data[JsonStringRemoteIp].isString() || !data[JsonStringRemotePort].isUInt())
+					MS_THROW_ERROR("missing remoteIP or remotePort");
 
-				request->Reject("unknown method");
+				if (data[JsonStringRemotePort].asUInt() > UINT16_MAX)
+					MS_THROW_ERROR("invalid remotePort");
+
+				SetRemoteParameters(
+				    data[JsonStringRemoteIp].asString(), data[JsonStringRemotePort].asUInt());
 			}
 		}
+		catch (const MediaSoupError& /*error*/)
+		{
+			Destroy();
+
+			throw;
+		}
 	}
 
-	void Transport::SendRtpPacket(RTC::RtpPacket* packet)
+	/**
+	 * Validates the given remote address and sends RTP and RTCP to it from now on.
+	 */
+	void Transport::SetRemoteParameters(const std::string& ip, uint16_t port)
 	{
 		MS_TRACE();
 
-		// If there is no selected tuple do nothing.
-		if (this->selectedTuple == nullptr)
-			return;
+		// clang-format off
+		struct sockaddr_storage addr{};
+		// clang-format on
+		int err;
 
-		// Ensure there is sending SRTP session.
-		if (this->srtpSendSession == nullptr)
+		switch (Utils::IP::GetFamily(ip))
 		{
-			MS_WARN_DEV("ignoring RTP packet due to non sending SRTP session");
+			case AF_INET:
+				err = uv_ip4_addr(
+				    ip.c_str(), static_cast<int>(port), reinterpret_cast<struct sockaddr_in*>(&addr));
+				break;
 
-			return;
+			case AF_INET6:
+				err = uv_ip6_addr(
+				    ip.c_str(), static_cast<int>(port), reinterpret_cast<struct sockaddr_in6*>(&addr));
+				break;
+
+			default:
+				MS_THROW_ERROR("invalid remote IP '%s'", ip.c_str());
 		}
 
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
+		if (err != 0)
+			MS_THROW_ERROR("invalid remote IP '%s': %s", ip.c_str(), uv_strerror(err));
 
-		if (!this->srtpSendSession->EncryptRtp(&data, &len))
-			return;
+		if (port == 0)
+			MS_THROW_ERROR("invalid remote port 0");
 
-		this->selectedTuple->Send(data, len);
+		if (Utils::IP::GetFamily(ip) != this->udpSockets[0]->GetLocalFamily())
+			MS_THROW_ERROR("remote IP '%s' of a different family than the local one", ip.c_str());
+
+		SetPlainTuple(reinterpret_cast<struct sockaddr*>(&addr));
 	}
 
-	void Transport::SendRtcpPacket(RTC::RTCP::Packet* packet)
+	void Transport::SetPlainTuple(const struct sockaddr* remoteAddr)
 	{
 		MS_TRACE();
 
-		// If there is no selected tuple do nothing.
-		if (this->selectedTuple == nullptr)
-			return;
+		static const Json::StaticString JsonStringClass{ "class" };
+		static const Json::StaticString JsonStringTuple{ "tuple" };
 
-		// Ensure there is sending SRTP session.
-		if (this->srtpSendSession == nullptr)
+		// Same remote IP and port, nothing changes.
+		if (
+		    this->plainTuple != nullptr &&
+		    Utils::IP::CompareAddresses(this->plainTuple->GetRemoteAddress(), remoteAddr))
 		{
-			MS_WARN_DEV("ignoring RTCP packet due to non sending SRTP session");
-
 			return;
 		}
 
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
+		Json::Value eventData(Json::objectValue);
+
+		delete this->plainTuple;
 
-		if (!this->srtpSendSession->EncryptRtcp(&data, &len))
+		this->plainTuple = new RTC::TransportTuple(this->udpSockets[0], remoteAddr);
+		this->plainTuple->StoreUdpRemoteAddress();
+		this->selectedTuple = this->plainTuple;
+
+		// Not yet allocated when given in the constructor. The initial tuple is
+		// then given in the response to the creation request instead.
+		if (!this->allocated)
 			return;
 
-		this->selectedTuple->Send(data, len);
+		// Notify.
+		eventData[JsonStringClass] = "Transport";
+		eventData[JsonStringTuple] = this->plainTuple->ToJson();
+		this->notifier->Emit(this->transportId, "tuplechange", eventData);
+
+		this->listener->OnTransportConnected(this);
 	}
 
-	void Transport::SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet)
+	/**
+	 * Whether data coming from the given tuple is accepted. With comedia the
+	 * first tuple sending data becomes the remote one.
+	 */
+	bool Transport::IsValidPlainTuple(const RTC::TransportTuple* tuple)
 	{
 		MS_TRACE();
 
-		// If there is no selected tuple do nothing.
-		if (this->selectedTuple == nullptr)
-			return;
-
-		// Ensure there is sending SRTP session.
-		if (this->srtpSendSession == nullptr)
-		{
-			MS_WARN_DEV("ignoring RTCP packet due to non sending SRTP session");
+		if (this->plainTuple != nullptr)
+			return this->plainTuple->Compare(tuple);
 
-			return;
-		}
+		if (!this->comedia)
+			return false;
 
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
+		MS_DEBUG_TAG(rtp, "comedia enabled, using the remote address of the first received packet");
 
-		if (!this->srtpSendSession->EncryptRtcp(&data, &len))
-			return;
+		SetPlainTuple(tuple->GetRemoteAddress());
 
-		this->selectedTuple->Send(data, len);
+		return true;
 	}
 
 	inline void Transport::MayRunDtlsTransport()
@@ -699,6 +1009,14 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		// Just RTCP and RTP in a plain RTP transport.
+		if (this->plainRtp && !RTCP::Packet::IsRtcp(data, len) && !RtpPacket::IsRtp(data, len))
+		{
+			MS_WARN_DEV("ignoring received packet of unknown type");
+
+			return;
+		}
+
 		// Check if it's STUN.
 		if (StunMessage::IsStun(data, len))
 		{
@@ -778,52 +1096,65 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		// Ensure DTLS is connected.
-		if (this->dtlsTransport->GetState() != RTC::DtlsTransport::DtlsState::CONNECTED)
+		if (this->plainRtp)
 		{
-			MS_DEBUG_2TAGS(dtls, rtp, "ignoring RTP packet while DTLS not connected");
+			// Ensure it comes from the remote tuple.
+			if (!IsValidPlainTuple(tuple))
+			{
+				MS_WARN_TAG(rtp, "ignoring RTP packet coming from an invalid tuple");
 
-			return;
+				return;
+			}
 		}
-
-		// Ensure there is receiving SRTP session.
-		if (this->srtpRecvSession == nullptr)
+		else
 		{
-			MS_DEBUG_TAG(srtp, "ignoring RTP packet due to non receiving SRTP session");
-
-			return;
-		}
+			// Ensure DTLS is connected.
+			if (this->dtlsTransport->GetState() != RTC::DtlsTransport::DtlsState::CONNECTED)
+			{
+				MS_DEBUG_2TAGS(dtls, rtp, "ignoring RTP packet while DTLS not connected");
 
-		// Ensure it comes from a valid tuple.
-		if (!this->iceServer->IsValidTuple(tuple))
-		{
-			MS_WARN_TAG(rtp, "ignoring RTP packet coming from an invalid tuple");
+				return;
+			}
 
-			return;
-		}
+			// Ensure there is receiving SRTP session.
+			if (this->srtpRecvSession == nullptr)
+			{
+				MS_DEBUG_TAG(srtp, "ignoring RTP packet due to non receiving SRTP session");
 
-		// Decrypt the SRTP packet.
-		if (!this->srtpRecvSession->DecryptSrtp(data, &len))
-		{
-			RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
+				return;
+			}
 
-			if (packet == nullptr)
+			// Ensure it comes from a valid tuple.
+			if (!this->iceServer->IsValidTuple(tuple))
 			{
-				MS_WARN_TAG(srtp, "DecryptSrtp() failed due to an invalid RTP packet");
+				MS_WARN_TAG(rtp, "ignoring RTP packet coming from an invalid tuple");
+
+				return;
 			}
-			else
+
+			// Decrypt the SRTP packet.
+			if (!this->srtpRecvSession->DecryptSrtp(data, &len))
 			{
-				MS_WARN_TAG(
-				    srtp,
-				    "DecryptSrtp() failed [ssrc:%" PRIu32 ", payloadType:%" PRIu8 ", seq:%" PRIu16 "]",
-				    packet->GetSsrc(),
-				    packet->GetPayloadType(),
-				    packet->GetSequenceNumber());
-
-				delete packet;
-			}
+				RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
 
-			return;
+				if (packet == nullptr)
+				{
+					MS_WARN_TAG(srtp, "DecryptSrtp() failed due to an invalid RTP packet");
+				}
+				else
+				{
+					MS_WARN_TAG(
+					    srtp,
+					    "DecryptSrtp() failed [ssrc:%" PRIu32 ", payloadType:%" PRIu8 ", seq:%" PRIu16 "]",
+					    packet->GetSsrc(),
+					    packet->GetPayloadType(),
+					    packet->GetSequenceNumber());
+
+					delete packet;
+				}
+
+				return;
+			}
 		}
 
 		RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
@@ -858,23 +1189,12 @@ namespace RTC
 		    rtpReceiver->rtpReceiverId);
 
 		// Trick for clients performing aggressive ICE regardless we are ICE-Lite.
-		this->iceServer->ForceSelectedTuple(tuple);
+		if (!this->plainRtp)
+			this->iceServer->ForceSelectedTuple(tuple);
 
 		// Pass the RTP packet to the corresponding RtpReceiver.
 		rtpReceiver->ReceiveRtpPacket(packet);
 
-		// Feed the remote bitrate estimator (REMB).
-		if (this->remoteBitrateEstimator)
-		{
-			uint32_t absSendTime;
-
-			if (packet->ReadAbsSendTime(&absSendTime))
-			{
-				this->remoteBitrateEstimator->IncomingPacket(
-				    DepLibUV::GetTime(), packet->GetPayloadLength(), *packet, absSendTime);
-			}
-		}
-
 		delete packet;
 	}
 
@@ -882,56 +1202,60 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		// Ensure DTLS is connected.
-		if (this->dtlsTransport->GetState() != RTC::DtlsTransport::DtlsState::CONNECTED)
+		if (this->plainRtp)
 		{
-			MS_DEBUG_2TAGS(dtls, rtcp, "ignoring RTCP packet while DTLS not connected");
+			// Ensure it comes from the remote tuple.
+			if (!IsValidPlainTuple(tuple))
+			{
+				MS_WARN_TAG(rtcp, "ignoring RTCP packet coming from an invalid tuple");
 
-			return;
+				return;
+			}
 		}
-
-		// Ensure there is receiving SRTP session.
-		if (this->srtpRecvSession == nullptr)
+		else
 		{
-			MS_DEBUG_TAG(srtp, "ignoring RTCP packet due to non receiving SRTP session");
+			// Ensure DTLS is connected.
+			if (this->dtlsTransport->GetState() != RTC::DtlsTransport::DtlsState::CONNECTED)
+			{
+				MS_DEBUG_2TAGS(dtls, rtcp, "ignoring RTCP packet while DTLS not connected");
 
-			return;
-		}
+				return;
+			}
 
-		// Ensure it comes from a valid tuple.
-		if (!this->iceServer->IsValidTuple(tuple))
-		{
-			MS_WARN_TAG(rtcp, "ignoring RTCP packet coming from an invalid tuple");
+			// Ensure there is receiving SRTP session.
+			if (this->srtpRecvSession == nullptr)
+			{
+				MS_DEBUG_TAG(srtp, "ignoring RTCP packet due to non receiving SRTP session");
 
-			return;
-		}
+				return;
+			}
 
-		// Decrypt the SRTCP packet.
-		if (!this->srtpRecvSession->DecryptSrtcp(data, &len))
-			return;
+			// Ensure it comes from a valid tuple.
+			if (!this->iceServer->IsValidTuple(tuple))
+			{
+				MS_WARN_TAG(rtcp, "ignoring RTCP packet coming from an invalid tuple");
+
+				return;
+			}
+
+			// Decrypt the SRTCP packet.
+			if (!this->srtpRecvSession->DecryptSrtcp(data, &len))
+				return;
+		}
 
-		RTC::RTCP::Packet* packet = RTC::RTCP::Packet::Parse(data, len);
+		RTC::RTCP::CompoundPacketView compoundPacket(data, len);
 
-		if (packet == nullptr)
+		if (!compoundPacket.IsValid())
 		{
 			MS_WARN_TAG(rtcp, "received data is not a valid RTCP compound or single packet");
 
 			return;
 		}
 
-		this->listener->OnTransportRtcpPacket(this, packet);
+		this->listener->OnTransportRtcpPacket(this, compoundPacket);
 
 		// Trick for clients performing aggressive ICE regardless we are ICE-Lite.
 		// this->iceServer->ForceSelectedTuple(tuple);
-
-		// Delete the whole packet.
-		while (packet != nullptr)
-		{
-			RTC::RTCP::Packet* nextPacket = packet->GetNext();
-
-			delete packet;
-			packet = nextPacket;
-		}
 	}
 
 	void Transport::OnPacketRecv(
@@ -1242,12 +1566,7 @@ namespace RTC
 			    ssrcsStream.str().c_str());
 		}
 
-		RTC::RTCP::FeedbackPsRembPacket packet(0, 0);
-
-		packet.SetBitrate(effectiveBitrate);
-		packet.SetSsrcs(ssrcs);
-		packet.Serialize(RTC::RTCP::Buffer);
-		this->SendRtcpPacket(&packet);
+		this->rtcpScheduler->SendRemb(effectiveBitrate, ssrcs);
 
 		// Trigger a full frame for all the suitable strams if the effective max bitrate
 		// has decreased abruptly.
@@ -1266,4 +1585,100 @@ namespace RTC
 			this->effectiveMaxBitrate       = effectiveBitrate;
 		}
 	}
+
+	void Transport::OnPacerRtpPacket(RTC::Pacer* /*pacer*/, RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		// The tuple or the SRTP session may have gone while the packet was queued.
+		if (this->selectedTuple == nullptr || (!this->plainRtp && this->srtpSendSession == nullptr))
+			return;
+
+		// Overwrite the transport-wide sequence number with ours so the remote
+		// transport feedback refers to this transport.
+		uint16_t wideSeqNumber;
+
+		if (packet->ReadTransportWideCc01(&wideSeqNumber))
+		{
+			wideSeqNumber =
+			    this->sendSideBandwidthEstimator->RtpPacketSent(packet->GetSize(), DepLibUV::GetTime());
+
+			packet->UpdateTransportWideCc01(wideSeqNumber);
+		}
+
+		const uint8_t* data = packet->GetData();
+		size_t len          = packet->GetSize();
+
+		if (!this->plainRtp && !this->srtpSendSession->EncryptRtp(&data, &len))
+			return;
+
+		this->selectedTuple->Send(data, len);
+	}
+
+	void Transport::OnTransportFeedback(
+	    RTC::TransportFeedbackGenerator* /*transportFeedbackGenerator*/,
+	    RTC::RTCP::FeedbackRtpTransportPacket* packet)
+	{
+		MS_TRACE();
+
+		packet->Serialize(RTC::RTCP::Buffer);
+		this->SendRtcpPacket(packet);
+	}
+
+	void Transport::OnSendSideBandwidthEstimation(
+	    RTC::SendSideBandwidthEstimator* /*sendSideBandwidthEstimator*/, uint32_t availableBitrate)
+	{
+		MS_TRACE();
+
+		this->pacer->SetBitrate(availableBitrate);
+
+		// The estimated bitrate is the session bandwidth for the RTCP intervals.
+		this->rtcpScheduler->SetBitrate(availableBitrate);
+
+		this->listener->OnTransportAvailableBitrateChange(this, availableBitrate);
+	}
+
+	void Transport::OnRtcpSchedulerPacket(
+	    RTC::RtcpScheduler* /*rtcpScheduler*/, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		// If there is no selected tuple do nothing.
+		if (this->selectedTuple == nullptr)
+			return;
+
+		// Ensure there is sending SRTP session.
+		if (!this->plainRtp && this->srtpSendSession == nullptr)
+		{
+			MS_WARN_DEV("ignoring RTCP packet due to non sending SRTP session");
+
+			return;
+		}
+
+		if (!this->plainRtp && !this->srtpSendSession->EncryptRtcp(&data, &len))
+			return;
+
+		this->selectedTuple->Send(data, len);
+	}
+
+	bool Transport::OnDumpWriterStep(Channel::DumpWriter* dumpWriter, size_t step, Json::Value& data)
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringRtpListener{ "rtpListener" };
+
+		// The RtpListener tables grow with the streams, so send them apart.
+		if (step == 0)
+		{
+			data[JsonStringRtpListener] = this->rtpListener.ToJson();
+
+			return false;
+		}
+
+		data = ToJson(false);
+
+		this->dumpWriters.erase(dumpWriter);
+
+		return true;
+	}
 } // namespace RTC
@@ -0,0 +1,159 @@
+#define MS_CLASS "RTC::TransportFeedbackGenerator"
+// #define MS_LOG_DEV
+
+#include "RTC/TransportFeedbackGenerator.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr uint64_t FeedbackInterval{ 100 }; // In ms.
+	// Send the feedback right away if too many packets are waiting.
+	static constexpr size_t MaxPendingPackets{ 1000 };
+	// Ignore packets this much older than the newest one.
+	static constexpr int64_t MaxReorderDistance{ 1000 };
+
+	/* Instance methods. */
+
+	TransportFeedbackGenerator::TransportFeedbackGenerator(Listener* listener) : listener(listener)
+	{
+		MS_TRACE();
+
+		// Set the timer.
+		this->timer = new Timer(this);
+	}
+
+	TransportFeedbackGenerator::~TransportFeedbackGenerator()
+	{
+		MS_TRACE();
+
+		// Close the timer.
+		this->timer->Destroy();
+	}
+
+	Json::Value TransportFeedbackGenerator::ToJson() const
+	{
+		MS_TRACE();
+
+		static const Json::StaticString JsonStringPacketsReceived{ "packetsReceived" };
+		static const Json::StaticString JsonStringFeedbackPacketsSent{ "feedbackPacketsSent" };
+
+		Json::Value json(Json::objectValue);
+
+		json[JsonStringPacketsReceived]     = Json::UInt64{ this->packetsReceived };
+		json[JsonStringFeedbackPacketsSent] = Json::UInt64{ this->feedbackPacketsSent };
+
+		return json;
+	}
+
+	/**
+	 * @param arrivalTime  In microseconds.
+	 */
+	void TransportFeedbackGenerator::IncomingPacket(
+	    uint64_t arrivalTime, uint32_t ssrc, uint16_t wideSeqNumber)
+	{
+		MS_TRACE();
+
+		int64_t wideSeq;
+
+		if (!this->started)
+		{
+			wideSeq = wideSeqNumber;
+
+			this->started     = true;
+			this->lastWideSeq = wideSeq;
+			this->nextWideSeq = wideSeq;
+		}
+		else
+		{
+			wideSeq = this->lastWideSeq + static_cast<int16_t>(
+			                                  wideSeqNumber - static_cast<uint16_t>(this->lastWideSeq));
+		}
+
+		// Already reported or too old.
+		if (wideSeq < this->nextWideSeq || this->lastWideSeq - wideSeq > MaxReorderDistance)
+		{
+			MS_DEBUG_DEV("ignoring old packet [wide seq:%" PRIu16 "]", wideSeqNumber);
+
+			return;
+		}
+
+		if (wideSeq > this->lastWideSeq)
+			this->lastWideSeq = wideSeq;
+
+		this->arrivalTimes[wideSeq] = arrivalTime;
+		this->mediaSsrc             = ssrc;
+		this->packetsReceived++;
+
+		if (this->arrivalTimes.size() >= MaxPendingPackets)
+			SendFeedback();
+		else if (!this->timer->IsActive())
+			this->timer->Start(FeedbackInterval, FeedbackInterval);
+	}
+
+	void TransportFeedbackGenerator::SendFeedback()
+	{
+		MS_TRACE();
+
+		auto it = this->arrivalTimes.begin();
+
+		// Each iteration fills a feedback packet.
+		while (it != this->arrivalTimes.end())
+		{
+			RTC::RTCP::FeedbackRtpTransportPacket packet(0, this->mediaSsrc);
+			int64_t wideSeq        = it->first;
+			uint32_t referenceTime = static_cast<uint32_t>(
+			    it->second / (RTC::RTCP::FeedbackRtpTransportPacket::ReferenceTimeUnit * 1000));
+			// Times in DeltaUnit.
+			int64_t lastTime = static_cast<int64_t>(referenceTime) *
+			                   RTC::RTCP::FeedbackRtpTransportPacket::ReferenceTimeUnit * 1000 /
+			                   RTC::RTCP::FeedbackRtpTransportPacket::DeltaUnit;
+			bool full{ false };
+
+			packet.SetBase(static_cast<uint16_t>(wideSeq), referenceTime, this->feedbackPacketCount++);
+
+			while (it != this->arrivalTimes.end() && !full)
+			{
+				// Lost packets.
+				for (; wideSeq < it->first && !full; ++wideSeq)
+				{
+					full = !packet.AddPacket(false, 0);
+				}
+
+				if (full)
+					break;
+
+				int64_t time =
+				    static_cast<int64_t>(it->second) / RTC::RTCP::FeedbackRtpTransportPacket::DeltaUnit;
+
+				if (!packet.AddPacket(true, static_cast<int32_t>(time - lastTime)))
+					break;
+
+				lastTime = time;
+				++wideSeq;
+				++it;
+			}
+
+			this->listener->OnTransportFeedback(this, &packet);
+			this->feedbackPacketsSent++;
+		}
+
+		this->arrivalTimes.clear();
+		this->nextWideSeq = this->lastWideSeq + 1;
+	}
+
+	inline void TransportFeedbackGenerator::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		if (this->arrivalTimes.empty())
+		{
+			this->timer->Stop();
+
+			return;
+		}
+
+		SendFeedback();
+	}
+} // namespace RTC
@@ -1,5 +1,4 @@
 #include "RTC/VP9Filter.hpp"
-#include "handles/Timer.hpp"
 
 namespace VP9
 {
@@ -32,11 +31,19 @@ namespace VP9
     
     uint32_t VP9InterPictureDependency::Parse(uint8_t* data, uint32_t size)
     {
+        //Check length
+        if (size<1)
+            //Error
+            return 0;
         //Get values
         temporalLayerId = data[0] >> 5;
         switchingPoint  = data[0] & 0x10;
         //Number of pdifs
         uint8_t pdifs = data[0] >> 2 & 0x03;
+        //Ensure length
+        if (1u+pdifs>size)
+            //Error
+            return 0;
         //Get each one
         for (uint8_t j=0;j<pdifs;++j)
             //Get it
@@ -141,7 +148,7 @@ namespace VP9
         //Parse header
         numberSpatialLayers			= (data[0] >> 5) + 1;
         spatialLayerFrameResolutionPresent	= data[0] & 0x10;
-        groupOfFramesDescriptionPresent		= data[0] & 0x0F;
+        groupOfFramesDescriptionPresent		= data[0] & 0x08;
         
         //Heder
         uint32_t len =  1;
@@ -171,6 +178,10 @@ namespace VP9
         //Is gof description present
         if (groupOfFramesDescriptionPresent)
         {
+            //Endusre lenght
+            if (len>=size)
+                //Error
+                return 0;
             //Get number of frames in group
             uint8_t n = data[len];
             //Inc len
@@ -597,10 +608,15 @@ namespace VP9
         VP9PayloadDescription desc;
         
         //Parse VP9 payload description
-        if (!desc.Parse(packet->GetPayload(), 1700))
+        if (!desc.Parse(packet->GetPayload(), packet->GetPayloadLength()))
             //Error
             return 0;
         
+        return Select(packet, desc, extSeqNum, mark);
+    }
+    
+    bool VP9LayerSelector::Select(RTC::RtpPacket *packet,const VP9PayloadDescription &desc,uint32_t &extSeqNum,bool &mark)
+    {
         //if (desc.startOfLayerFrame)
         //	UltraDebug("-VP9LayerSelector::Select() | #%d T%dS%d P=%d D=%d S=%d %s\n", desc.pictureId-42,desc.temporalLayerId,desc.spatialLayerId,desc.interPicturePredictedLayerFrame,desc.interlayerDependencyUsed,desc.switchingPoint
         //		,desc.interPicturePredictedLayerFrame==0 && desc.spatialLayerId==1 ? "<----------------------":"");
@@ -688,89 +704,4 @@ namespace VP9
         return true;
         
     }
-
-    const uint64_t dropTimerInterval = 6000;
-    const uint64_t keepTimerInterval = 2000;
-    
-    
-    VP9AudioLevelSelector::VP9AudioLevelSelector():dropped(0),lastFilteredPacketNumber(0)
-    {
-        this->dropTimer = new Timer(this);
-        this->keepTimer = new Timer(this);
-    };
-    
-    VP9AudioLevelSelector::~VP9AudioLevelSelector()
-    {
-        this->dropTimer->Destroy();
-        this->keepTimer->Destroy();
-    }
-    
-    bool VP9AudioLevelSelector::Select(RTC::RtpPacket *packet, bool forceSelect, uint32_t &extSeqNum,bool &mark)
-    {
-        bool selected = true;
-        if (forceSelect)
-        {
-            // no need to filter packets - stop timers and update packet number
-            dropTimer->Stop();
-            keepTimer->Stop();
-        }
-        else
-        {
-            // filter packet
-            VP9PayloadDescription desc;
-            //Parse VP9 payload description
-            if (!desc.Parse(packet->GetPayload(), 1700))
-                //Error
-                return 0;
-            // check if we need to filter current packet
-            if(lastFilteredPacketNumber + 1 == packet->GetExtendedSequenceNumber())
-            {
-                // we checked prev packet and also need to check this one
-                if (dropTimer->IsActive())
-                {
-                    // drop packet
-                    dropped++;
-                    selected = false;
-                }
-                // increase counters
-                lastFilteredPacketNumber = packet->GetExtendedSequenceNumber();
-            }
-            else
-            {
-                dropTimer->Stop();
-                keepTimer->Stop();
-                //we dont chek prev packet wait end of frame
-                if (desc.endOfLayerFrame)
-                {
-                    lastFilteredPacketNumber = packet->GetExtendedSequenceNumber();
-                    dropTimer->Start(dropTimerInterval);
-                }
-            }
-        }
-        // update counters
-        if(selected)
-        {
-            //Calculate new packet number removing the dropped pacekts by the selection layer
-            extSeqNum = packet->GetExtendedSequenceNumber() - dropped;
-            //RTP mark is set for the last frame layer of the selected layer
-            mark = packet->HasMarker();
-        }
-        return selected;
-    }
-    
-    inline void VP9AudioLevelSelector::OnTimer(Timer* timer)
-    {
-        if (timer == dropTimer)
-        {
-            dropTimer->Stop();
-            keepTimer->Start(keepTimerInterval);
-        }
-        else if (timer == keepTimer)
-        {
-            keepTimer->Stop();
-            dropTimer->Start(dropTimerInterval);
-        }
-    }
-    
-    
 }
@@ -69,8 +69,13 @@ void Settings::SetConfiguration(int argc, char* argv[])
         { "vp9MinSpartial",      optional_argument, nullptr, 's' },
         { "vp9MinTemporial",     optional_argument, nullptr, 'T' },
         { "needToFilterAudioLevels",     optional_argument, nullptr, 'a' },
+		{ "nackAggregationWindow",      optional_argument, nullptr, 'n' },
+		{ "keyFrameRequestMinInterval", optional_argument, nullptr, 'k' },
+		{ "keyFrameCacheSize",          optional_argument, nullptr, 'K' },
+		{ "retransmissionBudget",       optional_argument, nullptr, 'b' },
 		{ "dtlsCertificateFile", optional_argument, nullptr, 'c' },
 		{ "dtlsPrivateKeyFile",  optional_argument, nullptr, 'p' },
+		{ "channelFormat",       optional_argument, nullptr, 'f' },
 		{ nullptr, 0, nullptr, 0 }
 	};
 	// clang-format on
@@ -138,6 +143,22 @@ void Settings::SetConfiguration(int argc, char* argv[])
                 Settings::configuration.needToFilterAudioLevels = (stringValue == "true" || stringValue == "TRUE") ? true : false;
                 break;
 
+			case 'n':
+				Settings::configuration.nackAggregationWindow = std::stoi(optarg);
+				break;
+
+			case 'k':
+				Settings::configuration.keyFrameRequestMinInterval = std::stoi(optarg);
+				break;
+
+			case 'K':
+				Settings::configuration.keyFrameCacheSize = std::stoi(optarg);
+				break;
+
+			case 'b':
+				Settings::configuration.retransmissionBudget = std::stoi(optarg);
+				break;
+
 			case 'c':
 				stringValue                                 = std::string(optarg);
 				Settings::configuration.dtlsCertificateFile = stringValue;
@@ -148,6 +169,17 @@ void Settings::SetConfiguration(int argc, char* argv[])
 				Settings::configuration.dtlsPrivateKeyFile = stringValue;
 				break;
 
+			case 'f':
+				stringValue = std::string(optarg);
+
+				if (stringValue == "binary")
+					Settings::configuration.binaryChannel = true;
+				else if (stringValue == "json")
+					Settings::configuration.binaryChannel = false;
+				else
+					MS_THROW_ERROR("invalid channelFormat '%s'", stringValue.c_str());
+				break;
+
 			// Invalid option.
 			case '?':
 				if (isprint(optopt) != 0)
@@ -268,6 +300,16 @@ void Settings::PrintConfiguration()
 	}
 	MS_DEBUG_TAG(info, "  rtcMinPort          : %" PRIu16, Settings::configuration.rtcMinPort);
 	MS_DEBUG_TAG(info, "  rtcMaxPort          : %" PRIu16, Settings::configuration.rtcMaxPort);
+	MS_DEBUG_TAG(
+	    info, "  nackAggregationWindow      : %" PRIu32, Settings::configuration.nackAggregationWindow);
+	MS_DEBUG_TAG(
+	    info,
+	    "  keyFrameRequestMinInterval : %" PRIu32,
+	    Settings::configuration.keyFrameRequestMinInterval);
+	MS_DEBUG_TAG(
+	    info, "  keyFrameCacheSize          : %" PRIu32, Settings::configuration.keyFrameCacheSize);
+	MS_DEBUG_TAG(
+	    info, "  retransmissionBudget       : %" PRIu32, Settings::configuration.retransmissionBudget);
 	if (!Settings::configuration.dtlsCertificateFile.empty())
 	{
 		MS_DEBUG_TAG(
@@ -276,6 +318,11 @@ void Settings::PrintConfiguration()
 		    info, "  dtlsPrivateKeyFile  : \"%s\"", Settings::configuration.dtlsPrivateKeyFile.c_str());
 	}
 
+	MS_DEBUG_TAG(
+	    info,
+	    "  channelFormat       : \"%s\"",
+	    Settings::configuration.binaryChannel ? "binary" : "json");
+
 	MS_DEBUG_TAG(info, "</configuration>");
 }
 
@@ -0,0 +1,85 @@
+/**
+ * NOTE: This code cannot log to the Channel since the Channel uses it.
+ */
+
+#define MS_CLASS "Check"
+// #define MS_LOG_DEV
+
+#include "handles/Check.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupError.hpp"
+
+/* Static methods for UV callbacks. */
+
+inline static void onCheck(uv_check_t* handle)
+{
+	static_cast<Check*>(handle->data)->OnUvCheck();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+/* Instance methods. */
+
+Check::Check(Listener* listener) : listener(listener)
+{
+	MS_TRACE_STD();
+
+	int err;
+
+	this->uvHandle = new uv_check_t;
+	uvHandle->data = (void*)this;
+
+	err = uv_check_init(DepLibUV::GetLoop(), this->uvHandle);
+	if (err != 0)
+	{
+		delete this->uvHandle;
+		this->uvHandle = nullptr;
+
+		MS_THROW_ERROR_STD("uv_check_init() failed: %s", uv_strerror(err));
+	}
+}
+
+void Check::Destroy()
+{
+	MS_TRACE_STD();
+
+	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+
+	// Delete this.
+	delete this;
+}
+
+void Check::Start()
+{
+	MS_TRACE_STD();
+
+	if (uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) != 0)
+		return;
+
+	int err = uv_check_start(this->uvHandle, static_cast<uv_check_cb>(onCheck));
+
+	if (err != 0)
+		MS_THROW_ERROR_STD("uv_check_start() failed: %s", uv_strerror(err));
+}
+
+void Check::Stop()
+{
+	MS_TRACE_STD();
+
+	int err = uv_check_stop(this->uvHandle);
+
+	if (err != 0)
+		MS_THROW_ERROR_STD("uv_check_stop() failed: %s", uv_strerror(err));
+}
+
+inline void Check::OnUvCheck()
+{
+	MS_TRACE_STD();
+
+	// Notify the listener.
+	this->listener->OnCheck(this);
+}
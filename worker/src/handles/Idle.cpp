@@ -0,0 +1,85 @@
+/**
+ * NOTE: This code cannot log to the Channel since the Channel uses it.
+ */
+
+#define MS_CLASS "Idle"
+// #define MS_LOG_DEV
+
+#include "handles/Idle.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupError.hpp"
+
+/* Static methods for UV callbacks. */
+
+inline static void onIdle(uv_idle_t* handle)
+{
+	static_cast<Idle*>(handle->data)->OnUvIdle();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+/* Instance methods. */
+
+Idle::Idle(Listener* listener) : listener(listener)
+{
+	MS_TRACE_STD();
+
+	int err;
+
+	this->uvHandle = new uv_idle_t;
+	uvHandle->data = (void*)this;
+
+	err = uv_idle_init(DepLibUV::GetLoop(), this->uvHandle);
+	if (err != 0)
+	{
+		delete this->uvHandle;
+		this->uvHandle = nullptr;
+
+		MS_THROW_ERROR_STD("uv_idle_init() failed: %s", uv_strerror(err));
+	}
+}
+
+void Idle::Destroy()
+{
+	MS_TRACE_STD();
+
+	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+
+	// Delete this.
+	delete this;
+}
+
+void Idle::Start()
+{
+	MS_TRACE_STD();
+
+	if (uv_is_active(reinterpret_cast<uv_handle_t*>(this->uvHandle)) != 0)
+		return;
+
+	int err = uv_idle_start(this->uvHandle, static_cast<uv_idle_cb>(onIdle));
+
+	if (err != 0)
+		MS_THROW_ERROR_STD("uv_idle_start() failed: %s", uv_strerror(err));
+}
+
+void Idle::Stop()
+{
+	MS_TRACE_STD();
+
+	int err = uv_idle_stop(this->uvHandle);
+
+	if (err != 0)
+		MS_THROW_ERROR_STD("uv_idle_stop() failed: %s", uv_strerror(err));
+}
+
+inline void Idle::OnUvIdle()
+{
+	MS_TRACE_STD();
+
+	// Notify the listener.
+	this->listener->OnIdle(this);
+}
@@ -3,6 +3,7 @@
 
 #include "handles/TcpConnection.hpp"
 #include "DepLibUV.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
 #include "Utils.hpp"
@@ -227,6 +228,7 @@ void TcpConnection::Write(const uint8_t* data, size_t len)
 void TcpConnection::Write(const uint8_t* data1, size_t len1, const uint8_t* data2, size_t len2)
 {
 	MS_TRACE();
+	MS_LATENCY_PROBE(SEND);
 
 	if (this->isClosing)
 		return;
@@ -353,6 +355,7 @@ inline void TcpConnection::OnUvReadAlloc(size_t /*suggestedSize*/, uv_buf_t* buf
 inline void TcpConnection::OnUvRead(ssize_t nread, const uv_buf_t* /*buf*/)
 {
 	MS_TRACE();
+	MS_LATENCY_IO_CALLBACK();
 
 	if (this->isClosing)
 		return;
@@ -3,6 +3,7 @@
 
 #include "handles/TcpServer.hpp"
 #include "DepLibUV.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
 #include "Utils.hpp"
@@ -198,6 +199,7 @@ bool TcpServer::SetLocalAddress()
 inline void TcpServer::OnUvConnection(int status)
 {
 	MS_TRACE();
+	MS_LATENCY_IO_CALLBACK();
 
 	if (this->isClosing)
 		return;
@@ -0,0 +1,369 @@
+#define MS_CLASS "TimerWheel"
+// #define MS_LOG_DEV
+
+#include "handles/TimerWheel.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupError.hpp"
+#include <algorithm> // std::min(), std::max()
+
+/* Static. */
+
+static constexpr uint8_t SlotBits{ 8 };
+static constexpr uint64_t SlotMask{ 0xFF };
+// Timeouts beyond the highest level are clamped.
+static constexpr uint64_t MaxTimeout{ 0xFFFFFFFF }; // In ms.
+
+/* Static methods for UV callbacks. */
+
+inline static void onTimer(uv_timer_t* /*handle*/)
+{
+	TimerWheel::OnUvTimer();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
+
+/* Class variables. */
+
+uv_timer_t* TimerWheel::uvHandle{ nullptr };
+TimerWheel::Handle* TimerWheel::slots[TimerWheel::Levels][TimerWheel::SlotsPerLevel]{};
+uint64_t TimerWheel::currentTime{ 0 };
+bool TimerWheel::armed{ false };
+uint64_t TimerWheel::armedTime{ 0 };
+size_t TimerWheel::numHandles{ 0 };
+size_t TimerWheel::numLevelHandles[TimerWheel::Levels]{};
+uint64_t TimerWheel::numWakeups{ 0 };
+uint64_t TimerWheel::numTicks{ 0 };
+uint64_t TimerWheel::numExpired{ 0 };
+uint64_t TimerWheel::numCascaded{ 0 };
+size_t TimerWheel::maxExpiredPerWakeup{ 0 };
+
+/* Class methods. */
+
+void TimerWheel::ClassInit()
+{
+	MS_TRACE();
+
+	int err;
+
+	TimerWheel::uvHandle = new uv_timer_t;
+
+	err = uv_timer_init(DepLibUV::GetLoop(), TimerWheel::uvHandle);
+	if (err != 0)
+	{
+		delete TimerWheel::uvHandle;
+		TimerWheel::uvHandle = nullptr;
+
+		MS_THROW_ERROR("uv_timer_init() failed: %s", uv_strerror(err));
+	}
+
+	TimerWheel::currentTime = DepLibUV::GetTime();
+}
+
+void TimerWheel::ClassDestroy()
+{
+	MS_TRACE();
+
+	if (TimerWheel::uvHandle == nullptr)
+		return;
+
+	uv_close(reinterpret_cast<uv_handle_t*>(TimerWheel::uvHandle), static_cast<uv_close_cb>(onClose));
+
+	TimerWheel::uvHandle = nullptr;
+	TimerWheel::armed    = false;
+}
+
+Json::Value TimerWheel::ToJson()
+{
+	MS_TRACE();
+
+	static const Json::StaticString JsonStringTimers{ "timers" };
+	static const Json::StaticString JsonStringLevels{ "levels" };
+	static const Json::StaticString JsonStringWakeups{ "wakeups" };
+	static const Json::StaticString JsonStringTicks{ "ticks" };
+	static const Json::StaticString JsonStringExpired{ "expired" };
+	static const Json::StaticString JsonStringCascaded{ "cascaded" };
+	static const Json::StaticString JsonStringMaxExpiredPerWakeup{ "maxExpiredPerWakeup" };
+
+	Json::Value json(Json::objectValue);
+	Json::Value jsonLevels(Json::arrayValue);
+
+	for (auto levelHandles : TimerWheel::numLevelHandles)
+	{
+		jsonLevels.append(Json::UInt64{ levelHandles });
+	}
+
+	json[JsonStringTimers]              = Json::UInt64{ TimerWheel::numHandles };
+	json[JsonStringLevels]              = jsonLevels;
+	json[JsonStringWakeups]             = Json::UInt64{ TimerWheel::numWakeups };
+	json[JsonStringTicks]               = Json::UInt64{ TimerWheel::numTicks };
+	json[JsonStringExpired]             = Json::UInt64{ TimerWheel::numExpired };
+	json[JsonStringCascaded]            = Json::UInt64{ TimerWheel::numCascaded };
+	json[JsonStringMaxExpiredPerWakeup] = Json::UInt64{ TimerWheel::maxExpiredPerWakeup };
+
+	return json;
+}
+
+void TimerWheel::OnUvTimer()
+{
+	MS_TRACE();
+
+	uint64_t expiredBefore = TimerWheel::numExpired;
+
+	TimerWheel::armed = false;
+	TimerWheel::numWakeups++;
+
+	Advance(DepLibUV::GetTime());
+
+	TimerWheel::maxExpiredPerWakeup = std::max(
+	    TimerWheel::maxExpiredPerWakeup, static_cast<size_t>(TimerWheel::numExpired - expiredBefore));
+
+	if (TimerWheel::numHandles != 0)
+		Schedule(GetNextEventTime());
+}
+
+/**
+ * Adds the handle to the slot of its expiration time, in the lowest level
+ * whose slots cover it.
+ */
+void TimerWheel::Insert(Handle* handle)
+{
+	uint64_t delta = handle->expiresAt - TimerWheel::currentTime;
+	uint8_t level{ 0 };
+
+	while (level < Levels - 1 && delta >= (uint64_t{ 1 } << (SlotBits * (level + 1))))
+	{
+		++level;
+	}
+
+	auto index    = static_cast<uint16_t>((handle->expiresAt >> (SlotBits * level)) & SlotMask);
+	Handle** slot = &TimerWheel::slots[level][index];
+
+	handle->level = level;
+	handle->slot  = slot;
+	handle->prev  = nullptr;
+	handle->next  = *slot;
+
+	if (*slot != nullptr)
+		(*slot)->prev = handle;
+
+	*slot = handle;
+
+	TimerWheel::numHandles++;
+	TimerWheel::numLevelHandles[level]++;
+}
+
+void TimerWheel::Remove(Handle* handle)
+{
+	if (handle->prev != nullptr)
+		handle->prev->next = handle->next;
+	else
+		*handle->slot = handle->next;
+
+	if (handle->next != nullptr)
+		handle->next->prev = handle->prev;
+
+	handle->slot = nullptr;
+	handle->prev = nullptr;
+	handle->next = nullptr;
+
+	TimerWheel::numHandles--;
+	TimerWheel::numLevelHandles[handle->level]--;
+}
+
+/**
+ * Processes every millisecond up to the given time, firing the expired
+ * handles. Runs of empty slots in the lowest level are skipped.
+ */
+void TimerWheel::Advance(uint64_t now)
+{
+	while (TimerWheel::currentTime < now)
+	{
+		if (TimerWheel::numHandles == 0)
+		{
+			TimerWheel::currentTime = now;
+
+			break;
+		}
+
+		if (TimerWheel::numLevelHandles[0] == 0)
+		{
+			uint64_t nextTurn = ((TimerWheel::currentTime >> SlotBits) + 1) << SlotBits;
+
+			if (now < nextTurn)
+			{
+				TimerWheel::currentTime = now;
+
+				break;
+			}
+
+			TimerWheel::currentTime = nextTurn - 1;
+		}
+
+		uint64_t time = ++TimerWheel::currentTime;
+
+		TimerWheel::numTicks++;
+
+		// Move down the handles of the higher level slots reached.
+		for (uint8_t level{ 1 }; level < Levels; ++level)
+		{
+			if (((time >> (SlotBits * (level - 1))) & SlotMask) != 0)
+				break;
+
+			Cascade(level, static_cast<uint16_t>((time >> (SlotBits * level)) & SlotMask));
+		}
+
+		// Fire the expired handles. Listeners may start and stop any handle.
+		Handle** slot = &TimerWheel::slots[0][time & SlotMask];
+
+		while (*slot != nullptr)
+		{
+			Handle* handle = *slot;
+
+			Remove(handle);
+
+			TimerWheel::numExpired++;
+
+			if (handle->repeat != 0)
+			{
+				handle->expiresAt = time + handle->repeat;
+
+				Insert(handle);
+			}
+
+			handle->listener->OnTimer(handle);
+		}
+	}
+}
+
+void TimerWheel::Cascade(uint8_t level, uint16_t index)
+{
+	Handle* handle = TimerWheel::slots[level][index];
+
+	TimerWheel::slots[level][index] = nullptr;
+
+	while (handle != nullptr)
+	{
+		Handle* next = handle->next;
+
+		TimerWheel::numHandles--;
+		TimerWheel::numLevelHandles[level]--;
+		TimerWheel::numCascaded++;
+
+		Insert(handle);
+
+		handle = next;
+	}
+}
+
+/**
+ * Earliest time at which a handle expires or must be moved down a level.
+ */
+uint64_t TimerWheel::GetNextEventTime()
+{
+	uint64_t nextEventTime{ UINT64_MAX };
+
+	for (uint8_t level{ 0 }; level < Levels; ++level)
+	{
+		if (TimerWheel::numLevelHandles[level] == 0)
+			continue;
+
+		uint8_t shift  = SlotBits * level;
+		uint64_t block = TimerWheel::currentTime >> shift;
+
+		for (uint16_t i{ 1 }; i <= SlotsPerLevel; ++i)
+		{
+			if (TimerWheel::slots[level][(block + i) & SlotMask] != nullptr)
+			{
+				nextEventTime = std::min(nextEventTime, (block + i) << shift);
+
+				break;
+			}
+		}
+	}
+
+	return nextEventTime;
+}
+
+/**
+ * Makes the uv timer fire at the given time unless it fires before.
+ */
+void TimerWheel::Schedule(uint64_t time)
+{
+	if (TimerWheel::uvHandle == nullptr)
+		return;
+
+	if (TimerWheel::armed && TimerWheel::armedTime <= time)
+		return;
+
+	int err;
+	uint64_t now     = DepLibUV::GetTime();
+	uint64_t timeout = time > now ? time - now : 0;
+
+	err = uv_timer_start(TimerWheel::uvHandle, static_cast<uv_timer_cb>(onTimer), timeout, 0);
+	if (err != 0)
+		MS_THROW_ERROR("uv_timer_start() failed: %s", uv_strerror(err));
+
+	TimerWheel::armed     = true;
+	TimerWheel::armedTime = time;
+}
+
+void TimerWheel::Unschedule()
+{
+	if (TimerWheel::uvHandle == nullptr || !TimerWheel::armed)
+		return;
+
+	uv_timer_stop(TimerWheel::uvHandle);
+
+	TimerWheel::armed = false;
+}
+
+/* Instance methods. */
+
+TimerWheel::Handle::Handle(Listener* listener) : listener(listener)
+{
+}
+
+TimerWheel::Handle::~Handle()
+{
+	Stop();
+}
+
+void TimerWheel::Handle::Start(uint64_t timeout, uint64_t repeat)
+{
+	MS_TRACE();
+
+	uint64_t now = DepLibUV::GetTime();
+
+	if (IsActive())
+		TimerWheel::Remove(this);
+
+	// An idle wheel has nothing to process up to now.
+	if (TimerWheel::numHandles == 0)
+		TimerWheel::currentTime = std::max(TimerWheel::currentTime, now);
+
+	// Expire at least in the next slot to be processed.
+	this->expiresAt = std::max(now + std::min(timeout, MaxTimeout), TimerWheel::currentTime + 1);
+	this->expiresAt = std::min(this->expiresAt, TimerWheel::currentTime + MaxTimeout);
+	this->repeat    = repeat;
+
+	TimerWheel::Insert(this);
+	TimerWheel::Schedule(this->expiresAt);
+}
+
+void TimerWheel::Handle::Stop()
+{
+	MS_TRACE();
+
+	if (!IsActive())
+		return;
+
+	TimerWheel::Remove(this);
+
+	// Let the loop end if there is nothing else to run.
+	if (TimerWheel::numHandles == 0)
+		TimerWheel::Unschedule();
+}
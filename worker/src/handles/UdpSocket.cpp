@@ -3,6 +3,7 @@
 
 #include "handles/UdpSocket.hpp"
 #include "DepLibUV.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
 #include "Utils.hpp"
@@ -184,6 +185,7 @@ void UdpSocket::Dump() const
 void UdpSocket::Send(const uint8_t* data, size_t len, const struct sockaddr* addr)
 {
 	MS_TRACE();
+	MS_LATENCY_PROBE(SEND);
 
 	if (this->isClosing)
 		return;
@@ -326,6 +328,7 @@ inline void UdpSocket::OnUvRecv(
     ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned int flags)
 {
 	MS_TRACE();
+	MS_LATENCY_IO_CALLBACK();
 
 	if (this->isClosing)
 		return;
@@ -8,6 +8,7 @@
 
 #include "handles/UnixStreamSocket.hpp"
 #include "DepLibUV.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include "MediaSoupError.hpp"
 #include <cstdlib> // std::malloc(), std::free()
@@ -224,6 +225,7 @@ inline void UnixStreamSocket::OnUvReadAlloc(size_t /*suggestedSize*/, uv_buf_t*
 inline void UnixStreamSocket::OnUvRead(ssize_t nread, const uv_buf_t* /*buf*/)
 {
 	MS_TRACE_STD();
+	MS_LATENCY_IO_CALLBACK();
 
 	if (nread == 0)
 		return;
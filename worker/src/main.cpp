@@ -5,6 +5,7 @@
 #include "DepLibSRTP.hpp"
 #include "DepLibUV.hpp"
 #include "DepOpenSSL.hpp"
+#include "LatencyProbes.hpp"
 #include "Logger.hpp"
 #include "Loop.hpp"
 #include "MediaSoupError.hpp"
@@ -15,6 +16,7 @@
 #include "RTC/SrtpSession.hpp"
 #include "RTC/TcpServer.hpp"
 #include "RTC/UdpSocket.hpp"
+#include "handles/TimerWheel.hpp"
 #include <uv.h>
 #include <cerrno>
 #include <csignal>  // sigaction()
@@ -64,6 +66,9 @@ int main(int argc, char* argv[])
 		exitWithError();
 	}
 
+	// Use the Channel encoding requested by the Node side.
+	channel->SetBinary(Settings::configuration.binaryChannel);
+
 	// Print the effective configuration.
 	Settings::PrintConfiguration();
 
@@ -114,6 +119,8 @@ void init()
 	DepOpenSSL::ClassInit();
 	DepLibSRTP::ClassInit();
 	Utils::Crypto::ClassInit();
+	TimerWheel::ClassInit();
+	LatencyProbes::ClassInit();
 	RTC::UdpSocket::ClassInit();
 	RTC::TcpServer::ClassInit();
 	RTC::DtlsTransport::ClassInit();
@@ -164,6 +171,8 @@ void destroy()
 
 	// Free static stuff.
 	RTC::DtlsTransport::ClassDestroy();
+	TimerWheel::ClassDestroy();
+	LatencyProbes::ClassDestroy();
 	Utils::Crypto::ClassDestroy();
 	DepLibUV::ClassDestroy();
 	DepOpenSSL::ClassDestroy();
@@ -0,0 +1,128 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "Channel/BinaryCodec.hpp"
+#include <json/json.h>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace Channel;
+
+// Hidden by default, run them with: mediasoup-worker-test [benchmark]
+
+SCENARIO("benchmark Channel message encodings", "[.][benchmark][channel]")
+{
+	static constexpr size_t Iterations{ 100000 };
+	static constexpr size_t NumEntries{ 10 };
+
+	static uint8_t buffer[65536];
+
+	// An audiolevels notification for a room with 10 speakers.
+	Json::Value json(Json::objectValue);
+	Json::Value data(Json::objectValue);
+
+	data["class"]   = "Room";
+	data["entries"] = Json::arrayValue;
+
+	for (uint32_t i = 0; i < NumEntries; ++i)
+	{
+		Json::Value entry(Json::arrayValue);
+
+		entry.append(Json::UInt{ 10000000 + i });
+		entry.append(-30 - static_cast<int>(i));
+		data["entries"].append(entry);
+	}
+
+	json["targetId"] = Json::UInt{ 12345678 };
+	json["event"]    = "audiolevels";
+	json["data"]     = data;
+
+	SECTION("JSON")
+	{
+		Json::StreamWriterBuilder builder;
+
+		builder["indentation"] = "";
+
+		std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+		size_t len{ 0 };
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			std::ostringstream stream;
+
+			writer->write(json, &stream);
+			len = stream.str().size();
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::steady_clock::now() - start);
+
+		REQUIRE(len > 0);
+
+		WARN("JSON: " << elapsed.count() / Iterations << " ns/message [" << len << " bytes]");
+	}
+
+	SECTION("binary from a Json::Value")
+	{
+		size_t len{ 0 };
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			len = BinaryCodec::Encode(json, buffer, sizeof(buffer));
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::steady_clock::now() - start);
+
+		REQUIRE(len > 0);
+
+		WARN(
+		    "binary from a Json::Value: " << elapsed.count() / Iterations << " ns/message [" << len
+		                                  << " bytes]");
+	}
+
+	SECTION("binary from typed data")
+	{
+		size_t len{ 0 };
+		auto start = std::chrono::steady_clock::now();
+
+		// As Notifier::EmitAudioLevels() does.
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			BinaryCodec::Writer writer(buffer, sizeof(buffer));
+
+			writer.WriteObject(3);
+			writer.WriteKey("targetId");
+			writer.WriteUInt(12345678);
+			writer.WriteKey("event");
+			writer.WriteString("audiolevels", 11);
+			writer.WriteKey("data");
+			writer.WriteObject(2);
+			writer.WriteKey("class");
+			writer.WriteString("Room", 4);
+			writer.WriteKey("entries");
+			writer.WriteArray(NumEntries);
+
+			for (uint32_t j = 0; j < NumEntries; ++j)
+			{
+				writer.WriteArray(2);
+				writer.WriteUInt(10000000 + j);
+				writer.WriteInt(-30 - static_cast<int>(j));
+			}
+
+			len = writer.GetLength();
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::steady_clock::now() - start);
+
+		REQUIRE(len == BinaryCodec::Encode(json, buffer, sizeof(buffer)));
+
+		WARN(
+		    "binary from typed data: " << elapsed.count() / Iterations << " ns/message [" << len
+		                               << " bytes]");
+	}
+}
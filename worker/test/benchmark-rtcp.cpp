@@ -0,0 +1,149 @@
+#include "include/catch.hpp"
+#include "include/rtcpfixtures.hpp"
+#include "common.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include "RTC/RTCP/Packet.hpp"
+#include "RTC/RTCP/PacketView.hpp"
+#include <chrono>
+
+using namespace RTC::RTCP;
+
+// Hidden by default, run them with: mediasoup-worker-test [benchmark]
+
+SCENARIO("benchmark RTCP transport feedback", "[.][benchmark][rtcp]")
+{
+	static constexpr size_t Iterations{ 100000 };
+
+	static uint8_t buffer[BufferSize];
+
+	// Typical 100 ms feedback: 100 packets with some losses and jitter.
+	FeedbackRtpTransportPacket packet(0, 1234);
+
+	packet.SetBase(1000, 12345, 0);
+
+	for (size_t i = 0; i < 100; ++i)
+	{
+		if (i % 17 == 0)
+			packet.AddPacket(false, 0);
+		else
+			packet.AddPacket(true, (i % 5 == 0) ? 300 : 4);
+	}
+
+	size_t len = packet.Serialize(buffer);
+
+	SECTION("serialize")
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			packet.Serialize(buffer);
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::steady_clock::now() - start);
+
+		WARN("serialize: " << elapsed.count() / Iterations << " ns/packet [" << len << " bytes]");
+	}
+
+	SECTION("parse")
+	{
+		size_t parsedCount{ 0 };
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			FeedbackRtpTransportPacket* parsed = FeedbackRtpTransportPacket::Parse(buffer, len);
+
+			if (parsed)
+				++parsedCount;
+
+			delete parsed;
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::steady_clock::now() - start);
+
+		REQUIRE(parsedCount == Iterations);
+
+		WARN("parse: " << elapsed.count() / Iterations << " ns/packet [" << len << " bytes]");
+	}
+}
+
+SCENARIO("benchmark RTCP compound packet parsing", "[.][benchmark][rtcp]")
+{
+	static constexpr size_t Iterations{ 1000000 };
+
+	// Compound packet of the test-rtcp.cpp tests.
+	const uint8_t* buffer = Fixtures::RtcpCompoundPacket;
+	size_t len            = sizeof(Fixtures::RtcpCompoundPacket);
+
+	SECTION("Packet::Parse()")
+	{
+		size_t parsedCount{ 0 };
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			Packet* packet = Packet::Parse(buffer, len);
+
+			while (packet != nullptr)
+			{
+				Packet* next = packet->GetNext();
+
+				++parsedCount;
+
+				delete packet;
+				packet = next;
+			}
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::steady_clock::now() - start);
+
+		REQUIRE(parsedCount == Iterations * 6);
+
+		WARN("Packet::Parse(): " << elapsed.count() / Iterations << " ns/compound packet");
+	}
+
+	SECTION("CompoundPacketView")
+	{
+		size_t parsedCount{ 0 };
+		uint64_t sum{ 0 };
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < Iterations; ++i)
+		{
+			CompoundPacketView compoundPacket(buffer, len);
+
+			for (auto it = compoundPacket.Begin(); it != compoundPacket.End(); ++it)
+			{
+				++parsedCount;
+
+				// Read what the Peer reads.
+				switch (it->GetType())
+				{
+					case Type::SR:
+						sum += it->GetSsrc() + it->GetReceiverReport(0)->lsr;
+						break;
+					case Type::RTPFB:
+						sum += it->GetNackPacketId(0);
+						break;
+					case Type::PSFB:
+						sum += it->IsRemb() ? it->GetRembBitrate() : it->GetMediaSsrc();
+						break;
+					default:;
+				}
+			}
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::steady_clock::now() - start);
+
+		// Every packet but the SR report block, given along with the SR.
+		REQUIRE(parsedCount == Iterations * 5);
+		REQUIRE(sum != 0);
+
+		WARN("CompoundPacketView: " << elapsed.count() / Iterations << " ns/compound packet");
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef MS_TEST_RTCP_FIXTURES_HPP
+#define MS_TEST_RTCP_FIXTURES_HPP
+
+#include "common.hpp"
+
+namespace Fixtures
+{
+	// Compound packet with a SR (with one report block), NACK, PLI, FIR and REMB.
+	static const uint8_t RtcpCompoundPacket[] =
+	{
+		// SenderReport with one ReceiverReport.
+		0x81, 0xc8, 0x00, 0x0c, // RTCP common header
+		0x00, 0x00, 0x04, 0xD2, // ssrc
+		0x00, 0x00, 0x04, 0xD2, // ntp sec
+		0x00, 0x00, 0x04, 0xD2, // ntp frac
+		0x00, 0x00, 0x04, 0xD2, // rtp ts
+		0x00, 0x00, 0x04, 0xD2, // packet count
+		0x00, 0x00, 0x04, 0xD2, // octet count
+		0x00, 0x00, 0x16, 0x2E, // ssrc
+		0x01,                   // fractionLost
+		0x00, 0x00, 0x04,       // totalLost
+		0x00, 0x00, 0x04, 0xD2, // lastSeq
+		0x00, 0x00, 0x04, 0xD2, // jitter
+		0x00, 0x00, 0x04, 0xD2, // lsr
+		0x00, 0x00, 0x04, 0xD2, // dlsr
+		// NACK.
+		0x81, 0xcd, 0x00, 0x03, // RTCP common header
+		0x00, 0x00, 0x00, 0x01, // sender ssrc
+		0x00, 0x00, 0x04, 0xD2, // media ssrc
+		0x09, 0xc4, 0b10101010, 0b01010101,
+		// PLI.
+		0x81, 0xce, 0x00, 0x02, // RTCP common header
+		0x00, 0x00, 0x00, 0x01, // sender ssrc
+		0x00, 0x00, 0x04, 0xD2, // media ssrc
+		// FIR.
+		0x84, 0xce, 0x00, 0x04, // RTCP common header
+		0x00, 0x00, 0x00, 0x01, // sender ssrc
+		0x00, 0x00, 0x00, 0x00, // media ssrc
+		0x00, 0x00, 0x04, 0xD2, // ssrc
+		0x08, 0x00, 0x00, 0x00, // seq nr. + reserved
+		// REMB.
+		0x8f, 0xce, 0x00, 0x06, // RTCP common header
+		0x00, 0x00, 0x00, 0x01, // sender ssrc
+		0x00, 0x00, 0x00, 0x00, // media ssrc
+		0x52, 0x45, 0x4d, 0x42, // 'R' 'E' 'M' 'B'
+		0x02, 0x09, 0x00, 0x00, // num ssrc, exponent, mantissa
+		0x00, 0x00, 0x04, 0xD2, // ssrc
+		0x00, 0x00, 0x16, 0x2E  // ssrc
+	};
+} // namespace Fixtures
+
+#endif
@@ -0,0 +1,158 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "RTC/ActiveSpeakerDetector.hpp"
+
+using namespace RTC;
+
+// Audio levels (-dBov) of speech and silence.
+static constexpr uint8_t Speech{ 20 };
+static constexpr uint8_t Silence{ 90 };
+// Audio packets are sent every 20 ms, the detector runs every 300 ms.
+static constexpr uint64_t FrameInterval{ 20 };
+static constexpr uint64_t ProcessInterval{ 300 };
+
+// Feeds the levels of both streams for the given time, alternating speech
+// and pauses for the speaking ones. Returns the number of changes.
+static size_t talk(
+  ActiveSpeakerDetector& detector, uint64_t& now, uint64_t duration, bool speaking1, bool speaking2)
+{
+	size_t changes{ 0 };
+
+	for (uint64_t elapsed{ 0 }; elapsed < duration; elapsed += FrameInterval)
+	{
+		// A short pause every half a second.
+		bool pause = (now / FrameInterval) % 25 == 0;
+
+		detector.ReceiveLevel(1, speaking1 && !pause ? Speech : Silence, now);
+		detector.ReceiveLevel(2, speaking2 && !pause ? Speech : Silence, now);
+
+		now += FrameInterval;
+
+		if (now % ProcessInterval == 0 && detector.Process(now))
+			changes++;
+	}
+
+	return changes;
+}
+
+SCENARIO("dominant speaker identification", "[activespeakerdetector]")
+{
+	uint64_t now{ 1000 };
+
+	SECTION("no dominant speaker while everybody is silent")
+	{
+		ActiveSpeakerDetector detector;
+
+		REQUIRE(talk(detector, now, 3000, false, false) == 0);
+		REQUIRE(!detector.HasDominantSpeaker());
+	}
+
+	SECTION("the speaking stream becomes the dominant speaker once")
+	{
+		ActiveSpeakerDetector detector;
+
+		REQUIRE(talk(detector, now, 3000, true, false) == 1);
+		REQUIRE(detector.HasDominantSpeaker());
+		REQUIRE(detector.GetDominantSpeaker() == 1);
+		REQUIRE(detector.GetLevel(1) > -30);
+		REQUIRE(detector.GetLevel(2) < -60);
+	}
+
+	SECTION("another speaker replaces the dominant one when it stops talking")
+	{
+		ActiveSpeakerDetector detector;
+
+		REQUIRE(talk(detector, now, 10000, true, false) == 1);
+		REQUIRE(detector.GetDominantSpeaker() == 1);
+
+		// A short interruption does not change the dominant speaker.
+		REQUIRE(talk(detector, now, 400, true, true) == 0);
+		REQUIRE(detector.GetDominantSpeaker() == 1);
+
+		REQUIRE(talk(detector, now, 5000, false, true) == 1);
+		REQUIRE(detector.GetDominantSpeaker() == 2);
+	}
+
+	SECTION("medium blocks with speech are reported")
+	{
+		ActiveSpeakerDetector detector;
+		size_t speechBlocks{ 0 };
+
+		// Set the noise floor.
+		detector.ReceiveLevel(1, Silence, now);
+
+		for (uint8_t frame{ 0 }; frame < ActiveSpeakerDetector::MediumBlockFrames * 2; ++frame)
+		{
+			if (detector.ReceiveLevel(1, Speech, now))
+				speechBlocks++;
+		}
+
+		REQUIRE(speechBlocks == 2);
+
+		for (uint8_t frame{ 0 }; frame < ActiveSpeakerDetector::MediumBlockFrames * 2; ++frame)
+		{
+			REQUIRE(!detector.ReceiveLevel(1, Silence, now));
+		}
+	}
+
+	SECTION("speech is detected in every frame")
+	{
+		ActiveSpeakerDetector detector;
+
+		REQUIRE(!detector.IsActiveFrame(1));
+
+		detector.ReceiveLevel(1, Silence, now);
+
+		REQUIRE(!detector.IsActiveFrame(1));
+
+		// Before the medium block is complete.
+		REQUIRE(!detector.ReceiveLevel(1, Speech, now));
+		REQUIRE(detector.IsActiveFrame(1));
+
+		detector.ReceiveLevel(1, Silence, now);
+
+		REQUIRE(!detector.IsActiveFrame(1));
+	}
+
+	SECTION("the dominant speaker is kept while everybody is silent")
+	{
+		ActiveSpeakerDetector detector;
+
+		talk(detector, now, 3000, true, false);
+
+		REQUIRE(talk(detector, now, 5000, false, false) == 0);
+		REQUIRE(detector.GetDominantSpeaker() == 1);
+	}
+
+	SECTION("removing the dominant speaker is a change")
+	{
+		ActiveSpeakerDetector detector;
+
+		talk(detector, now, 3000, true, false);
+		detector.RemoveStream(1);
+
+		REQUIRE(!detector.HasDominantSpeaker());
+		REQUIRE(detector.Process(now));
+		REQUIRE(!detector.Process(now));
+	}
+
+	SECTION("muted streams are silent")
+	{
+		ActiveSpeakerDetector detector;
+
+		talk(detector, now, 3000, true, false);
+
+		// Stream 1 stops sending levels while stream 2 talks.
+		for (uint64_t elapsed{ 0 }; elapsed < 5000; elapsed += FrameInterval)
+		{
+			detector.ReceiveLevel(2, Speech, now);
+
+			now += FrameInterval;
+
+			if (now % ProcessInterval == 0)
+				detector.Process(now);
+		}
+
+		REQUIRE(detector.GetDominantSpeaker() == 2);
+	}
+}
@@ -0,0 +1,156 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "Channel/BinaryCodec.hpp"
+#include <json/json.h>
+#include <cstring> // std::memcmp()
+#include <string>
+
+using namespace Channel;
+
+SCENARIO("Channel binary encoding", "[channel][binarycodec]")
+{
+	static uint8_t buffer[65536];
+
+	SECTION("values survive a round trip")
+	{
+		Json::Value json(Json::objectValue);
+		Json::Value data(Json::objectValue);
+		Json::Value levels(Json::arrayValue);
+
+		levels.append(-127);
+		levels.append(0);
+		levels.append(Json::UInt64{ 0xFFFFFFFFFFFF });
+		levels.append(-0.25);
+
+		data["levels"]  = levels;
+		data["enabled"] = true;
+		data["muted"]   = false;
+		data["none"]    = Json::nullValue;
+		data["empty"]   = Json::Value(Json::objectValue);
+
+		json["id"]       = Json::UInt{ 12345678 };
+		json["method"]   = "rtpSender.setPreferredLayers";
+		json["internal"] = Json::Value(Json::objectValue);
+		json["data"]     = data;
+
+		size_t len = BinaryCodec::Encode(json, buffer, sizeof(buffer));
+
+		REQUIRE(len > 0);
+		REQUIRE(BinaryCodec::IsBinary(buffer, len));
+
+		Json::Value decoded;
+
+		REQUIRE(BinaryCodec::Decode(buffer, len, decoded));
+		REQUIRE(decoded.size() == 4);
+		REQUIRE(decoded["id"].asUInt() == 12345678);
+		// Integers decode as the JSON reader gives them.
+		REQUIRE(decoded["id"].type() == Json::intValue);
+		REQUIRE(decoded["method"].asString() == "rtpSender.setPreferredLayers");
+		REQUIRE(decoded["internal"].isObject());
+		REQUIRE(decoded["data"]["levels"][0].asInt() == -127);
+		REQUIRE(decoded["data"]["levels"][1].asUInt() == 0);
+		REQUIRE(decoded["data"]["levels"][2].asUInt64() == 0xFFFFFFFFFFFF);
+		REQUIRE(decoded["data"]["levels"][3].asDouble() == -0.25);
+		REQUIRE(decoded["data"]["enabled"].asBool());
+		REQUIRE(!decoded["data"]["muted"].asBool());
+		REQUIRE(decoded["data"].isMember("none"));
+		REQUIRE(decoded["data"]["none"].isNull());
+		REQUIRE(decoded["data"]["empty"].empty());
+
+		// Smaller than the JSON text.
+		Json::StreamWriterBuilder builder;
+
+		builder["indentation"] = "";
+
+		REQUIRE(len < Json::writeString(builder, json).size());
+	}
+
+	SECTION("strings keep embedded zeros")
+	{
+		std::string value("a\0b", 3);
+		Json::Value json(value.data(), value.data() + value.size());
+		size_t len = BinaryCodec::Encode(json, buffer, sizeof(buffer));
+		Json::Value decoded;
+
+		REQUIRE(BinaryCodec::Decode(buffer, len, decoded));
+		REQUIRE(decoded.asString() == value);
+	}
+
+	SECTION("typed data is written as its Json::Value")
+	{
+		Json::Value json(Json::objectValue);
+		Json::Value entry(Json::arrayValue);
+
+		entry.append(1234);
+		entry.append(-30);
+
+		json["event"]   = "audiolevels";
+		json["entries"] = Json::arrayValue;
+		json["entries"].append(entry);
+
+		BinaryCodec::Writer writer(buffer, sizeof(buffer));
+
+		writer.WriteObject(2);
+		writer.WriteKey("entries");
+		writer.WriteArray(1);
+		writer.WriteArray(2);
+		writer.WriteUInt(1234);
+		writer.WriteInt(-30);
+		writer.WriteKey("event");
+		writer.WriteString("audiolevels");
+
+		size_t len = writer.GetLength();
+		Json::Value decoded;
+
+		REQUIRE(len == BinaryCodec::Encode(json, buffer + len, sizeof(buffer) - len));
+		REQUIRE(std::memcmp(buffer, buffer + len, len) == 0);
+		REQUIRE(BinaryCodec::Decode(buffer, len, decoded));
+		REQUIRE(decoded == json);
+	}
+
+	SECTION("values not fitting into the buffer are not encoded")
+	{
+		Json::Value json("a long enough string");
+
+		REQUIRE(BinaryCodec::Encode(json, buffer, 10) == 0);
+
+		BinaryCodec::Writer writer(buffer, 10);
+
+		writer.WriteString("a long enough string");
+		writer.WriteUInt(1);
+
+		REQUIRE(writer.GetLength() == 0);
+		// Marker, tag, length, 20 bytes, tag, varint.
+		REQUIRE(writer.GetNeededSize() == 25);
+		REQUIRE(writer.GetNeededSize() == BinaryCodec::Encode(json, buffer, sizeof(buffer)) + 2);
+	}
+
+	SECTION("truncated or malformed data is rejected")
+	{
+		Json::Value json(Json::arrayValue);
+		Json::Value decoded;
+
+		json.append("foo");
+		json.append(1234);
+
+		size_t len = BinaryCodec::Encode(json, buffer, sizeof(buffer));
+
+		for (size_t i{ 0 }; i < len; ++i)
+		{
+			REQUIRE(!BinaryCodec::Decode(buffer, i, decoded));
+		}
+
+		// Trailing data.
+		REQUIRE(!BinaryCodec::Decode(buffer, len + 1, decoded));
+
+		// Unknown tag.
+		buffer[1] = 0xFF;
+
+		REQUIRE(!BinaryCodec::Decode(buffer, len, decoded));
+
+		// JSON text.
+		uint8_t text[] = "{\"id\":1}";
+
+		REQUIRE(!BinaryCodec::IsBinary(text, sizeof(text) - 1));
+	}
+}
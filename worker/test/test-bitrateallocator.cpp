@@ -0,0 +1,104 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "RTC/BitrateAllocator.hpp"
+#include <vector>
+
+using namespace RTC;
+
+// Layers of 100 kbps each, so sending up to s,t costs (s+1)*(t+1)*100 kbps.
+static BitrateAllocator::Stream createStream(BitrateAllocator::Priority priority)
+{
+	BitrateAllocator::Stream stream;
+
+	stream.priority               = priority;
+	stream.preferredSpatialLayer  = 2;
+	stream.preferredTemporalLayer = 2;
+
+	for (uint8_t spatialLayer{ 0 }; spatialLayer < RtpSender::MaxSpatialLayers; ++spatialLayer)
+	{
+		for (uint8_t temporalLayer{ 0 }; temporalLayer < RtpSender::MaxTemporalLayers; ++temporalLayer)
+		{
+			stream.layersBitrate[spatialLayer][temporalLayer] =
+			  (spatialLayer + 1) * (temporalLayer + 1) * 100000;
+		}
+	}
+
+	return stream;
+}
+
+SCENARIO("bitrate allocation", "[bitrateallocator]")
+{
+	SECTION("preferred layers are sent if the available bitrate is unknown")
+	{
+		std::vector<BitrateAllocator::Stream> streams;
+
+		streams.push_back(createStream(BitrateAllocator::Priority::THUMBNAIL));
+		streams.back().preferredSpatialLayer = 1;
+
+		BitrateAllocator::Allocate(0, streams);
+
+		REQUIRE(streams[0].spatialLayer == 1);
+		REQUIRE(streams[0].temporalLayer == 2);
+	}
+
+	SECTION("the active speaker goes first, then pinned streams, then thumbnails")
+	{
+		std::vector<BitrateAllocator::Stream> streams;
+
+		streams.push_back(createStream(BitrateAllocator::Priority::THUMBNAIL));
+		streams.push_back(createStream(BitrateAllocator::Priority::PINNED));
+		streams.push_back(createStream(BitrateAllocator::Priority::ACTIVE_SPEAKER));
+
+		// Base layers (300 kbps), plus 900 - 100 for the speaker plus 200 - 100
+		// for the pinned stream.
+		BitrateAllocator::Allocate(1300000, streams);
+
+		REQUIRE(streams[0].priority == BitrateAllocator::Priority::ACTIVE_SPEAKER);
+		REQUIRE(streams[0].spatialLayer == 2);
+		REQUIRE(streams[0].temporalLayer == 2);
+		REQUIRE(streams[1].priority == BitrateAllocator::Priority::PINNED);
+		REQUIRE(streams[1].spatialLayer == 1);
+		REQUIRE(streams[1].temporalLayer == 0);
+		REQUIRE(streams[2].priority == BitrateAllocator::Priority::THUMBNAIL);
+		REQUIRE(streams[2].spatialLayer == 0);
+		REQUIRE(streams[2].temporalLayer == 0);
+	}
+
+	SECTION("base layers are kept even if they do not fit")
+	{
+		std::vector<BitrateAllocator::Stream> streams;
+
+		streams.push_back(createStream(BitrateAllocator::Priority::ACTIVE_SPEAKER));
+		streams.push_back(createStream(BitrateAllocator::Priority::THUMBNAIL));
+		streams[0].currentSpatialLayer = 2;
+
+		BitrateAllocator::Allocate(100000, streams);
+
+		REQUIRE(streams[0].spatialLayer == 0);
+		REQUIRE(streams[0].temporalLayer == 0);
+		REQUIRE(streams[1].spatialLayer == 0);
+		REQUIRE(streams[1].temporalLayer == 0);
+	}
+
+	SECTION("upgrades require spare bitrate")
+	{
+		std::vector<BitrateAllocator::Stream> streams;
+
+		streams.push_back(createStream(BitrateAllocator::Priority::ACTIVE_SPEAKER));
+
+		// 300 kbps fit exactly 2,0 but it is not enough to upgrade to it.
+		BitrateAllocator::Allocate(300000, streams);
+
+		REQUIRE(streams[0].spatialLayer == 1);
+		REQUIRE(streams[0].temporalLayer == 0);
+
+		// Already sent, so kept.
+		streams[0].currentSpatialLayer  = 2;
+		streams[0].currentTemporalLayer = 0;
+
+		BitrateAllocator::Allocate(300000, streams);
+
+		REQUIRE(streams[0].spatialLayer == 2);
+		REQUIRE(streams[0].temporalLayer == 0);
+	}
+}
@@ -0,0 +1,151 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "Channel/Notifier.hpp"
+#include "Channel/UnixStreamSocket.hpp"
+#include <cerrno>
+#include <cstdlib> // std::strtoul()
+#include <fcntl.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace Channel;
+
+// Runs the loop while reading what the Channel writes, until nothing more
+// comes. Returns the netstring payloads.
+static std::vector<std::string> readMessages(int fd)
+{
+	std::string data;
+	std::vector<std::string> messages;
+	size_t idleRounds{ 0 };
+
+	while (idleRounds < 10)
+	{
+		char buffer[65536];
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		ssize_t len = read(fd, buffer, sizeof(buffer));
+
+		if (len > 0)
+		{
+			data.append(buffer, len);
+			idleRounds = 0;
+		}
+		else
+		{
+			REQUIRE(errno == EAGAIN);
+
+			idleRounds++;
+			usleep(1000);
+		}
+	}
+
+	for (size_t pos{ 0 }; pos < data.size();)
+	{
+		size_t colon = data.find(':', pos);
+
+		REQUIRE(colon != std::string::npos);
+
+		size_t len = std::strtoul(data.c_str() + pos, nullptr, 10);
+
+		REQUIRE(data[colon + 1 + len] == ',');
+
+		messages.push_back(data.substr(colon + 1, len));
+		pos = colon + len + 2;
+	}
+
+	return messages;
+}
+
+// Index written at the start of the packets given to "rtpraw".
+static size_t getIndex(const std::string& packet)
+{
+	return (static_cast<uint8_t>(packet[0]) << 8) | static_cast<uint8_t>(packet[1]);
+}
+
+SCENARIO("Channel events", "[channel]")
+{
+	int fds[2];
+
+	REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+	REQUIRE(fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0);
+
+	auto* channel = new Channel::UnixStreamSocket(fds[0]);
+	Notifier notifier(channel);
+
+	SECTION("packet events are rate limited, others are not")
+	{
+		uint8_t packet[100]{};
+
+		notifier.Emit(1, "close");
+
+		for (size_t i{ 0 }; i < 2500; ++i)
+		{
+			notifier.EmitRtpRaw(1, packet, sizeof(packet));
+		}
+
+		notifier.Emit(1, "close");
+
+		auto messages = readMessages(fds[1]);
+		size_t numCloseEvents{ 0 };
+		size_t numRtpRawEvents{ 0 };
+
+		for (auto& message : messages)
+		{
+			if (message.find("\"event\":\"close\"") != std::string::npos)
+				numCloseEvents++;
+			else if (message.find("\"event\":\"rtpraw\"") != std::string::npos)
+				numRtpRawEvents++;
+		}
+
+		REQUIRE(numCloseEvents == 2);
+		REQUIRE(numRtpRawEvents == 2000);
+		// Every "rtpraw" is followed by its packet.
+		REQUIRE(messages.size() == 2 + (2 * 2000));
+	}
+
+	SECTION("the oldest packet events are dropped when the queue is full")
+	{
+		uint8_t packet[1000]{};
+
+		notifier.Emit(1, "close");
+
+		// Above the maximum size of the queued events.
+		for (size_t i{ 0 }; i < 2000; ++i)
+		{
+			packet[0] = static_cast<uint8_t>(i >> 8);
+			packet[1] = static_cast<uint8_t>(i);
+
+			notifier.EmitRtpRaw(1, packet, sizeof(packet));
+		}
+
+		notifier.Emit(1, "close");
+
+		auto messages = readMessages(fds[1]);
+
+		REQUIRE(messages.size() > 4);
+		REQUIRE(messages.size() < 2 + (2 * 2000));
+
+		// Events which are not droppable are kept.
+		REQUIRE(messages.front().find("\"event\":\"close\"") != std::string::npos);
+		REQUIRE(messages.back().find("\"event\":\"close\"") != std::string::npos);
+
+		// The newest packets are kept, in order.
+		size_t numPackets = (messages.size() - 2) / 2;
+
+		REQUIRE(getIndex(messages[2]) == 2000 - numPackets);
+		REQUIRE(getIndex(messages[messages.size() - 2]) == 1999);
+
+		for (size_t i{ 4 }; i < messages.size() - 1; i += 2)
+		{
+			REQUIRE(getIndex(messages[i]) == getIndex(messages[i - 2]) + 1);
+		}
+	}
+
+	channel->Destroy();
+	DepLibUV::RunLoop();
+	close(fds[1]);
+}
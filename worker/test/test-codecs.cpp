@@ -0,0 +1,302 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "RTC/Codecs/H264.hpp"
+#include "RTC/Codecs/VP8.hpp"
+#include "RTC/RtpSender.hpp"
+#include "RTC/VP9Filter.hpp"
+#include <utility>
+#include <vector>
+
+using namespace RTC::Codecs;
+
+SCENARIO("VP8 payload descriptor", "[codecs][vp8]")
+{
+	SECTION("parse descriptor with two bytes picture ID and TL0PICIDX")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x90, 0xE0, 0x81, 0x23, 0x42, 0x60, // X, S, I, L, T, M, picId, tl0PicIdx, tid 1
+			0x10, 0x02, 0x00                    // VP8 payload header, key frame
+		};
+		// clang-format on
+
+		VP8::PayloadDescriptor descriptor;
+
+		REQUIRE(descriptor.Parse(buffer, sizeof(buffer)));
+		REQUIRE(descriptor.extended);
+		REQUIRE(descriptor.start);
+		REQUIRE(descriptor.partitionIndex == 0);
+		REQUIRE(descriptor.hasPictureId);
+		REQUIRE(descriptor.hasTwoBytesPictureId);
+		REQUIRE(descriptor.pictureId == 0x0123);
+		REQUIRE(descriptor.hasTl0PicIdx);
+		REQUIRE(descriptor.tl0PicIdx == 0x42);
+		REQUIRE(descriptor.hasTlIndex);
+		REQUIRE(descriptor.tlIndex == 1);
+		REQUIRE(descriptor.layerSync);
+		REQUIRE(descriptor.size == 6);
+		REQUIRE(descriptor.isKeyFrame);
+		REQUIRE(VP8::IsKeyFrame(buffer, sizeof(buffer)));
+
+		descriptor.Encode(buffer, 0x7FFE, 0x01);
+
+		VP8::PayloadDescriptor encoded;
+
+		REQUIRE(encoded.Parse(buffer, sizeof(buffer)));
+		REQUIRE(encoded.pictureId == 0x7FFE);
+		REQUIRE(encoded.tl0PicIdx == 0x01);
+		REQUIRE(encoded.tlIndex == 1);
+	}
+
+	SECTION("parse descriptor of a non key frame")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x90, 0x80, 0x05, // X, S, I, one byte picId
+			0x01, 0x00, 0x00  // VP8 payload header, inter frame
+		};
+		// clang-format on
+
+		VP8::PayloadDescriptor descriptor;
+
+		REQUIRE(descriptor.Parse(buffer, sizeof(buffer)));
+		REQUIRE(!descriptor.hasTwoBytesPictureId);
+		REQUIRE(descriptor.pictureId == 5);
+		REQUIRE(!descriptor.hasTl0PicIdx);
+		REQUIRE(!descriptor.isKeyFrame);
+	}
+
+	SECTION("truncated descriptor is rejected")
+	{
+		uint8_t buffer[] = { 0x90, 0xE0, 0x81 };
+
+		VP8::PayloadDescriptor descriptor;
+
+		REQUIRE(!descriptor.Parse(buffer, sizeof(buffer)));
+		REQUIRE(!VP8::IsKeyFrame(buffer, sizeof(buffer)));
+	}
+}
+
+SCENARIO("H264 key frames", "[codecs][h264]")
+{
+	SECTION("single NAL units")
+	{
+		uint8_t idr[]   = { 0x65, 0x88 };
+		uint8_t slice[] = { 0x41, 0x9A };
+
+		REQUIRE(H264::IsKeyFrame(idr, sizeof(idr)));
+		REQUIRE(!H264::IsKeyFrame(slice, sizeof(slice)));
+	}
+
+	SECTION("STAP-A with SPS")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0x78,                   // STAP-A
+			0x00, 0x02, 0x09, 0xF0, // AUD
+			0x00, 0x02, 0x67, 0x42  // SPS
+		};
+		// clang-format on
+
+		REQUIRE(H264::IsKeyFrame(buffer, sizeof(buffer)));
+	}
+
+	SECTION("FU-A")
+	{
+		uint8_t start[]  = { 0x7C, 0x85, 0x00 };
+		uint8_t middle[] = { 0x7C, 0x05, 0x00 };
+
+		REQUIRE(H264::IsKeyFrame(start, sizeof(start)));
+		REQUIRE(!H264::IsKeyFrame(middle, sizeof(middle)));
+	}
+}
+
+// Packet starting a VP8 picture with two bytes picture ID, TL0PICIDX and TID.
+static VP8::PayloadDescriptor createDescriptor(
+  uint16_t pictureId, uint8_t tl0PicIdx, uint8_t tlIndex, bool layerSync, bool isKeyFrame = false)
+{
+	VP8::PayloadDescriptor descriptor;
+
+	descriptor.extended             = true;
+	descriptor.start                = true;
+	descriptor.hasPictureId         = true;
+	descriptor.hasTwoBytesPictureId = true;
+	descriptor.hasTl0PicIdx         = true;
+	descriptor.hasTlIndex           = true;
+	descriptor.pictureId            = pictureId;
+	descriptor.tl0PicIdx            = tl0PicIdx;
+	descriptor.tlIndex              = tlIndex;
+	descriptor.layerSync            = layerSync;
+	descriptor.isKeyFrame           = isKeyFrame;
+
+	return descriptor;
+}
+
+SCENARIO("VP8 temporal layer selection", "[codecs][vp8]")
+{
+	uint16_t pictureId;
+	uint8_t tl0PicIdx;
+
+	SECTION("upper layers are dropped and picture IDs stay consecutive")
+	{
+		VP8::LayerSelector selector;
+
+		selector.SetTargetTemporalLayer(0);
+
+		// TL0 TL2 TL1 TL2 TL0.
+		REQUIRE(selector.Select(createDescriptor(100, 10, 0, false, true), pictureId, tl0PicIdx));
+		REQUIRE(pictureId == 100);
+		REQUIRE(tl0PicIdx == 10);
+		REQUIRE(!selector.Select(createDescriptor(101, 10, 2, true), pictureId, tl0PicIdx));
+		REQUIRE(!selector.Select(createDescriptor(102, 10, 1, true), pictureId, tl0PicIdx));
+		REQUIRE(!selector.Select(createDescriptor(103, 10, 2, false), pictureId, tl0PicIdx));
+		REQUIRE(selector.Select(createDescriptor(104, 11, 0, false), pictureId, tl0PicIdx));
+		REQUIRE(pictureId == 101);
+		REQUIRE(tl0PicIdx == 11);
+	}
+
+	SECTION("upper layers are switched to on layer sync frames")
+	{
+		VP8::LayerSelector selector;
+
+		selector.SetTargetTemporalLayer(0);
+
+		REQUIRE(selector.Select(createDescriptor(100, 10, 0, false, true), pictureId, tl0PicIdx));
+
+		selector.SetTargetTemporalLayer(1);
+
+		REQUIRE(selector.GetCurrentTemporalLayer() == 0);
+		REQUIRE(!selector.Select(createDescriptor(101, 10, 1, false), pictureId, tl0PicIdx));
+		REQUIRE(selector.Select(createDescriptor(102, 11, 0, false), pictureId, tl0PicIdx));
+		REQUIRE(pictureId == 101);
+		REQUIRE(selector.Select(createDescriptor(103, 11, 1, true), pictureId, tl0PicIdx));
+		REQUIRE(pictureId == 102);
+		REQUIRE(selector.GetCurrentTemporalLayer() == 1);
+
+		selector.SetTargetTemporalLayer(0);
+
+		REQUIRE(!selector.Select(createDescriptor(104, 11, 1, false), pictureId, tl0PicIdx));
+		REQUIRE(selector.GetCurrentTemporalLayer() == 0);
+	}
+
+	SECTION("picture IDs continue from the last forwarded ones after resync")
+	{
+		VP8::LayerSelector selector;
+
+		selector.SetTargetTemporalLayer(2);
+
+		REQUIRE(selector.Select(createDescriptor(0x7FFF, 255, 0, false, true), pictureId, tl0PicIdx));
+
+		selector.Resync();
+
+		REQUIRE(selector.Select(createDescriptor(5000, 30, 0, false, true), pictureId, tl0PicIdx));
+		REQUIRE(pictureId == 0);
+		REQUIRE(tl0PicIdx == 0);
+		REQUIRE(selector.Select(createDescriptor(5001, 30, 2, false), pictureId, tl0PicIdx));
+		REQUIRE(pictureId == 1);
+		REQUIRE(tl0PicIdx == 0);
+	}
+}
+
+SCENARIO("VP9 scalability structure", "[codecs][vp9]")
+{
+	// clang-format off
+	uint8_t buffer[] =
+	{
+		0x58,                   // N_S: 2, Y, G
+		0x01, 0x40, 0x00, 0xB4, // 320x180
+		0x02, 0x80, 0x01, 0x68, // 640x360
+		0x05, 0x00, 0x02, 0xD0, // 1280x720
+		0x02,                   // N_G: 2
+		0x04, 0x01,             // T: 0, U: 0, R: 1, P_DIFF: 1
+		0x34, 0x01              // T: 1, U: 1, R: 1, P_DIFF: 1
+	};
+	// clang-format on
+
+	SECTION("parse resolutions and picture group")
+	{
+		VP9::VP9ScalabilityScructure ss;
+
+		REQUIRE(ss.Parse(buffer, sizeof(buffer)) == sizeof(buffer));
+		REQUIRE(ss.numberSpatialLayers == 3);
+		REQUIRE(ss.spatialLayerFrameResolutionPresent);
+		REQUIRE(ss.groupOfFramesDescriptionPresent);
+		REQUIRE(ss.spatialLayerFrameResolutions.size() == 3);
+		REQUIRE(ss.spatialLayerFrameResolutions[0].first == 320);
+		REQUIRE(ss.spatialLayerFrameResolutions[0].second == 180);
+		REQUIRE(ss.spatialLayerFrameResolutions[2].first == 1280);
+		REQUIRE(ss.spatialLayerFrameResolutions[2].second == 720);
+		REQUIRE(ss.groupOfFramesDescription.size() == 2);
+		REQUIRE(ss.groupOfFramesDescription[0].temporalLayerId == 0);
+		REQUIRE(!ss.groupOfFramesDescription[0].switchingPoint);
+		REQUIRE(ss.groupOfFramesDescription[1].temporalLayerId == 1);
+		REQUIRE(ss.groupOfFramesDescription[1].switchingPoint);
+		REQUIRE(ss.groupOfFramesDescription[1].referenceIndexDiff == std::vector<uint8_t>({ 1 }));
+	}
+
+	SECTION("reserved bits do not set the G flag")
+	{
+		VP9::VP9ScalabilityScructure ss;
+
+		buffer[0] = 0x57; // N_S: 2, Y, reserved bits set.
+
+		REQUIRE(ss.Parse(buffer, sizeof(buffer)) == 13);
+		REQUIRE(!ss.groupOfFramesDescriptionPresent);
+		REQUIRE(ss.groupOfFramesDescription.empty());
+	}
+
+	SECTION("truncated picture group is rejected")
+	{
+		// N_G missing.
+		{
+			VP9::VP9ScalabilityScructure ss;
+
+			REQUIRE(ss.Parse(buffer, 13) == 0);
+		}
+
+		// Last P_DIFF missing.
+		{
+			VP9::VP9ScalabilityScructure ss;
+
+			REQUIRE(ss.Parse(buffer, sizeof(buffer) - 1) == 0);
+		}
+
+		// Second picture missing.
+		{
+			VP9::VP9ScalabilityScructure ss;
+
+			REQUIRE(ss.Parse(buffer, sizeof(buffer) - 2) == 0);
+		}
+	}
+}
+
+SCENARIO("VP9 spatial layer selection", "[codecs][vp9]")
+{
+	std::vector<std::pair<uint16_t, uint16_t>> resolutions = {
+		{ 320, 180 }, { 640, 360 }, { 1280, 720 }
+	};
+
+	SECTION("lowest spatial layer covering the rendered size")
+	{
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize(resolutions, 160, 90, 2) == 0);
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize(resolutions, 320, 180, 2) == 0);
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize(resolutions, 321, 180, 2) == 1);
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize(resolutions, 640, 400, 2) == 2);
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize(resolutions, 1920, 1080, 2) == 2);
+	}
+
+	SECTION("never above the given spatial layer")
+	{
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize(resolutions, 1280, 720, 1) == 1);
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize(resolutions, 160, 90, 0) == 0);
+	}
+
+	SECTION("unknown size or resolutions")
+	{
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize(resolutions, 0, 0, 2) == 2);
+		REQUIRE(RTC::RtpSender::GetSpatialLayerForSize({}, 320, 180, 1) == 1);
+	}
+}
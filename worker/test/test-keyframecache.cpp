@@ -0,0 +1,130 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "RTC/KeyFrameCache.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <vector>
+
+using namespace RTC;
+
+SCENARIO("cache VP9 key frames", "[rtp][keyframecache]")
+{
+	// VP9 payload descriptor first octet flags.
+	static constexpr uint8_t P{ 0x40 };
+	static constexpr uint8_t B{ 0x08 };
+	static constexpr uint8_t E{ 0x04 };
+
+	uint8_t buffer[] =
+	{
+		0b10000000, 0b01100101, 0, 1,
+		0, 0, 0, 4,
+		0, 0, 0, 5,
+		0, 0xAA
+	};
+
+	auto receivePacket = [&buffer](KeyFrameCache& cache, uint16_t seq, uint8_t desc, bool marker)
+	{
+		RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(packet);
+
+		packet->SetSequenceNumber(seq);
+		packet->SetExtendedSequenceNumber(seq);
+		packet->SetMarker(marker);
+		packet->GetPayload()[0] = desc;
+
+		cache.ReceivePacket(packet);
+
+		delete packet;
+	};
+
+	auto getSeqNumbers = [](KeyFrameCache& cache, std::vector<uint16_t>& seqNumbers)
+	{
+		std::vector<RtpPacket*> packets;
+
+		seqNumbers.clear();
+
+		if (!cache.GetPackets(packets))
+			return false;
+
+		for (auto* packet : packets)
+		{
+			seqNumbers.push_back(packet->GetSequenceNumber());
+		}
+
+		return true;
+	};
+
+	std::vector<uint16_t> seqNumbers;
+
+	SECTION("packets are cached from the key frame on")
+	{
+		KeyFrameCache cache(100);
+
+		// Inter predicted picture, ignored.
+		receivePacket(cache, 9, P | B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == false);
+
+		// Key frame in three packets.
+		receivePacket(cache, 10, B, false);
+		receivePacket(cache, 11, 0, false);
+
+		// Last packet of the key frame still missing.
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == false);
+
+		receivePacket(cache, 12, E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == true);
+		REQUIRE(seqNumbers == std::vector<uint16_t>({ 10, 11, 12 }));
+
+		// Packet 13 lost.
+		receivePacket(cache, 14, P | B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == false);
+
+		// Packet 13 retransmitted.
+		receivePacket(cache, 13, P | B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == true);
+		REQUIRE(seqNumbers == std::vector<uint16_t>({ 10, 11, 12, 13, 14 }));
+
+		// Duplicated and older packets are ignored.
+		receivePacket(cache, 13, P | B | E, true);
+		receivePacket(cache, 8, P | B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == true);
+		REQUIRE(seqNumbers == std::vector<uint16_t>({ 10, 11, 12, 13, 14 }));
+
+		// A new key frame replaces the cached one.
+		receivePacket(cache, 15, B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == true);
+		REQUIRE(seqNumbers == std::vector<uint16_t>({ 15 }));
+	}
+
+	SECTION("too long picture groups are dropped")
+	{
+		KeyFrameCache cache(3);
+
+		receivePacket(cache, 10, B | E, true);
+		receivePacket(cache, 11, P | B | E, true);
+		receivePacket(cache, 12, P | B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == true);
+		REQUIRE(seqNumbers.size() == 3);
+
+		receivePacket(cache, 13, P | B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == false);
+
+		// Nothing is cached until the next key frame.
+		receivePacket(cache, 14, P | B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == false);
+
+		receivePacket(cache, 15, B | E, true);
+
+		REQUIRE(getSeqNumbers(cache, seqNumbers) == true);
+		REQUIRE(seqNumbers == std::vector<uint16_t>({ 15 }));
+	}
+}
@@ -0,0 +1,76 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "LatencyProbes.hpp"
+
+using Histogram = LatencyProbes::Histogram;
+
+SCENARIO("latency histogram", "[latency]")
+{
+	SECTION("buckets are exact for small values and bounded for big ones")
+	{
+		for (uint64_t value{ 0 }; value < 32; ++value)
+		{
+			REQUIRE(Histogram::GetBucket(value) == value);
+			REQUIRE(Histogram::GetBucketMaxValue(Histogram::GetBucket(value)) == value);
+		}
+
+		for (uint64_t value : { uint64_t{ 33 }, uint64_t{ 1000 }, uint64_t{ 123456789 } })
+		{
+			uint64_t maxValue = Histogram::GetBucketMaxValue(Histogram::GetBucket(value));
+
+			REQUIRE(maxValue >= value);
+			REQUIRE(maxValue - value < value / Histogram::SubBuckets + 1);
+		}
+
+		REQUIRE(Histogram::GetBucket(UINT64_MAX) == Histogram::NumBuckets - 1);
+		REQUIRE(Histogram::GetBucketMaxValue(Histogram::NumBuckets - 1) == UINT64_MAX);
+	}
+
+	SECTION("percentiles")
+	{
+		Histogram histogram;
+
+		REQUIRE(histogram.GetPercentile(99) == 0);
+
+		// 1 to 1000 us.
+		for (uint64_t value{ 1 }; value <= 1000; ++value)
+		{
+			histogram.Record(value * 1000);
+		}
+
+		REQUIRE(histogram.GetCount() == 1000);
+		REQUIRE(histogram.GetMax() == 1000000);
+		REQUIRE(histogram.GetMean() == 500500);
+
+		uint64_t p50 = histogram.GetPercentile(50);
+		uint64_t p99 = histogram.GetPercentile(99);
+
+		REQUIRE(p50 >= 500000);
+		REQUIRE(p50 <= 500000 + 500000 / Histogram::SubBuckets);
+		REQUIRE(p99 >= 990000);
+		REQUIRE(p99 <= 1000000);
+		REQUIRE(histogram.GetPercentile(100) == 1000000);
+
+		histogram.Reset();
+
+		REQUIRE(histogram.GetCount() == 0);
+		REQUIRE(histogram.GetMax() == 0);
+	}
+
+	SECTION("loop lag")
+	{
+		static constexpr uint64_t Ms{ 1000000 };
+
+		// Woken up in time with nothing to do.
+		REQUIRE(LatencyProbes::GetLoopLag(10 * Ms, 0, 10) == 0);
+		// Woken up 2 ms late.
+		REQUIRE(LatencyProbes::GetLoopLag(12 * Ms, 0, 10) == 2 * Ms);
+		// Woken up early by I/O whose callbacks took 8 ms.
+		REQUIRE(LatencyProbes::GetLoopLag(9 * Ms, 8 * Ms, 10) == 8 * Ms);
+		// Woken up 2 ms late, then callbacks took 3 ms.
+		REQUIRE(LatencyProbes::GetLoopLag(15 * Ms, 3 * Ms, 10) == 5 * Ms);
+		// No timeout, so only callbacks delay anything.
+		REQUIRE(LatencyProbes::GetLoopLag(100 * Ms, 3 * Ms, -1) == 3 * Ms);
+		REQUIRE(LatencyProbes::GetLoopLag(100 * Ms, 0, -1) == 0);
+	}
+}
@@ -0,0 +1,145 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/Pacer.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <vector>
+
+using namespace RTC;
+
+SCENARIO("pace RTP packets", "[rtp][pacer]")
+{
+	class PacerListener :
+		public Pacer::Listener
+	{
+	public:
+		virtual void OnPacerRtpPacket(Pacer* /*pacer*/, RtpPacket* packet) override
+		{
+			INFO("packet sent by the pacer");
+
+			this->seqNumbers.push_back(packet->GetSequenceNumber());
+		}
+
+	public:
+		std::vector<uint16_t> seqNumbers;
+	};
+
+	// 1000 bytes RTP packet.
+	static uint8_t buffer[1000] =
+	{
+		0b10000000, 0b01100101, 0, 1,
+		0, 0, 0, 4,
+		0, 0, 0, 5
+	};
+
+	auto sendPacket = [](Pacer& pacer, uint16_t seq, Pacer::Priority priority)
+	{
+		RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(packet);
+
+		packet->SetSequenceNumber(seq);
+
+		pacer.SendRtpPacket(packet, priority);
+
+		delete packet;
+	};
+
+	SECTION("packets are not delayed if there is no bitrate estimation")
+	{
+		PacerListener listener;
+		Pacer pacer(&listener, 0);
+
+		for (uint16_t seq{ 1 }; seq <= 20; ++seq)
+		{
+			sendPacket(pacer, seq, Pacer::Priority::VIDEO);
+		}
+
+		REQUIRE(listener.seqNumbers.size() == 20);
+	}
+
+	SECTION("audio goes first, then retransmissions, then video")
+	{
+		PacerListener listener;
+		Pacer pacer(&listener, 0);
+
+		// Bucket of 7500 bytes.
+		pacer.SetBitrate(1000000);
+
+		for (uint16_t seq{ 1 }; seq <= 10; ++seq)
+		{
+			sendPacket(pacer, seq, Pacer::Priority::VIDEO);
+		}
+
+		// The bucket allows a burst of 8 packets.
+		REQUIRE(listener.seqNumbers == std::vector<uint16_t>({ 1, 2, 3, 4, 5, 6, 7, 8 }));
+
+		sendPacket(pacer, 100, Pacer::Priority::RETRANSMISSION);
+		sendPacket(pacer, 200, Pacer::Priority::AUDIO);
+
+		// Audio is never delayed.
+		REQUIRE(listener.seqNumbers.back() == 200);
+
+		// Let the pacer drain its queues.
+		DepLibUV::RunLoop();
+
+		REQUIRE(
+		  listener.seqNumbers ==
+		  std::vector<uint16_t>({ 1, 2, 3, 4, 5, 6, 7, 8, 200, 100, 9, 10 }));
+	}
+
+	SECTION("key frame bursts are paced even if there is no bitrate estimation")
+	{
+		PacerListener listener;
+		Pacer pacer(&listener, 0);
+
+		for (uint16_t seq{ 1 }; seq <= 40; ++seq)
+		{
+			sendPacket(pacer, seq, Pacer::Priority::KEY_FRAME);
+		}
+
+		// Bucket of 15000 bytes at the minimum burst bitrate.
+		REQUIRE(listener.seqNumbers.size() == 15);
+
+		// Live video goes after the cached packets.
+		sendPacket(pacer, 100, Pacer::Priority::VIDEO);
+
+		REQUIRE(listener.seqNumbers.size() == 15);
+
+		// Let the pacer drain its queues.
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.seqNumbers.size() == 41);
+		REQUIRE(listener.seqNumbers[39] == 40);
+		REQUIRE(listener.seqNumbers.back() == 100);
+
+		// Not paced anymore once the burst is over.
+		for (uint16_t seq{ 101 }; seq <= 120; ++seq)
+		{
+			sendPacket(pacer, seq, Pacer::Priority::VIDEO);
+		}
+
+		REQUIRE(listener.seqNumbers.size() == 61);
+	}
+
+	SECTION("retransmissions are limited to the given budget")
+	{
+		PacerListener listener;
+		// 10% of the media bitrate, but never less than 64 kbps.
+		Pacer pacer(&listener, 10);
+
+		for (uint16_t seq{ 1 }; seq <= 10; ++seq)
+		{
+			sendPacket(pacer, seq, Pacer::Priority::VIDEO);
+		}
+
+		for (uint16_t seq{ 1 }; seq <= 10; ++seq)
+		{
+			sendPacket(pacer, seq, Pacer::Priority::RETRANSMISSION);
+		}
+
+		// 64 kbps are 8 packets of 1000 bytes per second.
+		REQUIRE(listener.seqNumbers.size() == 18);
+		REQUIRE(pacer.ToJson()["retransmissionsDropped"].asUInt() == 2);
+	}
+}
@@ -0,0 +1,165 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "RTC/PacketTap.hpp"
+#include <cstring>    // std::memcmp()
+#include <fcntl.h>    // open()
+#include <sys/mman.h> // mmap(), munmap()
+#include <unistd.h>   // close()
+#include <vector>
+
+using namespace RTC;
+
+SCENARIO("shared memory packet tap", "[rtp][packettap]")
+{
+	// Minimal consumer mapping the tap the way an external reader would.
+	class Reader
+	{
+	public:
+		explicit Reader(const PacketTap& tap) : size(tap.GetSize())
+		{
+			int fd = open(tap.GetPath().c_str(), O_RDWR);
+
+			REQUIRE(fd != -1);
+
+			this->memory = static_cast<uint8_t*>(
+			    mmap(nullptr, this->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+
+			close(fd);
+
+			REQUIRE(this->memory != MAP_FAILED);
+
+			this->header = reinterpret_cast<PacketTap::Header*>(this->memory);
+		}
+
+		~Reader()
+		{
+			munmap(this->memory, this->size);
+		}
+
+		bool Read(PacketTap::Record& record, std::vector<uint8_t>& data)
+		{
+			uint64_t writePos = this->header->writePos.load(std::memory_order_acquire);
+			uint64_t readPos  = this->header->readPos.load(std::memory_order_relaxed);
+			uint64_t dataSize = this->header->dataSize;
+
+			if (readPos == writePos)
+				return false;
+
+			size_t offset = readPos % dataSize;
+			uint8_t* base = this->memory + PacketTap::DataOffset;
+
+			if (dataSize - offset < sizeof(PacketTap::Record) ||
+			    reinterpret_cast<PacketTap::Record*>(base + offset)->length == PacketTap::WrapLength)
+			{
+				readPos += dataSize - offset;
+				offset = 0;
+			}
+
+			std::memcpy(&record, base + offset, sizeof(record));
+			data.assign(
+			    base + offset + sizeof(record), base + offset + sizeof(record) + record.length);
+
+			readPos += sizeof(record) + ((record.length + 7) & ~7u);
+			this->header->readPos.store(readPos, std::memory_order_release);
+
+			return true;
+		}
+
+	public:
+		size_t size{ 0 };
+		uint8_t* memory{ nullptr };
+		PacketTap::Header* header{ nullptr };
+	};
+
+	uint8_t packet[1200];
+
+	for (size_t i{ 0 }; i < sizeof(packet); ++i)
+	{
+		packet[i] = static_cast<uint8_t>(i);
+	}
+
+	PacketTap::Record record{};
+	std::vector<uint8_t> data;
+
+	SECTION("the reader gets the header and the packets in order")
+	{
+		PacketTap tap(65536);
+		Reader reader(tap);
+
+		REQUIRE(reader.header->magic == uint32_t{ PacketTap::Magic });
+		REQUIRE(reader.header->version == uint32_t{ PacketTap::Version });
+		REQUIRE(reader.header->dataSize == 65536);
+		REQUIRE(tap.GetSize() == PacketTap::DataOffset + 65536);
+
+		REQUIRE(tap.Write(1, 1000, packet, 100));
+		REQUIRE(tap.Write(2, 1001, packet, 1200));
+
+		REQUIRE(reader.Read(record, data));
+		REQUIRE(record.rtpReceiverId == 1);
+		REQUIRE(record.arrivalTime == 1000);
+		REQUIRE(record.length == 100);
+		REQUIRE(std::memcmp(data.data(), packet, 100) == 0);
+
+		REQUIRE(reader.Read(record, data));
+		REQUIRE(record.rtpReceiverId == 2);
+		REQUIRE(record.arrivalTime == 1001);
+		REQUIRE(record.length == 1200);
+		REQUIRE(std::memcmp(data.data(), packet, 1200) == 0);
+
+		REQUIRE(!reader.Read(record, data));
+	}
+
+	SECTION("packets are dropped while the reader is behind")
+	{
+		PacketTap tap(65536);
+		Reader reader(tap);
+		size_t written{ 0 };
+
+		// 1216 bytes per record.
+		while (tap.Write(1, 0, packet, sizeof(packet)))
+		{
+			++written;
+		}
+
+		REQUIRE(written == 65536 / 1216);
+		REQUIRE(!tap.Write(1, 0, packet, sizeof(packet)));
+		REQUIRE(reader.header->dropped.load() == 2);
+
+		auto json = tap.ToJson();
+
+		REQUIRE(json["written"].asUInt() == written);
+		REQUIRE(json["dropped"].asUInt() == 2);
+
+		// Once read, there is room again.
+		REQUIRE(reader.Read(record, data));
+		REQUIRE(tap.Write(1, 0, packet, 100));
+	}
+
+	SECTION("records never wrap around the end of the data")
+	{
+		PacketTap tap(65536);
+		Reader reader(tap);
+		size_t read{ 0 };
+
+		// Write and read many more records than fit, with lengths making the
+		// records end at every possible 8 bytes offset.
+		for (size_t i{ 0 }; i < 1000; ++i)
+		{
+			size_t len = 100 + (i % 13) * 8 + (i % 7);
+
+			packet[0] = static_cast<uint8_t>(i);
+
+			REQUIRE(tap.Write(static_cast<uint32_t>(i), i, packet, len));
+			REQUIRE(reader.Read(record, data));
+			REQUIRE(record.rtpReceiverId == i);
+			REQUIRE(record.length == len);
+			REQUIRE(data[0] == static_cast<uint8_t>(i));
+			REQUIRE(std::memcmp(data.data() + 1, packet + 1, len - 1) == 0);
+
+			++read;
+		}
+
+		REQUIRE(read == 1000);
+		REQUIRE(reader.header->dropped.load() == 0);
+	}
+}
@@ -1,7 +1,9 @@
 #include "include/catch.hpp"
 #include "include/helpers.hpp"
+#include "include/rtcpfixtures.hpp"
 #include "common.hpp"
 #include "RTC/RTCP/Packet.hpp"
+#include "RTC/RTCP/PacketView.hpp"
 #include "RTC/RTCP/Sdes.hpp"
 #include "RTC/RTCP/SenderReport.hpp"
 #include "RTC/RTCP/ReceiverReport.hpp"
@@ -10,6 +12,7 @@
 #include "RTC/RTCP/FeedbackRtpTmmb.hpp"
 #include "RTC/RTCP/FeedbackRtpTllei.hpp"
 #include "RTC/RTCP/FeedbackRtpEcn.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
 #include "RTC/RTCP/FeedbackPsSli.hpp"
 #include "RTC/RTCP/FeedbackPsRpsi.hpp"
 #include "RTC/RTCP/FeedbackPsFir.hpp"
@@ -18,7 +21,9 @@
 #include "RTC/RTCP/FeedbackPsLei.hpp"
 #include "RTC/RTCP/FeedbackPsAfb.hpp"
 #include "RTC/RTCP/FeedbackPsRemb.hpp"
+#include <cstring>
 #include <string>
+#include <vector>
 
 using namespace RTC::RTCP;
 
@@ -97,6 +102,92 @@ SCENARIO("parse RTCP packets", "[parser][rtcp]")
 		delete packet;
 	}
 
+	SECTION("parse compound packet in place")
+	{
+		CompoundPacketView compoundPacket(
+		    Fixtures::RtcpCompoundPacket, sizeof(Fixtures::RtcpCompoundPacket));
+		auto it = compoundPacket.Begin();
+
+		REQUIRE(compoundPacket.IsValid());
+
+		REQUIRE(it->GetType() == Type::SR);
+		REQUIRE(it->GetSsrc() == 1234);
+		REQUIRE(it->GetReceiverReportCount() == 1);
+
+		SenderReport senderReport(it->GetSenderReport());
+		ReceiverReport receiverReport(it->GetReceiverReport(0));
+
+		REQUIRE(senderReport.GetOctetCount() == 1234);
+		REQUIRE(receiverReport.GetSsrc() == 5678);
+		REQUIRE(receiverReport.GetTotalLost() == 4);
+		REQUIRE(receiverReport.GetDelaySinceLastSenderReport() == 1234);
+
+		++it;
+
+		REQUIRE(it->GetType() == Type::RTPFB);
+		REQUIRE(it->GetRtpFeedbackType() == FeedbackRtp::MessageType::NACK);
+		REQUIRE(it->GetMediaSsrc() == 1234);
+		REQUIRE(it->GetNackItemCount() == 1);
+		REQUIRE(it->GetNackPacketId(0) == 2500);
+		REQUIRE(it->GetNackLostPacketBitmask(0) == 0b1010101001010101);
+
+		++it;
+
+		REQUIRE(it->GetType() == Type::PSFB);
+		REQUIRE(it->GetPsFeedbackType() == FeedbackPs::MessageType::PLI);
+		REQUIRE(it->GetSsrc() == 1);
+		REQUIRE(it->GetMediaSsrc() == 1234);
+		REQUIRE(!it->IsRemb());
+
+		++it;
+
+		REQUIRE(it->GetPsFeedbackType() == FeedbackPs::MessageType::FIR);
+		REQUIRE(it->GetSize() == 20);
+		REQUIRE(it->GetFirItemCount() == 1);
+		REQUIRE(it->GetFirItemSsrc(0) == 1234);
+		REQUIRE(it->GetFirItemSequenceNumber(0) == 8);
+
+		++it;
+
+		REQUIRE(it->GetPsFeedbackType() == FeedbackPs::MessageType::AFB);
+		REQUIRE(it->IsRemb());
+		REQUIRE(it->GetRembBitrate() == 262144);
+		REQUIRE(it->GetRembSsrcCount() == 2);
+
+		++it;
+
+		REQUIRE(it == compoundPacket.End());
+	}
+
+	SECTION("parse compound packet in place stops at the first invalid packet")
+	{
+		uint8_t buffer[] =
+		{
+			// PLI.
+			0x81, 0xce, 0x00, 0x02, // RTCP common header
+			0x00, 0x00, 0x00, 0x01, // sender ssrc
+			0x00, 0x00, 0x04, 0xD2, // media ssrc
+			// RR announcing a report which is not present.
+			0x81, 0xc9, 0x00, 0x01, // RTCP common header
+			0x00, 0x00, 0x04, 0xD2  // ssrc
+		};
+
+		CompoundPacketView compoundPacket(buffer, sizeof(buffer));
+		size_t count{ 0 };
+
+		for (auto it = compoundPacket.Begin(); it != compoundPacket.End(); ++it)
+		{
+			count++;
+		}
+
+		REQUIRE(count == 1);
+
+		// Version is zero.
+		buffer[0] = 0x01;
+
+		REQUIRE(!compoundPacket.IsValid());
+	}
+
 	SECTION("parse SdesChunk")
 	{
 		uint8_t buffer[] =
@@ -677,4 +768,169 @@ SCENARIO("parse RTCP packets", "[parser][rtcp]")
 		REQUIRE(parsed->GetBitrate() == bitrateParsed);
 		REQUIRE(parsed->GetSsrcs() == ssrcs);
 	}
+
+	SECTION("parse FeedbackRtpTransportPacket")
+	{
+		uint8_t buffer[] =
+		{
+			0x8f, 0xcd, 0x00, 0x06, // FMT 15, PT 205, length 6
+			0x00, 0x00, 0x00, 0x01, // Sender SSRC
+			0x11, 0x22, 0x33, 0x44, // Media SSRC
+			0x00, 0x01, 0x00, 0x04, // Base sequence number 1, 4 packets
+			0x00, 0x00, 0x01, 0x02, // Reference time 64 ms, feedback packet count 2
+			0xd2, 0x40, 0x04, 0xff, // Two bits status vector chunk, small delta
+			0xfc, 0x01, 0x00, 0x00  // Large delta, small delta, padding
+		};
+		FeedbackRtpTransportPacket* packet = FeedbackRtpTransportPacket::Parse(buffer, sizeof(buffer));
+
+		REQUIRE(packet);
+		REQUIRE(packet->GetSenderSsrc() == 1);
+		REQUIRE(packet->GetMediaSsrc() == 0x11223344);
+		REQUIRE(packet->GetBaseSequenceNumber() == 1);
+		REQUIRE(packet->GetPacketStatusCount() == 4);
+		REQUIRE(packet->GetReferenceTime() == 1);
+		REQUIRE(packet->GetFeedbackPacketCount() == 2);
+		REQUIRE(packet->GetSize() == sizeof(buffer));
+
+		std::vector<FeedbackRtpTransportPacket::PacketResult> results;
+
+		packet->GetPacketResults(results);
+
+		REQUIRE(results.size() == 4);
+		REQUIRE(results[0].sequenceNumber == 1);
+		REQUIRE(results[0].received == true);
+		REQUIRE(results[0].receivedAt == 65);
+		REQUIRE(results[1].sequenceNumber == 2);
+		REQUIRE(results[1].received == false);
+		REQUIRE(results[2].sequenceNumber == 3);
+		REQUIRE(results[2].received == true);
+		REQUIRE(results[2].receivedAt == 64);
+		REQUIRE(results[3].sequenceNumber == 4);
+		REQUIRE(results[3].received == true);
+		REQUIRE(results[3].receivedAt == 64);
+
+		uint8_t serialized[sizeof(buffer)];
+
+		REQUIRE(packet->Serialize(serialized) == sizeof(buffer));
+		REQUIRE(std::memcmp(serialized, buffer, sizeof(buffer)) == 0);
+
+		delete packet;
+	}
+
+	SECTION("parse FeedbackRtpTransportPacket in place")
+	{
+		uint8_t buffer[] =
+		{
+			0x8f, 0xcd, 0x00, 0x06, // FMT 15, PT 205, length 6
+			0x00, 0x00, 0x00, 0x01, // Sender SSRC
+			0x11, 0x22, 0x33, 0x44, // Media SSRC
+			0x00, 0x01, 0x00, 0x04, // Base sequence number 1, 4 packets
+			0x00, 0x00, 0x01, 0x02, // Reference time 64 ms, feedback packet count 2
+			0xd2, 0x40, 0x04, 0xff, // Two bits status vector chunk, small delta
+			0xfc, 0x01, 0x00, 0x00  // Large delta, small delta, padding
+		};
+		PacketView packet(buffer, sizeof(buffer));
+		std::vector<FeedbackRtpTransportPacket::PacketResult> results;
+
+		REQUIRE(packet.IsValid());
+		REQUIRE(packet.GetRtpFeedbackType() == FeedbackRtp::MessageType::TRANSPORT);
+		REQUIRE(packet.GetTransportFeedbackResults(results));
+		REQUIRE(results.size() == 4);
+		REQUIRE(results[0].sequenceNumber == 1);
+		REQUIRE(results[0].received == true);
+		REQUIRE(results[0].receivedAt == 65);
+		REQUIRE(results[1].sequenceNumber == 2);
+		REQUIRE(results[1].received == false);
+		REQUIRE(results[2].sequenceNumber == 3);
+		REQUIRE(results[2].received == true);
+		REQUIRE(results[2].receivedAt == 64);
+		REQUIRE(results[3].sequenceNumber == 4);
+		REQUIRE(results[3].received == true);
+		REQUIRE(results[3].receivedAt == 64);
+
+		// The last receive delta is missing.
+		PacketView truncated(buffer, sizeof(buffer) - 3);
+
+		results.clear();
+
+		REQUIRE(!truncated.GetTransportFeedbackResults(results));
+		REQUIRE(results.empty());
+	}
+
+	SECTION("create FeedbackRtpTransportPacket")
+	{
+		FeedbackRtpTransportPacket packet(1, 0x11223344);
+
+		packet.SetBase(1, 1, 2);
+
+		REQUIRE(packet.AddPacket(true, 4));
+		REQUIRE(packet.AddPacket(false, 0));
+		REQUIRE(packet.AddPacket(true, -4));
+		REQUIRE(packet.AddPacket(true, 1));
+		// Does not fit into a large delta.
+		REQUIRE(!packet.AddPacket(true, 40000));
+
+		uint8_t expected[] =
+		{
+			0x8f, 0xcd, 0x00, 0x06,
+			0x00, 0x00, 0x00, 0x01,
+			0x11, 0x22, 0x33, 0x44,
+			0x00, 0x01, 0x00, 0x04,
+			0x00, 0x00, 0x01, 0x02,
+			0xd2, 0x40, 0x04, 0xff,
+			0xfc, 0x01, 0x00, 0x00
+		};
+		uint8_t serialized[sizeof(expected)];
+
+		REQUIRE(packet.GetSize() == sizeof(expected));
+		REQUIRE(packet.Serialize(serialized) == sizeof(expected));
+		REQUIRE(std::memcmp(serialized, expected, sizeof(expected)) == 0);
+	}
+
+	SECTION("create FeedbackRtpTransportPacket with run length and one bit chunks")
+	{
+		FeedbackRtpTransportPacket packet(0, 0);
+
+		packet.SetBase(65530, 0, 0);
+
+		// 20 received packets.
+		for (size_t i = 0; i < 20; ++i)
+		{
+			REQUIRE(packet.AddPacket(true, 1));
+		}
+
+		// Lost and received packets alternated.
+		for (size_t i = 0; i < 5; ++i)
+		{
+			REQUIRE(packet.AddPacket(false, 0));
+			REQUIRE(packet.AddPacket(true, 2));
+		}
+
+		uint8_t buffer[RTC::RTCP::BufferSize];
+		size_t len = packet.Serialize(buffer);
+
+		// Header, run length chunk, one bit vector chunk and 25 small deltas.
+		REQUIRE(len == 4 + 8 + 8 + 2 + 2 + 25 + 3);
+		REQUIRE(buffer[20] == 0x20);
+		REQUIRE(buffer[21] == 20);
+		REQUIRE(buffer[22] == 0b10010101);
+		REQUIRE(buffer[23] == 0b01010000);
+
+		FeedbackRtpTransportPacket* parsed = FeedbackRtpTransportPacket::Parse(buffer, len);
+
+		REQUIRE(parsed);
+
+		std::vector<FeedbackRtpTransportPacket::PacketResult> results;
+
+		parsed->GetPacketResults(results);
+
+		REQUIRE(results.size() == 30);
+		REQUIRE(results[0].sequenceNumber == 65530);
+		REQUIRE(results[6].sequenceNumber == 0);
+		REQUIRE(results[20].received == false);
+		REQUIRE(results[29].received == true);
+		REQUIRE(results[29].receivedAt == 7);
+
+		delete parsed;
+	}
 }
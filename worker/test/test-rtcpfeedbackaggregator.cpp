@@ -0,0 +1,116 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/RtcpFeedbackAggregator.hpp"
+#include <vector>
+
+using namespace RTC;
+
+SCENARIO("aggregate NACK and key frame requests from many RtpSenders", "[rtcp][aggregator]")
+{
+	class RtcpFeedbackAggregatorListener :
+		public RtcpFeedbackAggregator::Listener
+	{
+	public:
+		virtual void OnAggregatedNackRequired(uint32_t ssrc, const std::vector<uint16_t>& seqNumbers) override
+		{
+			INFO("aggregated NACK required");
+
+			this->numNacks++;
+			this->ssrc = ssrc;
+			this->seqNumbers = seqNumbers;
+		}
+
+		virtual void OnAggregatedKeyFrameRequired(uint32_t ssrc) override
+		{
+			INFO("aggregated key frame required");
+
+			this->numKeyFrameRequests++;
+			this->ssrc = ssrc;
+		}
+
+	public:
+		size_t numNacks = 0;
+		size_t numKeyFrameRequests = 0;
+		uint32_t ssrc = 0;
+		std::vector<uint16_t> seqNumbers;
+	};
+
+	SECTION("NACKs for the same packets are merged into one")
+	{
+		RtcpFeedbackAggregatorListener listener;
+		RtcpFeedbackAggregator aggregator(&listener, 10, 1000);
+
+		aggregator.ReceiveNack(1234, { 102, 100, 101 });
+		aggregator.ReceiveNack(1234, { 101, 102, 103 });
+		aggregator.ReceiveNack(1234, { 100 });
+
+		REQUIRE(listener.numNacks == 0);
+
+		// Let the aggregation window expire.
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.numNacks == 1);
+		REQUIRE(listener.ssrc == 1234);
+		REQUIRE(listener.seqNumbers == std::vector<uint16_t>({ 100, 101, 102, 103 }));
+
+		// Same packets again are not requested before the retry interval.
+		aggregator.ReceiveNack(1234, { 100, 101 });
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.numNacks == 1);
+	}
+
+	SECTION("NACKs are sorted taking wrap around into account")
+	{
+		RtcpFeedbackAggregatorListener listener;
+		RtcpFeedbackAggregator aggregator(&listener, 0, 1000);
+
+		aggregator.ReceiveNack(1234, { 65535, 0, 65534, 1 });
+
+		REQUIRE(listener.numNacks == 1);
+		REQUIRE(listener.seqNumbers == std::vector<uint16_t>({ 65534, 65535, 0, 1 }));
+	}
+
+	SECTION("NACKs already sent by the RtpReceiver are not sent again")
+	{
+		RtcpFeedbackAggregatorListener listener;
+		RtcpFeedbackAggregator aggregator(&listener, 0, 1000);
+
+		aggregator.RegisterSentNack(1234, { 200, 201 });
+		aggregator.ReceiveNack(1234, { 200, 201 });
+
+		REQUIRE(listener.numNacks == 0);
+
+		aggregator.ReceiveNack(1234, { 201, 202 });
+
+		REQUIRE(listener.numNacks == 1);
+		REQUIRE(listener.seqNumbers == std::vector<uint16_t>({ 202 }));
+	}
+
+	SECTION("key frame requests are rate limited per stream")
+	{
+		RtcpFeedbackAggregatorListener listener;
+		RtcpFeedbackAggregator aggregator(&listener, 10, 1000);
+
+		REQUIRE(aggregator.ReceiveKeyFrameRequest(1234) == true);
+		REQUIRE(aggregator.ReceiveKeyFrameRequest(1234) == false);
+		REQUIRE(aggregator.ReceiveKeyFrameRequest(1234) == false);
+		REQUIRE(aggregator.ReceiveKeyFrameRequest(5678) == true);
+
+		aggregator.RegisterSentKeyFrameRequest(9999);
+
+		REQUIRE(aggregator.ReceiveKeyFrameRequest(9999) == false);
+
+		auto json = aggregator.ToJson();
+
+		REQUIRE(json["keyFrameRequestsReceived"].asUInt() == 5);
+		REQUIRE(json["keyFrameRequestsForwarded"].asUInt() == 2);
+
+		// Pending requests are dropped, not sent later.
+		aggregator.Clear();
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.numKeyFrameRequests == 0);
+	}
+}
@@ -0,0 +1,180 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/RTCP/FeedbackPsRemb.hpp"
+#include "RTC/RTCP/FeedbackRtpNack.hpp"
+#include "RTC/RTCP/Packet.hpp"
+#include "RTC/RTCP/ReceiverReport.hpp"
+#include "RTC/RTCP/Sdes.hpp"
+#include "RTC/RTCP/SenderReport.hpp"
+#include "RTC/RtcpScheduler.hpp"
+#include <string>
+#include <vector>
+
+using namespace RTC;
+
+SCENARIO("RTCP scheduler", "[rtcp][scheduler]")
+{
+	class RtcpSchedulerListener : public RtcpScheduler::Listener
+	{
+	public:
+		void OnRtcpSchedulerPacket(
+		    RtcpScheduler* /*rtcpScheduler*/, const uint8_t* data, size_t len) override
+		{
+			REQUIRE(len <= size_t{ RtcpScheduler::MaxPacketSize });
+
+			this->numPackets++;
+
+			RTCP::Packet* packet = RTCP::Packet::Parse(data, len);
+
+			REQUIRE(packet);
+
+			// A compound packet starts with a SR or a RR.
+			if (packet->GetType() == RTCP::Type::SR || packet->GetType() == RTCP::Type::RR)
+				this->numCompoundPackets++;
+
+			while (packet != nullptr)
+			{
+				RTCP::Packet* next = packet->GetNext();
+
+				switch (packet->GetType())
+				{
+					case RTCP::Type::SR:
+						this->numSenderReports += packet->GetCount();
+						break;
+					case RTCP::Type::RR:
+						this->numReceiverReports += packet->GetCount();
+						break;
+					case RTCP::Type::SDES:
+						this->numSdesPackets++;
+						this->numSdesChunks += packet->GetCount();
+						break;
+					case RTCP::Type::RTPFB:
+					{
+						auto* nack = static_cast<RTCP::FeedbackRtpNackPacket*>(packet);
+
+						for (auto it = nack->Begin(); it != nack->End(); ++it)
+						{
+							this->numNackItems++;
+						}
+
+						break;
+					}
+					case RTCP::Type::PSFB:
+						this->rembBitrate = static_cast<RTCP::FeedbackPsRembPacket*>(packet)->GetBitrate();
+						break;
+					default:;
+				}
+
+				delete packet;
+				packet = next;
+			}
+		}
+
+	public:
+		size_t numPackets{ 0 };
+		size_t numCompoundPackets{ 0 };
+		size_t numSenderReports{ 0 };
+		size_t numReceiverReports{ 0 };
+		size_t numSdesPackets{ 0 };
+		size_t numSdesChunks{ 0 };
+		size_t numNackItems{ 0 };
+		uint64_t rembBitrate{ 0 };
+	};
+
+	// Sends one report and stops.
+	class Reporter : public RtcpScheduler::Reporter
+	{
+	public:
+		Reporter(uint32_t ssrc, bool isSender, size_t numReceiverReports)
+		    : ssrc(ssrc), isSender(isSender), numReceiverReports(numReceiverReports)
+		{
+		}
+
+	public:
+		void OnRtcpSchedulerReport(RtcpScheduler* rtcpScheduler, uint64_t /*now*/) override
+		{
+			if (this->isSender)
+			{
+				RTCP::SenderReport report;
+
+				report.SetSsrc(this->ssrc);
+				report.SetPacketCount(100);
+				rtcpScheduler->AddSenderReport(&report, "test-cname");
+			}
+
+			for (size_t i{ 0 }; i < this->numReceiverReports; ++i)
+			{
+				RTCP::ReceiverReport report;
+
+				report.SetSsrc(this->ssrc + i);
+				rtcpScheduler->AddReceiverReport(&report);
+			}
+
+			rtcpScheduler->RemoveReporter(this);
+		}
+
+	public:
+		uint32_t ssrc{ 0 };
+		bool isSender{ false };
+		size_t numReceiverReports{ 0 };
+	};
+
+	SECTION("reports due at the same time are packed into one compound packet")
+	{
+		RtcpSchedulerListener listener;
+		RtcpScheduler scheduler(&listener);
+		Reporter sender1(1000, true, 0);
+		Reporter sender2(2000, true, 0);
+		Reporter receiver(3000, false, 2);
+
+		scheduler.AddReporter(&sender1, 100);
+		scheduler.AddReporter(&sender2, 100);
+		scheduler.AddReporter(&receiver, 100);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.numPackets == 1);
+		REQUIRE(listener.numCompoundPackets == 1);
+		REQUIRE(listener.numSenderReports == 2);
+		REQUIRE(listener.numReceiverReports == 2);
+		REQUIRE(listener.numSdesChunks == 2);
+	}
+
+	SECTION("reports not fitting into a compound packet go into another one")
+	{
+		RtcpSchedulerListener listener;
+		RtcpScheduler scheduler(&listener);
+		Reporter sender(1000, true, 0);
+		Reporter receiver(2000, false, 100);
+
+		scheduler.AddReporter(&sender, 100);
+		scheduler.AddReporter(&receiver, 100);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.numCompoundPackets == 3);
+		REQUIRE(listener.numSenderReports == 1);
+		REQUIRE(listener.numReceiverReports == 100);
+		// Every compound packet carries the CNAME.
+		REQUIRE(listener.numSdesPackets == 3);
+		REQUIRE(listener.numSdesChunks == 3);
+	}
+
+	SECTION("NACK and REMB are sent right away")
+	{
+		RtcpSchedulerListener listener;
+		RtcpScheduler scheduler(&listener);
+
+		scheduler.SendNack(1234, { 100, 101, 116, 117, 200 });
+
+		REQUIRE(listener.numPackets == 1);
+		REQUIRE(listener.numNackItems == 3);
+
+		scheduler.SendRemb(1000000, { 1234, 5678 });
+
+		REQUIRE(listener.numPackets == 2);
+		REQUIRE(listener.rembBitrate > 999000);
+		REQUIRE(listener.rembBitrate <= 1000000);
+	}
+}
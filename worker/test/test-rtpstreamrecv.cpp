@@ -117,5 +117,21 @@ SCENARIO("receive RTP packets and trigger NACK", "[rtp][rtpstream]")
 		rtpStream.ReceivePacket(packet);
 	}
 
+	SECTION("first packet is not taken into account for jitter")
+	{
+		RtpStreamRecvListener listener;
+		RtpStreamRecv rtpStream(&listener, params);
+
+		packet->SetSequenceNumber(1);
+		rtpStream.ReceivePacket(packet);
+
+		REQUIRE(rtpStream.GetStats(0).jitter == 0);
+
+		packet->SetSequenceNumber(2);
+		rtpStream.ReceivePacket(packet);
+
+		REQUIRE(rtpStream.GetStats(0).jitter == 0);
+	}
+
 	delete packet;
 }
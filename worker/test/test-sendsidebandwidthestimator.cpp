@@ -0,0 +1,167 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include "RTC/RTCP/PacketView.hpp"
+#include "RTC/SendSideBandwidthEstimator.hpp"
+#include <vector>
+
+using namespace RTC;
+
+class SendSideBandwidthEstimatorListener : public SendSideBandwidthEstimator::Listener
+{
+public:
+	virtual void OnSendSideBandwidthEstimation(
+	    SendSideBandwidthEstimator* /*sendSideBandwidthEstimator*/,
+	    uint32_t availableBitrate) override
+	{
+		INFO("available bitrate changed");
+
+		this->bitrate = availableBitrate;
+	}
+
+public:
+	uint32_t bitrate = 0;
+};
+
+struct Arrival
+{
+	uint16_t wideSeqNumber;
+	bool received;
+	int64_t arrivedAt;
+};
+
+// Sends 1000 bytes every 10 ms (800 kbps) and reports them every 100 ms. Every
+// packet arrives `delayGrowth` ms later than the previous one and one of each
+// `lossEvery` packets is lost.
+static void simulate(
+    SendSideBandwidthEstimator& estimator,
+    uint64_t& now,
+    uint64_t duration,
+    double delayGrowth,
+    size_t lossEvery,
+    double& delay)
+{
+	std::vector<Arrival> arrivals;
+	uint64_t end = now + duration;
+	size_t count{ 0 };
+
+	for (; now < end; now += 10)
+	{
+		Arrival arrival;
+
+		delay += delayGrowth;
+
+		arrival.wideSeqNumber = estimator.RtpPacketSent(1000, now);
+		arrival.received      = lossEvery == 0 || ++count % lossEvery != 0;
+		arrival.arrivedAt     = static_cast<int64_t>(now + delay);
+
+		arrivals.push_back(arrival);
+
+		if (now % 100 != 0)
+			continue;
+
+		RTCP::FeedbackRtpTransportPacket feedback(0, 1234);
+		auto referenceTime = static_cast<uint32_t>(
+		    arrivals.front().arrivedAt / RTCP::FeedbackRtpTransportPacket::ReferenceTimeUnit);
+		int64_t lastTime =
+		    int64_t{ referenceTime } * RTCP::FeedbackRtpTransportPacket::ReferenceTimeUnit * 4;
+
+		feedback.SetBase(arrivals.front().wideSeqNumber, referenceTime, 0);
+
+		for (auto& item : arrivals)
+		{
+			if (!item.received)
+			{
+				feedback.AddPacket(false, 0);
+
+				continue;
+			}
+
+			// Deltas in 250 us units.
+			REQUIRE(feedback.AddPacket(true, static_cast<int32_t>(item.arrivedAt * 4 - lastTime)));
+
+			lastTime = item.arrivedAt * 4;
+		}
+
+		uint8_t buffer[1500];
+		size_t len = feedback.Serialize(buffer);
+
+		estimator.ReceiveTransportFeedback(RTCP::PacketView(buffer, len), now);
+		arrivals.clear();
+	}
+}
+
+SCENARIO("send side bandwidth estimation", "[bwe]")
+{
+	SECTION("REMB is used if there is no transport feedback")
+	{
+		SendSideBandwidthEstimatorListener listener;
+		SendSideBandwidthEstimator estimator(&listener);
+
+		REQUIRE(estimator.GetAvailableBitrate() == 0);
+
+		estimator.ReceiveRemb(500000, 1000);
+
+		REQUIRE(listener.bitrate == 500000);
+		REQUIRE(estimator.GetAvailableBitrate() == 500000);
+	}
+
+	SECTION("transport-wide sequence numbers are consecutive")
+	{
+		SendSideBandwidthEstimatorListener listener;
+		SendSideBandwidthEstimator estimator(&listener);
+
+		REQUIRE(estimator.RtpPacketSent(1000, 1000) == 0);
+		REQUIRE(estimator.RtpPacketSent(1000, 1000) == 1);
+		REQUIRE(estimator.RtpPacketSent(1000, 1001) == 2);
+	}
+
+	SECTION("growing delay decreases the estimate")
+	{
+		SendSideBandwidthEstimatorListener listener;
+		SendSideBandwidthEstimator estimator(&listener);
+		// Rate calculators are initialized with the loop time.
+		uint64_t now = (DepLibUV::GetTime() / 100 + 1) * 100;
+		double delay{ 50 };
+
+		// The estimate is initialized with the acked bitrate after 5 seconds.
+		simulate(estimator, now, 7000, 0, 0, delay);
+
+		uint32_t bitrate = listener.bitrate;
+
+		REQUIRE(bitrate >= 700000);
+		REQUIRE(bitrate <= 1210000);
+
+		// Queues build up in the network.
+		simulate(estimator, now, 1000, 2, 0, delay);
+
+		REQUIRE(listener.bitrate < bitrate);
+		REQUIRE(listener.bitrate == estimator.GetAvailableBitrate());
+
+		// REMB caps the estimate.
+		estimator.ReceiveRemb(100000, now);
+
+		REQUIRE(listener.bitrate == 100000);
+	}
+
+	SECTION("high loss decreases the estimate")
+	{
+		SendSideBandwidthEstimatorListener listener;
+		SendSideBandwidthEstimator estimator(&listener);
+		// Rate calculators are initialized with the loop time.
+		uint64_t now = (DepLibUV::GetTime() / 100 + 1) * 100;
+		double delay{ 50 };
+
+		simulate(estimator, now, 7000, 0, 0, delay);
+
+		uint32_t bitrate = listener.bitrate;
+
+		REQUIRE(bitrate > 0);
+
+		// 25% loss.
+		simulate(estimator, now, 1000, 0, 4, delay);
+
+		REQUIRE(listener.bitrate < bitrate * 0.8);
+	}
+}
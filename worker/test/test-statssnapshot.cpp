@@ -0,0 +1,121 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpStreamRecv.hpp"
+#include "RTC/StatsSnapshot.hpp"
+#include "Utils.hpp"
+#include <vector>
+
+using namespace RTC;
+
+SCENARIO("RTP stream stats snapshot", "[rtp][stats]")
+{
+	class RtpStreamRecvListener : public RtpStreamRecv::Listener
+	{
+	public:
+		void OnNackRequired(
+		    RtpStreamRecv* /*rtpStream*/, const std::vector<uint16_t>& /*seqNumbers*/) override
+		{
+		}
+
+		void OnPliRequired(RtpStreamRecv* /*rtpStream*/) override
+		{
+		}
+	};
+
+	SECTION("records are written at fixed offsets")
+	{
+		StatsSnapshot snapshot(123456789012);
+		RtpStream::Stats stats;
+
+		stats.packets              = 1000;
+		stats.bytes                = 0x123456789A;
+		stats.packetsLost          = 12;
+		stats.fractionLost         = 64;
+		stats.jitter               = 30;
+		stats.rtt                  = 150;
+		stats.nackPackets          = 7;
+		stats.keyFrameRequests     = 2;
+		stats.retransmittedPackets = 5;
+		stats.bitrate              = 500000;
+
+		REQUIRE(snapshot.GetSize() == size_t{ StatsSnapshot::HeaderSize });
+		REQUIRE(snapshot.GetCount() == 0);
+
+		snapshot.Add(
+		    1, 0x11111111, StatsSnapshot::Direction::RECEIVE, Media::Kind::AUDIO, 0xFF, 0xFF, stats);
+		snapshot.Add(2, 0x22222222, StatsSnapshot::Direction::SEND, Media::Kind::VIDEO, 1, 2, stats);
+
+		const uint8_t* data = snapshot.GetData();
+
+		REQUIRE(snapshot.GetCount() == 2);
+		REQUIRE(snapshot.GetSize() == StatsSnapshot::HeaderSize + 2 * StatsSnapshot::RecordSize);
+		REQUIRE(data[0] == uint8_t{ StatsSnapshot::Version });
+		REQUIRE(data[1] == size_t{ StatsSnapshot::RecordSize });
+		REQUIRE(Utils::Byte::Get4Bytes(data, 4) == 2);
+		REQUIRE(Utils::Byte::Get8Bytes(data, 8) == 123456789012);
+
+		const uint8_t* record = data + StatsSnapshot::HeaderSize + StatsSnapshot::RecordSize;
+
+		REQUIRE(Utils::Byte::Get4Bytes(record, 0) == 2);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 4) == 0x22222222);
+		REQUIRE(record[8] == static_cast<uint8_t>(StatsSnapshot::Direction::SEND));
+		REQUIRE(record[9] == static_cast<uint8_t>(Media::Kind::VIDEO));
+		REQUIRE(record[10] == 1);
+		REQUIRE(record[11] == 2);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 12) == 1000);
+		REQUIRE(Utils::Byte::Get8Bytes(record, 16) == 0x123456789A);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 24) == 12);
+		REQUIRE(record[28] == 64);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 32) == 30);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 36) == 150);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 40) == 7);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 44) == 2);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 48) == 5);
+		REQUIRE(Utils::Byte::Get4Bytes(record, 52) == 500000);
+	}
+
+	SECTION("received packets are counted")
+	{
+		// clang-format off
+		uint8_t buffer[] =
+		{
+			0b10000000, 0b00000001, 0, 1,
+			0, 0, 0, 4,
+			0, 0, 0, 5,
+			1, 2, 3, 4
+		};
+		// clang-format on
+
+		RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		if (packet == nullptr)
+			FAIL("not a RTP packet");
+
+		RtpStream::Params params;
+
+		params.ssrc      = packet->GetSsrc();
+		params.clockRate = 90000;
+		params.useNack   = true;
+
+		RtpStreamRecvListener listener;
+		RtpStreamRecv rtpStream(&listener, params);
+
+		packet->SetSequenceNumber(1);
+		rtpStream.ReceivePacket(packet);
+		packet->SetSequenceNumber(2);
+		rtpStream.ReceivePacket(packet);
+		// Packets 3 and 4 are lost and NACKed.
+		packet->SetSequenceNumber(5);
+		rtpStream.ReceivePacket(packet);
+
+		auto stats = rtpStream.GetStats(0);
+
+		REQUIRE(stats.packets == 3);
+		REQUIRE(stats.bytes == 3 * sizeof(buffer));
+		REQUIRE(stats.packetsLost == 2);
+		REQUIRE(stats.nackPackets == 2);
+
+		delete packet;
+	}
+}
@@ -0,0 +1,104 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "handles/TimerWheel.hpp"
+#include <vector>
+
+SCENARIO("timers in the hierarchical timing wheel", "[timerwheel]")
+{
+	class TimerWheelListener : public TimerWheel::Listener
+	{
+	public:
+		void OnTimer(TimerWheel::Handle* handle) override
+		{
+			this->fired.push_back(handle);
+			this->firedAt.push_back(DepLibUV::GetTime());
+
+			// Stop repeating timers after the given number of expirations.
+			if (this->fired.size() == this->maxFired)
+				handle->Stop();
+		}
+
+	public:
+		std::vector<TimerWheel::Handle*> fired;
+		std::vector<uint64_t> firedAt;
+		size_t maxFired{ 0 };
+	};
+
+	SECTION("timers fire in expiration order")
+	{
+		TimerWheelListener listener;
+		TimerWheel::Handle handle1(&listener);
+		TimerWheel::Handle handle2(&listener);
+		TimerWheel::Handle handle3(&listener);
+		uint64_t startedAt = DepLibUV::GetTime();
+
+		handle1.Start(30);
+		handle2.Start(10);
+		handle3.Start(20);
+
+		REQUIRE(handle1.IsActive());
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.fired == std::vector<TimerWheel::Handle*>({ &handle2, &handle3, &handle1 }));
+		REQUIRE(listener.firedAt[0] >= startedAt + 10);
+		REQUIRE(listener.firedAt[2] >= startedAt + 30);
+		REQUIRE(!handle1.IsActive());
+	}
+
+	SECTION("stopped and restarted timers")
+	{
+		TimerWheelListener listener;
+		TimerWheel::Handle handle1(&listener);
+		TimerWheel::Handle handle2(&listener);
+
+		handle1.Start(10);
+		handle2.Start(10);
+		handle1.Stop();
+		handle2.Start(20);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.fired == std::vector<TimerWheel::Handle*>({ &handle2 }));
+	}
+
+	SECTION("repeating timers fire until stopped")
+	{
+		TimerWheelListener listener;
+		TimerWheel::Handle handle(&listener);
+		uint64_t startedAt = DepLibUV::GetTime();
+
+		listener.maxFired = 5;
+		handle.Start(5, 5);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.fired.size() == 5);
+		REQUIRE(listener.firedAt[4] >= startedAt + 25);
+		REQUIRE(!handle.IsActive());
+	}
+
+	SECTION("timers in higher levels are moved down and fire on time")
+	{
+		TimerWheelListener listener;
+		TimerWheel::Handle handle(&listener);
+		uint64_t startedAt = DepLibUV::GetTime();
+
+		handle.Start(300);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.fired.size() == 1);
+		REQUIRE(listener.firedAt[0] >= startedAt + 300);
+		REQUIRE(listener.firedAt[0] < startedAt + 400);
+	}
+
+	SECTION("metrics")
+	{
+		Json::Value json = TimerWheel::ToJson();
+
+		REQUIRE(json["timers"].asUInt64() == 0);
+		REQUIRE(json["levels"].size() == size_t{ TimerWheel::Levels });
+	}
+}
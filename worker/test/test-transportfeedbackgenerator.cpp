@@ -0,0 +1,91 @@
+#include "include/catch.hpp"
+#include "common.hpp"
+#include "DepLibUV.hpp"
+#include "RTC/RTCP/FeedbackRtpTransport.hpp"
+#include "RTC/TransportFeedbackGenerator.hpp"
+#include <vector>
+
+using namespace RTC;
+
+SCENARIO("generate transport-cc feedback", "[rtcp][transportcc]")
+{
+	class TransportFeedbackGeneratorListener :
+		public TransportFeedbackGenerator::Listener
+	{
+	public:
+		virtual void OnTransportFeedback(
+		  TransportFeedbackGenerator* /*transportFeedbackGenerator*/,
+		  RTCP::FeedbackRtpTransportPacket* packet) override
+		{
+			INFO("transport feedback generated");
+
+			this->numFeedbacks++;
+			this->mediaSsrc = packet->GetMediaSsrc();
+			packet->GetPacketResults(this->results);
+		}
+
+	public:
+		size_t numFeedbacks = 0;
+		uint32_t mediaSsrc = 0;
+		std::vector<RTCP::FeedbackRtpTransportPacket::PacketResult> results;
+	};
+
+	SECTION("arrival times are reported periodically")
+	{
+		TransportFeedbackGeneratorListener listener;
+		TransportFeedbackGenerator generator(&listener);
+
+		generator.IncomingPacket(1000000, 1234, 65534);
+		generator.IncomingPacket(1001000, 1234, 65535);
+		// Packet 0 lost.
+		generator.IncomingPacket(1003000, 5678, 1);
+
+		REQUIRE(listener.numFeedbacks == 0);
+
+		// Let the feedback interval expire.
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.numFeedbacks == 1);
+		REQUIRE(listener.mediaSsrc == 5678);
+		REQUIRE(listener.results.size() == 4);
+		REQUIRE(listener.results[0].sequenceNumber == 65534);
+		REQUIRE(listener.results[0].received == true);
+		REQUIRE(listener.results[0].receivedAt == 1000);
+		REQUIRE(listener.results[1].sequenceNumber == 65535);
+		REQUIRE(listener.results[1].receivedAt == 1001);
+		REQUIRE(listener.results[2].sequenceNumber == 0);
+		REQUIRE(listener.results[2].received == false);
+		REQUIRE(listener.results[3].sequenceNumber == 1);
+		REQUIRE(listener.results[3].receivedAt == 1003);
+
+		// The lost packet arrives too late, already reported.
+		generator.IncomingPacket(1010000, 1234, 0);
+		generator.IncomingPacket(1020000, 1234, 2);
+
+		listener.results.clear();
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.numFeedbacks == 2);
+		REQUIRE(listener.results.size() == 1);
+		REQUIRE(listener.results[0].sequenceNumber == 2);
+		REQUIRE(listener.results[0].receivedAt == 1020);
+	}
+
+	SECTION("too long gaps between packets are split into several feedbacks")
+	{
+		TransportFeedbackGeneratorListener listener;
+		TransportFeedbackGenerator generator(&listener);
+
+		// The second delta does not fit into a large delta (8191.75 ms max).
+		generator.IncomingPacket(1000000, 1234, 10);
+		generator.IncomingPacket(20000000, 1234, 11);
+
+		DepLibUV::RunLoop();
+
+		REQUIRE(listener.numFeedbacks == 2);
+		REQUIRE(listener.results.size() == 2);
+		REQUIRE(listener.results[0].receivedAt == 1000);
+		REQUIRE(listener.results[1].sequenceNumber == 11);
+		REQUIRE(listener.results[1].receivedAt == 20000);
+	}
+}
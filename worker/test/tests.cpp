@@ -7,6 +7,7 @@
 #include "DepLibUV.hpp"
 #include "DepOpenSSL.hpp"
 #include "Utils.hpp"
+#include "handles/TimerWheel.hpp"
 #include <string>
 
 static void init();
@@ -36,11 +37,13 @@ void init()
 	DepLibUV::ClassInit();
 	DepOpenSSL::ClassInit();
 	Utils::Crypto::ClassInit();
+	TimerWheel::ClassInit();
 }
 
 void destroy()
 {
 	// Free static stuff.
+	TimerWheel::ClassDestroy();
 	Utils::Crypto::ClassDestroy();
 	DepOpenSSL::ClassDestroy();
 	DepLibUV::ClassDestroy();